@@ -15,6 +15,7 @@
 //               ex16 -m ../data/beam-tet.mesh -tf 10 -dt 0.1
 //               ex16 -m ../data/amr-quad.mesh -o 4 -r 0
 //               ex16 -m ../data/amr-hex.mesh -o 2 -r 0
+//               ex16 -r 3 -dt 0.1 -tf 5 -rd 20
 //
 // Description:  This example solves a time dependent nonlinear heat equation
 //               problem of the form du/dt = C(u), with a non-linear diffusion
@@ -27,7 +28,9 @@
 //               high-order implicit (SDIRK) time integration. In this example,
 //               the diffusion operator is linearized by evaluating with the
 //               lagged solution from the previous timestep, so there is only
-//               a linear solve.
+//               a linear solve. With the -rd option, the linear systems are
+//               solved with DeflatedCGSolver, which recycles a subspace of
+//               approximate eigenvectors from one solve to the next.
 //
 //               We recommend viewing examples 2, 9 and 10 before viewing this
 //               example.
@@ -65,8 +68,9 @@ protected:
    CGSolver M_solver; // Krylov solver for inverting the mass matrix M
    DSmoother M_prec;  // Preconditioner for the mass matrix M
 
-   CGSolver T_solver; // Implicit solver for T = M + dt K
-   DSmoother T_prec;  // Preconditioner for the implicit solver
+   IterativeSolver *T_solver; // Implicit solver for T = M + dt K
+   DSmoother T_prec;          // Preconditioner for the implicit solver
+   int T_iterations;          // Total number of iterations of T_solver
 
    real_t alpha, kappa;
 
@@ -74,7 +78,7 @@ protected:
 
 public:
    ConductionOperator(FiniteElementSpace &f, real_t alpha, real_t kappa,
-                      const Vector &u);
+                      const Vector &u, int recycle_dim = 0);
 
    void Mult(const Vector &u, Vector &du_dt) const override;
    /** Solve the Backward-Euler equation: k = f(u + dt*k, t), for the unknown k.
@@ -84,6 +88,9 @@ public:
    /// Update the diffusion BilinearForm K using the given true-dof vector `u`.
    void SetParameters(const Vector &u);
 
+   /// Return the total number of iterations of the implicit solver.
+   int GetImplicitIterations() const { return T_iterations; }
+
    ~ConductionOperator() override;
 };
 
@@ -105,6 +112,7 @@ int main(int argc, char *argv[])
    bool visualization = true;
    bool visit = false;
    int vis_steps = 5;
+   int recycle_dim = 0;
 
    int precision = 8;
    cout.precision(precision);
@@ -134,6 +142,9 @@ int main(int argc, char *argv[])
                   "Save data files for VisIt (visit.llnl.gov) visualization.");
    args.AddOption(&vis_steps, "-vs", "--visualization-steps",
                   "Visualize every n-th timestep.");
+   args.AddOption(&recycle_dim, "-rd", "--recycle-dim",
+                  "Dimension of the subspace recycled between the implicit "
+                  "solves (0 = plain CG).");
    args.Parse();
    if (!args.Good())
    {
@@ -178,7 +189,7 @@ int main(int argc, char *argv[])
    u_gf.GetTrueDofs(u);
 
    // 7. Initialize the conduction operator and the visualization.
-   ConductionOperator oper(fespace, alpha, kappa, u);
+   ConductionOperator oper(fespace, alpha, kappa, u, recycle_dim);
 
    u_gf.SetFromTrueDofs(u);
    {
@@ -258,6 +269,12 @@ int main(int argc, char *argv[])
       oper.SetParameters(u);
    }
 
+   if (recycle_dim > 0)
+   {
+      cout << "Total number of CG iterations of the implicit solves: "
+           << oper.GetImplicitIterations() << endl;
+   }
+
    // 9. Save the final solution. This output can be viewed later using GLVis:
    //    "glvis -m ex16.mesh -g ex16-final.gf".
    {
@@ -273,9 +290,11 @@ int main(int argc, char *argv[])
 }
 
 ConductionOperator::ConductionOperator(FiniteElementSpace &f, real_t al,
-                                       real_t kap, const Vector &u)
+                                       real_t kap, const Vector &u,
+                                       int recycle_dim)
    : TimeDependentOperator(f.GetTrueVSize(), (real_t) 0.0), fespace(f),
-     M(NULL), K(NULL), T(NULL), current_dt(0.0), z(height)
+     M(NULL), K(NULL), T(NULL), current_dt(0.0), T_solver(NULL),
+     T_iterations(0), z(height)
 {
    const real_t rel_tol = 1e-8;
 
@@ -295,12 +314,22 @@ ConductionOperator::ConductionOperator(FiniteElementSpace &f, real_t al,
    alpha = al;
    kappa = kap;
 
-   T_solver.iterative_mode = false;
-   T_solver.SetRelTol(rel_tol);
-   T_solver.SetAbsTol(0.0);
-   T_solver.SetMaxIter(100);
-   T_solver.SetPrintLevel(0);
-   T_solver.SetPreconditioner(T_prec);
+   if (recycle_dim > 0)
+   {
+      DeflatedCGSolver *dcg = new DeflatedCGSolver;
+      dcg->SetRecycleDim(recycle_dim);
+      T_solver = dcg;
+   }
+   else
+   {
+      T_solver = new CGSolver;
+   }
+   T_solver->iterative_mode = false;
+   T_solver->SetRelTol(rel_tol);
+   T_solver->SetAbsTol(0.0);
+   T_solver->SetMaxIter(100);
+   T_solver->SetPrintLevel(0);
+   T_solver->SetPreconditioner(T_prec);
 
    SetParameters(u);
 }
@@ -325,12 +354,13 @@ void ConductionOperator::ImplicitSolve(const real_t dt,
    {
       T = Add(1.0, Mmat, dt, Kmat);
       current_dt = dt;
-      T_solver.SetOperator(*T);
+      T_solver->SetOperator(*T);
    }
    MFEM_VERIFY(dt == current_dt, ""); // SDIRK methods use the same dt
    Kmat.Mult(u, z);
    z.Neg();
-   T_solver.Mult(z, du_dt);
+   T_solver->Mult(z, du_dt);
+   T_iterations += T_solver->GetNumIterations();
 }
 
 void ConductionOperator::SetParameters(const Vector &u)
@@ -356,6 +386,7 @@ void ConductionOperator::SetParameters(const Vector &u)
 
 ConductionOperator::~ConductionOperator()
 {
+   delete T_solver;
    delete T;
    delete M;
    delete K;
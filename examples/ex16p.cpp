@@ -15,6 +15,7 @@
 //               mpirun -np 8 ex16p -m ../data/beam-tet.mesh -tf 10 -dt 0.1
 //               mpirun -np 4 ex16p -m ../data/amr-quad.mesh -o 4 -rs 0 -rp 0
 //               mpirun -np 4 ex16p -m ../data/amr-hex.mesh -o 2 -rs 0 -rp 0
+//               mpirun -np 4 ex16p -rs 3 -dt 0.1 -tf 5 -rd 20
 //
 // Description:  This example solves a time dependent nonlinear heat equation
 //               problem of the form du/dt = C(u), with a non-linear diffusion
@@ -27,8 +28,11 @@
 //               high-order implicit (SDIRK) time integration. In this example,
 //               the diffusion operator is linearized by evaluating with the
 //               lagged solution from the previous timestep, so there is only
-//               a linear solve. Optional saving with ADIOS2
-//               (adios2.readthedocs.io) is also illustrated.
+//               a linear solve. With the -rd option, the linear systems are
+//               solved with DeflatedCGSolver, which recycles a subspace of
+//               approximate eigenvectors from one solve to the next. Optional
+//               saving with ADIOS2 (adios2.readthedocs.io) is also
+//               illustrated.
 //
 //               We recommend viewing examples 2, 9 and 10 before viewing this
 //               example.
@@ -67,8 +71,9 @@ protected:
    CGSolver M_solver;    // Krylov solver for inverting the mass matrix M
    HypreSmoother M_prec; // Preconditioner for the mass matrix M
 
-   CGSolver T_solver;    // Implicit solver for T = M + dt K
-   HypreSmoother T_prec; // Preconditioner for the implicit solver
+   IterativeSolver *T_solver; // Implicit solver for T = M + dt K
+   HypreSmoother T_prec;      // Preconditioner for the implicit solver
+   int T_iterations;          // Total number of iterations of T_solver
 
    real_t alpha, kappa;
 
@@ -76,7 +81,7 @@ protected:
 
 public:
    ConductionOperator(ParFiniteElementSpace &f, real_t alpha, real_t kappa,
-                      const Vector &u);
+                      const Vector &u, int recycle_dim = 0);
 
    void Mult(const Vector &u, Vector &du_dt) const override;
    /** Solve the Backward-Euler equation: k = f(u + dt*k, t), for the unknown k.
@@ -86,6 +91,9 @@ public:
    /// Update the diffusion BilinearForm K using the given true-dof vector `u`.
    void SetParameters(const Vector &u);
 
+   /// Return the total number of iterations of the implicit solver.
+   int GetImplicitIterations() const { return T_iterations; }
+
    ~ConductionOperator() override;
 };
 
@@ -115,6 +123,7 @@ int main(int argc, char *argv[])
    bool visit = false;
    int vis_steps = 5;
    bool adios2 = false;
+   int recycle_dim = 0;
 
    int precision = 8;
    cout.precision(precision);
@@ -149,6 +158,9 @@ int main(int argc, char *argv[])
    args.AddOption(&adios2, "-adios2", "--adios2-streams", "-no-adios2",
                   "--no-adios2-streams",
                   "Save data using adios2 streams.");
+   args.AddOption(&recycle_dim, "-rd", "--recycle-dim",
+                  "Dimension of the subspace recycled between the implicit "
+                  "solves (0 = plain CG).");
    args.Parse();
    if (!args.Good())
    {
@@ -211,7 +223,7 @@ int main(int argc, char *argv[])
    u_gf.GetTrueDofs(u);
 
    // 9. Initialize the conduction operator and the VisIt visualization.
-   ConductionOperator oper(fespace, alpha, kappa, u);
+   ConductionOperator oper(fespace, alpha, kappa, u, recycle_dim);
 
    u_gf.SetFromTrueDofs(u);
    {
@@ -345,6 +357,12 @@ int main(int argc, char *argv[])
    }
 #endif
 
+   if (recycle_dim > 0 && myid == 0)
+   {
+      cout << "Total number of CG iterations of the implicit solves: "
+           << oper.GetImplicitIterations() << endl;
+   }
+
    // 11. Save the final solution in parallel. This output can be viewed later
    //     using GLVis: "glvis -np <np> -m ex16-mesh -g ex16-final".
    {
@@ -362,10 +380,11 @@ int main(int argc, char *argv[])
 }
 
 ConductionOperator::ConductionOperator(ParFiniteElementSpace &f, real_t al,
-                                       real_t kap, const Vector &u)
+                                       real_t kap, const Vector &u,
+                                       int recycle_dim)
    : TimeDependentOperator(f.GetTrueVSize(), (real_t) 0.0), fespace(f),
      M(NULL), K(NULL), T(NULL), current_dt(0.0),
-     M_solver(f.GetComm()), T_solver(f.GetComm()), z(height)
+     M_solver(f.GetComm()), T_solver(NULL), T_iterations(0), z(height)
 {
    const real_t rel_tol = 1e-8;
 
@@ -386,12 +405,22 @@ ConductionOperator::ConductionOperator(ParFiniteElementSpace &f, real_t al,
    alpha = al;
    kappa = kap;
 
-   T_solver.iterative_mode = false;
-   T_solver.SetRelTol(rel_tol);
-   T_solver.SetAbsTol(0.0);
-   T_solver.SetMaxIter(100);
-   T_solver.SetPrintLevel(0);
-   T_solver.SetPreconditioner(T_prec);
+   if (recycle_dim > 0)
+   {
+      DeflatedCGSolver *dcg = new DeflatedCGSolver(f.GetComm());
+      dcg->SetRecycleDim(recycle_dim);
+      T_solver = dcg;
+   }
+   else
+   {
+      T_solver = new CGSolver(f.GetComm());
+   }
+   T_solver->iterative_mode = false;
+   T_solver->SetRelTol(rel_tol);
+   T_solver->SetAbsTol(0.0);
+   T_solver->SetMaxIter(100);
+   T_solver->SetPrintLevel(0);
+   T_solver->SetPreconditioner(T_prec);
 
    SetParameters(u);
 }
@@ -416,12 +445,13 @@ void ConductionOperator::ImplicitSolve(const real_t dt,
    {
       T = Add(1.0, Mmat, dt, Kmat);
       current_dt = dt;
-      T_solver.SetOperator(*T);
+      T_solver->SetOperator(*T);
    }
    MFEM_VERIFY(dt == current_dt, ""); // SDIRK methods use the same dt
    Kmat.Mult(u, z);
    z.Neg();
-   T_solver.Mult(z, du_dt);
+   T_solver->Mult(z, du_dt);
+   T_iterations += T_solver->GetNumIterations();
 }
 
 void ConductionOperator::SetParameters(const Vector &u)
@@ -447,6 +477,7 @@ void ConductionOperator::SetParameters(const Vector &u)
 
 ConductionOperator::~ConductionOperator()
 {
+   delete T_solver;
    delete T;
    delete M;
    delete K;
@@ -13,12 +13,154 @@
 
 #include "fem.hpp"
 #include "../general/device.hpp"
+#include "../general/annotation.hpp"
 #include "../mesh/nurbs.hpp"
+#include <algorithm>
 #include <cmath>
 
+// Threaded assembly requires thread-safe integrators, see
+// BilinearForm::UseThreadedAssembly().
+#if defined(MFEM_THREAD_SAFE) && \
+    (defined(MFEM_USE_OPENMP) || defined(MFEM_USE_LEGACY_OPENMP))
+#define MFEM_BILINEARFORM_THREADED_ASSEMBLY
+#include <omp.h>
+#endif
+
 namespace mfem
 {
 
+void AssemblyScatterMap::Enable(bool enable)
+{
+   if (enable == IsEnabled()) { return; }
+   Reset();
+   state = enable ? RECORDING : OFF;
+}
+
+void AssemblyScatterMap::Reset()
+{
+   if (state == READY) { state = RECORDING; }
+   map_mat = nullptr;
+   map_nnz = 0;
+   cursor = 0;
+   offsets.DeleteAll();
+   map.DeleteAll();
+   log_sizes.DeleteAll();
+   log_vdofs.DeleteAll();
+}
+
+void AssemblyScatterMap::BeginAssembly(SparseMatrix &mat)
+{
+   if (state == READY &&
+       (&mat != map_mat || !mat.Finalized() || mat.NumNonZeroElems() != map_nnz))
+   {
+      // The matrix was reallocated since the map was built
+      Reset();
+   }
+   if (state == RECORDING)
+   {
+      log_sizes.SetSize(0);
+      log_vdofs.SetSize(0);
+   }
+   cursor = 0;
+}
+
+void AssemblyScatterMap::AddSubMatrix(SparseMatrix &mat,
+                                      const Array<int> &rows,
+                                      const Array<int> &cols,
+                                      const DenseMatrix &subm, int skip_zeros)
+{
+   switch (state)
+   {
+      case OFF:
+         mat.AddSubMatrix(rows, cols, subm, skip_zeros);
+         break;
+
+      case RECORDING:
+         log_sizes.Append(rows.Size());
+         log_sizes.Append(cols.Size());
+         log_vdofs.Append(rows);
+         log_vdofs.Append(cols);
+         // Insert the zeros too, they may become nonzero in the next assembly
+         mat.AddSubMatrix(rows, cols, subm, 0);
+         break;
+
+      case READY:
+      {
+         const int nr = rows.Size(), nc = cols.Size();
+         MFEM_VERIFY(cursor + 1 < offsets.Size() &&
+                     offsets[cursor+1] - offsets[cursor] == nr*nc,
+                     "the assembly sequence does not match the frozen sparsity");
+         const int *slot = map.GetData() + offsets[cursor++];
+         real_t *A = mat.HostReadWriteData();
+         for (int i = 0; i < nr; i++)
+         {
+            for (int j = 0; j < nc; j++)
+            {
+               const int p = slot[i*nc + j];
+               if (p >= 0) { A[p] += subm(i, j); }
+               else { A[-1-p] -= subm(i, j); }
+            }
+         }
+         break;
+      }
+   }
+}
+
+void AssemblyScatterMap::EndAssembly(SparseMatrix &mat)
+{
+   if (state == READY)
+   {
+      MFEM_VERIFY(cursor + 1 == offsets.Size(),
+                  "the assembly sequence does not match the frozen sparsity");
+      return;
+   }
+   if (state != RECORDING) { return; }
+
+   mat.Finalize(0);
+   const int *I = mat.HostReadI();
+   const int *J = mat.HostReadJ();
+
+   const int num_ins = log_sizes.Size()/2;
+   offsets.SetSize(num_ins + 1);
+   offsets[0] = 0;
+   for (int k = 0; k < num_ins; k++)
+   {
+      offsets[k+1] = offsets[k] + log_sizes[2*k]*log_sizes[2*k+1];
+   }
+   map.SetSize(offsets[num_ins]);
+
+   Array<int> col_pos(mat.Width());
+   col_pos = -1;
+   const int *vdofs = log_vdofs.GetData();
+   for (int k = 0; k < num_ins; k++)
+   {
+      const int nr = log_sizes[2*k], nc = log_sizes[2*k+1];
+      const int *rows = vdofs, *cols = vdofs + nr;
+      int *slot = map.GetData() + offsets[k];
+      for (int i = 0; i < nr; i++)
+      {
+         int gi = rows[i], s = 1;
+         if (gi < 0) { gi = -1-gi; s = -1; }
+         for (int p = I[gi]; p < I[gi+1]; p++) { col_pos[J[p]] = p; }
+         for (int j = 0; j < nc; j++)
+         {
+            int gj = cols[j], t = s;
+            if (gj < 0) { gj = -1-gj; t = -s; }
+            MFEM_ASSERT(col_pos[gj] >= 0, "internal error");
+            slot[i*nc + j] = (t > 0) ? col_pos[gj] : -1-col_pos[gj];
+         }
+         for (int p = I[gi]; p < I[gi+1]; p++) { col_pos[J[p]] = -1; }
+      }
+      vdofs += nr + nc;
+   }
+   log_sizes.DeleteAll();
+   log_vdofs.DeleteAll();
+
+   map_mat = &mat;
+   map_nnz = mat.NumNonZeroElems();
+   state = READY;
+}
+
 void BilinearForm::AllocMat()
 {
    if (static_cond) { return; }
@@ -29,7 +171,21 @@ void BilinearForm::AllocMat()
       return;
    }
 
-   const Table &elem_dof = fes->GetElementToDofTable();
+   const Table *elem_dof_ptr = &fes->GetElementToDofTable();
+   Table elem_dof_unsigned;
+   {
+      // decode the signed dofs of e.g. ND and RT spaces
+      const int *ed_J = elem_dof_ptr->GetJ();
+      const int nnz = elem_dof_ptr->Size_of_connections();
+      if (std::any_of(ed_J, ed_J + nnz, [](int d) { return d < 0; }))
+      {
+         elem_dof_unsigned = *elem_dof_ptr;
+         int *J = elem_dof_unsigned.GetJ();
+         for (int k = 0; k < nnz; k++) { if (J[k] < 0) { J[k] = -1-J[k]; } }
+         elem_dof_ptr = &elem_dof_unsigned;
+      }
+   }
+   const Table &elem_dof = *elem_dof_ptr;
    Table dof_dof;
 
    if (interior_face_integs.Size() > 0)
@@ -455,6 +611,8 @@ void BilinearForm::AssembleBdrElementMatrix(
 
 void BilinearForm::Assemble(int skip_zeros)
 {
+   MFEM_PERF_SCOPE("BilinearForm::Assemble");
+
    if (ext)
    {
       ext->Assemble();
@@ -474,9 +632,16 @@ void BilinearForm::Assemble(int skip_zeros)
       AllocMat();
    }
 
+   if (scatter_map.IsEnabled())
+   {
+      MFEM_VERIFY(!static_cond && !hybridization, "UseFrozenSparsity() is not"
+                  " supported with static condensation or hybridization");
+      scatter_map.BeginAssembly(*mat);
+   }
+
 #ifdef MFEM_USE_LEGACY_OPENMP
    int free_element_matrices = 0;
-   if (!element_matrices)
+   if (!element_matrices && !threaded_assembly)
    {
       ComputeElementMatrices();
       free_element_matrices = 1;
@@ -504,62 +669,76 @@ void BilinearForm::Assemble(int skip_zeros)
 
       DofTransformation doftrans;
       // Element-wise integration
-      for (int i = 0; i < fes -> GetNE(); i++)
+      const bool threaded = threaded_assembly && mat->Finalized() &&
+                            !scatter_map.IsEnabled() && !element_matrices &&
+                            !static_cond && !hybridization;
+      if (threaded)
       {
-         // Set both doftrans (potentially needed to assemble the element
-         // matrix) and vdofs, which is also needed when the element matrices
-         // are pre-assembled.
-         fes->GetElementVDofs(i, vdofs, doftrans);
-         if (element_matrices)
-         {
-            elmat_p = &(*element_matrices)(i);
-         }
-         else
+         AssembleElementsThreaded(skip_zeros);
+      }
+      else
+      {
+         for (int i = 0; i < fes -> GetNE(); i++)
          {
-            const int elem_attr = fes->GetMesh()->GetAttribute(i);
-            eltrans = fes->GetElementTransformation(i);
-
-            elmat.SetSize(0);
-            for (int k = 0; k < domain_integs.Size(); k++)
+            // Set both doftrans (potentially needed to assemble the element
+            // matrix) and vdofs, which is also needed when the element matrices
+            // are pre-assembled.
+            fes->GetElementVDofs(i, vdofs, doftrans);
+            if (element_matrices)
             {
-               if (domain_integs_marker[k]) { domain_integs_marker[k]->HostRead(); }
-               if ((domain_integs_marker[k] == NULL ||
-                    (*(domain_integs_marker[k]))[elem_attr-1] == 1)
-                   && !domain_integs[k]->Patchwise())
+               elmat_p = &(*element_matrices)(i);
+            }
+            else
+            {
+               const int elem_attr = fes->GetMesh()->GetAttribute(i);
+               eltrans = fes->GetElementTransformation(i);
+
+               elmat.SetSize(0);
+               for (int k = 0; k < domain_integs.Size(); k++)
                {
-                  domain_integs[k]->AssembleElementMatrix(*fes->GetFE(i),
-                                                          *eltrans, elemmat);
-                  if (elmat.Size() == 0)
+                  if (domain_integs_marker[k])
                   {
-                     elmat = elemmat;
+                     domain_integs_marker[k]->HostRead();
                   }
-                  else
+                  if ((domain_integs_marker[k] == NULL ||
+                       (*(domain_integs_marker[k]))[elem_attr-1] == 1)
+                      && !domain_integs[k]->Patchwise())
                   {
-                     elmat += elemmat;
+                     domain_integs[k]->AssembleElementMatrix(*fes->GetFE(i),
+                                                             *eltrans, elemmat);
+                     if (elmat.Size() == 0)
+                     {
+                        elmat = elemmat;
+                     }
+                     else
+                     {
+                        elmat += elemmat;
+                     }
                   }
                }
+               if (elmat.Size() == 0)
+               {
+                  continue;
+               }
+               else
+               {
+                  elmat_p = &elmat;
+               }
+               doftrans.TransformDual(elmat);
+               elmat_p = &elmat;
             }
-            if (elmat.Size() == 0)
+            if (static_cond)
             {
-               continue;
+               static_cond->AssembleMatrix(i, *elmat_p);
             }
             else
             {
-               elmat_p = &elmat;
-            }
-            doftrans.TransformDual(elmat);
-            elmat_p = &elmat;
-         }
-         if (static_cond)
-         {
-            static_cond->AssembleMatrix(i, *elmat_p);
-         }
-         else
-         {
-            mat->AddSubMatrix(vdofs, vdofs, *elmat_p, skip_zeros);
-            if (hybridization)
-            {
-               hybridization->AssembleMatrix(i, *elmat_p);
+               scatter_map.AddSubMatrix(*mat, vdofs, vdofs, *elmat_p,
+                                        skip_zeros);
+               if (hybridization)
+               {
+                  hybridization->AssembleMatrix(i, *elmat_p);
+               }
             }
          }
       }
@@ -574,6 +753,8 @@ void BilinearForm::Assemble(int skip_zeros)
             {
                if (domain_integs[k]->Patchwise())
                {
+                  MFEM_VERIFY(!scatter_map.IsEnabled(), "UseFrozenSparsity() is"
+                              " not supported with patch-wise integrators");
                   if (!vdofsSet)
                   {
                      fes->GetPatchVDofs(p, vdofs);
@@ -656,7 +837,7 @@ void BilinearForm::Assemble(int skip_zeros)
          elmat_p = &elmat;
          if (!static_cond)
          {
-            mat->AddSubMatrix(vdofs, vdofs, *elmat_p, skip_zeros);
+            scatter_map.AddSubMatrix(*mat, vdofs, vdofs, *elmat_p, skip_zeros);
             if (hybridization)
             {
                hybridization->AssembleBdrMatrix(i, *elmat_p);
@@ -689,7 +870,8 @@ void BilinearForm::Assemble(int skip_zeros)
                AssembleFaceMatrix(*fes->GetFE(tr->Elem1No),
                                   *fes->GetFE(tr->Elem2No),
                                   *tr, elemmat);
-               mat -> AddSubMatrix (vdofs, vdofs, elemmat, skip_zeros);
+               scatter_map.AddSubMatrix(*mat, vdofs, vdofs, elemmat,
+                                        skip_zeros);
             }
          }
       }
@@ -743,12 +925,18 @@ void BilinearForm::Assemble(int skip_zeros)
 
                boundary_face_integs[k] -> AssembleFaceMatrix (*fe1, *fe2, *tr,
                                                               elemmat);
-               mat -> AddSubMatrix (vdofs, vdofs, elemmat, skip_zeros);
+               scatter_map.AddSubMatrix(*mat, vdofs, vdofs, elemmat,
+                                        skip_zeros);
             }
          }
       }
    }
 
+   if (scatter_map.IsEnabled())
+   {
+      scatter_map.EndAssembly(*mat);
+   }
+
 #ifdef MFEM_USE_LEGACY_OPENMP
    if (free_element_matrices)
    {
@@ -757,6 +945,88 @@ void BilinearForm::Assemble(int skip_zeros)
 #endif
 }
 
+void BilinearForm::AssembleBSR(BSRMatrix &A)
+{
+   MFEM_PERF_SCOPE("BilinearForm::AssembleBSR");
+
+   MFEM_VERIFY(!static_cond && !hybridization, "AssembleBSR() is not supported"
+               " with static condensation or hybridization");
+   MFEM_VERIFY(interior_face_integs.Size() == 0 &&
+               boundary_face_integs.Size() == 0,
+               "AssembleBSR() does not support face integrators");
+
+   Mesh *mesh = fes->GetMesh();
+   const int vdim = fes->GetVDim();
+   const int ndofs = fes->GetNDofs();
+   const bool byvdim = (fes->GetOrdering() == Ordering::byVDIM);
+   // The space may change without changing size, e.g. when the mesh is
+   // rebalanced, so its sequence is checked too
+   if (A.NumBlockRows() != ndofs || A.NumBlockCols() != ndofs ||
+       A.BlockSize() != vdim || A.IsByVDim() != byvdim ||
+       bsr_sequence != fes->GetSequence())
+   {
+      // the block sparsity pattern is defined from the map: element->dof
+      Table elem_dof(fes->GetElementToDofTable()), dof_elem, dof_dof;
+      int *J = elem_dof.GetJ();
+      for (int k = 0; k < elem_dof.Size_of_connections(); k++)
+      {
+         if (J[k] < 0) { J[k] = -1-J[k]; }
+      }
+      Transpose(elem_dof, dof_elem, ndofs);
+      mfem::Mult(dof_elem, elem_dof, dof_dof);
+      BSRMatrix pattern(dof_dof, ndofs, vdim, byvdim);
+      A = std::move(pattern);
+      bsr_sequence = fes->GetSequence();
+   }
+   else
+   {
+      A = 0.0;
+   }
+
+   Array<int> dofs, dof_vdofs;
+   DofTransformation doftrans;
+   DenseMatrix elmat, emat;
+   // Sum the element matrices of the integrators marked for attribute @a attr
+   auto Integrate = [&](const Array<BilinearFormIntegrator*> &integs,
+                        const Array<Array<int>*> &markers, const int attr,
+                        const FiniteElement &fe, ElementTransformation &T)
+   {
+      elmat.SetSize(0);
+      for (int k = 0; k < integs.Size(); k++)
+      {
+         if (markers[k] && (*markers[k])[attr-1] == 0) { continue; }
+         MFEM_VERIFY(!integs[k]->Patchwise(), "AssembleBSR() does not support"
+                     " patchwise integration");
+         integs[k]->AssembleElementMatrix(fe, T, emat);
+         if (elmat.Size() == 0) { elmat = emat; }
+         else { elmat += emat; }
+      }
+      return elmat.Size() > 0;
+   };
+
+   for (int i = 0; i < fes->GetNE(); i++)
+   {
+      ElementTransformation &T = *fes->GetElementTransformation(i);
+      if (!Integrate(domain_integs, domain_integs_marker,
+                     mesh->GetAttribute(i), *fes->GetFE(i), T)) { continue; }
+      fes->GetElementVDofs(i, dof_vdofs, doftrans);
+      doftrans.TransformDual(elmat);
+      fes->GetElementDofs(i, dofs);
+      A.AddElementMatrix(dofs, elmat);
+   }
+
+   for (int i = 0; i < fes->GetNBE(); i++)
+   {
+      ElementTransformation &T = *fes->GetBdrElementTransformation(i);
+      if (!Integrate(boundary_integs, boundary_integs_marker,
+                     mesh->GetBdrAttribute(i), *fes->GetBE(i), T)) { continue; }
+      fes->GetBdrElementVDofs(i, dof_vdofs, doftrans);
+      doftrans.TransformDual(elmat);
+      fes->GetBdrElementDofs(i, dofs);
+      A.AddElementMatrix(dofs, elmat);
+   }
+}
+
 void BilinearForm::ConformingAssemble()
 {
    // Do not remove zero entries to preserve the symmetric structure of the
@@ -1064,6 +1334,135 @@ void BilinearForm::ComputeElementMatrices()
    }
 }
 
+void BilinearForm::AssembleElementsThreaded(int skip_zeros)
+{
+   MFEM_VERIFY(mat && mat->Finalized(),
+               "threaded assembly requires a preallocated sparsity pattern");
+
+   Mesh *mesh = fes->GetMesh();
+   const int num_elements = fes->GetNE();
+   if (num_elements == 0) { return; }
+
+   for (int k = 0; k < domain_integs.Size(); k++)
+   {
+      if (domain_integs_marker[k]) { domain_integs_marker[k]->HostRead(); }
+   }
+   const int *I = mat->HostReadI();
+   const int *J = mat->HostReadJ();
+   real_t *A = mat->HostReadWriteData();
+
+   int max_threads = 1;
+#ifdef MFEM_BILINEARFORM_THREADED_ASSEMBLY
+   max_threads = omp_get_max_threads();
+#endif
+
+   const int batch_size = std::min(num_elements, 16*max_threads);
+   std::vector<DenseMatrix> batch_elmats(batch_size);
+   std::vector<Array<int>> batch_vdofs(batch_size);
+
+#ifdef MFEM_BILINEARFORM_THREADED_ASSEMBLY
+   #pragma omp parallel
+#endif
+   {
+      int tid = 0, num_threads = 1;
+#ifdef MFEM_BILINEARFORM_THREADED_ASSEMBLY
+      // The team may be smaller than omp_get_max_threads(), e.g. with dynamic
+      // threads or when called from inside a parallel region.
+      tid = omp_get_thread_num();
+      num_threads = omp_get_num_threads();
+#endif
+      // Each thread owns a contiguous range of rows with (roughly) the same
+      // number of nonzeros. All threads visit the element matrices of a batch
+      // in element order, but only add the rows they own, so every matrix
+      // entry is updated by a single thread in the same order as in the serial
+      // loop.
+      const long long nnz = I[height];
+      const int row_begin =
+         (int)(std::lower_bound(I, I + height, nnz*tid/num_threads) - I);
+      const int row_end = (tid + 1 == num_threads) ? height :
+                          (int)(std::lower_bound(I, I + height,
+                                                 nnz*(tid+1)/num_threads) - I);
+
+      IsoparametricTransformation eltrans;
+      DofTransformation doftrans;
+      DenseMatrix integ_elmat;
+      Array<int> col_ptr(width);
+      col_ptr = -1;
+
+      for (int b = 0; b < num_elements; b += batch_size)
+      {
+         const int batch_end = std::min(b + batch_size, num_elements);
+
+         // 1. Compute the element matrices of the batch.
+#ifdef MFEM_BILINEARFORM_THREADED_ASSEMBLY
+         #pragma omp for schedule(dynamic)
+#endif
+         for (int i = b; i < batch_end; i++)
+         {
+            DenseMatrix &elmat = batch_elmats[i-b];
+            elmat.SetSize(0);
+            fes->GetElementVDofs(i, batch_vdofs[i-b], doftrans);
+            const int elem_attr = mesh->GetAttribute(i);
+            fes->GetElementTransformation(i, &eltrans);
+            for (int k = 0; k < domain_integs.Size(); k++)
+            {
+               if ((domain_integs_marker[k] == NULL ||
+                    (*(domain_integs_marker[k]))[elem_attr-1] == 1)
+                   && !domain_integs[k]->Patchwise())
+               {
+                  domain_integs[k]->AssembleElementMatrix(*fes->GetFE(i),
+                                                          eltrans, integ_elmat);
+                  if (elmat.Size() == 0)
+                  {
+                     elmat = integ_elmat;
+                  }
+                  else
+                  {
+                     elmat += integ_elmat;
+                  }
+               }
+            }
+            if (elmat.Size() > 0) { doftrans.TransformDual(elmat); }
+         }
+
+         // 2. Add the rows owned by this thread, following the same rules as
+         //    SparseMatrix::AddSubMatrix().
+         for (int i = b; i < batch_end; i++)
+         {
+            const DenseMatrix &elmat = batch_elmats[i-b];
+            const Array<int> &el_vdofs = batch_vdofs[i-b];
+            if (elmat.Size() == 0) { continue; }
+            for (int ii = 0; ii < el_vdofs.Size(); ii++)
+            {
+               int gi = el_vdofs[ii], s = 1;
+               if (gi < 0) { gi = -1-gi; s = -1; }
+               if (gi < row_begin || gi >= row_end) { continue; }
+
+               for (int p = I[gi]; p < I[gi+1]; p++) { col_ptr[J[p]] = p; }
+               for (int jj = 0; jj < el_vdofs.Size(); jj++)
+               {
+                  int gj = el_vdofs[jj], t = s;
+                  if (gj < 0) { gj = -1-gj; t = -s; }
+                  real_t a = elmat(ii, jj);
+                  if (skip_zeros && a == 0.0)
+                  {
+                     if (skip_zeros == 2 || elmat(jj, ii) == 0.0) { continue; }
+                  }
+                  if (t < 0) { a = -a; }
+                  MFEM_VERIFY(col_ptr[gj] >= 0, "entry (" << gi << "," << gj
+                              << ") is not in the sparsity pattern");
+                  A[col_ptr[gj]] += a;
+               }
+               for (int p = I[gi]; p < I[gi+1]; p++) { col_ptr[J[p]] = -1; }
+            }
+         }
+#ifdef MFEM_BILINEARFORM_THREADED_ASSEMBLY
+         #pragma omp barrier
+#endif
+      }
+   }
+}
+
 const DenseTensor &BilinearForm::GetElementMatrices()
 {
    ComputeElementMatrices(); // Won't recompute if element_matrices exists
@@ -1224,6 +1623,19 @@ void BilinearForm::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void BilinearForm::ArrayMult(const Array<const Vector *> &X,
+                             Array<Vector *> &Y) const
+{
+   if (ext)
+   {
+      ext->ArrayMult(X, Y);
+   }
+   else
+   {
+      mat->ArrayMult(X, Y);
+   }
+}
+
 void BilinearForm::MultTranspose(const Vector & x, Vector & y) const
 {
    if (ext)
@@ -1263,6 +1675,7 @@ void BilinearForm::Update(FiniteElementSpace *nfes)
    {
       delete mat;
       mat = NULL;
+      scatter_map.Reset();
       hybridization.reset();
       sequence = fes->GetSequence();
    }
@@ -1518,6 +1931,8 @@ void MixedBilinearForm::AddBdrTraceFaceIntegrator(BilinearFormIntegrator *bfi,
 
 void MixedBilinearForm::Assemble(int skip_zeros)
 {
+   MFEM_PERF_SCOPE("MixedBilinearForm::Assemble");
+
    if (ext)
    {
       ext->Assemble();
@@ -1533,6 +1948,7 @@ void MixedBilinearForm::Assemble(int skip_zeros)
    {
       mat = new SparseMatrix(height, width);
    }
+   if (scatter_map.IsEnabled()) { scatter_map.BeginAssembly(*mat); }
 
    if (domain_integs.Size())
    {
@@ -1569,7 +1985,8 @@ void MixedBilinearForm::Assemble(int skip_zeros)
             }
          }
          TransformDual(ran_dof_trans, dom_dof_trans, elmat);
-         mat -> AddSubMatrix (test_vdofs, trial_vdofs, elmat, skip_zeros);
+         scatter_map.AddSubMatrix(*mat, test_vdofs, trial_vdofs, elmat,
+                                  skip_zeros);
       }
    }
 
@@ -1619,7 +2036,8 @@ void MixedBilinearForm::Assemble(int skip_zeros)
             elmat += elemmat;
          }
          TransformDual(ran_dof_trans, dom_dof_trans, elmat);
-         mat -> AddSubMatrix (test_vdofs, trial_vdofs, elmat, skip_zeros);
+         scatter_map.AddSubMatrix(*mat, test_vdofs, trial_vdofs, elmat,
+                                  skip_zeros);
       }
    }
 
@@ -1661,7 +2079,8 @@ void MixedBilinearForm::Assemble(int skip_zeros)
                interior_face_integs[k]->AssembleFaceMatrix(*trial_fe1, *test_fe1, *trial_fe2,
                                                            *test_fe2,
                                                            *ftr, elemmat);
-               mat->AddSubMatrix(test_vdofs, trial_vdofs, elemmat, skip_zeros);
+               scatter_map.AddSubMatrix(*mat, test_vdofs, trial_vdofs,
+                                        elemmat, skip_zeros);
             }
          }
       }
@@ -1719,7 +2138,8 @@ void MixedBilinearForm::Assemble(int skip_zeros)
                boundary_face_integs[k]->AssembleFaceMatrix(*trial_fe1, *test_fe1, *trial_fe2,
                                                            *test_fe2,
                                                            *ftr, elemmat);
-               mat->AddSubMatrix(test_vdofs, trial_vdofs, elemmat, skip_zeros);
+               scatter_map.AddSubMatrix(*mat, test_vdofs, trial_vdofs,
+                                        elemmat, skip_zeros);
             }
          }
       }
@@ -1756,7 +2176,8 @@ void MixedBilinearForm::Assemble(int skip_zeros)
          {
             trace_face_integs[k]->AssembleFaceMatrix(*trial_face_fe, *test_fe1,
                                                      *test_fe2, *ftr, elemmat);
-            mat->AddSubMatrix(test_vdofs, trial_vdofs, elemmat, skip_zeros);
+            scatter_map.AddSubMatrix(*mat, test_vdofs, trial_vdofs, elemmat,
+                                     skip_zeros);
          }
       }
    }
@@ -1815,11 +2236,14 @@ void MixedBilinearForm::Assemble(int skip_zeros)
                                                                  *test_fe1,
                                                                  *test_fe2,
                                                                  *ftr, elemmat);
-               mat->AddSubMatrix(test_vdofs, trial_vdofs, elemmat, skip_zeros);
+               scatter_map.AddSubMatrix(*mat, test_vdofs, trial_vdofs,
+                                        elemmat, skip_zeros);
             }
          }
       }
    }
+
+   if (scatter_map.IsEnabled()) { scatter_map.EndAssembly(*mat); }
 }
 
 void MixedBilinearForm::AssembleDiagonal_ADAt(const Vector &D,
@@ -2332,6 +2756,7 @@ void MixedBilinearForm::Update()
 {
    delete mat;
    mat = NULL;
+   scatter_map.Reset();
    delete mat_e;
    mat_e = NULL;
    height = test_fes->GetVSize();
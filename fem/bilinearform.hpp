@@ -53,6 +53,65 @@ enum class AssemblyLevel
 };
 
 
+/** @brief Records the element matrix insertions performed by a legacy
+    Assemble() call and replays them directly into the CSR data of the matrix
+    in subsequent calls, see BilinearForm::UseFrozenSparsity().
+
+    The first Assemble() call (symbolic phase) inserts all entries of the
+    element matrices, including zeros, finalizes the matrix and computes, for
+    every inserted entry, its position in the CSR data array. The following
+    calls (numeric phase) add the element matrices through this map, without
+    allocations, searches, or a call to SparseMatrix::Finalize(). The sequence
+    of insertions must be the same in every call. */
+class AssemblyScatterMap
+{
+protected:
+   enum State { OFF, RECORDING, READY };
+
+   State state = OFF;
+   /// The matrix for which the map was built. Not owned.
+   const SparseMatrix *map_mat = nullptr;
+   /// Number of nonzeros of #map_mat when the map was built.
+   int map_nnz = 0;
+   /// Index of the next insertion in the READY state.
+   int cursor = 0;
+   /** @brief CSR positions of the inserted entries; the entries of insertion k
+       are stored, row-wise, in [offsets[k], offsets[k+1]). Negative positions
+       p encode entries with a sign change, in position -1-p. */
+   Array<int> offsets, map;
+   /// The row and column indices of every insertion, used while recording.
+   Array<int> log_sizes, log_vdofs;
+
+public:
+   /// Enable or disable the map. Disabling the map frees its data.
+   void Enable(bool enable);
+
+   bool IsEnabled() const { return state != OFF; }
+
+   /// Return true if the map has been built and can be replayed.
+   bool IsReady() const { return state == READY; }
+
+   /// Discard the map; the next assembly will record a new one.
+   void Reset();
+
+   /// Start an assembly into @a mat. Must be called before AddSubMatrix().
+   void BeginAssembly(SparseMatrix &mat);
+
+   /** @brief Add @a subm to @a mat, recording or replaying the insertion if the
+       map is enabled. Otherwise, calls SparseMatrix::AddSubMatrix(). */
+   void AddSubMatrix(SparseMatrix &mat, const Array<int> &rows,
+                     const Array<int> &cols, const DenseMatrix &subm,
+                     int skip_zeros);
+
+   /** @brief Finish the assembly into @a mat. After recording, @a mat is
+       finalized and the map is built. */
+   void EndAssembly(SparseMatrix &mat);
+
+   /// Return the memory used by the map in bytes.
+   long MemoryUsage() const
+   { return (long)(offsets.Capacity() + map.Capacity())*sizeof(int); }
+};
+
 /** @brief A "square matrix" operator for the associated FE space and
     BLFIntegrators The sum of all the BLFIntegrators can be used form the matrix
     M. This class also supports other assembly levels specified via the
@@ -60,6 +119,7 @@ enum class AssemblyLevel
 class BilinearForm : public Matrix
 {
    friend FABilinearFormExtension;
+   friend PABilinearFormExtension;
 
 protected:
    /// Sparse matrix $ M $ to be associated with the form. Owned.
@@ -134,9 +194,31 @@ protected:
 
    int precompute_sparsity;
 
+   /// Use threads in the domain element loop, see UseThreadedAssembly().
+   bool threaded_assembly = false;
+
+   /// Fuse the element restriction into the PA kernels, see UseFusedPA().
+   bool fused_pa = false;
+
+   /// Store the PA data in single precision, see UseSinglePrecisionPA().
+   bool single_pa = false;
+
+   /// True if UseSinglePrecisionPA() was called.
+   bool single_pa_set = false;
+
+   /// Element-to-CSR map used by UseFrozenSparsity().
+   AssemblyScatterMap scatter_map;
+
+   /// Space sequence of the block sparsity last computed by AssembleBSR().
+   long bsr_sequence = -1;
+
    /// Allocate appropriate SparseMatrix and assign it to #mat
    void AllocMat();
 
+   /** @brief Threaded version of the domain element loop in Assemble(), used
+       when #threaded_assembly is set and #mat is allocated in CSR format. */
+   void AssembleElementsThreaded(int skip_zeros);
+
    /** @brief For partially conforming trial and/or test FE spaces, complete the
        assembly process by performing $ P^t A P $ where $ A $ is the
        internal sparse matrix and $ P $ is the conforming prolongation
@@ -241,6 +323,79 @@ public:
        integrators present in the bilinear form. */
    void UsePrecomputedSparsity(int ps = 1) { precompute_sparsity = ps; }
 
+   /** @brief Compute and add the domain element matrices in parallel in the
+       AssemblyLevel::LEGACY Assemble().
+
+       The element matrices are computed in batches by all threads; each thread
+       then adds the rows of the batch that it owns in the CSR matrix, so there
+       are no write conflicts and the result is bitwise identical to the serial
+       assembly with the same sparsity pattern. The threaded loop requires the
+       matrix to be allocated in CSR format, so this method also enables
+       UsePrecomputedSparsity(); if the pattern is not available (e.g. vector
+       spaces, static condensation, hybridization) the serial loop is used.
+
+       Threads are used only when MFEM is built with OpenMP and
+       MFEM_THREAD_SAFE, which guarantees that the integrators' methods
+       AssembleElementMatrix() use local scratch data. Otherwise, the batched
+       loop runs on a single thread. */
+   void UseThreadedAssembly(bool use = true)
+   {
+      threaded_assembly = use;
+      if (use) { precompute_sparsity = 1; }
+   }
+
+   /** @brief Freeze the sparsity pattern after the first call to Assemble() and
+       reuse it, together with a map from element matrix entries to CSR
+       positions, in all subsequent calls.
+
+       This is useful when the form is re-assembled many times on the same
+       mesh, e.g. in time-dependent or Newton iterations. The first Assemble()
+       inserts all element matrix entries (including zeros) and finalizes the
+       matrix; the following calls add the element matrices directly into the
+       CSR data array. As usual, the matrix should be set to zero, e.g. with
+       `a = 0.0`, before re-assembling. The map is rebuilt when the matrix is
+       reallocated, e.g. after Update(). This option takes precedence over
+       UseThreadedAssembly() and is not compatible with static condensation,
+       hybridization, or patch-wise NURBS integrators. */
+   void UseFrozenSparsity(bool use = true) { scatter_map.Enable(use); }
+
+   /** @brief Apply the element restriction and its transpose inside the PA
+       kernels in the action of the form with AssemblyLevel::PARTIAL.
+
+       The element dofs are gathered directly from the input L-vector and the
+       element contributions are added atomically to the output L-vector, so no
+       E-vectors are created. The fused action is used only when all domain
+       integrators support it (see BilinearFormIntegrator::SupportsFusedPA()),
+       none of them is restricted to a subset of the elements, and the space
+       uses an ElementRestriction; otherwise the regular action is used. Due to
+       the atomic additions, the result may differ from the regular action in
+       the last bits. */
+   void UseFusedPA(bool use = true) { fused_pa = use; }
+
+   /// Return true if UseFusedPA() was enabled.
+   bool FusedPAEnabled() const { return fused_pa; }
+
+   /** @brief Store the quadrature point data of the domain integrators in
+       single precision with AssemblyLevel::PARTIAL, see
+       NonlinearFormIntegrator::SetPASinglePrecision().
+
+       The vectors and the computations in the action remain in real_t
+       precision, so the form is a perturbation of relative size ~1e-7 of the
+       full precision operator. This is intended for preconditioners, e.g.
+       multigrid levels or smoothers, where it reduces the memory traffic of the
+       action without limiting the accuracy of the outer solver. Currently
+       supported by the DiffusionIntegrator and MassIntegrator for the
+       specialized kernel sizes; other integrators use real_t data. Must be
+       called before Assemble().
+
+       Once called, this setting overrides the one of every domain integrator;
+       otherwise, the integrators keep their own setting. */
+   void UseSinglePrecisionPA(bool use = true)
+   { single_pa = use; single_pa_set = true; }
+
+   /// Return true if UseSinglePrecisionPA() was enabled.
+   bool SinglePrecisionPAEnabled() const { return single_pa; }
+
    /** @brief Use the given CSR sparsity pattern to allocate the internal
        SparseMatrix.
 
@@ -300,6 +455,12 @@ public:
    /// Matrix vector multiplication:  $ y = M x $
    void Mult(const Vector &x, Vector &y) const override;
 
+   /** @brief Matrix vector multiplication on multiple vectors: $ Y = M X $.
+       With partial assembly, the PA data is read once for a batch of vectors,
+       see BilinearFormIntegrator::AddMultPABatch(). */
+   void ArrayMult(const Array<const Vector *> &X,
+                  Array<Vector *> &Y) const override;
+
    /** @brief Matrix vector multiplication with the original uneliminated
        matrix.  The original matrix is $ M + M_e $ so we have:
        $ y = M x + M_e x $ */
@@ -447,6 +608,22 @@ public:
    /// Assembles the form i.e. sums over all domain/bdr integrators.
    void Assemble(int skip_zeros = 1);
 
+   /** @brief Assemble the domain and boundary integrators into the block sparse
+       matrix @a A, with one vdim x vdim block for each pair of coupled scalar
+       dofs of the vector space.
+
+       The matrix uses the vdof numbering and the ordering of the space, so it
+       can be used in place of SpMat() as an Operator on the vdofs. If the size
+       of @a A does not match the space, or the space changed since the last
+       call (see FiniteElementSpace::GetSequence()), its block sparsity is
+       computed from the element-to-dof connectivity; otherwise, the sparsity
+       is reused and only the values are recomputed. This method uses the
+       legacy assembly and does not use or change the internal SparseMatrix;
+       face integrators, static condensation and hybridization are not
+       supported. Essential boundary conditions can be imposed with
+       BSRMatrix::EliminateBC(). */
+   void AssembleBSR(BSRMatrix &A);
+
    /** @brief Assemble the diagonal of the bilinear form into @a diag. Note that
        @a diag is a tdof Vector.
 
@@ -804,6 +981,9 @@ protected:
    mutable DenseMatrix elemmat;
    mutable Array<int>  trial_vdofs, test_vdofs;
 
+   /// Element-to-CSR map used by UseFrozenSparsity().
+   AssemblyScatterMap scatter_map;
+
 private:
    /// Copy construction is not supported; body is undefined.
    MixedBilinearForm(const MixedBilinearForm &);
@@ -985,6 +1165,10 @@ public:
    /** This method must be called before assembly. See ::AssemblyLevel*/
    void SetAssemblyLevel(AssemblyLevel assembly_level);
 
+   /** @brief Reuse the sparsity pattern and the element-to-CSR map computed in
+       the first call to Assemble(), see BilinearForm::UseFrozenSparsity(). */
+   void UseFrozenSparsity(bool use = true) { scatter_map.Enable(use); }
+
    void Assemble(int skip_zeros = 1);
 
    /** @brief Assemble the diagonal of ADA^T into diag, where A is this mixed
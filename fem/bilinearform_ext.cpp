@@ -373,6 +373,8 @@ void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
 
 void PABilinearFormExtension::Assemble()
 {
+   MFEM_PERF_SCOPE("PABilinearFormExtension::Assemble");
+
    SetupRestrictionOperators(L2FaceValues::DoubleValued);
 
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
@@ -386,6 +388,7 @@ void PABilinearFormExtension::Assemble()
       }
       else
       {
+         if (a->single_pa_set) { integ->SetPASinglePrecision(a->single_pa); }
          integ->AssemblePA(*a->FESpace());
       }
    }
@@ -411,6 +414,8 @@ void PABilinearFormExtension::Assemble()
 
 void PABilinearFormExtension::AssembleDiagonal(Vector &y) const
 {
+   MFEM_PERF_SCOPE("PABilinearFormExtension::AssembleDiagonal");
+
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
 
    auto assemble_diagonal_with_markers = [&](BilinearFormIntegrator &integ,
@@ -526,8 +531,102 @@ void PABilinearFormExtension::FormLinearSystem(const Array<int> &ess_tdof_list,
    A.Reset(oper); // A will own oper
 }
 
+const ElementRestriction *PABilinearFormExtension::GetFusedRestriction() const
+{
+   if (!a->FusedPAEnabled()) { return nullptr; }
+   const auto *R = dynamic_cast<const ElementRestriction*>(elem_restrict);
+   if (!R) { return nullptr; }
+   const Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const Array<Array<int>*> &elem_markers = *a->GetDBFI_Marker();
+   if (integrators.Size() == 0) { return nullptr; }
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      if (elem_markers[i] || !integrators[i]->SupportsFusedPA())
+      {
+         return nullptr;
+      }
+   }
+   return R;
+}
+
+const ElementRestriction *PABilinearFormExtension::GetBatchRestriction() const
+{
+   if (DeviceCanUseCeed()) { return nullptr; }
+   const auto *R = dynamic_cast<const ElementRestriction*>(elem_restrict);
+   if (!R) { return nullptr; }
+   if (a->GetBBFI()->Size() || a->GetFBFI()->Size() || a->GetBFBFI()->Size())
+   {
+      return nullptr;
+   }
+   const Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const Array<Array<int>*> &elem_markers = *a->GetDBFI_Marker();
+   if (integrators.Size() == 0) { return nullptr; }
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      if (elem_markers[i] || integrators[i]->Patchwise()) { return nullptr; }
+   }
+   return R;
+}
+
+void PABilinearFormExtension::ArrayMult(const Array<const Vector *> &X,
+                                        Array<Vector *> &Y) const
+{
+   MFEM_PERF_SCOPE("PABilinearFormExtension::ArrayMult");
+
+   const ElementRestriction *R = GetBatchRestriction();
+   if (!R)
+   {
+      Operator::ArrayMult(X, Y);
+      return;
+   }
+   MFEM_ASSERT(X.Size() == Y.Size(), "Number of columns mismatch!");
+
+   // The number of vectors in a batch is bounded to limit the size of the
+   // E-vector workspace
+   constexpr int max_batch = 16;
+   const Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int esize = R->Height();
+   const int nbatch = std::min(X.Size(), max_batch);
+   batchX.SetSize(nbatch*esize);
+   batchY.SetSize(nbatch*esize);
+   batchX.UseDevice(true);
+   batchY.UseDevice(true);
+   // E-vectors referencing batchX and batchY
+   std::vector<Vector> ex(nbatch), ey(nbatch);
+   Array<Vector *> EX;
+   Array<const Vector *> EY, LX;
+   Array<Vector *> LY;
+   for (int v0 = 0; v0 < X.Size(); v0 += max_batch)
+   {
+      const int nvec = std::min(X.Size() - v0, max_batch);
+      EX.SetSize(nvec);
+      EY.SetSize(nvec);
+      LX.SetSize(nvec);
+      LY.SetSize(nvec);
+      for (int v = 0; v < nvec; ++v)
+      {
+         ex[v].MakeRef(batchX, v*esize, esize);
+         ey[v].MakeRef(batchY, v*esize, esize);
+         EX[v] = &ex[v];
+         EY[v] = &ey[v];
+         LX[v] = X[v0 + v];
+         LY[v] = Y[v0 + v];
+      }
+      Vector xe(batchX, 0, nvec*esize), ye(batchY, 0, nvec*esize);
+      R->ArrayMult(LX, EX);
+      ye = 0.0;
+      for (int i = 0; i < integrators.Size(); ++i)
+      {
+         integrators[i]->AddMultPABatch(xe, ye, nvec);
+      }
+      R->ArrayMultTranspose(EY, LY);
+   }
+}
+
 void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_SCOPE("PABilinearFormExtension::Mult");
+
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
 
    const int iSz = integrators.Size();
@@ -550,6 +649,7 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
    MFEM_VERIFY(!(somePatchwise && !allPatchwise),
                "All or none of the integrators should be patchwise");
 
+   const ElementRestriction *fused_restrict;
    if (DeviceCanUseCeed() || !elem_restrict || allPatchwise)
    {
       y.UseDevice(true); // typically this is a large vector, so store on device
@@ -566,6 +666,15 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
          }
       }
    }
+   else if ((fused_restrict = GetFusedRestriction()))
+   {
+      y.UseDevice(true);
+      y = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultPAFused(*fused_restrict, x, y);
+      }
+   }
    else
    {
       if (iSz)
@@ -697,6 +806,8 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 
 void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_SCOPE("PABilinearFormExtension::MultTranspose");
+
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int iSz = integrators.Size();
    if (elem_restrict)
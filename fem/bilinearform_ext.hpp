@@ -72,6 +72,7 @@ protected:
    Array<int> elem_attributes, bdr_attributes;
    mutable Vector tmp_evec; // Work array
    mutable Vector localX, localY;
+   mutable Vector batchX, batchY; // E-vectors of ArrayMult()
    mutable Vector int_face_X, int_face_Y;
    mutable Vector bdr_face_X, bdr_face_Y;
    mutable Vector int_face_dXdn, int_face_dYdn;
@@ -92,12 +93,26 @@ public:
                          OperatorHandle &A, Vector &X, Vector &B,
                          int copy_interior = 0) override;
    void Mult(const Vector &x, Vector &y) const override;
+   /** @brief Action on multiple vectors. If only domain integrators are used,
+       the vectors are processed in batches, reading the PA data and the
+       element restriction once per batch. */
+   void ArrayMult(const Array<const Vector *> &X,
+                  Array<Vector *> &Y) const override;
    void MultTranspose(const Vector &x, Vector &y) const override;
    void Update() override;
 
 protected:
    void SetupRestrictionOperators(const L2FaceValues m);
 
+   /** @brief Return the element restriction if the batched action of the
+       domain integrators can be used in ArrayMult(), and nullptr otherwise. */
+   const ElementRestriction *GetBatchRestriction() const;
+
+   /** @brief Return the element restriction if the fused action of the domain
+       integrators can be used in Mult(), see BilinearForm::UseFusedPA(), and
+       nullptr otherwise. */
+   const ElementRestriction *GetFusedRestriction() const;
+
    /// @brief Accumulate the action (or transpose) of the integrator on @a x
    /// into @a y, taking into account the (possibly null) @a markers array.
    ///
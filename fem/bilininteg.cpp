@@ -12,6 +12,7 @@
 // Implementation of Bilinear Form Integrators
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
 #include <cmath>
 #include <algorithm>
 #include <memory>
@@ -133,6 +134,56 @@ void BilinearFormIntegrator::AddMultTransposePA(const Vector &, Vector &) const
               "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::ToSinglePrecision(Vector &pa_data,
+                                               Array<float> &pa_data_sp)
+{
+   const int n = pa_data.Size();
+   pa_data_sp.SetSize(n, pa_data.GetMemory().GetMemoryType());
+   const auto d = pa_data.Read();
+   auto d_sp = pa_data_sp.Write();
+   mfem::forall(n, [=] MFEM_HOST_DEVICE (int i)
+   {
+      d_sp[i] = static_cast<float>(d[i]);
+   });
+   pa_data.Destroy();
+}
+
+void BilinearFormIntegrator::FromSinglePrecision(const Array<float> &pa_data_sp,
+                                                 Vector &pa_data)
+{
+   const int n = pa_data_sp.Size();
+   pa_data.SetSize(n);
+   pa_data.UseDevice(true);
+   const auto d_sp = pa_data_sp.Read();
+   auto d = pa_data.Write();
+   mfem::forall(n, [=] MFEM_HOST_DEVICE (int i)
+   {
+      d[i] = static_cast<real_t>(d_sp[i]);
+   });
+}
+
+void BilinearFormIntegrator::AddMultPAFused(const ElementRestriction &,
+                                            const Vector &, Vector &) const
+{
+   MFEM_ABORT("BilinearFormIntegrator::AddMultPAFused(...)\n"
+              "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultPABatch(const Vector &x, Vector &y,
+                                            int nvec) const
+{
+   MFEM_ASSERT(x.Size() % nvec == 0 && y.Size() % nvec == 0,
+               "invalid number of vectors");
+   const int x_size = x.Size() / nvec, y_size = y.Size() / nvec;
+   Vector xv, yv;
+   for (int v = 0; v < nvec; v++)
+   {
+      xv.MakeRef(const_cast<Vector&>(x), v*x_size, x_size);
+      yv.MakeRef(y, v*y_size, y_size);
+      AddMultPA(xv, yv);
+   }
+}
+
 void BilinearFormIntegrator::AssembleMF(const FiniteElementSpace &fes)
 {
    MFEM_ABORT("BilinearFormIntegrator::AssembleMF(...)\n"
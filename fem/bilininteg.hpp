@@ -31,6 +31,13 @@ protected:
    BilinearFormIntegrator(const IntegrationRule *ir = NULL)
       : NonlinearFormIntegrator(ir) { }
 
+   /// Move the PA data @a pa_data to @a pa_data_sp, in single precision.
+   static void ToSinglePrecision(Vector &pa_data, Array<float> &pa_data_sp);
+
+   /// Copy the single precision PA data @a pa_data_sp to @a pa_data.
+   static void FromSinglePrecision(const Array<float> &pa_data_sp,
+                                   Vector &pa_data);
+
 public:
    // TODO: add support for other assembly levels (in addition to PA) and their
    // actions.
@@ -90,6 +97,31 @@ public:
        called. */
    virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
 
+   /// Method for partially assembled action with fused element restriction.
+   /** Perform the action of the integrator on the input @a x and add the
+       result to the output @a y, where @a x and @a y are L-vectors. The element
+       restriction @a R and its transpose are applied inside the PA kernel, so
+       that no E-vectors are created.
+
+       This method can be called only after the method AssemblePA() has been
+       called, and only if SupportsFusedPA() returns true. */
+   virtual void AddMultPAFused(const ElementRestriction &R, const Vector &x,
+                               Vector &y) const;
+
+   /// Return true if AddMultPAFused() is supported for the assembled space.
+   virtual bool SupportsFusedPA() const { return false; }
+
+   /// Method for partially assembled action on multiple vectors.
+   /** Perform the action of the integrator on the @a nvec E-vectors stored one
+       after another in @a x and add the results to the corresponding E-vectors
+       in @a y. The default implementation calls AddMultPA() for each vector;
+       integrators with a native implementation read their PA data once for
+       all vectors.
+
+       This method can be called only after the method AssemblePA() has been
+       called. */
+   virtual void AddMultPABatch(const Vector &x, Vector &y, int nvec) const;
+
    /// Method defining element assembly.
    /** The result of the element assembly is added to the @a emat Vector if
        @a add is true. Otherwise, if @a add is false, we set @a emat. */
@@ -2178,7 +2210,25 @@ public:
                                       const Array<real_t>&, const Vector&, Vector&,
                                       const int, const int);
 
+   /// The last argument is the number of vectors stored in the input/output.
+   using ApplyFusedKernelType = void(*)(const int, const bool,
+                                        const Array<real_t>&,
+                                        const Array<real_t>&, const real_t*,
+                                        const int*, const Vector&, Vector&,
+                                        const int, const int, const int);
+
+   /// Same as ApplyFusedKernelType, with single precision PA data.
+   using ApplyMixedKernelType = void(*)(const int, const bool,
+                                        const Array<real_t>&,
+                                        const Array<real_t>&, const float*,
+                                        const int*, const Vector&, Vector&,
+                                        const int, const int, const int);
+
    MFEM_REGISTER_KERNELS(ApplyPAKernels, ApplyKernelType, (int, int, int));
+   MFEM_REGISTER_KERNELS(ApplyFusedPAKernels, ApplyFusedKernelType,
+                         (int, int, int));
+   MFEM_REGISTER_KERNELS(ApplyMixedPAKernels, ApplyMixedKernelType,
+                         (int, int, int));
    MFEM_REGISTER_KERNELS(DiagonalPAKernels, DiagonalKernelType, (int, int, int));
    struct Kernels { Kernels(); };
 
@@ -2201,6 +2251,8 @@ private:
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, dofs1D, quad1D;
    Vector pa_data;
+   /// PA data in single precision, see SetPASinglePrecision()
+   Array<float> pa_data_sp;
    bool symmetric = true; ///< False if using a nonsymmetric matrix coefficient
 
    // Data for NURBS patch PA
@@ -2242,6 +2294,9 @@ private:
 
    void SetupPatchPA(const int patch, Mesh *mesh, bool unitWeights=false);
 
+   /// Convert the PA data to single precision, if requested and supported.
+   void SetupSinglePrecisionPA();
+
    void SetupPatchBasisData(Mesh *mesh, unsigned int patch);
 
    /** Called by AssemblePatchMatrix for sparse matrix assembly on a NURBS patch
@@ -2326,6 +2381,13 @@ public:
 
    void AddMultPatchPA(const int patch, const Vector &x, Vector &y) const;
 
+   void AddMultPAFused(const ElementRestriction &R, const Vector &x,
+                       Vector &y) const override;
+
+   void AddMultPABatch(const Vector &x, Vector &y, int nvec) const override;
+
+   bool SupportsFusedPA() const override;
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe);
 
@@ -2337,6 +2399,8 @@ public:
    static void AddSpecialization()
    {
       ApplyPAKernels::Specialization<DIM,D1D,Q1D>::Add();
+      ApplyFusedPAKernels::Specialization<DIM,D1D,Q1D>::Add();
+      ApplyMixedPAKernels::Specialization<DIM,D1D,Q1D>::Add();
       DiagonalPAKernels::Specialization<DIM,D1D,Q1D>::Add();
    }
 protected:
@@ -2361,6 +2425,8 @@ protected:
    // PA extension
    const FiniteElementSpace *fespace;
    Vector pa_data;
+   /// PA data in single precision, see SetPASinglePrecision()
+   Array<float> pa_data_sp;
    const DofToQuad *maps;                 ///< Not owned
    const GeometricFactors *geom;          ///< Not owned
    const FaceGeometricFactors *face_geom; ///< Not owned
@@ -2368,6 +2434,9 @@ protected:
 
    void AssembleEA_(Vector &ea, const bool add);
 
+   /// Convert the PA data to single precision, if requested and supported.
+   void SetupSinglePrecisionPA();
+
 public:
 
    using ApplyKernelType = void(*)(const int, const Array<real_t>&,
@@ -2378,7 +2447,23 @@ public:
                                        const Vector&, Vector&, const int,
                                        const int);
 
+   /// The last argument is the number of vectors stored in the input/output.
+   using ApplyFusedKernelType = void(*)(const int, const Array<real_t>&,
+                                        const real_t*, const int*,
+                                        const Vector&, Vector&, const int,
+                                        const int, const int);
+
+   /// Same as ApplyFusedKernelType, with single precision PA data.
+   using ApplyMixedKernelType = void(*)(const int, const Array<real_t>&,
+                                        const float*, const int*,
+                                        const Vector&, Vector&, const int,
+                                        const int, const int);
+
    MFEM_REGISTER_KERNELS(ApplyPAKernels, ApplyKernelType, (int, int, int));
+   MFEM_REGISTER_KERNELS(ApplyFusedPAKernels, ApplyFusedKernelType,
+                         (int, int, int));
+   MFEM_REGISTER_KERNELS(ApplyMixedPAKernels, ApplyMixedKernelType,
+                         (int, int, int));
    MFEM_REGISTER_KERNELS(DiagonalPAKernels, DiagonalKernelType, (int, int, int));
    struct Kernels { Kernels(); };
 
@@ -2421,6 +2506,13 @@ public:
 
    void AddMultTransposePA(const Vector&, Vector&) const override;
 
+   void AddMultPAFused(const ElementRestriction &R, const Vector &x,
+                       Vector &y) const override;
+
+   void AddMultPABatch(const Vector &x, Vector &y, int nvec) const override;
+
+   bool SupportsFusedPA() const override;
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe,
                                          const ElementTransformation &Trans);
@@ -2433,6 +2525,8 @@ public:
    static void AddSpecialization()
    {
       ApplyPAKernels::Specialization<DIM,D1D,Q1D>::Add();
+      ApplyFusedPAKernels::Specialization<DIM,D1D,Q1D>::Add();
+      ApplyMixedPAKernels::Specialization<DIM,D1D,Q1D>::Add();
       DiagonalPAKernels::Specialization<DIM,D1D,Q1D>::Add();
    }
 
@@ -3195,6 +3289,8 @@ public:
 
    void AddMultPA(const Vector &x, Vector &y) const override;
 
+   void AddMultPABatch(const Vector &x, Vector &y, int nvec) const override;
+
    void AddMultTransposePA(const Vector &x, Vector &y) const override;
 
    /** Compute the stress corresponding to the local displacement @a $u$ and
@@ -0,0 +1,80 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "elementcost.hpp"
+#include "bilininteg.hpp"
+
+namespace mfem
+{
+
+void ElementCostRecorder::Reset(int num_elements)
+{
+   MFEM_VERIFY(current < 0, "Stop() must be called before Reset()");
+   costs.SetSize(num_elements);
+   costs = 0.0;
+}
+
+void ElementCostRecorder::Start(int elem)
+{
+   MFEM_VERIFY(current < 0, "Stop() must be called before Start()");
+   MFEM_ASSERT(0 <= elem && elem < costs.Size(), "invalid element " << elem);
+   current = elem;
+   timer.Restart();
+}
+
+void ElementCostRecorder::Stop()
+{
+   MFEM_VERIFY(current >= 0, "Start() must be called before Stop()");
+   timer.Stop();
+   costs(current) += timer.RealTime();
+   current = -1;
+}
+
+void ElementCostRecorder::AddAssemblyTime(BilinearForm &a)
+{
+   FiniteElementSpace &fes = *a.FESpace();
+   MFEM_VERIFY(fes.GetNE() == costs.Size(), "the number of elements of the "
+               "space does not match the recorder, see Reset()");
+
+   Array<BilinearFormIntegrator*> &integs = *a.GetDBFI();
+   Array<Array<int>*> &markers = *a.GetDBFI_Marker();
+   DenseMatrix elmat;
+   for (int i = 0; i < fes.GetNE(); i++)
+   {
+      const FiniteElement &fe = *fes.GetFE(i);
+      const int attr = fes.GetAttribute(i);
+      Start(i);
+      ElementTransformation &T = *fes.GetElementTransformation(i);
+      for (int k = 0; k < integs.Size(); k++)
+      {
+         if (markers[k] && (*markers[k])[attr-1] == 0) { continue; }
+         integs[k]->AssembleElementMatrix(fe, T, elmat);
+      }
+      Stop();
+   }
+}
+
+void ElementCostRecorder::AddQuadratureCost(const FiniteElementSpace &fes,
+                                            real_t scale)
+{
+   MFEM_VERIFY(fes.GetNE() == costs.Size(), "the number of elements of the "
+               "space does not match the recorder, see Reset()");
+
+   for (int i = 0; i < fes.GetNE(); i++)
+   {
+      const FiniteElement &fe = *fes.GetFE(i);
+      const ElementTransformation &T = *fes.GetElementTransformation(i);
+      const IntegrationRule &ir = MassIntegrator::GetRule(fe, fe, T);
+      costs(i) += scale * ir.GetNPoints() * fe.GetDof();
+   }
+}
+
+} // namespace mfem
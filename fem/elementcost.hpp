@@ -0,0 +1,85 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_ELEMENTCOST
+#define MFEM_ELEMENTCOST
+
+#include "../config/config.hpp"
+#include "../general/tic_toc.hpp"
+#include "../linalg/vector.hpp"
+#include "fespace.hpp"
+#include "bilinearform.hpp"
+
+namespace mfem
+{
+
+/** @brief Record the computational cost of the elements of a mesh.
+
+    The costs can be measured, with Start() and Stop() around the work done on
+    an element or with AddAssemblyTime(), or estimated, e.g. with
+    AddQuadratureCost(). They are accumulated until Reset(), and can be used as
+    weights for load balancing, see ParMesh::Rebalance(const Vector&, real_t).
+
+    Typical usage in an adaptive loop:
+    @code
+       ElementCostRecorder recorder(mesh.GetNE());
+       // ... assembly and solve, with recorder.Start(i) and recorder.Stop()
+       mesh.Rebalance(recorder.GetCosts(), 1.1);
+       fespace.Update();
+    @endcode */
+class ElementCostRecorder
+{
+protected:
+   Vector costs;
+   StopWatch timer;
+   int current = -1;
+
+public:
+   /// Create a recorder for @a num_elements elements, with zero costs.
+   ElementCostRecorder(int num_elements = 0) { Reset(num_elements); }
+
+   /// Resize the recorder to @a num_elements elements and zero the costs.
+   void Reset(int num_elements);
+
+   /// Start measuring the time spent on the element @a elem.
+   void Start(int elem);
+
+   /// Stop the measurement and add the elapsed time to the current element.
+   void Stop();
+
+   /// Add @a cost to the cost of the element @a elem.
+   void AddCost(int elem, real_t cost) { costs(elem) += cost; }
+
+   /** @brief Add the time of the assembly of the element matrices of the
+       domain integrators of @a a, measured on each element. */
+   void AddAssemblyTime(BilinearForm &a);
+
+   /** @brief Add an estimate of the cost of the assembly on each element of
+       @a fes: the number of quadrature points of the default rule of the mass
+       matrix times the number of element DOFs, scaled by @a scale.
+
+       This is independent of the machine load, and follows the polynomial
+       orders of variable-order spaces. */
+   void AddQuadratureCost(const FiniteElementSpace &fes, real_t scale = 1.0);
+
+   /// Return the number of elements.
+   int GetNE() const { return costs.Size(); }
+
+   /// Return the costs of the elements.
+   const Vector &GetCosts() const { return costs; }
+
+   /// Return the cost of the element @a elem.
+   real_t GetCost(int elem) const { return costs(elem); }
+};
+
+} // namespace mfem
+
+#endif
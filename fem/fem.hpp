@@ -34,6 +34,7 @@
 #include "hybridization.hpp"
 #include "datacollection.hpp"
 #include "estimators.hpp"
+#include "elementcost.hpp"
 #include "staticcond.hpp"
 #include "tmop.hpp"
 #include "tmop_tools.hpp"
@@ -41,6 +42,7 @@
 #include "gslib.hpp"
 #include "restriction.hpp"
 #include "quadinterpolator.hpp"
+#include "qdata_cache.hpp"
 #include "quadinterpolator_face.hpp"
 #include "transfer.hpp"
 #include "fespacehierarchy.hpp"
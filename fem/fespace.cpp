@@ -2801,8 +2801,9 @@ void FiniteElementSpace::Construct()
       nvdofs = mesh->GetNV() * fec->GetNumDof(Geometry::POINT, order);
    }
 
-   // assign edge DOFs
-   if (mesh->GetNEdges())
+   // assign edge DOFs (a variable-order space may have ghost edges even
+   // without local ones, on an empty rank)
+   if (mesh->GetNEdges() || IsVariableOrder())
    {
       if (IsVariableOrder())
       {
@@ -2824,7 +2825,7 @@ void FiniteElementSpace::Construct()
    }
 
    // assign face DOFs
-   if (mesh->GetNFaces())
+   if (mesh->GetNFaces() || IsVariableOrder())
    {
       if (IsVariableOrder() || mixed_faces)
       {
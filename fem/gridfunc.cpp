@@ -19,6 +19,7 @@
 #include "../mesh/nurbs.hpp"
 #include "../mesh/vtkhdf.hpp"
 #include "../general/text.hpp"
+#include "../general/binaryfile.hpp"
 
 #ifdef MFEM_USE_MPI
 #include "pfespace.hpp"
@@ -77,6 +78,25 @@ GridFunction::GridFunction(Mesh *m, std::istream &input)
    fes_sequence = fes->GetSequence();
 }
 
+GridFunction::GridFunction(Mesh *m, const BinaryFile &file,
+                           const std::string &name)
+   : Vector()
+{
+   // Grid functions are stored on the device
+   UseDevice(true);
+
+   fes = new FiniteElementSpace;
+   std::istringstream space(file.GetString(name + "/space"));
+   fec_owned = fes->Load(m, space);
+
+   uint64_t size;
+   real_t *values = file.GetEntry<real_t>(name + "/data", size);
+   MFEM_VERIFY(size == uint64_t(fes->GetVSize()),
+               "invalid binary grid function " << name);
+   NewDataAndSize(values, fes->GetVSize());
+   fes_sequence = fes->GetSequence();
+}
+
 GridFunction::GridFunction(Mesh *m, GridFunction *gf_array[], int num_pieces)
 {
    UseDevice(true);
@@ -3665,6 +3685,15 @@ void GridFunction::Save(const char *fname, int precision) const
    Save(ofs);
 }
 
+void GridFunction::SaveBinary(BinaryFileWriter &out,
+                              const std::string &name) const
+{
+   std::ostringstream space;
+   fes->Save(space);
+   out.Write(name + "/space", space.str());
+   out.Write(name + "/data", HostRead(), Size());
+}
+
 #ifdef MFEM_USE_ADIOS2
 void GridFunction::Save(adios2stream &os,
                         const std::string& variable_name,
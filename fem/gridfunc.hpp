@@ -105,6 +105,14 @@ public:
        are owned by the GridFunction. */
    GridFunction(Mesh *m, std::istream &input);
 
+   /// Construct a GridFunction on the Mesh @a m from the entries @a name of
+   /// the binary file @a file, written with SaveBinary().
+   /** The reconstructed FiniteElementSpace and FiniteElementCollection are
+       owned by the GridFunction. The values are not copied: they refer to the
+       memory-mapped data of @a file, which must outlive the GridFunction. */
+   GridFunction(Mesh *m, const BinaryFile &file,
+                const std::string &name = "gf");
+
    GridFunction(Mesh *m, GridFunction *gf_array[], int num_pieces);
 
    /// Copy assignment. Only the data of the base class Vector is copied.
@@ -1532,6 +1540,9 @@ public:
    /// ASCII output.
    virtual void Save(const char *fname, int precision=16) const;
 
+   /// Write the GridFunction as the entries @a name of the binary file @a out.
+   void SaveBinary(BinaryFileWriter &out, const std::string &name = "gf") const;
+
 #ifdef MFEM_USE_ADIOS2
    /// Save the GridFunction to a binary output stream using adios2 bp format.
    virtual void Save(adios2stream &out, const std::string& variable_name,
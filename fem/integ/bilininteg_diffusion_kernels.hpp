@@ -19,6 +19,7 @@
 #include "../../linalg/dtensor.hpp"
 #include "../../linalg/vector.hpp"
 #include "../bilininteg.hpp"
+#include "../restriction.hpp"
 
 namespace mfem
 {
@@ -644,6 +645,184 @@ inline void PADiffusionApply2D(const int NE,
    });
 }
 
+// Variant of SmemPADiffusionApply2D() for the fused restriction, the lower
+// precision PA data and the batched vectors. If the gather map of an
+// ElementRestriction is given, x_ and y_ are L-vectors: the element dofs are
+// gathered from x_ and the result is scatter-added to y_ (fused restriction).
+// The PA data d_ (a device pointer) may be stored in a lower precision qd_t;
+// the computations are done in real_t. x_ and y_ may hold nvec vectors stored
+// one after another: the vectors are processed inside the element loop, so
+// the PA data and the basis of an element are reused from cache.
+template<int T_D1D = 0, int T_Q1D = 0, typename qd_t = real_t>
+inline void SmemPADiffusionFusedApply2D(const int NE,
+                                        const bool symmetric,
+                                        const Array<real_t> &b_,
+                                        const Array<real_t> &g_,
+                                        const qd_t *d_,
+                                        const int *map,
+                                        const Vector &x_,
+                                        Vector &y_,
+                                        const int d1d = 0,
+                                        const int q1d = 0,
+                                        const int nvec = 1)
+{
+   static constexpr int T_NBZ = diffusion::NBZApply(T_D1D);
+   static constexpr int NBZ = T_NBZ ? T_NBZ : 1;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int max_q1d = T_Q1D ? T_Q1D : DeviceDofQuadLimits::Get().MAX_Q1D;
+   const int max_d1d = T_D1D ? T_D1D : DeviceDofQuadLimits::Get().MAX_D1D;
+   MFEM_VERIFY(D1D <= max_d1d, "");
+   MFEM_VERIFY(Q1D <= max_q1d, "");
+   auto b = Reshape(b_.Read(), Q1D, D1D);
+   auto g = Reshape(g_.Read(), Q1D, D1D);
+   auto D = Reshape(d_, Q1D*Q1D, symmetric ? 3 : 4, NE);
+   const real_t *x_0 = x_.Read();
+   real_t *y_0 = y_.ReadWrite();
+   const int x_stride = x_.Size() / nvec;
+   const int y_stride = y_.Size() / nvec;
+   mfem::forall_2D_batch(NE, Q1D, Q1D, NBZ, [=] MFEM_HOST_DEVICE(int e)
+   {
+      const int tidz = MFEM_THREAD_ID(z);
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : DofQuadLimits::MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : DofQuadLimits::MAX_D1D;
+      MFEM_SHARED real_t sBG[2][MQ1*MD1];
+      real_t (*B)[MD1] = (real_t (*)[MD1]) (sBG+0);
+      real_t (*G)[MD1] = (real_t (*)[MD1]) (sBG+1);
+      real_t (*Bt)[MQ1] = (real_t (*)[MQ1]) (sBG+0);
+      real_t (*Gt)[MQ1] = (real_t (*)[MQ1]) (sBG+1);
+      MFEM_SHARED real_t Xz[NBZ][MD1][MD1];
+      MFEM_SHARED real_t GD[2][NBZ][MD1][MQ1];
+      MFEM_SHARED real_t GQ[2][NBZ][MD1][MQ1];
+      real_t (*X)[MD1] = (real_t (*)[MD1])(Xz + tidz);
+      real_t (*DQ0)[MD1] = (real_t (*)[MD1])(GD[0] + tidz);
+      real_t (*DQ1)[MD1] = (real_t (*)[MD1])(GD[1] + tidz);
+      real_t (*QQ0)[MD1] = (real_t (*)[MD1])(GQ[0] + tidz);
+      real_t (*QQ1)[MD1] = (real_t (*)[MD1])(GQ[1] + tidz);
+      for (int vec = 0; vec < nvec; ++vec)
+      {
+         const real_t *x = x_0 + vec*x_stride;
+         real_t *Y = y_0 + vec*y_stride;
+         MFEM_FOREACH_THREAD(dy,y,D1D)
+         {
+            MFEM_FOREACH_THREAD(dx,x,D1D)
+            {
+               const int lid = dx + D1D*(dy + D1D*e);
+               X[dy][dx] = map ? GatherLDof(map, x, lid) : x[lid];
+            }
+         }
+         if (tidz == 0)
+         {
+            MFEM_FOREACH_THREAD(dy,y,D1D)
+            {
+               MFEM_FOREACH_THREAD(q,x,Q1D)
+               {
+                  B[q][dy] = b(q,dy);
+                  G[q][dy] = g(q,dy);
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dy,y,D1D)
+         {
+            MFEM_FOREACH_THREAD(qx,x,Q1D)
+            {
+               real_t u = 0.0;
+               real_t v = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const real_t coords = X[dy][dx];
+                  u += B[qx][dx] * coords;
+                  v += G[qx][dx] * coords;
+               }
+               DQ0[dy][qx] = u;
+               DQ1[dy][qx] = v;
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qy,y,Q1D)
+         {
+            MFEM_FOREACH_THREAD(qx,x,Q1D)
+            {
+               real_t u = 0.0;
+               real_t v = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  u += DQ1[dy][qx] * B[qy][dy];
+                  v += DQ0[dy][qx] * G[qy][dy];
+               }
+               QQ0[qy][qx] = u;
+               QQ1[qy][qx] = v;
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qy,y,Q1D)
+         {
+            MFEM_FOREACH_THREAD(qx,x,Q1D)
+            {
+               const int q = (qx + ((qy) * Q1D));
+               const real_t O11 = D(q,0,e);
+               const real_t O21 = D(q,1,e);
+               const real_t O12 = symmetric ? O21 : D(q,2,e);
+               const real_t O22 = symmetric ? D(q,2,e) : D(q,3,e);
+               const real_t gX = QQ0[qy][qx];
+               const real_t gY = QQ1[qy][qx];
+               QQ0[qy][qx] = (O11 * gX) + (O12 * gY);
+               QQ1[qy][qx] = (O21 * gX) + (O22 * gY);
+            }
+         }
+         MFEM_SYNC_THREAD;
+         if (tidz == 0)
+         {
+            MFEM_FOREACH_THREAD(dy,y,D1D)
+            {
+               MFEM_FOREACH_THREAD(q,x,Q1D)
+               {
+                  Bt[dy][q] = b(q,dy);
+                  Gt[dy][q] = g(q,dy);
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qy,y,Q1D)
+         {
+            MFEM_FOREACH_THREAD(dx,x,D1D)
+            {
+               real_t u = 0.0;
+               real_t v = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  u += Gt[dx][qx] * QQ0[qy][qx];
+                  v += Bt[dx][qx] * QQ1[qy][qx];
+               }
+               DQ0[qy][dx] = u;
+               DQ1[qy][dx] = v;
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dy,y,D1D)
+         {
+            MFEM_FOREACH_THREAD(dx,x,D1D)
+            {
+               real_t u = 0.0;
+               real_t v = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  u += DQ0[qy][dx] * Bt[dy][qy];
+                  v += DQ1[qy][dx] * Gt[dy][qy];
+               }
+               const int lid = dx + D1D*(dy + D1D*e);
+               if (map) { ScatterAddLDof(map, Y, lid, u + v); }
+               else { Y[lid] += (u + v); }
+            }
+         }
+         MFEM_SYNC_THREAD;
+      }
+   });
+}
+
 // Shared memory PA Diffusion Apply 2D kernel
 template<int T_D1D = 0, int T_Q1D = 0>
 inline void SmemPADiffusionApply2D(const int NE,
@@ -997,6 +1176,247 @@ inline void PADiffusionApply3D(const int NE,
    });
 }
 
+// Variant of SmemPADiffusionApply3D(), see SmemPADiffusionFusedApply2D() for
+// the fused restriction with @a map, the PA data type qd_t and the number of
+// vectors nvec.
+template<int T_D1D = 0, int T_Q1D = 0, typename qd_t = real_t>
+inline void SmemPADiffusionFusedApply3D(const int NE,
+                                        const bool symmetric,
+                                        const Array<real_t> &b_,
+                                        const Array<real_t> &g_,
+                                        const qd_t *d_,
+                                        const int *map,
+                                        const Vector &x_,
+                                        Vector &y_,
+                                        const int d1d = 0,
+                                        const int q1d = 0,
+                                        const int nvec = 1)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int max_q1d = T_Q1D ? T_Q1D : DeviceDofQuadLimits::Get().MAX_Q1D;
+   const int max_d1d = T_D1D ? T_D1D : DeviceDofQuadLimits::Get().MAX_D1D;
+   MFEM_VERIFY(D1D <= max_d1d, "");
+   MFEM_VERIFY(Q1D <= max_q1d, "");
+   auto b = Reshape(b_.Read(), Q1D, D1D);
+   auto g = Reshape(g_.Read(), Q1D, D1D);
+   auto d = Reshape(d_, Q1D, Q1D, Q1D, symmetric ? 6 : 9, NE);
+   const real_t *x_0 = x_.Read();
+   real_t *y_0 = y_.ReadWrite();
+   const int x_stride = x_.Size() / nvec;
+   const int y_stride = y_.Size() / nvec;
+   mfem::forall_3D(NE, Q1D, Q1D, Q1D, [=] MFEM_HOST_DEVICE (int e)
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : DofQuadLimits::MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : DofQuadLimits::MAX_D1D;
+      constexpr int MDQ = (MQ1 > MD1) ? MQ1 : MD1;
+      MFEM_SHARED real_t sBG[2][MQ1*MD1];
+      real_t (*B)[MD1] = (real_t (*)[MD1]) (sBG+0);
+      real_t (*G)[MD1] = (real_t (*)[MD1]) (sBG+1);
+      real_t (*Bt)[MQ1] = (real_t (*)[MQ1]) (sBG+0);
+      real_t (*Gt)[MQ1] = (real_t (*)[MQ1]) (sBG+1);
+      MFEM_SHARED real_t sm0[3][MDQ*MDQ*MDQ];
+      MFEM_SHARED real_t sm1[3][MDQ*MDQ*MDQ];
+      real_t (*X)[MD1][MD1]    = (real_t (*)[MD1][MD1]) (sm0+2);
+      real_t (*DDQ0)[MD1][MQ1] = (real_t (*)[MD1][MQ1]) (sm0+0);
+      real_t (*DDQ1)[MD1][MQ1] = (real_t (*)[MD1][MQ1]) (sm0+1);
+      real_t (*DQQ0)[MQ1][MQ1] = (real_t (*)[MQ1][MQ1]) (sm1+0);
+      real_t (*DQQ1)[MQ1][MQ1] = (real_t (*)[MQ1][MQ1]) (sm1+1);
+      real_t (*DQQ2)[MQ1][MQ1] = (real_t (*)[MQ1][MQ1]) (sm1+2);
+      real_t (*QQQ0)[MQ1][MQ1] = (real_t (*)[MQ1][MQ1]) (sm0+0);
+      real_t (*QQQ1)[MQ1][MQ1] = (real_t (*)[MQ1][MQ1]) (sm0+1);
+      real_t (*QQQ2)[MQ1][MQ1] = (real_t (*)[MQ1][MQ1]) (sm0+2);
+      real_t (*QQD0)[MQ1][MD1] = (real_t (*)[MQ1][MD1]) (sm1+0);
+      real_t (*QQD1)[MQ1][MD1] = (real_t (*)[MQ1][MD1]) (sm1+1);
+      real_t (*QQD2)[MQ1][MD1] = (real_t (*)[MQ1][MD1]) (sm1+2);
+      real_t (*QDD0)[MD1][MD1] = (real_t (*)[MD1][MD1]) (sm0+0);
+      real_t (*QDD1)[MD1][MD1] = (real_t (*)[MD1][MD1]) (sm0+1);
+      real_t (*QDD2)[MD1][MD1] = (real_t (*)[MD1][MD1]) (sm0+2);
+      for (int vec = 0; vec < nvec; ++vec)
+      {
+         const real_t *x = x_0 + vec*x_stride;
+         real_t *y = y_0 + vec*y_stride;
+         MFEM_FOREACH_THREAD(dz,z,D1D)
+         {
+            MFEM_FOREACH_THREAD(dy,y,D1D)
+            {
+               MFEM_FOREACH_THREAD(dx,x,D1D)
+               {
+                  const int lid = dx + D1D*(dy + D1D*(dz + D1D*e));
+                  X[dz][dy][dx] = map ? GatherLDof(map, x, lid) : x[lid];
+               }
+            }
+         }
+         if (MFEM_THREAD_ID(z) == 0)
+         {
+            MFEM_FOREACH_THREAD(dy,y,D1D)
+            {
+               MFEM_FOREACH_THREAD(qx,x,Q1D)
+               {
+                  B[qx][dy] = b(qx,dy);
+                  G[qx][dy] = g(qx,dy);
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dz,z,D1D)
+         {
+            MFEM_FOREACH_THREAD(dy,y,D1D)
+            {
+               MFEM_FOREACH_THREAD(qx,x,Q1D)
+               {
+                  real_t u = 0.0, v = 0.0;
+                  MFEM_UNROLL(MD1)
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     const real_t coords = X[dz][dy][dx];
+                     u += coords * B[qx][dx];
+                     v += coords * G[qx][dx];
+                  }
+                  DDQ0[dz][dy][qx] = u;
+                  DDQ1[dz][dy][qx] = v;
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dz,z,D1D)
+         {
+            MFEM_FOREACH_THREAD(qy,y,Q1D)
+            {
+               MFEM_FOREACH_THREAD(qx,x,Q1D)
+               {
+                  real_t u = 0.0, v = 0.0, w = 0.0;
+                  MFEM_UNROLL(MD1)
+                  for (int dy = 0; dy < D1D; ++dy)
+                  {
+                     u += DDQ1[dz][dy][qx] * B[qy][dy];
+                     v += DDQ0[dz][dy][qx] * G[qy][dy];
+                     w += DDQ0[dz][dy][qx] * B[qy][dy];
+                  }
+                  DQQ0[dz][qy][qx] = u;
+                  DQQ1[dz][qy][qx] = v;
+                  DQQ2[dz][qy][qx] = w;
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qz,z,Q1D)
+         {
+            MFEM_FOREACH_THREAD(qy,y,Q1D)
+            {
+               MFEM_FOREACH_THREAD(qx,x,Q1D)
+               {
+                  real_t u = 0.0, v = 0.0, w = 0.0;
+                  MFEM_UNROLL(MD1)
+                  for (int dz = 0; dz < D1D; ++dz)
+                  {
+                     u += DQQ0[dz][qy][qx] * B[qz][dz];
+                     v += DQQ1[dz][qy][qx] * B[qz][dz];
+                     w += DQQ2[dz][qy][qx] * G[qz][dz];
+                  }
+                  const real_t O11 = d(qx,qy,qz,0,e);
+                  const real_t O12 = d(qx,qy,qz,1,e);
+                  const real_t O13 = d(qx,qy,qz,2,e);
+                  const real_t O21 = symmetric ? O12 : d(qx,qy,qz,3,e);
+                  const real_t O22 = symmetric ? d(qx,qy,qz,3,e) :
+                                     d(qx,qy,qz,4,e);
+                  const real_t O23 = symmetric ? d(qx,qy,qz,4,e) :
+                                     d(qx,qy,qz,5,e);
+                  const real_t O31 = symmetric ? O13 : d(qx,qy,qz,6,e);
+                  const real_t O32 = symmetric ? O23 : d(qx,qy,qz,7,e);
+                  const real_t O33 = symmetric ? d(qx,qy,qz,5,e) :
+                                     d(qx,qy,qz,8,e);
+                  const real_t gX = u;
+                  const real_t gY = v;
+                  const real_t gZ = w;
+                  QQQ0[qz][qy][qx] = (O11*gX) + (O12*gY) + (O13*gZ);
+                  QQQ1[qz][qy][qx] = (O21*gX) + (O22*gY) + (O23*gZ);
+                  QQQ2[qz][qy][qx] = (O31*gX) + (O32*gY) + (O33*gZ);
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+         if (MFEM_THREAD_ID(z) == 0)
+         {
+            MFEM_FOREACH_THREAD(dy,y,D1D)
+            {
+               MFEM_FOREACH_THREAD(qx,x,Q1D)
+               {
+                  Bt[dy][qx] = b(qx,dy);
+                  Gt[dy][qx] = g(qx,dy);
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qz,z,Q1D)
+         {
+            MFEM_FOREACH_THREAD(qy,y,Q1D)
+            {
+               MFEM_FOREACH_THREAD(dx,x,D1D)
+               {
+                  real_t u = 0.0, v = 0.0, w = 0.0;
+                  MFEM_UNROLL(MQ1)
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     u += QQQ0[qz][qy][qx] * Gt[dx][qx];
+                     v += QQQ1[qz][qy][qx] * Bt[dx][qx];
+                     w += QQQ2[qz][qy][qx] * Bt[dx][qx];
+                  }
+                  QQD0[qz][qy][dx] = u;
+                  QQD1[qz][qy][dx] = v;
+                  QQD2[qz][qy][dx] = w;
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qz,z,Q1D)
+         {
+            MFEM_FOREACH_THREAD(dy,y,D1D)
+            {
+               MFEM_FOREACH_THREAD(dx,x,D1D)
+               {
+                  real_t u = 0.0, v = 0.0, w = 0.0;
+                  MFEM_UNROLL(Q1D)
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     u += QQD0[qz][qy][dx] * Bt[dy][qy];
+                     v += QQD1[qz][qy][dx] * Gt[dy][qy];
+                     w += QQD2[qz][qy][dx] * Bt[dy][qy];
+                  }
+                  QDD0[qz][dy][dx] = u;
+                  QDD1[qz][dy][dx] = v;
+                  QDD2[qz][dy][dx] = w;
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dz,z,D1D)
+         {
+            MFEM_FOREACH_THREAD(dy,y,D1D)
+            {
+               MFEM_FOREACH_THREAD(dx,x,D1D)
+               {
+                  real_t u = 0.0, v = 0.0, w = 0.0;
+                  MFEM_UNROLL(MQ1)
+                  for (int qz = 0; qz < Q1D; ++qz)
+                  {
+                     u += QDD0[qz][dy][dx] * Bt[dz][qz];
+                     v += QDD1[qz][dy][dx] * Bt[dz][qz];
+                     w += QDD2[qz][dy][dx] * Gt[dz][qz];
+                  }
+                  const int lid = dx + D1D*(dy + D1D*(dz + D1D*e));
+                  if (map) { ScatterAddLDof(map, y, lid, u + v + w); }
+                  else { y[lid] += (u + v + w); }
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+      }
+   });
+}
+
 // Shared memory PA Diffusion Apply 3D kernel
 template<int T_D1D = 0, int T_Q1D = 0>
 inline void SmemPADiffusionApply3D(const int NE,
@@ -1227,6 +1647,8 @@ inline void SmemPADiffusionApply3D(const int NE,
 namespace
 {
 using ApplyKernelType = DiffusionIntegrator::ApplyKernelType;
+using ApplyFusedKernelType = DiffusionIntegrator::ApplyFusedKernelType;
+using ApplyMixedKernelType = DiffusionIntegrator::ApplyMixedKernelType;
 using DiagonalKernelType = DiffusionIntegrator::DiagonalKernelType;
 }
 
@@ -1246,6 +1668,40 @@ ApplyKernelType DiffusionIntegrator::ApplyPAKernels::Fallback(int DIM, int, int)
    else { MFEM_ABORT(""); }
 }
 
+template<int DIM, int T_D1D, int T_Q1D>
+ApplyFusedKernelType DiffusionIntegrator::ApplyFusedPAKernels::Kernel()
+{
+   using namespace internal;
+   if (DIM == 2) { return SmemPADiffusionFusedApply2D<T_D1D,T_Q1D>; }
+   else if (DIM == 3) { return SmemPADiffusionFusedApply3D<T_D1D,T_Q1D>; }
+   else { MFEM_ABORT(""); }
+}
+
+inline ApplyFusedKernelType
+DiffusionIntegrator::ApplyFusedPAKernels::Fallback(int DIM, int D1D, int Q1D)
+{
+   MFEM_ABORT("No fused PA diffusion kernel for DIM = " << DIM << ", D1D = "
+              << D1D << ", Q1D = " << Q1D);
+   return nullptr;
+}
+
+template<int DIM, int T_D1D, int T_Q1D>
+ApplyMixedKernelType DiffusionIntegrator::ApplyMixedPAKernels::Kernel()
+{
+   using namespace internal;
+   if (DIM == 2) { return SmemPADiffusionFusedApply2D<T_D1D,T_Q1D,float>; }
+   else if (DIM == 3) { return SmemPADiffusionFusedApply3D<T_D1D,T_Q1D,float>; }
+   else { MFEM_ABORT(""); }
+}
+
+inline ApplyMixedKernelType
+DiffusionIntegrator::ApplyMixedPAKernels::Fallback(int DIM, int D1D, int Q1D)
+{
+   MFEM_ABORT("No mixed precision PA diffusion kernel for DIM = " << DIM
+              << ", D1D = " << D1D << ", Q1D = " << Q1D);
+   return nullptr;
+}
+
 template<int DIM, int D1D, int Q1D>
 DiagonalKernelType DiffusionIntegrator::DiagonalPAKernels::Kernel()
 {
@@ -12,6 +12,7 @@
 #include "../bilininteg.hpp"
 #include "../gridfunc.hpp"
 #include "../qfunction.hpp"
+#include "../qdata_cache.hpp"
 #include "../../mesh/nurbs.hpp"
 #include "../ceed/integrators/diffusion/diffusion.hpp"
 #include "bilininteg_diffusion_kernels.hpp"
@@ -27,10 +28,15 @@ void DiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
    }
    else
    {
-      if (pa_data.Size() == 0) { AssemblePA(*fespace); }
+      if (pa_data.Size() == 0 && pa_data_sp.Size() == 0)
+      {
+         AssemblePA(*fespace);
+      }
       const Array<real_t> &B = maps->B;
       const Array<real_t> &G = maps->G;
-      const Vector &Dv = pa_data;
+      Vector pa_data_dp;
+      if (pa_data_sp.Size()) { FromSinglePrecision(pa_data_sp, pa_data_dp); }
+      const Vector &Dv = pa_data_sp.Size() ? pa_data_dp : pa_data;
       DiagonalPAKernels::Run(dim, dofs1D, quad1D, ne, symmetric, B, G, Dv,
                              diag, dofs1D, quad1D);
    }
@@ -43,6 +49,12 @@ void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
    {
       ceedOp->AddMult(x, y);
    }
+   else if (pa_data_sp.Size())
+   {
+      ApplyMixedPAKernels::Run(dim, dofs1D, quad1D, ne, symmetric, maps->B,
+                               maps->G, pa_data_sp.Read(), nullptr, x, y,
+                               dofs1D, quad1D, 1);
+   }
    else
    {
       const Array<real_t> &B = maps->B;
@@ -86,6 +98,80 @@ void DiffusionIntegrator::AddMultTransposePA(const Vector &x, Vector &y) const
    }
 }
 
+bool DiffusionIntegrator::SupportsFusedPA() const
+{
+   if (DeviceCanUseCeed()) { return false; }
+#ifdef MFEM_USE_OCCA
+   if (DeviceCanUseOcca()) { return false; }
+#endif
+   if (!fespace || fespace->GetVDim() != 1) { return false; }
+   if (pa_data.Size() == 0 && pa_data_sp.Size() == 0) { return false; }
+   if (dim != 2 && dim != 3) { return false; }
+   // The single precision data is only created when ApplyMixedPAKernels has
+   // the specialization, see SetupSinglePrecisionPA()
+   const auto &table = ApplyFusedPAKernels::GetDispatchTable();
+   return table.find(std::make_tuple(dim, dofs1D, quad1D)) != table.end();
+}
+
+void DiffusionIntegrator::AddMultPAFused(const ElementRestriction &R,
+                                         const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(SupportsFusedPA(), "fused PA is not supported");
+   MFEM_ASSERT(R.GatherMap().Size() == ne*static_cast<int>(pow(dofs1D, dim)),
+               "incompatible element restriction");
+   const int *map = R.GatherMap().Read();
+   if (pa_data_sp.Size())
+   {
+      ApplyMixedPAKernels::Run(dim, dofs1D, quad1D, ne, symmetric, maps->B,
+                               maps->G, pa_data_sp.Read(), map, x, y,
+                               dofs1D, quad1D, 1);
+   }
+   else
+   {
+      ApplyFusedPAKernels::Run(dim, dofs1D, quad1D, ne, symmetric, maps->B,
+                               maps->G, pa_data.Read(), map, x, y,
+                               dofs1D, quad1D, 1);
+   }
+}
+
+void DiffusionIntegrator::AddMultPABatch(const Vector &x, Vector &y,
+                                         int nvec) const
+{
+   // The kernels with fused restriction also apply to E-vectors (null map)
+   if (!SupportsFusedPA())
+   {
+      BilinearFormIntegrator::AddMultPABatch(x, y, nvec);
+      return;
+   }
+   if (pa_data_sp.Size())
+   {
+      ApplyMixedPAKernels::Run(dim, dofs1D, quad1D, ne, symmetric, maps->B,
+                               maps->G, pa_data_sp.Read(), nullptr, x, y,
+                               dofs1D, quad1D, nvec);
+   }
+   else
+   {
+      ApplyFusedPAKernels::Run(dim, dofs1D, quad1D, ne, symmetric, maps->B,
+                               maps->G, pa_data.Read(), nullptr, x, y,
+                               dofs1D, quad1D, nvec);
+   }
+}
+
+void DiffusionIntegrator::SetupSinglePrecisionPA()
+{
+   pa_data_sp.DeleteAll();
+   if (!pa_single || std::is_same<real_t, float>::value) { return; }
+#ifdef MFEM_USE_OCCA
+   if (DeviceCanUseOcca()) { return; }
+#endif
+   const auto &table = ApplyMixedPAKernels::GetDispatchTable();
+   if (table.find(std::make_tuple(dim, dofs1D, quad1D)) == table.end())
+   {
+      return;
+   }
+   ToSinglePrecision(pa_data, pa_data_sp);
+}
+
 void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
 {
    const MemoryType mt = (pa_mt == MemoryType::DEFAULT) ?
@@ -118,12 +204,30 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    const int nq = ir->GetNPoints();
    dim = mesh->Dimension();
    ne = fes.GetNE();
-   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS, mt);
-   const int sdim = mesh->SpaceDimension();
    maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
    dofs1D = maps->ndof;
    quad1D = maps->nqpt;
 
+   // Read the PA data from the on-disk cache, if enabled and available
+   mesh->EnsureNodes();
+   const std::string cache_key = (MQ || VQ) ? std::string() :
+                                 QuadratureDataCache::GetKey(
+                                    "DiffusionIntegrator", *mesh->GetNodes(),
+                                    *ir, Q);
+   if (!cache_key.empty())
+   {
+      symmetric = (dims > 1);
+      pa_data.SetSize(symmDims * nq * ne, mt);
+      if (QuadratureDataCache::Load(cache_key, {&pa_data}))
+      {
+         SetupSinglePrecisionPA();
+         return;
+      }
+   }
+
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS, mt);
+   const int sdim = mesh->SpaceDimension();
+
    QuadratureSpace qs(*mesh, *ir);
    CoefficientVector coeff(qs, CoefficientStorage::COMPRESSED);
 
@@ -139,6 +243,8 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    pa_data.SetSize(pa_size * nq * ne, mt);
    internal::PADiffusionSetup(dim, sdim, dofs1D, quad1D, coeff_dim, ne,
                               ir->GetWeights(), geom->J, coeff, pa_data);
+   QuadratureDataCache::Save(cache_key, {&pa_data});
+   SetupSinglePrecisionPA();
 }
 
 void DiffusionIntegrator::AssembleNURBSPA(const FiniteElementSpace &fes)
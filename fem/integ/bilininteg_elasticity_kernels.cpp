@@ -73,15 +73,18 @@ void ElasticityComponentAddMultPA(const int dim, const int nDofs,
 void ElasticityAddMultPA(const int dim, const int nDofs,
                          const FiniteElementSpace &fespace, const CoefficientVector &lambda,
                          const CoefficientVector &mu, const GeometricFactors &geom,
-                         const DofToQuad &maps, const Vector &x, QuadratureFunction &QVec, Vector &y)
+                         const DofToQuad &maps, const Vector &x, QuadratureFunction &QVec, Vector &y,
+                         const int nvec)
 {
    switch (dim)
    {
       case 2:
-         ElasticityAddMultPA_<2>(nDofs, fespace, lambda, mu, geom, maps, x, QVec, y);
+         ElasticityAddMultPA_<2>(nDofs, fespace, lambda, mu, geom, maps, x, QVec, y,
+                                 nvec);
          break;
       case 3:
-         ElasticityAddMultPA_<3>(nDofs, fespace, lambda, mu, geom, maps, x, QVec, y);
+         ElasticityAddMultPA_<3>(nDofs, fespace, lambda, mu, geom, maps, x, QVec, y,
+                                 nvec);
          break;
       default:
          MFEM_ABORT("Only dimensions 2 and 3 supported.");
@@ -61,12 +61,16 @@ namespace internal
 /// @param[in] geom Geometric factors corresponding to fespace.
 /// @param[in] maps DofToQuad maps for one element (assume elements all same).
 /// @param[in] x Input vector. nDofs x dim x numEls.
-/// @param Q Scratch Q-Vector. nQuad x dim x dim x numEls.
+/// @param Q Scratch Q-Vector. nQuad x dim x dim x numEls x nvec.
 /// @param[in,out] y Ax gets added to this. nDofs x dim x numEls.
+/// @param[in] nvec Number of vectors stored one after another in x and y. The
+///                 geometric factors and the coefficients are read once for all
+///                 the vectors.
 void ElasticityAddMultPA(const int dim, const int nDofs,
                          const FiniteElementSpace &fespace, const CoefficientVector &lambda,
                          const CoefficientVector &mu, const GeometricFactors &geom,
-                         const DofToQuad &maps, const Vector &x, QuadratureFunction &QVec, Vector &y);
+                         const DofToQuad &maps, const Vector &x, QuadratureFunction &QVec, Vector &y,
+                         const int nvec = 1);
 
 /// @brief Elasticity component kernel for AddMultPA.
 ///
@@ -145,7 +149,7 @@ template<int dim, int i_block = -1, int j_block = -1>
 void ElasticityAddMultPA_(const int nDofs, const FiniteElementSpace &fespace,
                           const CoefficientVector &lambda, const CoefficientVector &mu,
                           const GeometricFactors &geom, const DofToQuad &maps, const Vector &x,
-                          QuadratureFunction &QVec, Vector &y)
+                          QuadratureFunction &QVec, Vector &y, const int nvec = 1)
 {
    using future::tensor;
    using future::make_tensor;
@@ -168,92 +172,111 @@ void ElasticityAddMultPA_(const int nDofs, const FiniteElementSpace &fespace,
    const QuadratureInterpolator *E_To_Q_Map = fespace.GetQuadratureInterpolator(
                                                  ir);
    E_To_Q_Map->SetOutputLayout(QVectorLayout::byNODES);
-   // interpolate physical derivatives to quadrature points.
-   E_To_Q_Map->PhysDerivatives(x, QVec);
 
    const int numPoints = ir.GetNPoints();
    const int numEls = fespace.GetNE();
+   // x, y and QVec hold nvec vectors stored one after another.
+   const int xSize = x.Size() / nvec;
+   const int qVecSize = numPoints * d * qSize * numEls;
+   MFEM_ASSERT(QVec.Size() >= nvec * qVecSize, "invalid QVec size");
+   // interpolate physical derivatives to quadrature points.
+   for (int v = 0; v < nvec; v++)
+   {
+      const Vector xv(const_cast<Vector&>(x), v * xSize, xSize);
+      Vector qv(QVec, v * qVecSize, qVecSize);
+      E_To_Q_Map->PhysDerivatives(xv, qv);
+   }
+
    const auto lamDev = Reshape(lambda.Read(), numPoints, numEls);
    const auto muDev = Reshape(mu.Read(), numPoints, numEls);
    const auto J = Reshape(geom.J.Read(), numPoints, d, d, numEls);
-   auto Q = Reshape(QVec.ReadWrite(), numPoints, d, qSize, numEls);
+   auto Q = Reshape(QVec.ReadWrite(), numPoints, d, qSize, numEls, nvec);
    const real_t *ipWeights = ir.GetWeights().Read();
    mfem::forall_2D(numEls, numPoints, 1, [=] MFEM_HOST_DEVICE (int e)
    {
       // for(int p = 0; p < numPoints, )
       MFEM_FOREACH_THREAD(p, x,numPoints)
       {
+         // the geometric factors and the coefficients are loaded once for all
+         // the vectors
          auto invJ = inv(make_tensor<d, d>(
          [&](int i, int j) { return J(p, i, j, e); }));
-         tensor<real_t, aSize, d> gradx;
-         // load grad(x) into gradx
-         if (isComponent)
-         {
-            for (int i = 0; i < d; i++)
-            {
-               gradx(0,i) = Q(p, i, 0, e);
-            }
-         }
-         else
+         const real_t w = ipWeights[p] /det(invJ);
+         const real_t lam = lamDev(p, e);
+         const real_t mu_p = muDev(p, e);
+         for (int v = 0; v < nvec; v++)
          {
-            for (int j = 0; j < d; j++)
+            tensor<real_t, aSize, d> gradx;
+            // load grad(x) into gradx
+            if (isComponent)
             {
                for (int i = 0; i < d; i++)
                {
-                  gradx(i,j) = Q(p, i, j, e);
+                  gradx(0,i) = Q(p, i, 0, e, v);
                }
             }
-         }
-         // compute divergence
-         real_t div = 0.;
-         for (int i = aLower; i < aUpper; i++)
-         {
-            // take size of gradx into account
-            const int iIndex = isComponent ? 0 : i;
-            div += gradx(iIndex,i);
-         }
-         const real_t w = ipWeights[p] /det(invJ);
-         for (int m = 0; m < d; m++)
-         {
-            for (int q = qLower; q < qUpper; q++)
+            else
             {
-               // compute contraction of 4*sym(grad(u))sym(grad(v)) term.
-               // this contraction could be made slightly cheaper using Voigt
-               // notation, but repeated entries are summed for simplicity.
-               real_t contraction = 0.;
-               // not sure how to combine cases
-               if (isComponent)
+               for (int j = 0; j < d; j++)
                {
-                  for (int a = 0; a < d; a++)
+                  for (int i = 0; i < d; i++)
                   {
-                     contraction += 2*((a == q)*invJ(m,j_block) + (j_block==q)*invJ(m,a))*(gradx(0,
-                                                                                                 a));
+                     gradx(i,j) = Q(p, i, j, e, v);
                   }
                }
-               else
+            }
+            // compute divergence
+            real_t div = 0.;
+            for (int i = aLower; i < aUpper; i++)
+            {
+               // take size of gradx into account
+               const int iIndex = isComponent ? 0 : i;
+               div += gradx(iIndex,i);
+            }
+            for (int m = 0; m < d; m++)
+            {
+               for (int q = qLower; q < qUpper; q++)
                {
-                  for (int a = 0; a < d; a++)
+                  // compute contraction of 4*sym(grad(u))sym(grad(v)) term.
+                  // this contraction could be made slightly cheaper using
+                  // Voigt notation, but repeated entries are summed for
+                  // simplicity.
+                  real_t contraction = 0.;
+                  // not sure how to combine cases
+                  if (isComponent)
                   {
-                     for (int b = 0; b < d; b++)
+                     for (int a = 0; a < d; a++)
                      {
-                        contraction += ((a == q)*invJ(m,b) + (b==q)*invJ(m,a))
-                                       *(gradx(a,b) + gradx(b, a));
+                        contraction += 2*((a == q)*invJ(m,j_block) +
+                                          (j_block==q)*invJ(m,a))*gradx(0,a);
                      }
                   }
+                  else
+                  {
+                     for (int a = 0; a < d; a++)
+                     {
+                        for (int b = 0; b < d; b++)
+                        {
+                           contraction += ((a == q)*invJ(m,b) + (b==q)*invJ(m,a))
+                                          *(gradx(a,b) + gradx(b, a));
+                        }
+                     }
+                  }
+                  // lambda*div(u)*div(v) + 2*mu*sym(grad(u))*sym(grad(v))
+                  // contraction = 4*sym(grad(u))sym(grad(v))
+                  const int qIndex = isComponent ? 0 : q;
+                  Q(p,m,qIndex,e,v) = w*(lam*invJ(m,q)*div +
+                                         0.5*mu_p*contraction);
                }
-               // lambda*div(u)*div(v) + 2*mu*sym(grad(u))*sym(grad(v))
-               // contraction = 4*sym(grad(u))sym(grad(v))
-               const int qIndex = isComponent ? 0 : q;
-               Q(p,m,qIndex,e) = w*(lamDev(p, e)*invJ(m,q)*div + 0.5*muDev(p, e)*contraction);
             }
          }
       }
    });
 
    // Reduce quadrature function to an E-Vector
-   const auto QRead = Reshape(QVec.Read(), numPoints, d, qSize, numEls);
+   const auto QRead = Reshape(QVec.Read(), numPoints, d, qSize, numEls, nvec);
    const auto G = Reshape(maps.G.Read(), numPoints, d, nDofs);
-   auto yDev = Reshape(y.ReadWrite(), nDofs, qSize, numEls);
+   auto yDev = Reshape(y.ReadWrite(), nDofs, qSize, numEls, nvec);
    mfem::forall_2D(numEls, qSize, nDofs, [=] MFEM_HOST_DEVICE (int e)
    {
       MFEM_FOREACH_THREAD(i, y, nDofs)
@@ -261,15 +284,18 @@ void ElasticityAddMultPA_(const int nDofs, const FiniteElementSpace &fespace,
          MFEM_FOREACH_THREAD(q, x, qSize)
          {
             const int qIndex = isComponent ? 0 : q;
-            real_t sum = 0.;
-            for (int m = 0; m < d; m++ )
+            for (int v = 0; v < nvec; v++)
             {
-               for (int p = 0; p < numPoints; p++ )
+               real_t sum = 0.;
+               for (int m = 0; m < d; m++ )
                {
-                  sum += QRead(p,m,qIndex,e)*G(p,m,i);
+                  for (int p = 0; p < numPoints; p++ )
+                  {
+                     sum += QRead(p,m,qIndex,e,v)*G(p,m,i);
+                  }
                }
+               yDev(i, qIndex, e, v) += sum;
             }
-            yDev(i, qIndex, e) += sum;
          }
       }
    });
@@ -70,6 +70,15 @@ void ElasticityIntegrator::AddMultPA(const Vector &x, Vector &y) const
                                  *geom, *maps, x, *q_vec, y);
 }
 
+void ElasticityIntegrator::AddMultPABatch(const Vector &x, Vector &y,
+                                          int nvec) const
+{
+   // Make room for the quadrature point values of all the vectors
+   if (q_vec->GetVDim() < nvec*vdim*vdim) { q_vec->SetVDim(nvec*vdim*vdim); }
+   internal::ElasticityAddMultPA(vdim, ndofs, *fespace, *lambda_quad, *mu_quad,
+                                 *geom, *maps, x, *q_vec, y, nvec);
+}
+
 void ElasticityIntegrator::AddMultTransposePA(const Vector &x, Vector &y) const
 {
    AddMultPA(x, y); // Operator is symmetric
@@ -14,6 +14,20 @@
 namespace mfem
 {
 
+namespace
+{
+// Register the kernels staging the data in registers, instead of shared
+// memory, as variants of the specialized apply kernels, see KernelTuner.
+template <int DIM, int D1D, int Q1D>
+void AddApplyVariant()
+{
+   MassIntegrator::ApplyPAKernels::AddVariant(
+      DIM, D1D, Q1D, "registers",
+      (DIM == 2) ? internal::PAMassApply2D<D1D,Q1D>
+      : internal::PAMassApply3D<D1D,Q1D>);
+}
+}
+
 MassIntegrator::Kernels::Kernels()
 {
    // 2D
@@ -36,6 +50,25 @@ MassIntegrator::Kernels::Kernels()
    MassIntegrator::AddSpecialization<3,6,7>();
    MassIntegrator::AddSpecialization<3,7,8>();
    MassIntegrator::AddSpecialization<3,8,9>();
+   // Variants of the apply kernels
+   AddApplyVariant<2,2,2>();
+   AddApplyVariant<2,3,3>();
+   AddApplyVariant<2,4,4>();
+   AddApplyVariant<2,5,5>();
+   AddApplyVariant<2,6,6>();
+   AddApplyVariant<2,7,7>();
+   AddApplyVariant<2,8,8>();
+   AddApplyVariant<2,9,9>();
+   AddApplyVariant<3,2,2>();
+   AddApplyVariant<3,2,3>();
+   AddApplyVariant<3,3,4>();
+   AddApplyVariant<3,4,5>();
+   AddApplyVariant<3,4,6>();
+   AddApplyVariant<3,5,6>();
+   AddApplyVariant<3,5,8>();
+   AddApplyVariant<3,6,7>();
+   AddApplyVariant<3,7,8>();
+   AddApplyVariant<3,8,9>();
 }
 
 namespace internal
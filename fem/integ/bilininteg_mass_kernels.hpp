@@ -18,6 +18,7 @@
 #include "../../linalg/dtensor.hpp"
 #include "../../linalg/vector.hpp"
 #include "../bilininteg.hpp"
+#include "../restriction.hpp"
 
 namespace mfem
 {
@@ -527,16 +528,22 @@ void PAMassApply2D_Element(const int e,
    }
 }
 
-template<int T_D1D, int T_Q1D, int T_NBZ, bool ACCUMULATE = true>
+// If the gather map of an ElementRestriction is given, x_ and y_ are
+// L-vectors: the element dofs are gathered from x_ and the result is
+// scatter-added to y_ (fused restriction), ignoring ACCUMULATE. The PA data d_
+// may be stored in a lower precision qd_t; the computations are done in real_t.
+template<int T_D1D, int T_Q1D, int T_NBZ, bool ACCUMULATE = true,
+         typename qd_t = real_t>
 MFEM_HOST_DEVICE inline
 void SmemPAMassApply2D_Element(const int e,
                                const int NE,
                                const real_t *b_,
-                               const real_t *d_,
+                               const qd_t *d_,
                                const real_t *x_,
                                real_t *y_,
                                int d1d = 0,
-                               int q1d = 0)
+                               int q1d = 0,
+                               const int *map = nullptr)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -547,7 +554,7 @@ void SmemPAMassApply2D_Element(const int e,
    constexpr int MDQ = (MQ1 > MD1) ? MQ1 : MD1;
 
    auto b = ConstDeviceMatrix(b_, Q1D, D1D);
-   auto D = ConstDeviceCube(d_, Q1D, Q1D, NE);
+   auto D = DeviceTensor<3,const qd_t>(d_, Q1D, Q1D, NE);
    auto x = ConstDeviceCube(x_, D1D, D1D, NE);
    auto Y = DeviceCube(y_, D1D, D1D, NE);
 
@@ -568,7 +575,8 @@ void SmemPAMassApply2D_Element(const int e,
    {
       MFEM_FOREACH_THREAD(dx,x,D1D)
       {
-         X[dy][dx] = x(dx,dy,e);
+         X[dy][dx] = map ? GatherLDof(map, x_, dx + D1D*(dy + D1D*e)) :
+                     x(dx,dy,e);
       }
    }
    if (tidz == 0)
@@ -641,7 +649,11 @@ void SmemPAMassApply2D_Element(const int e,
          {
             dd += (QD[qy][dx] * Bt[dy][qy]);
          }
-         if (ACCUMULATE)
+         if (map)
+         {
+            ScatterAddLDof(map, y_, dx + D1D*(dy + D1D*e), dd);
+         }
+         else if (ACCUMULATE)
          {
             Y(dx, dy, e) += dd;
          }
@@ -804,16 +816,19 @@ void PAMassApply3D_Element(const int e,
    }
 }
 
-template<int T_D1D, int T_Q1D, bool ACCUMULATE = true>
+// See SmemPAMassApply2D_Element() for the fused restriction with @a map and
+// the PA data type qd_t.
+template<int T_D1D, int T_Q1D, bool ACCUMULATE = true, typename qd_t = real_t>
 MFEM_HOST_DEVICE inline
 void SmemPAMassApply3D_Element(const int e,
                                const int NE,
                                const real_t *b_,
-                               const real_t *d_,
+                               const qd_t *d_,
                                const real_t *x_,
                                real_t *y_,
                                const int d1d = 0,
-                               const int q1d = 0)
+                               const int q1d = 0,
+                               const int *map = nullptr)
 {
    constexpr int D1D = T_D1D ? T_D1D : d1d;
    constexpr int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -822,7 +837,7 @@ void SmemPAMassApply3D_Element(const int e,
    constexpr int MDQ = (MQ1 > MD1) ? MQ1 : MD1;
 
    auto b = ConstDeviceMatrix(b_, Q1D, D1D);
-   auto d = DeviceTensor<4,const real_t>(d_, Q1D, Q1D, Q1D, NE);
+   auto d = DeviceTensor<4,const qd_t>(d_, Q1D, Q1D, Q1D, NE);
    auto x = DeviceTensor<4,const real_t>(x_, D1D, D1D, D1D, NE);
    auto y = DeviceTensor<4,real_t>(y_, D1D, D1D, D1D, NE);
 
@@ -844,7 +859,9 @@ void SmemPAMassApply3D_Element(const int e,
          MFEM_UNROLL(MD1)
          for (int dz = 0; dz < D1D; ++dz)
          {
-            X[dz][dy][dx] = x(dx,dy,dz,e);
+            X[dz][dy][dx] =
+               map ? GatherLDof(map, x_, dx + D1D*(dy + D1D*(dz + D1D*e))) :
+               x(dx,dy,dz,e);
          }
       }
       MFEM_FOREACH_THREAD(dx,x,Q1D)
@@ -1018,7 +1035,11 @@ void SmemPAMassApply3D_Element(const int e,
          MFEM_UNROLL(MD1)
          for (int dz = 0; dz < D1D; ++dz)
          {
-            if (ACCUMULATE)
+            if (map)
+            {
+               ScatterAddLDof(map, y_, dx + D1D*(dy + D1D*(dz + D1D*e)), u[dz]);
+            }
+            else if (ACCUMULATE)
             {
                y(dx,dy,dz,e) += u[dz];
             }
@@ -1143,6 +1164,72 @@ inline void SmemPAMassApply3D(const int NE,
    });
 }
 
+// Shared memory PA Mass Apply 2D kernel with fused element restriction: x_
+// and y_ are L-vectors and map is the gather map of the ElementRestriction.
+// If map is null, x_ and y_ are E-vectors. The PA data d_ is a device pointer.
+// x_ and y_ may hold nvec vectors stored one after another: the vectors are
+// processed inside the element loop, so the PA data and the basis of an
+// element are reused from cache.
+template<int T_D1D = 0, int T_Q1D = 0, typename qd_t = real_t>
+inline void SmemPAMassFusedApply2D(const int NE,
+                                   const Array<real_t> &b_,
+                                   const qd_t *d_,
+                                   const int *map,
+                                   const Vector &x_,
+                                   Vector &y_,
+                                   const int d1d = 0,
+                                   const int q1d = 0,
+                                   const int nvec = 1)
+{
+   static constexpr int T_NBZ = mass::NBZ(T_D1D);
+   static constexpr int NBZ = T_NBZ ? T_NBZ : 1;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const auto b = b_.Read();
+   const auto x = x_.Read();
+   auto Y = y_.ReadWrite();
+   const int x_stride = x_.Size() / nvec;
+   const int y_stride = y_.Size() / nvec;
+   mfem::forall_2D_batch(NE, Q1D, Q1D, NBZ, [=] MFEM_HOST_DEVICE (int e)
+   {
+      for (int vec = 0; vec < nvec; ++vec)
+      {
+         internal::SmemPAMassApply2D_Element<T_D1D,T_Q1D,T_NBZ>(
+            e, NE, b, d_, x + vec*x_stride, Y + vec*y_stride, d1d, q1d, map);
+         MFEM_SYNC_THREAD;
+      }
+   });
+}
+
+// Shared memory PA Mass Apply 3D kernel with fused element restriction, see
+// SmemPAMassFusedApply2D().
+template<int T_D1D = 0, int T_Q1D = 0, typename qd_t = real_t>
+inline void SmemPAMassFusedApply3D(const int NE,
+                                   const Array<real_t> &b_,
+                                   const qd_t *d_,
+                                   const int *map,
+                                   const Vector &x_,
+                                   Vector &y_,
+                                   const int d1d = 0,
+                                   const int q1d = 0,
+                                   const int nvec = 1)
+{
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   auto b = b_.Read();
+   auto x = x_.Read();
+   auto y = y_.ReadWrite();
+   const int x_stride = x_.Size() / nvec;
+   const int y_stride = y_.Size() / nvec;
+   mfem::forall_2D(NE, Q1D, Q1D, [=] MFEM_HOST_DEVICE (int e)
+   {
+      for (int vec = 0; vec < nvec; ++vec)
+      {
+         internal::SmemPAMassApply3D_Element<T_D1D,T_Q1D>(
+            e, NE, b, d_, x + vec*x_stride, y + vec*y_stride, d1d, q1d, map);
+         MFEM_SYNC_THREAD;
+      }
+   });
+}
+
 template<int T_D1D = 0, int T_Q1D = 0>
 inline void EAMassAssemble1D(const int NE,
                              const Array<real_t> &basis,
@@ -1386,6 +1473,8 @@ inline void EAMassAssemble3D(const int NE,
 namespace
 {
 using ApplyKernelType = MassIntegrator::ApplyKernelType;
+using ApplyFusedKernelType = MassIntegrator::ApplyFusedKernelType;
+using ApplyMixedKernelType = MassIntegrator::ApplyMixedKernelType;
 using DiagonalKernelType = MassIntegrator::DiagonalKernelType;
 }
 
@@ -1407,6 +1496,39 @@ inline ApplyKernelType MassIntegrator::ApplyPAKernels::Fallback(
    else { MFEM_ABORT(""); }
 }
 
+template<int DIM, int T_D1D, int T_Q1D>
+ApplyFusedKernelType MassIntegrator::ApplyFusedPAKernels::Kernel()
+{
+   if (DIM == 2) { return internal::SmemPAMassFusedApply2D<T_D1D,T_Q1D>; }
+   else if (DIM == 3) { return internal::SmemPAMassFusedApply3D<T_D1D,T_Q1D>; }
+   else { MFEM_ABORT(""); }
+}
+
+inline ApplyFusedKernelType MassIntegrator::ApplyFusedPAKernels::Fallback(
+   int DIM, int D1D, int Q1D)
+{
+   MFEM_ABORT("No fused PA mass kernel for DIM = " << DIM << ", D1D = " << D1D
+              << ", Q1D = " << Q1D);
+   return nullptr;
+}
+
+template<int DIM, int T_D1D, int T_Q1D>
+ApplyMixedKernelType MassIntegrator::ApplyMixedPAKernels::Kernel()
+{
+   using namespace internal;
+   if (DIM == 2) { return SmemPAMassFusedApply2D<T_D1D,T_Q1D,float>; }
+   else if (DIM == 3) { return SmemPAMassFusedApply3D<T_D1D,T_Q1D,float>; }
+   else { MFEM_ABORT(""); }
+}
+
+inline ApplyMixedKernelType MassIntegrator::ApplyMixedPAKernels::Fallback(
+   int DIM, int D1D, int Q1D)
+{
+   MFEM_ABORT("No mixed precision PA mass kernel for DIM = " << DIM
+              << ", D1D = " << D1D << ", Q1D = " << Q1D);
+   return nullptr;
+}
+
 template<int DIM, int T_D1D, int T_Q1D>
 DiagonalKernelType MassIntegrator::DiagonalPAKernels::Kernel()
 {
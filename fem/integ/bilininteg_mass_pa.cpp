@@ -13,6 +13,7 @@
 #include "../bilininteg.hpp"
 #include "../gridfunc.hpp"
 #include "../qfunction.hpp"
+#include "../qdata_cache.hpp"
 #include "../ceed/integrators/mass/mass.hpp"
 #include "bilininteg_mass_kernels.hpp"
 
@@ -51,12 +52,24 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    dim = mesh->Dimension();
    ne = fes.GetMesh()->GetNE();
    nq = ir->GetNPoints();
-   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::DETERMINANTS, mt);
    maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
    dofs1D = maps->ndof;
    quad1D = maps->nqpt;
    pa_data.SetSize(ne*nq, mt);
 
+   // Read the PA data from the on-disk cache, if enabled and available
+   mesh->EnsureNodes();
+   const std::string cache_key = QuadratureDataCache::GetKey(
+                                    "MassIntegrator", *mesh->GetNodes(), *ir, Q,
+                                    map_type);
+   if (QuadratureDataCache::Load(cache_key, {&pa_data}))
+   {
+      SetupSinglePrecisionPA();
+      return;
+   }
+
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::DETERMINANTS, mt);
+
    QuadratureSpace qs(*mesh, *ir);
    CoefficientVector coeff(Q, qs, CoefficientStorage::COMPRESSED);
 
@@ -79,6 +92,23 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
          v(i,e) =  W(i) * coeff * (by_val ? detJ : 1.0/detJ);
       }
    });
+   QuadratureDataCache::Save(cache_key, {&pa_data});
+   SetupSinglePrecisionPA();
+}
+
+void MassIntegrator::SetupSinglePrecisionPA()
+{
+   pa_data_sp.DeleteAll();
+   if (!pa_single || std::is_same<real_t, float>::value) { return; }
+#ifdef MFEM_USE_OCCA
+   if (DeviceCanUseOcca()) { return; }
+#endif
+   const auto &table = ApplyMixedPAKernels::GetDispatchTable();
+   if (table.find(std::make_tuple(dim, dofs1D, quad1D)) == table.end())
+   {
+      return;
+   }
+   ToSinglePrecision(pa_data, pa_data_sp);
 }
 
 void MassIntegrator::AssemblePABoundary(const FiniteElementSpace &fes)
@@ -161,6 +191,13 @@ void MassIntegrator::AssembleDiagonalPA(Vector &diag)
    {
       ceedOp->GetDiagonal(diag);
    }
+   else if (pa_data_sp.Size())
+   {
+      Vector pa_data_dp;
+      FromSinglePrecision(pa_data_sp, pa_data_dp);
+      DiagonalPAKernels::Run(dim, dofs1D, quad1D, ne, maps->B, pa_data_dp,
+                             diag, dofs1D, quad1D);
+   }
    else
    {
       DiagonalPAKernels::Run(dim, dofs1D, quad1D, ne, maps->B, pa_data,
@@ -174,6 +211,12 @@ void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
    {
       ceedOp->AddMult(x, y);
    }
+   else if (pa_data_sp.Size())
+   {
+      ApplyMixedPAKernels::Run(dim, dofs1D, quad1D, ne, maps->B,
+                               pa_data_sp.Read(), nullptr, x, y, dofs1D,
+                               quad1D, 1);
+   }
    else
    {
       const int D1D = dofs1D;
@@ -205,4 +248,65 @@ void MassIntegrator::AddMultTransposePA(const Vector &x, Vector &y) const
    AddMultPA(x, y);
 }
 
+bool MassIntegrator::SupportsFusedPA() const
+{
+   if (DeviceCanUseCeed()) { return false; }
+#ifdef MFEM_USE_OCCA
+   if (DeviceCanUseOcca()) { return false; }
+#endif
+   if (!fespace || fespace->GetVDim() != 1) { return false; }
+   if (pa_data.Size() == 0 && pa_data_sp.Size() == 0) { return false; }
+   // Domain integrator only, see AssemblePABoundary()
+   if (dim != fespace->GetMesh()->Dimension() || ne != fespace->GetNE())
+   {
+      return false;
+   }
+   if (dim != 2 && dim != 3) { return false; }
+   const auto &table = ApplyFusedPAKernels::GetDispatchTable();
+   return table.find(std::make_tuple(dim, dofs1D, quad1D)) != table.end();
+}
+
+void MassIntegrator::AddMultPAFused(const ElementRestriction &R,
+                                    const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(SupportsFusedPA(), "fused PA is not supported");
+   MFEM_ASSERT(R.GatherMap().Size() == ne*static_cast<int>(pow(dofs1D, dim)),
+               "incompatible element restriction");
+   const int *map = R.GatherMap().Read();
+   if (pa_data_sp.Size())
+   {
+      ApplyMixedPAKernels::Run(dim, dofs1D, quad1D, ne, maps->B,
+                               pa_data_sp.Read(), map, x, y, dofs1D, quad1D,
+                               1);
+   }
+   else
+   {
+      ApplyFusedPAKernels::Run(dim, dofs1D, quad1D, ne, maps->B,
+                               pa_data.Read(), map, x, y, dofs1D, quad1D, 1);
+   }
+}
+
+void MassIntegrator::AddMultPABatch(const Vector &x, Vector &y,
+                                    int nvec) const
+{
+   // The kernels with fused restriction also apply to E-vectors (null map)
+   if (!SupportsFusedPA())
+   {
+      BilinearFormIntegrator::AddMultPABatch(x, y, nvec);
+      return;
+   }
+   if (pa_data_sp.Size())
+   {
+      ApplyMixedPAKernels::Run(dim, dofs1D, quad1D, ne, maps->B,
+                               pa_data_sp.Read(), nullptr, x, y, dofs1D,
+                               quad1D, nvec);
+   }
+   else
+   {
+      ApplyFusedPAKernels::Run(dim, dofs1D, quad1D, ne, maps->B,
+                               pa_data.Read(), nullptr, x, y, dofs1D, quad1D,
+                               nvec);
+   }
+}
+
 } // namespace mfem
@@ -14,10 +14,14 @@
 
 #include "../config/config.hpp"
 #include "kernel_reporter.hpp"
+#include "kernel_tuner.hpp"
 #include <unordered_map>
 #include <tuple>
 #include <type_traits>
 #include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace mfem
 {
@@ -41,7 +45,9 @@ namespace mfem
 // functions depending on the parameters.
 //
 // Specialized functions can be registered using the static AddSpecialization
-// member function.
+// member function. Alternative implementations of a specialized kernel can be
+// registered with the AddVariant static member function of the dispatch table;
+// the fastest one is then selected at runtime when the KernelTuner is enabled.
 
 #define MFEM_EXPAND(X) X // Workaround needed for MSVC compiler
 
@@ -132,6 +138,12 @@ class KernelDispatchTable<Kernels,
          Signature, KernelDispatchKeyHash<Params...>>;
    TableType table;
 
+   using KeyHash = KernelDispatchKeyHash<Params...>;
+   using VariantList = std::vector<std::pair<std::string, Signature>>;
+   std::unordered_map<std::tuple<Params...>, VariantList, KeyHash> variants;
+   std::unordered_map<std::tuple<Params...>, KernelTuner::State, KeyHash>
+   tuning;
+
    /// @brief Call function @a f with arguments @a args (perfect forwaring).
    ///
    /// Only valid when the function @a f is not a member function.
@@ -154,12 +166,45 @@ class KernelDispatchTable<Kernels,
       (t.*f)(std::forward<Args>(args)...);
    }
 
+   /// @brief Run one of @a kernel and its @a variants, as selected by the
+   /// KernelTuner, timing the call while the selection is not final.
+   template<typename... Args>
+   static void RunTuned(const std::tuple<Params...> &key, Signature kernel,
+                        const VariantList &variants, Params... params,
+                        Args&&... args)
+   {
+      auto &tuning = Kernels::Get().tuning;
+      auto it = tuning.find(key);
+      if (it == tuning.end() || it->second.IsStale())
+      {
+         std::vector<std::string> names(1, "default");
+         for (const auto &v : variants) { names.push_back(v.first); }
+         const std::string entry = std::string(Kernels::Get().kernel_name) +
+                                   "<" + internal::Stringify(params...) + ">";
+         if (it != tuning.end()) { tuning.erase(it); }
+         it = tuning.emplace(key, KernelTuner::State(entry, names)).first;
+      }
+      KernelTuner::State &state = it->second;
+      const int v = state.Next();
+      const Signature f = (v == 0) ? kernel : variants[v - 1].second;
+      if (state.IsTuned())
+      {
+         Invoke(f, std::forward<Args>(args)...);
+         return;
+      }
+      const double t0 = KernelTuner::Time();
+      Invoke(f, std::forward<Args>(args)...);
+      state.Record(v, KernelTuner::Time() - t0);
+   }
+
 public:
    /// @brief Run the kernel with the given dispatch parameters and arguments.
    ///
    /// If a compile-time specialized version of the kernel with the given
    /// parameters has been registered, it will be called. Otherwise, the
-   /// fallback kernel will be called.
+   /// fallback kernel will be called. If variants of the specialized kernel
+   /// have been registered and the KernelTuner is enabled, the fastest variant
+   /// is called instead.
    ///
    /// If the kernel is a member function, then the first argument after @a
    /// params should be the object on which it is called.
@@ -171,6 +216,17 @@ public:
       const auto it = table.find(key);
       if (it != table.end())
       {
+         if (KernelTuner::IsEnabled())
+         {
+            const auto &variants = Kernels::Get().variants;
+            const auto v = variants.find(key);
+            if (v != variants.end())
+            {
+               RunTuned(key, it->second, v->second, params...,
+                        std::forward<Args>(args)...);
+               return;
+            }
+         }
          Invoke(it->second, std::forward<Args>(args)...);
       }
       else
@@ -204,6 +260,19 @@ public:
       };
    };
 
+   /// @brief Register the kernel @a kernel, identified by @a name, as a variant
+   /// of the specialized kernel with the given dispatch parameters.
+   ///
+   /// All variants must compute the same result. When the KernelTuner is
+   /// enabled, the fastest of the specialized kernel and its variants is
+   /// called by Run().
+   static void AddVariant(Params... params, const std::string &name,
+                          Signature kernel)
+   {
+      Kernels::Get().variants[std::make_tuple(params...)].emplace_back(
+         name, kernel);
+   }
+
    /// Return the dispatch map table
    static const TableType &GetDispatchTable()
    {
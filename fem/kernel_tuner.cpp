@@ -0,0 +1,122 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "kernel_tuner.hpp"
+#include "../general/backends.hpp"
+#include "../general/device.hpp"
+#include "../general/globals.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <limits>
+
+namespace mfem
+{
+
+KernelTuner::KernelTuner()
+{
+   const char *env = GetEnv("MFEM_KERNEL_TUNING");
+   if (env && std::string(env) != "NO")
+   {
+      enabled = true;
+      if (std::string(env) != "YES") { db_file = env; Load(); }
+   }
+}
+
+KernelTuner &KernelTuner::Instance()
+{
+   static KernelTuner instance;
+   return instance;
+}
+
+void KernelTuner::Enable(const std::string &db_file)
+{
+   KernelTuner &tuner = Instance();
+   tuner.enabled = true;
+   if (db_file != tuner.db_file)
+   {
+      tuner.db_file = db_file;
+      tuner.Load();
+   }
+}
+
+void KernelTuner::Reset()
+{
+   KernelTuner &tuner = Instance();
+   tuner.selections.clear();
+   tuner.generation++;
+}
+
+std::string KernelTuner::GetSelection(const std::string &entry)
+{
+   const auto &selections = Instance().selections;
+   const auto it = selections.find(entry);
+   return (it == selections.end()) ? std::string() : it->second;
+}
+
+double KernelTuner::Time()
+{
+   if (Device::Allows(Backend::DEVICE_MASK)) { MFEM_DEVICE_SYNC; }
+   using clock = std::chrono::steady_clock;
+   return std::chrono::duration<double>(
+             clock::now().time_since_epoch()).count();
+}
+
+// Every line of the database is "<variant>\t<entry>"; later lines take
+// precedence, so that the file can be appended to.
+void KernelTuner::Load()
+{
+   if (db_file.empty()) { return; }
+   std::ifstream in(db_file);
+   std::string line;
+   while (std::getline(in, line))
+   {
+      const size_t tab = line.find('\t');
+      if (tab == std::string::npos || tab == 0) { continue; }
+      selections[line.substr(tab + 1)] = line.substr(0, tab);
+   }
+   generation++;
+}
+
+void KernelTuner::Store(const std::string &entry, const std::string &variant)
+{
+   selections[entry] = variant;
+   if (db_file.empty()) { return; }
+   std::ofstream out(db_file, std::ios::app);
+   if (!out)
+   {
+      MFEM_WARNING("Unable to write kernel tuning database " << db_file);
+      return;
+   }
+   out << variant << '\t' << entry << '\n';
+}
+
+KernelTuner::State::State(const std::string &entry,
+                          const std::vector<std::string> &names)
+   : entry(entry), names(names),
+     best(names.size(), std::numeric_limits<double>::infinity()),
+     generation(Instance().generation)
+{
+   const std::string selected = GetSelection(entry);
+   const auto it = std::find(names.begin(), names.end(), selected);
+   if (it != names.end()) { winner = int(it - names.begin()); }
+}
+
+void KernelTuner::State::Record(int v, double t)
+{
+   best[v] = std::min(best[v], t);
+   if (++calls < int(names.size()) * Instance().trials) { return; }
+   winner = int(std::min_element(best.begin(), best.end()) - best.begin());
+   Instance().Store(entry, names[winner]);
+}
+
+} // namespace mfem
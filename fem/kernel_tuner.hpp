@@ -0,0 +1,114 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_KERNEL_TUNER_HPP
+#define MFEM_KERNEL_TUNER_HPP
+
+#include "../config/config.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mfem
+{
+
+/// @brief Singleton class selecting, by timing, the fastest of the registered
+/// variants of a specialized kernel (see KernelDispatchTable::AddVariant).
+///
+/// When tuning is enabled, the first calls of a kernel with given dispatch
+/// parameters cycle through its variants (the default specialization and the
+/// added variants), each call running exactly one of them, until every variant
+/// has been timed GetNumTrials() times. The variant with the smallest time is
+/// then used for all subsequent calls. Since all variants compute the same
+/// result, tuning does not change the output of the kernels, up to round-off.
+///
+/// The selected variants can be stored in a text database file, so that later
+/// runs on the same machine skip the tuning phase. Since the kernels are
+/// identified by their source location, the database is tied to a given build
+/// of MFEM.
+///
+/// @note Tuning is disabled by default. It is enabled if the environment
+/// variable MFEM_KERNEL_TUNING is set to a value other than 'NO', or if
+/// KernelTuner::Enable() is called. A value other than 'YES' is used as the
+/// name of the database file.
+class KernelTuner
+{
+public:
+   /// Tuning state of one kernel with given dispatch parameters.
+   class State
+   {
+      std::string entry;
+      std::vector<std::string> names;
+      std::vector<double> best;
+      int winner = -1, calls = 0, generation;
+   public:
+      /// Tuning state of kernel @a entry with the variants @a names, starting
+      /// from the variant stored in the database, if any.
+      State(const std::string &entry, const std::vector<std::string> &names);
+
+      /// Return true if the state was created before the last Reset().
+      bool IsStale() const { return generation != Instance().generation; }
+
+      /// Return true if the fastest variant has been selected.
+      bool IsTuned() const { return winner >= 0; }
+
+      /// Return the index of the variant to use for the next call.
+      int Next() const { return IsTuned() ? winner : calls % names.size(); }
+
+      /// Record the time @a t (in seconds) of a call to variant @a v.
+      void Record(int v, double t);
+
+      /// Return the name of the selected variant, or an empty string.
+      std::string GetWinner() const
+      { return IsTuned() ? names[winner] : std::string(); }
+   };
+
+   /// @brief Enable tuning. If @a db_file is not empty, previously selected
+   /// variants are loaded from, and new selections appended to, that file.
+   static void Enable(const std::string &db_file = "");
+
+   /// Disable tuning: the default specializations are used.
+   static void Disable() { Instance().enabled = false; }
+
+   /// Return true if tuning is enabled.
+   static bool IsEnabled() { return Instance().enabled; }
+
+   /// Set the number of timed calls of every variant before selection.
+   static void SetNumTrials(int trials) { Instance().trials = trials; }
+
+   /// Return the number of timed calls of every variant before selection.
+   static int GetNumTrials() { return Instance().trials; }
+
+   /// Forget all selections, in memory and loaded from the database.
+   static void Reset();
+
+   /// Return the variant selected for kernel @a entry, or an empty string.
+   static std::string GetSelection(const std::string &entry);
+
+   /// @brief Wait for the device and return a wall-clock time stamp, in
+   /// seconds. Used to time the kernel variants.
+   static double Time();
+
+private:
+   bool enabled = false;
+   int trials = 3, generation = 0;
+   std::string db_file;
+   std::map<std::string, std::string> selections;
+
+   KernelTuner();
+   static KernelTuner &Instance();
+   void Load();
+   void Store(const std::string &entry, const std::string &variant);
+};
+
+} // namespace mfem
+
+#endif
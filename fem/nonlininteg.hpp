@@ -44,6 +44,9 @@ protected:
 
    MemoryType pa_mt = MemoryType::DEFAULT;
 
+   /// Store the PA data in single precision, see SetPASinglePrecision().
+   bool pa_single = false;
+
    NonlinearFormIntegrator(const IntegrationRule *ir = NULL)
       : Integrator(ir), ceedOp(NULL) { }
 
@@ -58,6 +61,15 @@ public:
    /// in PA extensions.
    void SetPAMemoryType(MemoryType mt) { pa_mt = mt; }
 
+   /** @brief Request single precision storage of the quadrature point data in
+       PA extensions, with the action still computed in real_t precision.
+
+       This halves the memory footprint and traffic of the PA data, at the cost
+       of a relative perturbation of the operator of about 1e-7, which is
+       typically acceptable for preconditioners and smoothers. Integrators that
+       do not support it ignore the request. Must be set before AssemblePA(). */
+   void SetPASinglePrecision(bool single) { pa_single = single; }
+
 
    /// Perform the local action of the NonlinearFormIntegrator
    virtual void AssembleElementVector(const FiniteElement &el,
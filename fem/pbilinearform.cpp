@@ -217,6 +217,12 @@ HypreParMatrix *ParBilinearForm::ParallelAssemble(SparseMatrix *m)
    return Mh.As<HypreParMatrix>();
 }
 
+HypreParMatrix *ParBilinearForm::ParallelAssemble(const BSRMatrix &A_local)
+{
+   std::unique_ptr<SparseMatrix> m(A_local.ToSparseMatrix());
+   return ParallelAssemble(m.get());
+}
+
 void ParBilinearForm::AssembleSharedFaces(int skip_zeros)
 {
    ParMesh *pmesh = pfes->GetParMesh();
@@ -113,6 +113,11 @@ public:
    /** The returned matrix has to be deleted by the caller. */
    HypreParMatrix *ParallelAssemble(SparseMatrix *m);
 
+   /** @brief Return the block sparse matrix @a A_local, e.g. assembled with
+       AssembleBSR(), assembled on the true dofs, i.e. P^t A_local P. */
+   /** The returned matrix has to be deleted by the caller. */
+   HypreParMatrix *ParallelAssemble(const BSRMatrix &A_local);
+
    /** @brief Compute parallel RAP operator and store it in @a A as a HypreParMatrix.
 
        @param[in] loc_A The rank-local `SparseMatrix`.
@@ -149,11 +149,26 @@ void ParFiniteElementSpace::CommunicateGhostOrder()
                  "each mesh modification.");
    }
 
+   // Check whether the mesh was rebalanced.
+   const bool rebalanced = mesh->GetLastOperation() == Mesh::REBALANCE &&
+                           mesh->GetSequence() != mesh_sequence;
+   if (rebalanced && mesh->GetSequence() != mesh_sequence + 1)
+   {
+      MFEM_ABORT("Error in update sequence. Space needs to be updated after "
+                 "each mesh modification.");
+   }
+
    if (href)
    {
       // Update elems_pref and elem_orders
       FiniteElementSpace::UpdateElementOrders();
    }
+   else if (rebalanced)
+   {
+      // Note: the Allreduce below also ensures that all the messages have been
+      // received before RebalanceMatrix() reuses the communication pattern.
+      MigrateElementOrders();
+   }
 
    int local_orders_changed = orders_changed;
    int global_orders_changed = 0;
@@ -161,7 +176,7 @@ void ParFiniteElementSpace::CommunicateGhostOrder()
    MPI_Allreduce(&local_orders_changed, &global_orders_changed, 1, MPI_INT,
                  MPI_MAX, MyComm);
 
-   if ((global_orders_changed == 0 && !href) || NRanks == 1)
+   if ((global_orders_changed == 0 && !href && !rebalanced) || NRanks == 1)
    {
       return;
    }
@@ -178,6 +193,34 @@ void ParFiniteElementSpace::CommunicateGhostOrder()
    pncmesh->CommunicateGhostData(localOrders, ghost_orders);
 }
 
+void ParFiniteElementSpace::MigrateElementOrders()
+{
+   // Send the orders of the elements that changed owner in the last Rebalance
+   const int old_ne = elem_order.Size();
+   Array<int> old_orders(old_ne);
+   for (int i = 0; i < old_ne; i++) { old_orders[i] = elem_order[i]; }
+   pmesh->pncmesh->SendRebalanceValues(old_orders);
+
+   const Array<int> &old_index = pmesh->pncmesh->GetRebalanceOldIndex();
+   MFEM_VERIFY(old_index.Size() == pmesh->GetNE(), "internal error");
+
+   Array<char> new_order(pmesh->GetNE());
+   new_order = 0;
+   for (int i = 0; i < pmesh->GetNE(); i++)
+   {
+      if (old_index[i] >= 0) { new_order[i] = elem_order[old_index[i]]; }
+   }
+
+   Array<int> new_elements, orders;
+   pmesh->pncmesh->RecvRebalanceValues(new_elements, orders);
+   for (int i = 0; i < new_elements.Size(); i++)
+   {
+      new_order[new_elements[i]] = (char) orders[i];
+   }
+
+   mfem::Swap(elem_order, new_order);
+}
+
 void ParFiniteElementSpace::Construct()
 {
    if (NURBSext)
@@ -4368,15 +4411,165 @@ static int_type* make_j_array(int_type* I, int nrows)
    return J;
 }
 
+HypreParMatrix*
+ParFiniteElementSpace::ConformingRebalanceMatrix(int old_ndofs,
+                                                 const Table* old_elem_dof,
+                                                 const Table* old_elem_fos)
+{
+   const Array<int> &partition = pmesh->GetRebalancePartition();
+   MFEM_VERIFY(partition.Size() == old_elem_dof->Size(),
+               "Mesh::Rebalance was not called before "
+               "ParFiniteElementSpace::RebalanceMatrix");
+
+   HYPRE_BigInt old_offset = HYPRE_AssumedPartitionCheck()
+                             ? old_dof_offsets[0] : old_dof_offsets[MyRank];
+
+   // Send the old global DOFs of each element to its new rank, in the order of
+   // the elements, followed by the old face orientations (in 3D), which define
+   // the old DOF transformation. A negative DOF 'd' is sent as -1-d.
+   Array<int> send_cnt(NRanks), send_dsp(NRanks+1);
+   Array<int> recv_cnt(NRanks), recv_dsp(NRanks+1);
+   send_cnt = 0;
+   for (int i = 0; i < partition.Size(); i++)
+   {
+      send_cnt[partition[i]] += old_elem_dof->RowSize(i) * vdim +
+                                (old_elem_fos ? old_elem_fos->RowSize(i) : 0);
+   }
+   MPI_Alltoall(send_cnt.GetData(), 1, MPI_INT, recv_cnt.GetData(), 1, MPI_INT,
+                MyComm);
+   send_dsp[0] = recv_dsp[0] = 0;
+   for (int p = 0; p < NRanks; p++)
+   {
+      send_dsp[p+1] = send_dsp[p] + send_cnt[p];
+      recv_dsp[p+1] = recv_dsp[p] + recv_cnt[p];
+   }
+
+   Array<int> dofs, fo, pos;
+   send_dsp.Copy(pos);
+   Array<HYPRE_BigInt> send_buf(send_dsp[NRanks]);
+   for (int i = 0; i < partition.Size(); i++)
+   {
+      int &k = pos[partition[i]];
+      old_elem_dof->GetRow(i, dofs);
+      DofsToVDofs(dofs, old_ndofs);
+      for (int j = 0; j < dofs.Size(); j++)
+      {
+         const int col = dofs[j];
+         send_buf[k++] = (col >= 0) ? old_offset + col
+                         : -1 - (old_offset + (-1 - col));
+      }
+      if (old_elem_fos)
+      {
+         old_elem_fos->GetRow(i, fo);
+         for (int j = 0; j < fo.Size(); j++) { send_buf[k++] = fo[j]; }
+      }
+   }
+
+   Array<HYPRE_BigInt> recv_buf(recv_dsp[NRanks]);
+   MPI_Alltoallv(send_buf.GetData(), send_cnt.GetData(), send_dsp.GetData(),
+                 HYPRE_MPI_BIG_INT, recv_buf.GetData(), recv_cnt.GetData(),
+                 recv_dsp.GetData(), HYPRE_MPI_BIG_INT, MyComm);
+
+   // The elements were received in the order of their old ranks and local
+   // numbers, i.e. in the order of their data in 'recv_buf'. Each new DOF is
+   // set from the first element containing it: the old element values are
+   // mapped by the inverse of the old DOF transformation and the new one.
+   const int vsize = GetVSize();
+   Array<int> row_begin(vsize), row_size(vsize);
+   row_size = 0;
+   Array<HYPRE_BigInt> cols;
+   Array<real_t> vals;
+   DofTransformation doftrans, old_doftrans;
+   DenseMatrix T;
+   Vector t;
+   for (int i = 0, k = 0; i < pmesh->GetNE(); i++)
+   {
+      GetElementDofs(i, dofs, doftrans);
+      const int nd = dofs.Size();
+      MFEM_VERIFY(k + nd*vdim <= recv_buf.Size(), "internal error");
+      const HYPRE_BigInt *old_vdofs = &recv_buf[k];
+      k += nd*vdim;
+      if (elem_fos)
+      {
+         fo.SetSize(elem_fos->RowSize(i));
+         for (int j = 0; j < fo.Size(); j++) { fo[j] = (int) recv_buf[k++]; }
+      }
+
+      const bool identity = doftrans.IsIdentity();
+      if (!identity)
+      {
+         old_doftrans.SetDofTransformation(*doftrans.GetDofTransformation());
+         old_doftrans.SetFaceOrientations(fo);
+         T.SetSize(nd);
+         t.SetSize(nd);
+         for (int c = 0; c < nd; c++)
+         {
+            t = 0.0;
+            t(c) = 1.0;
+            old_doftrans.InvTransformPrimal(t);
+            doftrans.TransformPrimal(t);
+            T.SetCol(c, t);
+         }
+      }
+
+      for (int vd = 0; vd < vdim; vd++)
+      {
+         for (int j = 0; j < nd; j++)
+         {
+            int row = DofToVDof(dofs[j], vd);
+            real_t row_sign = 1.0;
+            if (row < 0) { row = -1 - row; row_sign = -1.0; }
+            if (row_size[row]) { continue; }
+
+            row_begin[row] = cols.Size();
+            for (int c = identity ? j : 0; c < (identity ? j+1 : nd); c++)
+            {
+               const real_t val = identity ? 1.0 : T(j, c);
+               if (val == 0.0) { continue; }
+               HYPRE_BigInt col = old_vdofs[c + vd*nd];
+               real_t sign = row_sign;
+               if (col < 0) { col = -1 - col; sign = -sign; }
+               cols.Append(col);
+               vals.Append(sign*val);
+               row_size[row]++;
+            }
+         }
+      }
+   }
+
+   Array<int> I(vsize + 1);
+   Array<HYPRE_BigInt> J(cols.Size());
+   Vector data(cols.Size());
+   I[0] = 0;
+   for (int row = 0; row < vsize; row++)
+   {
+      for (int c = 0; c < row_size[row]; c++)
+      {
+         J[I[row] + c] = cols[row_begin[row] + c];
+         data(I[row] + c) = vals[row_begin[row] + c];
+      }
+      I[row+1] = I[row] + row_size[row];
+   }
+
+   const int nrk = HYPRE_AssumedPartitionCheck() ? 2 : NRanks;
+   return new HypreParMatrix(MyComm, vsize, dof_offsets[nrk],
+                             old_dof_offsets[nrk], I.GetData(), J.GetData(),
+                             data.GetData(), dof_offsets, old_dof_offsets);
+}
+
 HypreParMatrix*
 ParFiniteElementSpace::RebalanceMatrix(int old_ndofs,
                                        const Table* old_elem_dof,
                                        const Table* old_elem_fos)
 {
-   MFEM_VERIFY(Nonconforming(), "Only supported for nonconforming meshes.");
    MFEM_VERIFY(old_dof_offsets.Size(), "ParFiniteElementSpace::Update needs to "
                "be called before ParFiniteElementSpace::RebalanceMatrix");
 
+   if (Conforming())
+   {
+      return ConformingRebalanceMatrix(old_ndofs, old_elem_dof, old_elem_fos);
+   }
+
    HYPRE_BigInt old_offset = HYPRE_AssumedPartitionCheck()
                              ? old_dof_offsets[0] : old_dof_offsets[MyRank];
 
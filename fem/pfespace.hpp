@@ -131,6 +131,9 @@ private:
    /// Set ghost_orders.
    void CommunicateGhostOrder();
 
+   /// Migrate the orders of the elements after ParMesh::Rebalance().
+   void MigrateElementOrders();
+
    /// Sets @a tdof2ldof. See documentation of @a tdof2ldof for details.
    void SetTDOF2LDOFinfo(int ntdofs, int vdim_factor, int dof_stride,
                          int allnedofs);
@@ -240,6 +243,14 @@ private:
                                    const Table* old_elem_dof,
                                    const Table* old_elem_fos);
 
+   /** The RebalanceMatrix() of a conforming mesh: the old DOFs and face
+       orientations of each element are sent to its new rank, see
+       ParMesh::GetRebalancePartition(). The DOF orientations (and the face DOF
+       transformations of ND spaces) of the old and new meshes can differ. */
+   HypreParMatrix* ConformingRebalanceMatrix(int old_ndofs,
+                                             const Table* old_elem_dof,
+                                             const Table* old_elem_fos);
+
    /** Calculate a GridFunction restriction matrix after mesh derefinement.
        The matrix is constructed so that the new grid function interpolates
        the original function, i.e., the original function is evaluated at the
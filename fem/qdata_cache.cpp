@@ -0,0 +1,204 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "qdata_cache.hpp"
+#include "coefficient.hpp"
+#include "gridfunc.hpp"
+#include "../general/hash.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+namespace mfem
+{
+
+namespace
+{
+
+constexpr char qdata_magic[8] = {'M','F','E','M','Q','D','0','1'};
+
+template <typename T>
+void Append(Hasher &hasher, const T *values, size_t n)
+{
+   hasher.append(reinterpret_cast<const uint8_t*>(values), n*sizeof(T));
+}
+
+template <typename T>
+void Append(Hasher &hasher, const T value) { Append(hasher, &value, 1); }
+
+void Append(Hasher &hasher, const std::string &s)
+{
+   Append(hasher, s.size());
+   Append(hasher, s.data(), s.size());
+}
+
+}
+
+QuadratureDataCache::QuadratureDataCache()
+{
+   const char *env = GetEnv("MFEM_QDATA_CACHE");
+   if (env && env[0] != '\0')
+   {
+      enabled = true;
+      dir = env;
+   }
+}
+
+QuadratureDataCache &QuadratureDataCache::Instance()
+{
+   static QuadratureDataCache instance;
+   return instance;
+}
+
+void QuadratureDataCache::Enable(const std::string &dir)
+{
+   Instance().enabled = true;
+   Instance().dir = dir;
+}
+
+bool QuadratureDataCache::CanHash(const Coefficient *Q)
+{
+   return Q == nullptr || dynamic_cast<const ConstantCoefficient*>(Q);
+}
+
+std::string QuadratureDataCache::GetKey(const std::string &kind,
+                                        const GridFunction &nodes,
+                                        const IntegrationRule &ir,
+                                        const Coefficient *Q, int flags)
+{
+   if (!IsEnabled() || !CanHash(Q)) { return std::string(); }
+
+   Hasher hasher;
+   hasher.init(0x5c0e8f9d2a7b4163ull);
+   Append(hasher, kind);
+   Append(hasher, int(sizeof(real_t)));
+   Append(hasher, flags);
+
+   // Nodes: finite element space, element-to-dof map and values
+   const FiniteElementSpace &fes = *nodes.FESpace();
+   const Mesh &mesh = *fes.GetMesh();
+   Append(hasher, std::string(fes.FEColl()->Name()));
+   Append(hasher, fes.GetVDim());
+   Append(hasher, int(fes.GetOrdering()));
+   Append(hasher, mesh.Dimension());
+   Append(hasher, mesh.SpaceDimension());
+   Append(hasher, mesh.GetNE());
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      Append(hasher, int(mesh.GetElementGeometry(i)));
+   }
+   const Table &e2d = fes.GetElementToDofTable();
+   Append(hasher, e2d.GetI(), e2d.Size() + 1);
+   Append(hasher, e2d.GetJ(), e2d.Size_of_connections());
+   Append(hasher, nodes.Size());
+   Append(hasher, nodes.HostRead(), nodes.Size());
+
+   // Integration rule
+   Append(hasher, ir.GetNPoints());
+   for (int i = 0; i < ir.GetNPoints(); i++)
+   {
+      const IntegrationPoint &ip = ir.IntPoint(i);
+      const real_t p[4] = {ip.x, ip.y, ip.z, ip.weight};
+      Append(hasher, p, 4);
+   }
+
+   // Coefficient
+   const auto *cQ = dynamic_cast<const ConstantCoefficient*>(Q);
+   Append(hasher, int(cQ != nullptr));
+   if (cQ) { Append(hasher, cQ->constant); }
+
+   hasher.finalize();
+   char key[33];
+   snprintf(key, sizeof(key), "%016llx%016llx",
+            (unsigned long long)hasher.data[0],
+            (unsigned long long)hasher.data[1]);
+   return key;
+}
+
+std::string QuadratureDataCache::FileName(const std::string &key)
+{
+   return Instance().dir + "/" + key + ".qdata";
+}
+
+// File layout: magic, number of vectors, sizeof(real_t), the size of every
+// vector, followed by the data of every vector.
+bool QuadratureDataCache::Load(const std::string &key,
+                               const std::vector<Vector*> &data)
+{
+   if (key.empty()) { return false; }
+   std::ifstream in(FileName(key), std::ios::binary);
+   if (!in) { return false; }
+
+   char magic[8];
+   uint64_t header[2];
+   in.read(magic, sizeof(magic));
+   in.read(reinterpret_cast<char*>(header), sizeof(header));
+   if (!in || !std::equal(magic, magic + 8, qdata_magic) ||
+       header[0] != data.size() || header[1] != sizeof(real_t))
+   {
+      return false;
+   }
+   for (const Vector *v : data)
+   {
+      uint64_t size;
+      in.read(reinterpret_cast<char*>(&size), sizeof(size));
+      if (!in || size != uint64_t(v->Size())) { return false; }
+   }
+   for (Vector *v : data)
+   {
+      in.read(reinterpret_cast<char*>(v->HostWrite()),
+              v->Size()*sizeof(real_t));
+   }
+   return bool(in);
+}
+
+void QuadratureDataCache::Save(const std::string &key,
+                               const std::vector<const Vector*> &data)
+{
+   if (key.empty()) { return; }
+   // Write to a temporary file first, so that concurrent readers (e.g. other
+   // MPI ranks with identical local meshes) never see a partial entry.
+   const std::string filename = FileName(key);
+   const std::string tmp =
+      filename + "." + std::to_string(std::random_device{}());
+   {
+      std::ofstream out(tmp, std::ios::binary);
+      const uint64_t header[2] = { data.size(), sizeof(real_t) };
+      out.write(qdata_magic, sizeof(qdata_magic));
+      out.write(reinterpret_cast<const char*>(header), sizeof(header));
+      for (const Vector *v : data)
+      {
+         const uint64_t size = v->Size();
+         out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+      }
+      for (const Vector *v : data)
+      {
+         out.write(reinterpret_cast<const char*>(v->HostRead()),
+                   v->Size()*sizeof(real_t));
+      }
+      if (!out)
+      {
+         MFEM_WARNING("Unable to write quadrature data cache file " << tmp);
+         out.close();
+         std::remove(tmp.c_str());
+         return;
+      }
+   }
+   if (std::rename(tmp.c_str(), filename.c_str()) != 0)
+   {
+      std::remove(tmp.c_str());
+   }
+}
+
+} // namespace mfem
@@ -0,0 +1,90 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_QDATA_CACHE_HPP
+#define MFEM_QDATA_CACHE_HPP
+
+#include "../config/config.hpp"
+#include "../linalg/vector.hpp"
+#include <string>
+#include <vector>
+
+namespace mfem
+{
+
+class Coefficient;
+class GridFunction;
+class IntegrationRule;
+
+/** @brief Persistent on-disk cache of quadrature point data, such as the
+    GeometricFactors of a Mesh and the partial assembly data of the
+    DiffusionIntegrator and MassIntegrator.
+
+    Every cache entry is a file in the cache directory, named after a 128-bit
+    hash of all the inputs of the computation: the mesh nodes (values, finite
+    element space and element connectivity), the integration rule, an optional
+    coefficient and integer flags. When the inputs match a previous run, the
+    data is read from disk instead of being recomputed; otherwise it is
+    computed and saved. Entries with an unexpected size are ignored.
+
+    Only coefficients whose values can be hashed are supported, i.e. no
+    coefficient or a ConstantCoefficient. For other coefficients, GetKey()
+    returns an empty key and the data is always recomputed.
+
+    The cache is disabled by default. It is enabled with Enable() or by setting
+    the environment variable `MFEM_QDATA_CACHE` to the cache directory, which
+    must exist. In parallel, each rank caches the data of its local mesh, so
+    the directory can be shared by all ranks. */
+class QuadratureDataCache
+{
+public:
+   /// Enable the cache, storing the entries in the existing directory @a dir.
+   static void Enable(const std::string &dir);
+
+   /// Disable the cache.
+   static void Disable() { Instance().enabled = false; }
+
+   /// Return true if the cache is enabled.
+   static bool IsEnabled() { return Instance().enabled; }
+
+   /// Return true if the values of @a Q can be included in a key.
+   static bool CanHash(const Coefficient *Q);
+
+   /** @brief Return the key of the data @a kind computed from the mesh @a nodes
+       at the points of @a ir, with coefficient @a Q and additional @a flags.
+
+       Returns an empty string if the cache is disabled or CanHash(Q) is
+       false. */
+   static std::string GetKey(const std::string &kind, const GridFunction &nodes,
+                             const IntegrationRule &ir,
+                             const Coefficient *Q = nullptr, int flags = 0);
+
+   /** @brief Read the entry @a key into the vectors @a data, which must have
+       the sizes used when the entry was saved. Returns false, leaving
+       @a data in an undefined state, if there is no such valid entry. */
+   static bool Load(const std::string &key, const std::vector<Vector*> &data);
+
+   /// Save the vectors @a data as the entry @a key.
+   static void Save(const std::string &key,
+                    const std::vector<const Vector*> &data);
+
+private:
+   bool enabled = false;
+   std::string dir;
+
+   QuadratureDataCache();
+   static QuadratureDataCache &Instance();
+   static std::string FileName(const std::string &key);
+};
+
+} // namespace mfem
+
+#endif
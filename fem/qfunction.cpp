@@ -13,6 +13,7 @@
 #include "quadinterpolator.hpp"
 #include "quadinterpolator_face.hpp"
 #include "../general/forall.hpp"
+#include "../general/binaryfile.hpp"
 #include "../mesh/pmesh.hpp"
 
 namespace mfem
@@ -47,6 +48,26 @@ QuadratureFunction::QuadratureFunction(Mesh *mesh, std::istream &in)
    Load(in, vdim*qspace->GetSize());
 }
 
+QuadratureFunction::QuadratureFunction(Mesh *mesh, const BinaryFile &file,
+                                       const std::string &name)
+   : QuadratureFunction()
+{
+   const char *msg = "invalid binary quadrature function ";
+   std::istringstream space(file.GetString(name + "/space"));
+   std::string ident;
+
+   qspace = new QuadratureSpace(mesh, space);
+   own_qspace = true;
+
+   space >> ident; MFEM_VERIFY(ident == "VDim:", msg << name);
+   space >> vdim;
+
+   uint64_t size;
+   real_t *values = file.GetEntry<real_t>(name + "/data", size);
+   MFEM_VERIFY(size == uint64_t(vdim)*qspace->GetSize(), msg << name);
+   NewDataAndSize(values, vdim*qspace->GetSize());
+}
+
 void QuadratureFunction::Save(std::ostream &os) const
 {
    GetSpace()->Save(os);
@@ -56,6 +77,16 @@ void QuadratureFunction::Save(std::ostream &os) const
    os.flush();
 }
 
+void QuadratureFunction::SaveBinary(BinaryFileWriter &out,
+                                    const std::string &name) const
+{
+   std::ostringstream space;
+   GetSpace()->Save(space);
+   space << "VDim: " << vdim << '\n';
+   out.Write(name + "/space", space.str());
+   out.Write(name + "/data", HostRead(), Size());
+}
+
 void QuadratureFunction::ProjectGridFunction(const GridFunction &gf)
 {
    SetVDim(gf.VectorDim());
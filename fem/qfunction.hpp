@@ -71,6 +71,14 @@ public:
    /** The QuadratureFunction assumes ownership of the read QuadratureSpace. */
    QuadratureFunction(Mesh *mesh, std::istream &in);
 
+   /// Read a QuadratureFunction from the entries @a name of the binary file
+   /// @a file, written with SaveBinary().
+   /** The QuadratureFunction assumes ownership of the read QuadratureSpace.
+       The values are not copied: they refer to the memory-mapped data of
+       @a file, which must outlive the QuadratureFunction. */
+   QuadratureFunction(Mesh *mesh, const BinaryFile &file,
+                      const std::string &name = "qf");
+
    /// Get the vector dimension.
    int GetVDim() const { return vdim; }
 
@@ -179,6 +187,10 @@ public:
    /// Write the QuadratureFunction to the stream @a out.
    void Save(std::ostream &out) const;
 
+   /// Write the QuadratureFunction as the entries @a name of the binary file
+   /// @a out.
+   void SaveBinary(BinaryFileWriter &out, const std::string &name = "qf") const;
+
    /// @brief Write the QuadratureFunction to @a out in VTU (ParaView) format.
    ///
    /// The data will be uncompressed if @a compression_level is zero, or if the
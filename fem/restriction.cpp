@@ -108,6 +108,8 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
 
 void ElementRestriction::Mult(const Vector& x, Vector& y) const
 {
+   MFEM_PERF_SCOPE("ElementRestriction::Mult");
+
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -128,6 +130,98 @@ void ElementRestriction::Mult(const Vector& x, Vector& y) const
    });
 }
 
+void ElementRestriction::ArrayMult(const Array<const Vector *> &X,
+                                   Array<Vector *> &Y) const
+{
+   MFEM_PERF_SCOPE("ElementRestriction::ArrayMult");
+
+   MFEM_ASSERT(X.Size() == Y.Size(), "Number of columns mismatch!");
+   const int nvec = X.Size();
+   if (nvec == 0) { return; }
+   Array<const real_t *> x_ptrs(nvec);
+   Array<real_t *> y_ptrs(nvec);
+   for (int v = 0; v < nvec; ++v)
+   {
+      MFEM_ASSERT(X[v]->Size() == width && Y[v]->Size() == height,
+                  "invalid vector size");
+      x_ptrs[v] = X[v]->Read();
+      y_ptrs[v] = Y[v]->Write();
+   }
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int vd = vdim;
+   const int nl = ndofs;
+   const bool t = byvdim;
+   auto d_x = x_ptrs.Read();
+   auto d_y = y_ptrs.Read();
+   auto d_gather_map = gather_map.Read();
+   mfem::forall(dof*ne, [=] MFEM_HOST_DEVICE (int i)
+   {
+      const int gid = d_gather_map[i];
+      const bool plus = gid >= 0;
+      const int j = plus ? gid : -1-gid;
+      for (int c = 0; c < vd; ++c)
+      {
+         const int l_idx = t ? c + vd*j : j + nl*c;
+         const int e_idx = i % nd + nd*(c + vd*(i / nd));
+         for (int v = 0; v < nvec; ++v)
+         {
+            const real_t dof_value = d_x[v][l_idx];
+            d_y[v][e_idx] = plus ? dof_value : -dof_value;
+         }
+      }
+   });
+}
+
+void ElementRestriction::ArrayMultTranspose(const Array<const Vector *> &X,
+                                            Array<Vector *> &Y) const
+{
+   MFEM_PERF_SCOPE("ElementRestriction::ArrayMultTranspose");
+
+   MFEM_ASSERT(X.Size() == Y.Size(), "Number of columns mismatch!");
+   const int nvec = X.Size();
+   if (nvec == 0) { return; }
+   Array<const real_t *> x_ptrs(nvec);
+   Array<real_t *> y_ptrs(nvec);
+   for (int v = 0; v < nvec; ++v)
+   {
+      MFEM_ASSERT(X[v]->Size() == height && Y[v]->Size() == width,
+                  "invalid vector size");
+      x_ptrs[v] = X[v]->Read();
+      y_ptrs[v] = Y[v]->Write();
+   }
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int vd = vdim;
+   const int nl = ndofs;
+   const bool t = byvdim;
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_x = x_ptrs.Read();
+   auto d_y = y_ptrs.Read();
+   mfem::forall(ndofs, [=] MFEM_HOST_DEVICE (int i)
+   {
+      const int offset = d_offsets[i];
+      const int next_offset = d_offsets[i + 1];
+      for (int c = 0; c < vd; ++c)
+      {
+         const int l_idx = t ? c + vd*i : i + nl*c;
+         for (int v = 0; v < nvec; ++v)
+         {
+            real_t dof_value = 0;
+            for (int j = offset; j < next_offset; ++j)
+            {
+               const int idx = d_indices[j];
+               const int idx_j = (idx >= 0) ? idx : -1 - idx;
+               const int e_idx = idx_j % nd + nd*(c + vd*(idx_j / nd));
+               dof_value += (idx >= 0) ? d_x[v][e_idx] : -d_x[v][e_idx];
+            }
+            d_y[v][l_idx] = dof_value;
+         }
+      }
+   });
+}
+
 void ElementRestriction::MultUnsigned(const Vector& x, Vector& y) const
 {
    // Assumes all elements have the same number of dofs
@@ -181,6 +275,8 @@ void ElementRestriction::TAddMultTranspose(const Vector& x, Vector& y) const
 
 void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
 {
+   MFEM_PERF_SCOPE("ElementRestriction::MultTranspose");
+
    constexpr bool ADD = false;
    TAddMultTranspose<ADD>(x, y);
 }
@@ -507,6 +603,8 @@ L2ElementRestriction::L2ElementRestriction(const FiniteElementSpace &fes)
 
 void L2ElementRestriction::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_SCOPE("L2ElementRestriction::Mult");
+
    const int nd = ndof;
    const int vd = vdim;
    const bool t = byvdim;
@@ -547,6 +645,8 @@ void L2ElementRestriction::TAddMultTranspose(const Vector &x, Vector &y) const
 
 void L2ElementRestriction::MultTranspose(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_SCOPE("L2ElementRestriction::MultTranspose");
+
    constexpr bool ADD = false;
    TAddMultTranspose<ADD>(x, y);
 }
@@ -655,6 +755,8 @@ ConformingFaceRestriction::ConformingFaceRestriction(
 
 void ConformingFaceRestriction::Mult(const Vector& x, Vector& y) const
 {
+   MFEM_PERF_SCOPE("ConformingFaceRestriction::Mult");
+
    if (nf==0) { return; }
    // Assumes all elements have the same number of dofs
    const int nface_dofs = face_dofs;
@@ -719,6 +821,8 @@ static void ConformingFaceRestriction_AddMultTranspose(
 void ConformingFaceRestriction::AddMultTranspose(
    const Vector& x, Vector& y, const real_t a) const
 {
+   MFEM_PERF_SCOPE("ConformingFaceRestriction::AddMultTranspose");
+
    ConformingFaceRestriction_AddMultTranspose(
       ndofs, face_dofs, nf, vdim, byvdim, gather_offsets, gather_indices, x, y,
       true, a);
@@ -1024,6 +1128,8 @@ void L2FaceRestriction::DoubleValuedConformingMult(const Vector& x,
 
 void L2FaceRestriction::Mult(const Vector& x, Vector& y) const
 {
+   MFEM_PERF_SCOPE("L2FaceRestriction::Mult");
+
    if (nf==0) { return; }
    if (m==L2FaceValues::DoubleValued)
    {
@@ -1099,6 +1205,8 @@ void L2FaceRestriction::DoubleValuedConformingAddMultTranspose(
 void L2FaceRestriction::AddMultTranspose(const Vector& x, Vector& y,
                                          const real_t a) const
 {
+   MFEM_PERF_SCOPE("L2FaceRestriction::AddMultTranspose");
+
    MFEM_VERIFY(a == 1.0, "General coefficient case is not yet supported!");
    if (nf==0) { return; }
    if (m == L2FaceValues::DoubleValued)
@@ -12,6 +12,7 @@
 #ifndef MFEM_RESTRICTION
 #define MFEM_RESTRICTION
 
+#include "../general/backends.hpp"
 #include "../linalg/operator.hpp"
 #include "../mesh/mesh.hpp"
 #include "normal_deriv_restriction.hpp"
@@ -58,6 +59,14 @@ public:
    void AddMultTranspose(const Vector &x, Vector &y,
                          const real_t a = 1.0) const override;
 
+   /// Mult() for multiple vectors, reading the gather map once for all of them.
+   void ArrayMult(const Array<const Vector *> &X,
+                  Array<Vector *> &Y) const override;
+   /// MultTranspose() for multiple vectors, reading the element-dof mappings
+   /// once for all of them.
+   void ArrayMultTranspose(const Array<const Vector *> &X,
+                           Array<Vector *> &Y) const override;
+
    /// Compute Mult without applying signs based on DOF orientations.
    void MultUnsigned(const Vector &x, Vector &y) const;
    /// Compute MultTranspose without applying signs based on DOF orientations.
@@ -98,6 +107,32 @@ public:
    ///@}
 };
 
+namespace internal
+{
+
+/** @brief Read the entry @a lid of the E-vector corresponding to the L-vector
+    @a x, using the (signed) gather map of an ElementRestriction with vdim 1,
+    see ElementRestriction::GatherMap(). */
+MFEM_HOST_DEVICE inline real_t GatherLDof(const int *map, const real_t *x,
+                                          const int lid)
+{
+   const int gid = map[lid];
+   return gid >= 0 ? x[gid] : -x[-1-gid];
+}
+
+/** @brief Add @a val, the entry @a lid of an E-vector, to the L-vector @a y,
+    i.e. the transpose of GatherLDof(). The addition is atomic, since L-vector
+    dofs are shared between elements. */
+MFEM_HOST_DEVICE inline void ScatterAddLDof(const int *map, real_t *y,
+                                            const int lid, const real_t val)
+{
+   const int gid = map[lid];
+   if (gid >= 0) { AtomicAdd(y[gid], val); }
+   else { AtomicAdd(y[-1-gid], -val); }
+}
+
+} // namespace internal
+
 /// Operator that converts L2 FiniteElementSpace L-vectors to E-vectors.
 /** Objects of this type are typically created and owned by FiniteElementSpace
     objects, see FiniteElementSpace::GetElementRestriction(). L-vectors
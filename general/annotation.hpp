@@ -27,10 +27,18 @@
 
 #else
 
-#define MFEM_PERF_FUNCTION
-#define MFEM_PERF_BEGIN(s)
-#define MFEM_PERF_END(s)
-#define MFEM_PERF_SCOPE(name)
+// Use the built-in profiler, see class Profiler in profiler.hpp. Note that
+// MFEM_PERF_FUNCTION names the region with the unqualified function name, so
+// class methods should use MFEM_PERF_SCOPE("Class::Method") instead.
+#include "profiler.hpp"
+#define MFEM_PERF_CONCAT_(a, b) a##b
+#define MFEM_PERF_CONCAT(a, b) MFEM_PERF_CONCAT_(a, b)
+#define MFEM_PERF_FUNCTION \
+  mfem::Profiler::Scope mfem_perf_function_scope(__func__)
+#define MFEM_PERF_BEGIN(s) mfem::Profiler::Begin(s)
+#define MFEM_PERF_END(s) mfem::Profiler::End(s)
+#define MFEM_PERF_SCOPE(name) \
+  mfem::Profiler::Scope MFEM_PERF_CONCAT(mfem_perf_scope_, __LINE__)(name)
 
 #endif
 
@@ -95,11 +95,13 @@ MFEM_HOST_DEVICE T AtomicAdd(T &add, const T val)
 #if ((defined(MFEM_USE_CUDA) && defined(__CUDA_ARCH__)) || \
      (defined(MFEM_USE_HIP)  && defined(__HIP_DEVICE_COMPILE__)))
    return atomicAdd(&add,val);
+#elif defined(MFEM_USE_OPENMP)
+   T old;
+   #pragma omp atomic capture
+   { old = add; add += val; }
+   return old;
 #else
    T old = add;
-#ifdef MFEM_USE_OPENMP
-   #pragma omp atomic
-#endif
    add += val;
    return old;
 #endif
@@ -0,0 +1,182 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "binaryfile.hpp"
+#include "binaryio.hpp"
+
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mfem
+{
+
+namespace
+{
+
+// Header: magic, version, endianness tag, sizeof(int), sizeof(real_t), offset
+// of the entry table and number of entries, padded to 'header_size' bytes.
+// Every entry of the table is {type, length of the name, offset, length} with
+// the name following, padded to a multiple of 8 bytes.
+constexpr char magic[8] = {'M','F','E','M','_','B','I','N'};
+constexpr uint32_t version = 1;
+constexpr uint32_t endian_tag = 0x01020304;
+constexpr uint64_t header_size = 64;
+constexpr uint64_t alignment = 64;
+
+void WritePadding(std::ostream &os, uint64_t &pos, uint64_t align)
+{
+   static const char zeros[alignment] = {};
+   const uint64_t pad = (align - pos % align) % align;
+   os.write(zeros, pad);
+   pos += pad;
+}
+
+}
+
+BinaryFileWriter::BinaryFileWriter(const std::string &filename)
+   : os(filename, std::ios::binary), pos(0)
+{
+   MFEM_VERIFY(os, "unable to create binary file " << filename);
+   // reserve the header, written by Close()
+   static const char zeros[header_size] = {};
+   os.write(zeros, header_size);
+   pos = header_size;
+}
+
+void BinaryFileWriter::Write(const std::string &name, binary_file::Type type,
+                             const void *data, uint64_t count, size_t size)
+{
+   MFEM_VERIFY(os.is_open(), "binary file already closed");
+   MFEM_VERIFY(entries.find(name) == entries.end(),
+               "duplicate binary file entry " << name);
+   WritePadding(os, pos, alignment);
+   entries[name] = { type, pos, count };
+   os.write(static_cast<const char*>(data), count*size);
+   pos += count*size;
+}
+
+void BinaryFileWriter::Close()
+{
+   if (!os.is_open()) { return; }
+   WritePadding(os, pos, 8);
+   const uint64_t table_offset = pos;
+   for (const auto &it : entries)
+   {
+      const std::string &name = it.first;
+      bin_io::write<uint32_t>(os, uint32_t(it.second.type));
+      bin_io::write<uint32_t>(os, uint32_t(name.size()));
+      bin_io::write<uint64_t>(os, it.second.offset);
+      bin_io::write<uint64_t>(os, it.second.count);
+      os.write(name.data(), name.size());
+      pos += 24 + name.size();
+      WritePadding(os, pos, 8);
+   }
+   os.seekp(0);
+   os.write(magic, sizeof(magic));
+   bin_io::write<uint32_t>(os, version);
+   bin_io::write<uint32_t>(os, endian_tag);
+   bin_io::write<uint32_t>(os, sizeof(int));
+   bin_io::write<uint32_t>(os, sizeof(real_t));
+   bin_io::write<uint64_t>(os, table_offset);
+   bin_io::write<uint64_t>(os, entries.size());
+   MFEM_VERIFY(os, "error writing binary file");
+   os.close();
+}
+
+BinaryFile::BinaryFile(const std::string &filename)
+{
+#ifndef _WIN32
+   const int fd = open(filename.c_str(), O_RDONLY);
+   MFEM_VERIFY(fd >= 0, "unable to open binary file " << filename);
+   struct stat st;
+   MFEM_VERIFY(fstat(fd, &st) == 0, "unable to stat binary file " << filename);
+   size = st.st_size;
+   if (size > 0)
+   {
+      void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                       fd, 0);
+      MFEM_VERIFY(ptr != MAP_FAILED, "unable to map binary file " << filename);
+      data = static_cast<char*>(ptr);
+      mapped = true;
+   }
+   close(fd);
+#else
+   std::ifstream is(filename, std::ios::binary | std::ios::ate);
+   MFEM_VERIFY(is, "unable to open binary file " << filename);
+   size = is.tellg();
+   is.seekg(0);
+   // allocate with 64-byte alignment, like the entries in the file
+   data = static_cast<char*>(operator new[](size, std::align_val_t(alignment)));
+   is.read(data, size);
+   MFEM_VERIFY(is, "unable to read binary file " << filename);
+#endif
+
+   const char *msg = "invalid binary file ";
+   MFEM_VERIFY(size >= header_size && std::memcmp(data, magic, 8) == 0,
+               msg << filename);
+   const char *h = data + sizeof(magic);
+   MFEM_VERIFY(bin_io::read<uint32_t>(h) == version,
+               "unsupported binary file version in " << filename);
+   MFEM_VERIFY(bin_io::read<uint32_t>(h + 4) == endian_tag,
+               "binary file " << filename << " has a different endianness");
+   MFEM_VERIFY(bin_io::read<uint32_t>(h + 8) == sizeof(int) &&
+               bin_io::read<uint32_t>(h + 12) == sizeof(real_t),
+               "binary file " << filename << " has different int or real_t"
+               " sizes");
+   uint64_t pos = bin_io::read<uint64_t>(h + 16);
+   const uint64_t num_entries = bin_io::read<uint64_t>(h + 24);
+   for (uint64_t i = 0; i < num_entries; i++)
+   {
+      MFEM_VERIFY(pos + 24 <= size, msg << filename);
+      Entry e;
+      e.type = binary_file::Type(bin_io::read<uint32_t>(data + pos));
+      const uint32_t name_size = bin_io::read<uint32_t>(data + pos + 4);
+      e.offset = bin_io::read<uint64_t>(data + pos + 8);
+      e.count = bin_io::read<uint64_t>(data + pos + 16);
+      const uint64_t entry_size = (e.type == binary_file::Type::INT) ?
+                                  sizeof(int) :
+                                  (e.type == binary_file::Type::REAL) ?
+                                  sizeof(real_t) : 1;
+      MFEM_VERIFY(pos + 24 + name_size <= size &&
+                  e.offset + e.count*entry_size <= size, msg << filename);
+      entries[std::string(data + pos + 24, name_size)] = e;
+      pos += 24 + name_size;
+      pos += (8 - pos % 8) % 8;
+   }
+}
+
+BinaryFile::~BinaryFile()
+{
+#ifndef _WIN32
+   if (mapped) { munmap(data, size); }
+#else
+   operator delete[](data, std::align_val_t(alignment));
+#endif
+}
+
+const BinaryFile::Entry &BinaryFile::Find(const std::string &name,
+                                          binary_file::Type type) const
+{
+   const auto it = entries.find(name);
+   MFEM_VERIFY(it != entries.end(), "binary file entry " << name
+               << " not found");
+   MFEM_VERIFY(it->second.type == type, "binary file entry " << name
+               << " has a different type");
+   return it->second;
+}
+
+} // namespace mfem
@@ -0,0 +1,138 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BINARYFILE_HPP
+#define MFEM_BINARYFILE_HPP
+
+#include "../config/config.hpp"
+#include "error.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mfem
+{
+
+/** @brief MFEM binary container file: a set of named arrays of integers, reals
+    or characters, used by the binary I/O of Mesh, GridFunction and
+    QuadratureFunction.
+
+    The file starts with a header containing a magic string, the format
+    version, an endianness tag and the sizes of int and real_t, followed by the
+    arrays, each aligned to 64 bytes, and a table with the name, type, offset
+    and length of every array. Files are written with BinaryFileWriter and read
+    with BinaryFile. */
+namespace binary_file
+{
+/// Type of the entries of a binary file.
+enum class Type : uint32_t { INT = 0, REAL = 1, CHAR = 2 };
+
+template <typename T> struct TypeOf;
+template <> struct TypeOf<int> { static constexpr Type value = Type::INT; };
+template <> struct TypeOf<real_t> { static constexpr Type value = Type::REAL; };
+template <> struct TypeOf<char> { static constexpr Type value = Type::CHAR; };
+}
+
+/// Writer of MFEM binary container files, see BinaryFile.
+class BinaryFileWriter
+{
+   struct Entry
+   {
+      binary_file::Type type;
+      uint64_t offset, count;
+   };
+   std::ofstream os;
+   std::map<std::string, Entry> entries;
+   uint64_t pos;
+
+   void Write(const std::string &name, binary_file::Type type,
+              const void *data, uint64_t count, size_t size);
+
+public:
+   /// Create the file @a filename.
+   explicit BinaryFileWriter(const std::string &filename);
+
+   /// Write the entry table and close the file, if not already done.
+   ~BinaryFileWriter() { Close(); }
+
+   /// Add the array @a data of length @a count as the entry @a name.
+   template <typename T>
+   void Write(const std::string &name, const T *data, uint64_t count)
+   { Write(name, binary_file::TypeOf<T>::value, data, count, sizeof(T)); }
+
+   /// Add the string @a str as the entry @a name.
+   void Write(const std::string &name, const std::string &str)
+   { Write(name, str.data(), str.size()); }
+
+   /// Write the entry table and close the file.
+   void Close();
+};
+
+/** @brief Read-only access to an MFEM binary container file, see
+    BinaryFileWriter.
+
+    On POSIX systems, the file is memory-mapped and GetEntry() returns pointers
+    into the mapping, so that arrays can be used as non-owning Array or Vector
+    data without copying: pages are read on first access. The mapping is
+    private, i.e. changes to the arrays are not written to the file. Objects
+    using the arrays must not outlive the BinaryFile. On other systems, the file
+    is read into memory. */
+class BinaryFile
+{
+   struct Entry
+   {
+      binary_file::Type type;
+      uint64_t offset, count;
+   };
+   char *data = nullptr;
+   uint64_t size = 0;
+   bool mapped = false;
+   std::map<std::string, Entry> entries;
+
+   const Entry &Find(const std::string &name, binary_file::Type type) const;
+
+public:
+   /// Open (map) the file @a filename.
+   explicit BinaryFile(const std::string &filename);
+
+   BinaryFile(const BinaryFile &) = delete;
+   BinaryFile &operator=(const BinaryFile &) = delete;
+
+   ~BinaryFile();
+
+   /// Return true if the file contains the entry @a name.
+   bool HasEntry(const std::string &name) const
+   { return entries.find(name) != entries.end(); }
+
+   /// Return the data of the entry @a name, of type @a T, and its length.
+   template <typename T>
+   T *GetEntry(const std::string &name, uint64_t &count) const
+   {
+      const Entry &e = Find(name, binary_file::TypeOf<T>::value);
+      count = e.count;
+      return reinterpret_cast<T*>(data + e.offset);
+   }
+
+   /// Return the entry @a name, of character type, as a string.
+   std::string GetString(const std::string &name) const
+   {
+      uint64_t count;
+      const char *str = GetEntry<char>(name, count);
+      return std::string(str, count);
+   }
+};
+
+} // namespace mfem
+
+#endif
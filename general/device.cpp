@@ -577,6 +577,12 @@ void Device::Setup(const std::string &device_option, const int device_id)
       }
    }
    if (Allows(Backend::DEBUG_DEVICE)) { ngpu = 1; }
+#ifndef MFEM_USE_CALIPER
+   if (device_option.find(":profile") != std::string::npos)
+   {
+      Profiler::Enable();
+   }
+#endif
 }
 
 MemoryType Device::QueryMemoryType(void *ptr)
@@ -214,6 +214,8 @@ public:
          and evaluation of operators and enables the 'hip' backend to avoid
          transfers between host and device.
        - The 'debug' backend should not be combined with other device backends.
+       - The option ':profile' can be appended to any backend name, e.g.
+         'cpu:profile', to enable the built-in Profiler.
 
        @note If the device is actually enabled, this method will also update the
        current host/device MemoryType and MemoryClass. */
@@ -26,6 +26,11 @@
 #include "array.hpp"
 #include "reducers.hpp"
 
+#include <memory>
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
 namespace mfem
 {
 
@@ -212,11 +217,16 @@ private:
 
 
 /// OpenMP backend
+/** The iterations are statically partitioned into contiguous ranges, one per
+    thread, so that kernels over the same index space (e.g. the elements of a
+    restriction, of a PA kernel and of the first write to its E-vector or
+    quadrature data) always access the same memory from the same thread. With
+    first-touch page placement, this keeps the data local on NUMA systems. */
 template <typename HBODY>
 void OmpWrap(const int N, HBODY &&h_body)
 {
 #ifdef MFEM_USE_OPENMP
-   #pragma omp parallel for
+   #pragma omp parallel for schedule(static)
    for (int k = 0; k < N; k++)
    {
       h_body(k);
@@ -1000,6 +1010,34 @@ void reduce(int N, T &res, B &&body, const R &reducer, bool use_dev,
    }
 #endif
 
+#ifdef MFEM_USE_OPENMP
+   if (use_dev && mfem::Device::Allows(Backend::OMP))
+   {
+      // Every thread reduces a contiguous range, as in OmpWrap(), and the
+      // partial results are joined in thread order, so the result does not
+      // depend on the scheduling for a given number of threads. The team may
+      // be smaller than requested (dynamic adjustment, nested regions), so
+      // the ranges are split by the actual team size.
+      const int max_nt = std::min(omp_get_max_threads(), N);
+      std::unique_ptr<T[]> partial(new T[max_nt]);
+      int nt = 1;
+      #pragma omp parallel num_threads(max_nt)
+      {
+         const int team = omp_get_num_threads();
+         const int tid = omp_get_thread_num();
+         if (tid == 0) { nt = team; }
+         const int begin = int((long long)N*tid/team);
+         const int end = int((long long)N*(tid+1)/team);
+         T local;
+         reducer.SetInitialValue(local);
+         for (int i = begin; i < end; ++i) { body(i, local); }
+         partial[tid] = local;
+      }
+      for (int t = 0; t < nt; ++t) { reducer.Join(res, partial[t]); }
+      return;
+   }
+#endif
+
    for (int i = 0; i < N; ++i)
    {
       body(i, res);
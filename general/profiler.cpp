@@ -0,0 +1,436 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "profiler.hpp"
+#include "error.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace mfem
+{
+
+bool Profiler::enabled = false;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct Region
+{
+   std::string name;
+   int parent;
+   std::vector<int> children;
+   long long calls = 0;
+   double inclusive = 0.0; // seconds
+   double nested = 0.0; // inclusive time of the child regions, in seconds
+
+   Region(const std::string &name_, int parent_)
+      : name(name_), parent(parent_) { }
+};
+
+struct TraceEvent
+{
+   int region;
+   double start, duration; // microseconds
+};
+
+struct ThreadData
+{
+   int tid;
+   std::vector<Region> regions; // regions[0] is the root
+   std::vector<int> stack;
+   std::vector<Clock::time_point> start;
+   std::vector<TraceEvent> events;
+
+   explicit ThreadData(int tid_) : tid(tid_) { regions.emplace_back("", -1); }
+};
+
+struct ProfilerState
+{
+   std::mutex mutex;
+   std::vector<std::unique_ptr<ThreadData>> threads;
+   bool trace = false;
+   const Clock::time_point epoch = Clock::now();
+   int rank = -1, nranks = 1;
+};
+
+ProfilerState &State()
+{
+   static ProfilerState state;
+   return state;
+}
+
+ThreadData &GetThreadData()
+{
+   thread_local ThreadData *td = nullptr;
+   if (!td)
+   {
+      ProfilerState &state = State();
+      std::lock_guard<std::mutex> lock(state.mutex);
+      state.threads.emplace_back(new ThreadData((int)state.threads.size()));
+      td = state.threads.back().get();
+   }
+   return *td;
+}
+
+void UpdateRank()
+{
+   ProfilerState &state = State();
+#ifdef MFEM_USE_MPI
+   int initialized, finalized;
+   MPI_Initialized(&initialized);
+   MPI_Finalized(&finalized);
+   if (initialized && !finalized)
+   {
+      MPI_Comm_rank(MPI_COMM_WORLD, &state.rank);
+      MPI_Comm_size(MPI_COMM_WORLD, &state.nranks);
+   }
+#else
+   state.rank = 0;
+#endif
+}
+
+// Merge the subtree of 'src' rooted at 'src_id' into the children of 'dst_id'.
+void MergeTree(std::vector<Region> &dst, int dst_id,
+               const std::vector<Region> &src, int src_id)
+{
+   for (int c : src[src_id].children)
+   {
+      const Region &r = src[c];
+      int id = -1;
+      for (int d : dst[dst_id].children)
+      {
+         if (dst[d].name == r.name) { id = d; break; }
+      }
+      if (id < 0)
+      {
+         id = (int)dst.size();
+         dst.emplace_back(r.name, dst_id);
+         dst[dst_id].children.push_back(id);
+      }
+      dst[id].calls += r.calls;
+      dst[id].inclusive += r.inclusive;
+      dst[id].nested += r.nested;
+      MergeTree(dst, id, src, c);
+   }
+}
+
+std::vector<Region> MergedTree()
+{
+   ProfilerState &state = State();
+   std::lock_guard<std::mutex> lock(state.mutex);
+   std::vector<Region> tree;
+   tree.emplace_back("", -1);
+   for (const auto &td : state.threads) { MergeTree(tree, 0, td->regions, 0); }
+   return tree;
+}
+
+struct FlatEntry
+{
+   long long calls = 0;
+   double inclusive = 0.0, exclusive = 0.0;
+};
+
+std::map<std::string, FlatEntry> FlatReport(const std::vector<Region> &tree)
+{
+   std::map<std::string, FlatEntry> flat;
+   for (size_t i = 1; i < tree.size(); i++)
+   {
+      FlatEntry &e = flat[tree[i].name];
+      e.calls += tree[i].calls;
+      e.inclusive += tree[i].inclusive;
+      e.exclusive += tree[i].inclusive - tree[i].nested;
+   }
+   return flat;
+}
+
+void PrintHeader(std::ostream &os)
+{
+   os << std::setw(12) << "Calls" << std::setw(16) << "Inclusive (s)"
+      << std::setw(16) << "Exclusive (s)" << "   Region\n";
+}
+
+void PrintTree(std::ostream &os, const std::vector<Region> &tree, int id,
+               int depth)
+{
+   for (int c : tree[id].children)
+   {
+      const Region &r = tree[c];
+      os << std::setw(12) << r.calls << std::setw(16) << r.inclusive
+         << std::setw(16) << r.inclusive - r.nested << "   "
+         << std::string(2*depth, ' ') << r.name << '\n';
+      PrintTree(os, tree, c, depth + 1);
+   }
+}
+
+std::string JSONEscape(const std::string &str)
+{
+   std::string esc;
+   for (char c : str)
+   {
+      if (c == '"' || c == '\\') { esc += '\\'; }
+      esc += c;
+   }
+   return esc;
+}
+
+// Support for the MFEM_PROFILE and MFEM_PROFILE_TRACE environment variables.
+struct ProfilerEnv
+{
+   ProfilerEnv()
+   {
+      if (!GetEnv("MFEM_PROFILE")) { return; }
+      // Construct the state first, so that it outlives the exit handler
+      State();
+      Profiler::Enable(true, GetEnv("MFEM_PROFILE_TRACE") != nullptr);
+      std::atexit(Finalize);
+   }
+
+   static void Finalize()
+   {
+      ProfilerState &state = State();
+      UpdateRank();
+      if (state.rank <= 0)
+      {
+         const bool flat = !std::strcmp(GetEnv("MFEM_PROFILE"), "flat");
+         Profiler::PrintReport(mfem::out,
+                               flat ? Profiler::FLAT : Profiler::TREE);
+      }
+      if (const char *trace_file = GetEnv("MFEM_PROFILE_TRACE"))
+      {
+         std::string filename(trace_file);
+         if (state.nranks > 1) { filename += "." + std::to_string(state.rank); }
+         Profiler::SaveTrace(filename, std::max(state.rank, 0));
+      }
+   }
+};
+
+ProfilerEnv profiler_env;
+
+} // anonymous namespace
+
+void Profiler::Enable(bool enable, bool trace)
+{
+   UpdateRank();
+   enabled = enable;
+   State().trace = enable && trace;
+}
+
+void Profiler::BeginRegion(const char *name)
+{
+   ThreadData &td = GetThreadData();
+   // The MPI rank is needed at exit, possibly after MPI has been finalized
+   if (td.stack.empty() && State().rank < 0) { UpdateRank(); }
+   const int parent = td.stack.empty() ? 0 : td.stack.back();
+   int id = -1;
+   for (int c : td.regions[parent].children)
+   {
+      if (td.regions[c].name == name) { id = c; break; }
+   }
+   if (id < 0)
+   {
+      id = (int)td.regions.size();
+      td.regions.emplace_back(name, parent);
+      td.regions[parent].children.push_back(id);
+   }
+   td.stack.push_back(id);
+   td.start.push_back(Clock::now());
+}
+
+void Profiler::EndRegion(const char *name)
+{
+   const Clock::time_point stop = Clock::now();
+   ThreadData &td = GetThreadData();
+   MFEM_VERIFY(!td.stack.empty(), "no active profiler region to end");
+   const int id = td.stack.back();
+   Region &r = td.regions[id];
+   MFEM_VERIFY(!name || r.name == name, "ending the profiler region '"
+               << name << "' inside of region '" << r.name << "'");
+
+   const Clock::time_point start = td.start.back();
+   const double dt = std::chrono::duration<double>(stop - start).count();
+   r.calls++;
+   r.inclusive += dt;
+   td.regions[r.parent].nested += dt;
+
+   ProfilerState &state = State();
+   if (state.trace)
+   {
+      const double t0 =
+         std::chrono::duration<double, std::micro>(start - state.epoch).count();
+      td.events.push_back({id, t0, 1e6*dt});
+   }
+   td.stack.pop_back();
+   td.start.pop_back();
+}
+
+void Profiler::Reset()
+{
+   ProfilerState &state = State();
+   std::lock_guard<std::mutex> lock(state.mutex);
+   for (auto &td : state.threads)
+   {
+      MFEM_VERIFY(td->stack.empty(), "cannot reset the profiler while the "
+                  "region '" << td->regions[td->stack.back()].name
+                  << "' is active");
+      td->regions.clear();
+      td->regions.emplace_back("", -1);
+      td->events.clear();
+   }
+}
+
+void Profiler::PrintReport(std::ostream &os, Format fmt)
+{
+   const std::vector<Region> tree = MergedTree();
+   std::ios::fmtflags flags = os.flags();
+   os << "MFEM profiler report, " << State().threads.size() << " thread(s)\n"
+      << std::fixed << std::setprecision(6);
+   PrintHeader(os);
+   if (fmt == TREE)
+   {
+      PrintTree(os, tree, 0, 0);
+   }
+   else
+   {
+      const std::map<std::string, FlatEntry> flat = FlatReport(tree);
+      std::vector<std::pair<std::string, FlatEntry>> sorted(flat.begin(),
+                                                            flat.end());
+      std::stable_sort(sorted.begin(), sorted.end(),
+                       [](const std::pair<std::string, FlatEntry> &a,
+                          const std::pair<std::string, FlatEntry> &b)
+      { return a.second.exclusive > b.second.exclusive; });
+      for (const auto &e : sorted)
+      {
+         os << std::setw(12) << e.second.calls
+            << std::setw(16) << e.second.inclusive
+            << std::setw(16) << e.second.exclusive << "   " << e.first << '\n';
+      }
+   }
+   os.flags(flags);
+   os << std::flush;
+}
+
+#ifdef MFEM_USE_MPI
+void Profiler::PrintReport(MPI_Comm comm, std::ostream &os)
+{
+   int rank, nranks;
+   MPI_Comm_rank(comm, &rank);
+   MPI_Comm_size(comm, &nranks);
+
+   // Serialize the local flat report as "name\n" strings and inclusive times
+   const std::map<std::string, FlatEntry> flat = FlatReport(MergedTree());
+   std::string names;
+   std::vector<double> times;
+   for (const auto &e : flat)
+   {
+      names += e.first + '\n';
+      times.push_back(e.second.inclusive);
+   }
+
+   int sizes[2] = { (int)names.size(), (int)times.size() };
+   std::vector<int> all_sizes(rank == 0 ? 2*nranks : 0);
+   MPI_Gather(sizes, 2, MPI_INT, all_sizes.data(), 2, MPI_INT, 0, comm);
+
+   std::vector<int> name_counts, name_displs, time_counts, time_displs;
+   if (rank == 0)
+   {
+      name_counts.resize(nranks); name_displs.resize(nranks + 1, 0);
+      time_counts.resize(nranks); time_displs.resize(nranks + 1, 0);
+      for (int p = 0; p < nranks; p++)
+      {
+         name_counts[p] = all_sizes[2*p];
+         time_counts[p] = all_sizes[2*p+1];
+         name_displs[p+1] = name_displs[p] + name_counts[p];
+         time_displs[p+1] = time_displs[p] + time_counts[p];
+      }
+   }
+   std::vector<char> all_names(rank == 0 ? name_displs[nranks] : 0);
+   std::vector<double> all_times(rank == 0 ? time_displs[nranks] : 0);
+   MPI_Gatherv(names.data(), sizes[0], MPI_CHAR, all_names.data(),
+               name_counts.data(), name_displs.data(), MPI_CHAR, 0, comm);
+   MPI_Gatherv(times.data(), sizes[1], MPI_DOUBLE, all_times.data(),
+               time_counts.data(), time_displs.data(), MPI_DOUBLE, 0, comm);
+   if (rank != 0) { return; }
+
+   struct Stats { double min, max, sum; int nranks; };
+   std::map<std::string, Stats> stats;
+   for (int p = 0; p < nranks; p++)
+   {
+      std::istringstream is(std::string(all_names.data() + name_displs[p],
+                                        name_counts[p]));
+      std::string name;
+      for (int i = 0; std::getline(is, name); i++)
+      {
+         const double t = all_times[time_displs[p] + i];
+         auto it = stats.find(name);
+         if (it == stats.end()) { stats[name] = {t, t, t, 1}; continue; }
+         Stats &s = it->second;
+         s.min = std::min(s.min, t);
+         s.max = std::max(s.max, t);
+         s.sum += t;
+         s.nranks++;
+      }
+   }
+
+   std::ios::fmtflags flags = os.flags();
+   os << "MFEM profiler report, inclusive times over " << nranks
+      << " rank(s)\n" << std::fixed << std::setprecision(6)
+      << std::setw(8) << "Ranks" << std::setw(14) << "Min (s)"
+      << std::setw(14) << "Max (s)" << std::setw(14) << "Avg (s)"
+      << "   Region\n";
+   for (const auto &e : stats)
+   {
+      const Stats &s = e.second;
+      os << std::setw(8) << s.nranks << std::setw(14) << s.min
+         << std::setw(14) << s.max << std::setw(14) << s.sum/s.nranks
+         << "   " << e.first << '\n';
+   }
+   os.flags(flags);
+   os << std::flush;
+}
+#endif
+
+void Profiler::SaveTrace(const std::string &filename, int pid)
+{
+   std::ofstream ofs(filename);
+   MFEM_VERIFY(ofs.good(), "cannot open the trace file " << filename);
+   ofs << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+
+   ProfilerState &state = State();
+   std::lock_guard<std::mutex> lock(state.mutex);
+   bool first = true;
+   for (const auto &td : state.threads)
+   {
+      for (const TraceEvent &ev : td->events)
+      {
+         ofs << (first ? "\n" : ",\n") << "{\"name\":\""
+             << JSONEscape(td->regions[ev.region].name)
+             << "\",\"ph\":\"X\",\"ts\":" << ev.start
+             << ",\"dur\":" << ev.duration << ",\"pid\":" << pid
+             << ",\"tid\":" << td->tid << '}';
+         first = false;
+      }
+   }
+   ofs << "\n]}\n";
+}
+
+} // namespace mfem
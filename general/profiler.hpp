@@ -0,0 +1,100 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_PROFILER_HPP
+#define MFEM_PROFILER_HPP
+
+#include "../config/config.hpp"
+#include "globals.hpp"
+#include <string>
+
+namespace mfem
+{
+
+/** @brief Lightweight built-in region profiler, used by the MFEM_PERF_*
+    macros (see annotation.hpp) when MFEM is not built with Caliper.
+
+    The profiler is disabled by default, in which case every region costs a
+    single branch. It can be enabled:
+    - with Enable(),
+    - with the device option ":profile", e.g. `Device device("cpu:profile")`,
+    - with the environment variable `MFEM_PROFILE`. In this case, the report of
+      the first MPI rank is printed to mfem::out at program exit: a flat report
+      if the variable is set to "flat", a tree report otherwise. If the
+      environment variable `MFEM_PROFILE_TRACE` is also set, a Chrome
+      trace-event file with that name is written at exit (with the MPI rank
+      appended in parallel runs).
+
+    Regions can be nested and each thread keeps its own tree of regions,
+    recording the number of calls and the inclusive and exclusive (excluding
+    nested regions) times. Reports merge the trees of all threads. */
+class Profiler
+{
+public:
+   /// Report format used by PrintReport().
+   enum Format { FLAT, TREE };
+
+   /// Enable or disable the profiler. If @a trace is true, every region call
+   /// is also recorded as an event for SaveTrace().
+   static void Enable(bool enable = true, bool trace = false);
+
+   /// Return true if the profiler is enabled.
+   static bool IsEnabled() { return enabled; }
+
+   /// Begin the region @a name, nested in the current region of the thread.
+   static void Begin(const char *name) { if (enabled) { BeginRegion(name); } }
+   static void Begin(const std::string &name) { Begin(name.c_str()); }
+
+   /// End the region @a name, which must be the current region of the thread.
+   static void End(const char *name) { if (enabled) { EndRegion(name); } }
+   static void End(const std::string &name) { End(name.c_str()); }
+
+   /// Clear all recorded timings and trace events.
+   static void Reset();
+
+   /// Print the timings of all regions, merged over all threads.
+   static void PrintReport(std::ostream &os = mfem::out, Format fmt = TREE);
+
+#ifdef MFEM_USE_MPI
+   /** @brief Print, on the root of @a comm, the minimum, maximum and average
+       over the ranks of @a comm of the inclusive time of every region, in flat
+       format. Collective on @a comm. */
+   static void PrintReport(MPI_Comm comm, std::ostream &os = mfem::out);
+#endif
+
+   /// Write the recorded trace events in the Chrome trace-event JSON format.
+   /** The file can be loaded in chrome://tracing or https://ui.perfetto.dev.
+       Requires the profiler to be enabled with @a trace = true. */
+   static void SaveTrace(const std::string &filename, int pid = 0);
+
+   /// RAII helper that begins a region on construction and ends it on
+   /// destruction.
+   class Scope
+   {
+      const bool active;
+   public:
+      explicit Scope(const char *name) : active(enabled)
+      { if (active) { BeginRegion(name); } }
+      explicit Scope(const std::string &name) : Scope(name.c_str()) { }
+      ~Scope() { if (active) { EndRegion(nullptr); } }
+   };
+
+private:
+   static MFEM_EXPORT bool enabled;
+
+   static void BeginRegion(const char *name);
+   /// End the current region; if @a name is not NULL, check that it matches.
+   static void EndRegion(const char *name);
+};
+
+}
+
+#endif
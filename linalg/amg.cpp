@@ -0,0 +1,433 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of the smoothed aggregation AMG preconditioner
+
+#include "amg.hpp"
+#include "solvers.hpp"
+#include "sparsesmoothers.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+namespace mfem
+{
+
+SmoothedAggregationAMG::SmoothedAggregationAMG(const SparseMatrix &A)
+   : Solver(A.Height())
+{
+   SetOperator(A);
+}
+
+void SmoothedAggregationAMG::Aggregate(Level &lev) const
+{
+   const SparseMatrix &A = *lev.A;
+   const int n = A.Height();
+   const int *I = A.HostReadI();
+   const int *J = A.HostReadJ();
+   const real_t *V = A.HostReadData();
+
+   Vector d(n);
+   d = 0.0;
+   for (int i = 0; i < n; i++)
+   {
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         if (J[k] == i) { d(i) += V[k]; }
+      }
+   }
+
+   // Pattern of the filtered matrix: the diagonal first, then the strong
+   // connections of the row. The strength of the connections is kept for the
+   // aggregation.
+   int *SI = Memory<int>(n+1);
+   SI[0] = 0;
+   Array<bool> strong(I[n]);
+   for (int i = 0; i < n; i++)
+   {
+      int count = 1;
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         const int j = J[k];
+         strong[k] = (j != i && V[k] != 0.0 &&
+                      std::abs(V[k]) >= theta*std::sqrt(std::abs(d(i)*d(j))));
+         if (strong[k]) { count++; }
+      }
+      SI[i+1] = SI[i] + count;
+   }
+   int *SJ = Memory<int>(SI[n]);
+   real_t *SV = Memory<real_t>(SI[n]);
+   Array<real_t> strength(SI[n]);
+   lev.filter_map.SetSize(I[n]);
+   for (int i = 0; i < n; i++)
+   {
+      int pos = SI[i];
+      SJ[pos] = i;
+      strength[pos] = 0.0;
+      pos++;
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         if (strong[k])
+         {
+            SJ[pos] = J[k];
+            strength[pos] = std::abs(V[k])/std::sqrt(std::abs(d(i)*d(J[k])));
+            lev.filter_map[k] = pos++;
+         }
+         else
+         {
+            // Weak connections are added to the diagonal, preserving the row
+            // sums of the matrix
+            lev.filter_map[k] = SI[i];
+         }
+      }
+   }
+   lev.S.reset(new SparseMatrix(SI, SJ, SV, n, n));
+
+   // Aggregation in three phases, see P. Vanek, J. Mandel and M. Brezina,
+   // "Algebraic multigrid by smoothed aggregation for second and fourth order
+   // elliptic problems", Computing 56 (1996). The value -2 marks the nodes
+   // not yet aggregated and -1 the isolated nodes, which are not aggregated.
+   Array<int> &agg = lev.aggregates;
+   agg.SetSize(n);
+   for (int i = 0; i < n; i++)
+   {
+      agg[i] = (SI[i+1] - SI[i] > 1) ? -2 : -1;
+   }
+   int na = 0;
+
+   // 1. Aggregate the nodes whose strong neighbors are all free, together
+   //    with their neighbors.
+   for (int i = 0; i < n; i++)
+   {
+      if (agg[i] != -2) { continue; }
+      bool free = true;
+      for (int k = SI[i] + 1; k < SI[i+1] && free; k++)
+      {
+         free = (agg[SJ[k]] == -2);
+      }
+      if (!free) { continue; }
+      agg[i] = na;
+      for (int k = SI[i] + 1; k < SI[i+1]; k++) { agg[SJ[k]] = na; }
+      na++;
+   }
+
+   // 2. Add the remaining nodes to the aggregate of their strongest neighbor
+   //    from the first phase.
+   Array<int> agg1(agg);
+   for (int i = 0; i < n; i++)
+   {
+      if (agg1[i] != -2) { continue; }
+      real_t max_strength = 0.0;
+      for (int k = SI[i] + 1; k < SI[i+1]; k++)
+      {
+         if (agg1[SJ[k]] >= 0 && strength[k] > max_strength)
+         {
+            max_strength = strength[k];
+            agg[i] = agg1[SJ[k]];
+         }
+      }
+   }
+
+   // 3. Aggregate the nodes that are left with their free neighbors.
+   for (int i = 0; i < n; i++)
+   {
+      if (agg[i] != -2) { continue; }
+      agg[i] = na;
+      for (int k = SI[i] + 1; k < SI[i+1]; k++)
+      {
+         if (agg[SJ[k]] == -2) { agg[SJ[k]] = na; }
+      }
+      na++;
+   }
+   lev.num_aggregates = na;
+}
+
+void SmoothedAggregationAMG::BuildTentativeProlongation(Level &lev) const
+{
+   const Array<int> &agg = lev.aggregates;
+   const int n = agg.Size(), na = lev.num_aggregates;
+
+   // Piecewise constant interpolation, with columns of unit norm
+   Array<int> agg_size(na);
+   agg_size = 0;
+   for (int i = 0; i < n; i++)
+   {
+      if (agg[i] >= 0) { agg_size[agg[i]]++; }
+   }
+   int *PI = Memory<int>(n+1);
+   PI[0] = 0;
+   for (int i = 0; i < n; i++) { PI[i+1] = PI[i] + (agg[i] >= 0); }
+   int *PJ = Memory<int>(PI[n]);
+   real_t *PV = Memory<real_t>(PI[n]);
+   for (int i = 0; i < n; i++)
+   {
+      if (agg[i] < 0) { continue; }
+      PJ[PI[i]] = agg[i];
+      PV[PI[i]] = 1.0/std::sqrt((real_t)agg_size[agg[i]]);
+   }
+   lev.P_tent.reset(new SparseMatrix(PI, PJ, PV, n, na));
+}
+
+void SmoothedAggregationAMG::BuildCoarseLevel(Level &lev, Level &coarse,
+                                              bool reuse) const
+{
+   const SparseMatrix &A = *lev.A;
+   const int n = A.Height();
+   const real_t *V = A.HostReadData();
+
+   // Filtered matrix A_F in the pattern of S
+   SparseMatrix &S = *lev.S;
+   const int *SI = S.HostReadI();
+   real_t *SV = S.HostReadWriteData();
+   std::fill(SV, SV + SI[n], 0.0);
+   for (int k = 0; k < lev.filter_map.Size(); k++)
+   {
+      SV[lev.filter_map[k]] += V[k];
+   }
+
+   // Damping omega = 4/(3 rho), with the Gershgorin bound of the spectral
+   // radius rho of D_F^{-1} A_F
+   real_t rho = 0.0;
+   for (int i = 0; i < n; i++)
+   {
+      const real_t d = SV[SI[i]];
+      if (d == 0.0) { continue; }
+      real_t row_sum = 0.0;
+      for (int k = SI[i]; k < SI[i+1]; k++) { row_sum += std::abs(SV[k]); }
+      rho = std::max(rho, row_sum/std::abs(d));
+   }
+   const real_t omega = (rho > 0.0) ? 4.0/(3.0*rho) : 0.0;
+
+   // S = I - omega D_F^{-1} A_F
+   for (int i = 0; i < n; i++)
+   {
+      const real_t d = SV[SI[i]];
+      const real_t s = (d != 0.0) ? -omega/d : 0.0;
+      for (int k = SI[i]; k < SI[i+1]; k++) { SV[k] *= s; }
+      SV[SI[i]] += 1.0;
+   }
+
+   // P = S P_tent, R = P^T, A_c = R (A P)
+   if (reuse)
+   {
+      mfem::Mult(S, *lev.P_tent, lev.P.get());
+      lev.R.reset(Transpose(*lev.P));
+      mfem::Mult(A, *lev.P, lev.AP.get());
+      mfem::Mult(*lev.R, *lev.AP, coarse.A_owned.get());
+   }
+   else
+   {
+      lev.P.reset(mfem::Mult(S, *lev.P_tent));
+      lev.R.reset(Transpose(*lev.P));
+      lev.AP.reset(mfem::Mult(A, *lev.P));
+      coarse.A_owned.reset(mfem::Mult(*lev.R, *lev.AP));
+   }
+   coarse.A = coarse.A_owned.get();
+}
+
+void SmoothedAggregationAMG::SetupSmoother(Level &lev) const
+{
+   const SparseMatrix &A = *lev.A;
+   switch (smoother_type)
+   {
+      case SmootherType::JACOBI:
+         lev.smoother.reset(new DSmoother(A, 1));
+         break;
+      case SmootherType::CHEBYSHEV:
+         A.GetDiag(lev.diag);
+         lev.smoother.reset(new OperatorChebyshevSmoother(A, lev.diag,
+                                                          no_ess_dofs,
+                                                          chebyshev_order));
+         break;
+   }
+   const int n = A.Height();
+   lev.b.SetSize(n);
+   lev.x.SetSize(n);
+   lev.r.SetSize(n);
+   lev.z.SetSize(n);
+}
+
+void SmoothedAggregationAMG::SetupCoarseSolver()
+{
+   Level &lev = levels.back();
+   const SparseMatrix &A = *lev.A;
+   lev.b.SetSize(A.Height());
+   lev.x.SetSize(A.Height());
+   lev.r.SetSize(A.Height());
+   switch (coarse_type)
+   {
+      case CoarseSolverType::DENSE:
+      {
+         A.ToDenseMatrix(coarse_dense);
+         coarse_solver.reset(new DenseMatrixInverse(coarse_dense));
+         break;
+      }
+#ifdef MFEM_USE_SUITESPARSE
+      case CoarseSolverType::UMFPACK:
+      {
+         UMFPackSolver *umf = new UMFPackSolver;
+         umf->SetOperator(A);
+         coarse_solver.reset(umf);
+         break;
+      }
+      case CoarseSolverType::KLU:
+      {
+         KLUSolver *klu = new KLUSolver;
+         klu->SetOperator(A);
+         coarse_solver.reset(klu);
+         break;
+      }
+#endif
+      default:
+         MFEM_ABORT("The coarse solver requires MFEM_USE_SUITESPARSE");
+   }
+}
+
+void SmoothedAggregationAMG::Setup(bool reuse)
+{
+   if (reuse)
+   {
+      for (size_t l = 0; l + 1 < levels.size(); l++)
+      {
+         BuildCoarseLevel(levels[l], levels[l+1], true);
+      }
+   }
+   else
+   {
+      const SparseMatrix *A = levels[0].A;
+      levels.clear();
+      levels.emplace_back();
+      levels[0].A = A;
+      for (int l = 0; l + 1 < max_levels; l++)
+      {
+         if (levels[l].A->Height() <= max_coarse_size) { break; }
+         Aggregate(levels[l]);
+         if (levels[l].num_aggregates == 0)
+         {
+            levels[l].S.reset();
+            break;
+         }
+         BuildTentativeProlongation(levels[l]);
+         levels.emplace_back();
+         BuildCoarseLevel(levels[l], levels[l+1], false);
+      }
+   }
+
+   for (size_t l = 0; l + 1 < levels.size(); l++)
+   {
+      SetupSmoother(levels[l]);
+   }
+   SetupCoarseSolver();
+
+   if (print_level > 0)
+   {
+      mfem::out << "SmoothedAggregationAMG hierarchy:\n"
+                << "   level        rows         nnz\n";
+      for (size_t l = 0; l < levels.size(); l++)
+      {
+         mfem::out << std::setw(8) << l
+                   << std::setw(12) << levels[l].A->Height()
+                   << std::setw(12) << levels[l].A->NumNonZeroElems() << '\n';
+      }
+      mfem::out << "   operator complexity: " << GetOperatorComplexity()
+                << std::endl;
+   }
+}
+
+void SmoothedAggregationAMG::SetOperator(const Operator &op)
+{
+   const SparseMatrix *A = dynamic_cast<const SparseMatrix *>(&op);
+   MFEM_VERIFY(A != NULL && A->Finalized(),
+               "SmoothedAggregationAMG requires a finalized SparseMatrix");
+   MFEM_VERIFY(A->Height() == A->Width(), "The matrix must be square");
+   height = width = A->Height();
+
+   const int n = A->Height(), nnz = A->NumNonZeroElems();
+   const int *I = A->HostReadI(), *J = A->HostReadJ();
+   const bool reuse = reuse_setup && !levels.empty() &&
+                      fine_I.Size() == n + 1 && fine_J.Size() == nnz &&
+                      std::equal(I, I + n + 1, fine_I.GetData()) &&
+                      std::equal(J, J + nnz, fine_J.GetData());
+   if (levels.empty()) { levels.emplace_back(); }
+   levels[0].A = A;
+   if (reuse_setup && !reuse)
+   {
+      fine_I.SetSize(n + 1);
+      fine_I.Assign(I);
+      fine_J.SetSize(nnz);
+      fine_J.Assign(J);
+   }
+   Setup(reuse);
+}
+
+void SmoothedAggregationAMG::Cycle(int l) const
+{
+   const Level &lev = levels[l];
+   if (l + 1 == (int)levels.size())
+   {
+      coarse_solver->Mult(lev.b, lev.x);
+      return;
+   }
+   const SparseMatrix &A = *lev.A;
+   const Level &coarse = levels[l+1];
+
+   // Smoothing step x += M (b - A x)
+   auto smooth = [&]()
+   {
+      A.Mult(lev.x, lev.r);
+      subtract(lev.b, lev.r, lev.r);
+      lev.smoother->Mult(lev.r, lev.z);
+      lev.x += lev.z;
+   };
+
+   // Pre-smoothing, starting from x = 0
+   lev.smoother->Mult(lev.b, lev.x);
+   for (int s = 1; s < smoother_sweeps; s++) { smooth(); }
+
+   // Coarse grid correction
+   A.Mult(lev.x, lev.r);
+   subtract(lev.b, lev.r, lev.r);
+   lev.R->Mult(lev.r, coarse.b);
+   Cycle(l + 1);
+   lev.P->AddMult(coarse.x, lev.x);
+
+   // Post-smoothing, with the same smoother for a symmetric cycle
+   for (int s = 0; s < smoother_sweeps; s++) { smooth(); }
+}
+
+void SmoothedAggregationAMG::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_VERIFY(!levels.empty(), "SetOperator() must be called first");
+   const Level &fine = levels[0];
+   if (iterative_mode)
+   {
+      fine.A->Mult(x, fine.r);
+      subtract(b, fine.r, fine.b);
+      Cycle(0);
+      x += fine.x;
+   }
+   else
+   {
+      fine.b = b;
+      Cycle(0);
+      x = fine.x;
+   }
+}
+
+real_t SmoothedAggregationAMG::GetOperatorComplexity() const
+{
+   if (levels.empty()) { return 0.0; }
+   real_t nnz = 0.0;
+   for (const Level &lev : levels) { nnz += lev.A->NumNonZeroElems(); }
+   return nnz/levels[0].A->NumNonZeroElems();
+}
+
+} // namespace mfem
@@ -0,0 +1,206 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_AMG
+#define MFEM_AMG
+
+#include "../config/config.hpp"
+#include "../general/array.hpp"
+#include "operator.hpp"
+#include "sparsemat.hpp"
+#include "densemat.hpp"
+#include <memory>
+#include <vector>
+
+namespace mfem
+{
+
+/** @brief Smoothed aggregation algebraic multigrid for a serial SparseMatrix.
+
+    A native multilevel preconditioner for symmetric positive definite
+    matrices, e.g. scalar elliptic problems and their low-order refined (LOR)
+    discretizations, which does not need hypre or MPI. Each application is one
+    V-cycle, which is a symmetric preconditioner for CGSolver.
+
+    The hierarchy is built as follows on every level:
+    - the strong connections are the off-diagonal entries with
+      |a_ij| >= theta sqrt(|a_ii a_jj|), see SetStrengthThreshold();
+    - the nodes are grouped into aggregates of strongly connected nodes, and
+      nodes without strong connections, e.g. eliminated essential dofs, are not
+      aggregated;
+    - the tentative prolongation interpolates the constant vector on each
+      aggregate, and is smoothed with one damped Jacobi step with the filtered
+      matrix (the weak connections are added to the diagonal);
+    - the coarse matrix is the Galerkin product R A P with R = P^T.
+
+    The coarsening stops at SetMaxCoarseSize() rows or SetMaxLevels() levels,
+    and the coarsest system is solved with a direct solver, see
+    SetCoarseSolver().
+
+    When SetOperator() is called with a matrix with the same sparsity pattern
+    as the previous one, only the values are recomputed: the aggregates and
+    the sparsity of the prolongations and coarse matrices are reused, see
+    SetReuseSetup(). */
+class SmoothedAggregationAMG : public Solver
+{
+public:
+   /// Smoothers of the V-cycle.
+   enum class SmootherType
+   {
+      /// l1-Jacobi, see DSmoother.
+      JACOBI,
+      /// Chebyshev with the Jacobi scaling, see OperatorChebyshevSmoother.
+      CHEBYSHEV
+   };
+
+   /// Direct solvers for the coarsest level.
+   enum class CoarseSolverType
+   {
+      /// Dense LU factorization, see DenseMatrixInverse.
+      DENSE,
+      /// UMFPackSolver, requires MFEM_USE_SUITESPARSE.
+      UMFPACK,
+      /// KLUSolver, requires MFEM_USE_SUITESPARSE.
+      KLU
+   };
+
+protected:
+   /// Data of one level of the hierarchy.
+   struct Level
+   {
+      /// Matrix of the level, owned by #A_owned except on the finest level.
+      const SparseMatrix *A = nullptr;
+      std::unique_ptr<SparseMatrix> A_owned;
+
+      /// Aggregate of each node, or -1 for the nodes that are not aggregated.
+      Array<int> aggregates;
+      int num_aggregates = 0;
+
+      /** Prolongation smoother I - omega D_F^{-1} A_F, with the pattern of the
+          filtered matrix A_F, and the position in its data of each entry of
+          #A (the weak entries go to the diagonal). */
+      std::unique_ptr<SparseMatrix> S;
+      Array<int> filter_map;
+
+      /// Tentative and smoothed prolongations, restriction and A*P.
+      std::unique_ptr<SparseMatrix> P_tent, P, R, AP;
+
+      Vector diag;
+      std::unique_ptr<Solver> smoother;
+
+      /// Right-hand side, solution, residual and correction of the V-cycle.
+      mutable Vector b, x, r, z;
+   };
+
+   std::vector<Level> levels;
+   std::unique_ptr<Operator> coarse_solver;
+   DenseMatrix coarse_dense;
+
+   real_t theta = 0.08;
+   int max_levels = 10;
+   int max_coarse_size = 200;
+   SmootherType smoother_type = SmootherType::JACOBI;
+   int smoother_sweeps = 1;
+   int chebyshev_order = 2;
+   CoarseSolverType coarse_type = CoarseSolverType::DENSE;
+   bool reuse_setup = true;
+   int print_level = 0;
+
+   /// Sparsity pattern of the finest matrix of the last setup.
+   Array<int> fine_I, fine_J;
+
+   /// No essential dofs for the Chebyshev smoothers.
+   Array<int> no_ess_dofs;
+
+   /// Compute the aggregates and the pattern of the filtered matrix.
+   void Aggregate(Level &lev) const;
+
+   /// Build the tentative prolongation of the aggregates of @a lev.
+   void BuildTentativeProlongation(Level &lev) const;
+
+   /** Compute the smoothed prolongation and the coarse matrix of @a lev. If
+       @a reuse is true, the existing sparsity patterns are reused. */
+   void BuildCoarseLevel(Level &lev, Level &coarse, bool reuse) const;
+
+   /// Create the smoother of @a lev.
+   void SetupSmoother(Level &lev) const;
+
+   /// Create the solver of the coarsest level.
+   void SetupCoarseSolver();
+
+   /// Build the hierarchy, reusing the patterns if @a reuse is true.
+   void Setup(bool reuse);
+
+   /// Apply a V-cycle on level @a l, solving for lev.x with rhs lev.b.
+   void Cycle(int l) const;
+
+public:
+   /// Create an "empty" AMG solver, SetOperator() must be called later.
+   SmoothedAggregationAMG() : Solver(0) { }
+
+   /// Create an AMG solver for the SparseMatrix @a A.
+   SmoothedAggregationAMG(const SparseMatrix &A);
+
+   /** @brief Set the threshold of the strong connections (default 0.08). With
+       @a theta_ = 0, all the nonzero entries are strong connections. */
+   void SetStrengthThreshold(real_t theta_) { theta = theta_; }
+
+   /// Set the maximum number of levels (default 10).
+   void SetMaxLevels(int max_levels_) { max_levels = max_levels_; }
+
+   /// Stop the coarsening when the size is at most @a size (default 200).
+   void SetMaxCoarseSize(int size) { max_coarse_size = size; }
+
+   /** @brief Set the smoother of the V-cycle and its number of pre- and
+       post-smoothing sweeps (default one l1-Jacobi sweep). With
+       SmootherType::CHEBYSHEV, @a order is the polynomial order. */
+   void SetSmoother(SmootherType type, int sweeps = 1, int order = 2)
+   { smoother_type = type; smoother_sweeps = sweeps; chebyshev_order = order; }
+
+   /// Set the direct solver of the coarsest level (default dense LU).
+   void SetCoarseSolver(CoarseSolverType type) { coarse_type = type; }
+
+   /** @brief Reuse the aggregates and the sparsity patterns of the hierarchy
+       when SetOperator() is called with a matrix with the same sparsity
+       (default true). The hierarchy is rebuilt from scratch otherwise. */
+   void SetReuseSetup(bool reuse) { reuse_setup = reuse; }
+
+   /// Print the hierarchy after the setup if @a print_lvl > 0.
+   void SetPrintLevel(int print_lvl) { print_level = print_lvl; }
+
+   /** @brief Set the matrix and build the hierarchy; @a op must be a finalized
+       SparseMatrix, which is referenced (not copied). */
+   void SetOperator(const Operator &op) override;
+
+   /// Apply one V-cycle with zero initial guess (or @a x in iterative_mode).
+   void Mult(const Vector &b, Vector &x) const override;
+
+   /// The V-cycle is symmetric, same as Mult().
+   void MultTranspose(const Vector &b, Vector &x) const override
+   { Mult(b, x); }
+
+   /// Return the number of levels of the hierarchy.
+   int GetNumLevels() const { return (int)levels.size(); }
+
+   /// Return the matrix of level @a l, with 0 the finest level.
+   const SparseMatrix &GetLevelMatrix(int l) const { return *levels[l].A; }
+
+   /// Return the prolongation from level @a l+1 to level @a l.
+   const SparseMatrix &GetProlongation(int l) const { return *levels[l].P; }
+
+   /** @brief Return the operator complexity, the number of nonzeros of all
+       the level matrices divided by the number of nonzeros of the finest. */
+   real_t GetOperatorComplexity() const;
+};
+
+} // namespace mfem
+
+#endif
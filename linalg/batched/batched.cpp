@@ -13,6 +13,7 @@
 #include "native.hpp"
 #include "gpu_blas.hpp"
 #include "magma.hpp"
+#include "simd.hpp"
 
 namespace mfem
 {
@@ -20,6 +21,7 @@ namespace mfem
 BatchedLinAlg::BatchedLinAlg()
 {
    backends[NATIVE].reset(new NativeBatchedLinAlg);
+   backends[SIMD].reset(new SIMDBatchedLinAlg);
 
    if (Device::Allows(mfem::Backend::CUDA_MASK | mfem::Backend::HIP_MASK))
    {
@@ -41,7 +43,7 @@ BatchedLinAlg::BatchedLinAlg()
    }
    else
    {
-      active_backend = NATIVE;
+      active_backend = SIMD;
    }
 }
 
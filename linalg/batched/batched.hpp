@@ -34,7 +34,8 @@ public:
    /// @brief Available backends for implementations of batched algorithms.
    ///
    /// The initially active backend will be the first available backend in this
-   /// order: MAGMA, GPU_BLAS, NATIVE.
+   /// order: MAGMA, GPU_BLAS, NATIVE. Without a GPU device, the SIMD backend
+   /// is initially active.
    enum Backend
    {
       /// @brief The standard MFEM backend, implemented using mfem::forall
@@ -45,6 +46,9 @@ public:
       GPU_BLAS,
       /// MAGMA backend, only available if MFEM is compiled with MAGMA support.
       MAGMA,
+      /// @brief CPU backend vectorized across the matrices of the batch, see
+      /// SIMDBatchedLinAlg. Always available.
+      SIMD,
       /// Counter for the number of backends.
       NUM_BACKENDS
    };
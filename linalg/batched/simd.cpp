@@ -0,0 +1,276 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../simd.hpp"
+#include "simd.hpp"
+#include "../dtensor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace mfem
+{
+
+namespace
+{
+
+/// The SIMD width, with at least 4 lanes to let the compiler vectorize.
+constexpr int simd_lanes =
+   (MFEM_SIMD_BYTES/sizeof(real_t) < 4) ? 4 : MFEM_SIMD_BYTES/sizeof(real_t);
+
+using simd_t = AutoSIMD<real_t, simd_lanes, simd_lanes*sizeof(real_t)>;
+
+/** Copy the (m x n) matrices of the group @a g of @a A, which has @a n_mat
+    matrices, to the interleaved array @a V of m*n SIMD vectors. The lanes
+    past the last matrix are set to @a fill times the identity. */
+void Interleave(const real_t *A, const int m, const int n, const int n_mat,
+                const int g, const real_t fill, simd_t *V)
+{
+   const int mn = m*n;
+   for (int l = 0; l < simd_lanes; l++)
+   {
+      const int e = g*simd_lanes + l;
+      if (e < n_mat)
+      {
+         const real_t *A_e = A + (size_t)e*mn;
+         for (int i = 0; i < mn; i++) { V[i][l] = A_e[i]; }
+      }
+      else
+      {
+         for (int i = 0; i < mn; i++) { V[i][l] = 0.0; }
+         for (int i = 0; i < std::min(m, n); i++) { V[i + i*m][l] = fill; }
+      }
+   }
+}
+
+/// Copy the interleaved array @a V back to the matrices of the group @a g.
+void Deinterleave(const simd_t *V, const int mn, const int n_mat, const int g,
+                  real_t *A)
+{
+   for (int l = 0; l < simd_lanes; l++)
+   {
+      const int e = g*simd_lanes + l;
+      if (e >= n_mat) { break; }
+      real_t *A_e = A + (size_t)e*mn;
+      for (int i = 0; i < mn; i++) { A_e[i] = V[i][l]; }
+   }
+}
+
+/** LU factorization with partial pivoting of the interleaved (m x m) matrices
+    @a V, with the algorithm of kernels::LUFactor() in each lane. The pivot of
+    row i of lane l is stored in ipiv[l + simd_lanes*i]. Return false if a
+    pivot is zero. */
+bool LUFactorLanes(simd_t *V, const int m, int *ipiv)
+{
+   bool pivot_flag = true;
+   for (int i = 0; i < m; i++)
+   {
+      // The pivots differ between the lanes
+      for (int l = 0; l < simd_lanes; l++)
+      {
+         int piv = i;
+         real_t a = std::fabs(V[i + m*i][l]);
+         for (int j = i + 1; j < m; j++)
+         {
+            const real_t b = std::fabs(V[j + m*i][l]);
+            if (b > a)
+            {
+               a = b;
+               piv = j;
+            }
+         }
+         ipiv[l + simd_lanes*i] = piv;
+         if (piv != i)
+         {
+            for (int j = 0; j < m; j++)
+            {
+               std::swap(V[i + m*j][l], V[piv + m*j][l]);
+            }
+         }
+         if (a == 0.0) { pivot_flag = false; }
+      }
+
+      simd_t a_ii_inv;
+      a_ii_inv = 1.0;
+      a_ii_inv /= V[i + m*i];
+      for (int j = i + 1; j < m; j++) { V[j + m*i] *= a_ii_inv; }
+      for (int k = i + 1; k < m; k++)
+      {
+         const simd_t a_ik = V[i + m*k];
+         for (int j = i + 1; j < m; j++) { V[j + m*k] -= a_ik*V[j + m*i]; }
+      }
+   }
+   return pivot_flag;
+}
+
+/// Solve with the interleaved LU factors of LUFactorLanes(), overwriting @a x.
+void LUSolveLanes(const simd_t *LU, const int m, const int *ipiv, simd_t *x)
+{
+   // x <- P x
+   for (int i = 0; i < m; i++)
+   {
+      for (int l = 0; l < simd_lanes; l++)
+      {
+         std::swap(x[i][l], x[ipiv[l + simd_lanes*i]][l]);
+      }
+   }
+   // x <- L^{-1} x
+   for (int j = 0; j < m; j++)
+   {
+      const simd_t x_j = x[j];
+      for (int i = j + 1; i < m; i++) { x[i] -= LU[i + j*m]*x_j; }
+   }
+   // x <- U^{-1} x
+   for (int j = m - 1; j >= 0; j--)
+   {
+      x[j] /= LU[j + j*m];
+      const simd_t x_j = x[j];
+      for (int i = 0; i < j; i++) { x[i] -= LU[i + j*m]*x_j; }
+   }
+}
+
+} // anonymous namespace
+
+const int SIMDBatchedLinAlg::lanes = simd_lanes;
+
+void SIMDBatchedLinAlg::Invert(DenseTensor &A) const
+{
+   const int m = A.SizeI();
+   const int n_mat = A.SizeK();
+   const int n_groups = (n_mat + simd_lanes - 1)/simd_lanes;
+   real_t *d_A = A.HostReadWrite();
+   int failed = 0;
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel reduction(+:failed)
+#endif
+   {
+      std::vector<simd_t> LU(m*m), inv(m*m);
+      std::vector<int> ipiv(simd_lanes*m);
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for
+#endif
+      for (int g = 0; g < n_groups; g++)
+      {
+         Interleave(d_A, m, m, n_mat, g, 1.0, LU.data());
+         if (!LUFactorLanes(LU.data(), m, ipiv.data())) { failed++; }
+         // Solve with the columns of the identity
+         for (int j = 0; j < m; j++)
+         {
+            simd_t *x = inv.data() + j*m;
+            for (int i = 0; i < m; i++) { x[i] = (i == j) ? 1.0 : 0.0; }
+            LUSolveLanes(LU.data(), m, ipiv.data(), x);
+         }
+         Deinterleave(inv.data(), m*m, n_mat, g, d_A);
+      }
+   }
+   MFEM_VERIFY(failed == 0, "Batch LU factorization failed");
+}
+
+void SIMDBatchedLinAlg::LUFactor(DenseTensor &A, Array<int> &P) const
+{
+   const int m = A.SizeI();
+   const int n_mat = A.SizeK();
+   const int n_groups = (n_mat + simd_lanes - 1)/simd_lanes;
+   P.SetSize(m*n_mat);
+   real_t *d_A = A.HostReadWrite();
+   int *d_P = P.HostWrite();
+   int failed = 0;
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel reduction(+:failed)
+#endif
+   {
+      std::vector<simd_t> LU(m*m);
+      std::vector<int> ipiv(simd_lanes*m);
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for
+#endif
+      for (int g = 0; g < n_groups; g++)
+      {
+         Interleave(d_A, m, m, n_mat, g, 1.0, LU.data());
+         if (!LUFactorLanes(LU.data(), m, ipiv.data())) { failed++; }
+         Deinterleave(LU.data(), m*m, n_mat, g, d_A);
+         for (int l = 0; l < simd_lanes; l++)
+         {
+            const int e = g*simd_lanes + l;
+            if (e >= n_mat) { break; }
+            for (int i = 0; i < m; i++)
+            {
+               d_P[i + (size_t)e*m] = ipiv[l + simd_lanes*i];
+            }
+         }
+      }
+   }
+   MFEM_VERIFY(failed == 0, "Batch LU factorization failed");
+}
+
+void SIMDBatchedLinAlg::LUSolve(const DenseTensor &LU, const Array<int> &P,
+                                Vector &x) const
+{
+   const int m = LU.SizeI();
+   const int n_mat = LU.SizeK();
+   const int n_rhs = x.Size() / m / n_mat;
+   // With few right-hand sides, the solves do not amortize the interleaving
+   // of the factors
+   if (n_rhs < simd_lanes) { return NativeBatchedLinAlg::LUSolve(LU, P, x); }
+   const int n_groups = (n_mat + simd_lanes - 1)/simd_lanes;
+   const real_t *d_LU = LU.HostRead();
+   const int *d_P = P.HostRead();
+   real_t *d_x = x.HostReadWrite();
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel
+#endif
+   {
+      std::vector<simd_t> V(m*m), xv(m);
+      std::vector<int> ipiv(simd_lanes*m);
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for
+#endif
+      for (int g = 0; g < n_groups; g++)
+      {
+         Interleave(d_LU, m, m, n_mat, g, 1.0, V.data());
+         for (int l = 0; l < simd_lanes; l++)
+         {
+            const int e = g*simd_lanes + l;
+            for (int i = 0; i < m; i++)
+            {
+               ipiv[l + simd_lanes*i] = (e < n_mat) ? d_P[i + (size_t)e*m] : i;
+            }
+         }
+         for (int r = 0; r < n_rhs; r++)
+         {
+            for (int l = 0; l < simd_lanes; l++)
+            {
+               const int e = g*simd_lanes + l;
+               if (e >= n_mat)
+               {
+                  for (int i = 0; i < m; i++) { xv[i][l] = 0.0; }
+                  continue;
+               }
+               const real_t *x_e = d_x + ((size_t)e*n_rhs + r)*m;
+               for (int i = 0; i < m; i++) { xv[i][l] = x_e[i]; }
+            }
+            LUSolveLanes(V.data(), m, ipiv.data(), xv.data());
+            for (int l = 0; l < simd_lanes; l++)
+            {
+               const int e = g*simd_lanes + l;
+               if (e >= n_mat) { break; }
+               real_t *x_e = d_x + ((size_t)e*n_rhs + r)*m;
+               for (int i = 0; i < m; i++) { x_e[i] = xv[i][l]; }
+            }
+         }
+      }
+   }
+}
+
+} // namespace mfem
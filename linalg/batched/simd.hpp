@@ -0,0 +1,52 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_SIMD_BATCHED_LINALG
+#define MFEM_SIMD_BATCHED_LINALG
+
+#include "native.hpp"
+
+namespace mfem
+{
+
+/** @brief CPU backend of BatchedLinAlg, vectorized across the matrices of the
+    batch.
+
+    The matrices are processed in groups of #lanes: each group is copied to an
+    interleaved layout, with the entry (i,j) of the matrices of the group in
+    one SIMD vector (AutoSIMD, see linalg/simd.hpp), and the LU factorization,
+    the inversion and the triangular solves are computed with SIMD operations,
+    one matrix per lane. This vectorizes the small matrices (e.g. the element
+    matrices of size 8 to 64) whose scalar loops are too short to vectorize.
+    The partial pivoting is done lane by lane, and the factors and pivots have
+    the same format as with NativeBatchedLinAlg.
+
+    The products, and the solves with less than #lanes right-hand sides, are
+    limited by the memory bandwidth and gain nothing from the interleaving:
+    they use the NativeBatchedLinAlg implementation.
+
+    The computations are done on the host, in parallel over the groups with
+    OpenMP threads when MFEM_USE_OPENMP is enabled. */
+class SIMDBatchedLinAlg : public NativeBatchedLinAlg
+{
+public:
+   /// Number of matrices processed together, one per SIMD lane.
+   static const int lanes;
+
+   void Invert(DenseTensor &A) const override;
+   void LUFactor(DenseTensor &A, Array<int> &P) const override;
+   void LUSolve(const DenseTensor &LU, const Array<int> &P,
+                Vector &x) const override;
+};
+
+} // namespace mfem
+
+#endif
@@ -0,0 +1,415 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "bsrmat.hpp"
+#include "sparsemat.hpp"
+#include "../general/forall.hpp"
+
+#include <algorithm>
+
+namespace mfem
+{
+
+namespace
+{
+
+// y += a A x for the block rows of the matrix, one block row per thread. The
+// component c of node i is at index i*n_stride + c*c_stride in x and y.
+template<int T_BS = 0>
+void BSRAddMult(const int nbr, const int bs, const Array<int> &I_,
+                const Array<int> &J_, const Array<real_t> &A_,
+                const Vector &x_, Vector &y_, const int xn_stride,
+                const int xc_stride, const int yn_stride, const int yc_stride,
+                const real_t a)
+{
+   const int BS = T_BS ? T_BS : bs;
+   const auto I = I_.Read();
+   const auto J = J_.Read();
+   const auto A = A_.Read();
+   const auto x = x_.Read();
+   auto y = y_.ReadWrite();
+   mfem::forall(nbr, [=] MFEM_HOST_DEVICE (int i)
+   {
+      if (T_BS)
+      {
+         // Fixed size: accumulate the block row in registers
+         real_t sum[T_BS ? T_BS : 1];
+         for (int c = 0; c < T_BS; c++) { sum[c] = 0.0; }
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            const int j = J[k];
+            const real_t *Ak = A + k*T_BS*T_BS;
+            for (int d = 0; d < T_BS; d++)
+            {
+               const real_t xd = x[j*xn_stride + d*xc_stride];
+               for (int c = 0; c < T_BS; c++) { sum[c] += Ak[c*T_BS + d]*xd; }
+            }
+         }
+         for (int c = 0; c < T_BS; c++)
+         {
+            y[i*yn_stride + c*yc_stride] += a*sum[c];
+         }
+      }
+      else
+      {
+         for (int c = 0; c < BS; c++)
+         {
+            real_t sum = 0.0;
+            for (int k = I[i]; k < I[i+1]; k++)
+            {
+               const int j = J[k];
+               const real_t *Akc = A + (k*BS + c)*BS;
+               for (int d = 0; d < BS; d++)
+               {
+                  sum += Akc[d]*x[j*xn_stride + d*xc_stride];
+               }
+            }
+            y[i*yn_stride + c*yc_stride] += a*sum;
+         }
+      }
+   });
+}
+
+}
+
+void BSRMatrix::InitSizes(int nbrows, int nbcols, int bs_, bool byvdim_)
+{
+   MFEM_VERIFY(bs_ > 0, "invalid block size: " << bs_);
+   bs = bs_;
+   nbr = nbrows;
+   nbc = nbcols;
+   byvdim = byvdim_;
+   height = nbr*bs;
+   width = nbc*bs;
+}
+
+BSRMatrix::BSRMatrix(const Table &pattern, int nbcols, int bs_, bool byvdim_)
+   : Operator(0)
+{
+   InitSizes(pattern.Size(), nbcols, bs_, byvdim_);
+   I.SetSize(nbr + 1);
+   I[0] = 0;
+   for (int i = 0; i < nbr; i++) { I[i+1] = I[i] + pattern.RowSize(i); }
+   J.SetSize(I[nbr]);
+   for (int i = 0; i < nbr; i++)
+   {
+      const int *row = pattern.GetRow(i);
+      std::copy(row, row + pattern.RowSize(i), J.GetData() + I[i]);
+      std::sort(J.GetData() + I[i], J.GetData() + I[i+1]);
+      MFEM_ASSERT(std::adjacent_find(J.GetData() + I[i],
+                                     J.GetData() + I[i+1]) ==
+                  J.GetData() + I[i+1], "repeated block in row " << i);
+   }
+   A.SetSize(J.Size()*bs*bs);
+   A = 0.0;
+}
+
+BSRMatrix::BSRMatrix(const SparseMatrix &mat, int bs_, bool byvdim_)
+   : Operator(0)
+{
+   MFEM_VERIFY(mat.Finalized(), "The matrix must be finalized.");
+   MFEM_VERIFY(mat.Height() % bs_ == 0 && mat.Width() % bs_ == 0,
+               "The matrix size is not divisible by the block size.");
+   InitSizes(mat.Height()/bs_, mat.Width()/bs_, bs_, byvdim_);
+   const int *mI = mat.HostReadI();
+   const int *mJ = mat.HostReadJ();
+   const real_t *mA = mat.HostReadData();
+
+   // Scalar index of component c of row node i, and node and component of a
+   // scalar column index
+   auto row = [&](int i, int c) { return byvdim ? c + bs*i : i + nbr*c; };
+   auto col_node = [&](int k) { return byvdim ? k/bs : k % nbc; };
+   auto col_comp = [&](int k) { return byvdim ? k % bs : k/nbc; };
+
+   // Block pattern: union of the columns of the scalar rows of a block row
+   Array<int> marker(nbc);
+   marker = -1;
+   I.SetSize(nbr + 1);
+   I[0] = 0;
+   for (int pass = 0; pass < 2; pass++)
+   {
+      for (int i = 0; i < nbr; i++)
+      {
+         int nnz = 0;
+         for (int c = 0; c < bs; c++)
+         {
+            const int r = row(i, c);
+            for (int k = mI[r]; k < mI[r+1]; k++)
+            {
+               const int j = col_node(mJ[k]);
+               if (marker[j] != i)
+               {
+                  marker[j] = i;
+                  if (pass == 1) { J[I[i] + nnz] = j; }
+                  nnz++;
+               }
+            }
+         }
+         if (pass == 0) { I[i+1] = I[i] + nnz; }
+         else { std::sort(J.GetData() + I[i], J.GetData() + I[i+1]); }
+      }
+      if (pass == 0)
+      {
+         J.SetSize(I[nbr]);
+         marker = -1;
+      }
+   }
+
+   A.SetSize(J.Size()*bs*bs);
+   A = 0.0;
+   for (int i = 0; i < nbr; i++)
+   {
+      for (int c = 0; c < bs; c++)
+      {
+         const int r = row(i, c);
+         for (int k = mI[r]; k < mI[r+1]; k++)
+         {
+            const int b = FindBlock(i, col_node(mJ[k]));
+            A[(b*bs + c)*bs + col_comp(mJ[k])] += mA[k];
+         }
+      }
+   }
+}
+
+int BSRMatrix::FindBlock(int i, int j) const
+{
+   const int *begin = J.GetData() + I[i], *end = J.GetData() + I[i+1];
+   const int *pos = std::lower_bound(begin, end, j);
+   return (pos != end && *pos == j) ? int(pos - J.GetData()) : -1;
+}
+
+real_t *BSRMatrix::GetBlock(int i, int j)
+{
+   const int k = FindBlock(i, j);
+   return (k < 0) ? nullptr : A.HostReadWrite() + k*bs*bs;
+}
+
+const real_t *BSRMatrix::GetBlock(int i, int j) const
+{
+   const int k = FindBlock(i, j);
+   return (k < 0) ? nullptr : A.HostRead() + k*bs*bs;
+}
+
+BSRMatrix &BSRMatrix::operator=(real_t a)
+{
+   A = a;
+   return *this;
+}
+
+void BSRMatrix::AddElementMatrix(const Array<int> &dofs,
+                                 const DenseMatrix &elmat)
+{
+   const int nd = dofs.Size();
+   MFEM_ASSERT(elmat.Height() == nd*bs && elmat.Width() == nd*bs,
+               "invalid element matrix size");
+   real_t *data = A.HostReadWrite();
+   for (int a = 0; a < nd; a++)
+   {
+      const int i = (dofs[a] >= 0) ? dofs[a] : -1-dofs[a];
+      const real_t sa = (dofs[a] >= 0) ? 1.0 : -1.0;
+      for (int b = 0; b < nd; b++)
+      {
+         const int j = (dofs[b] >= 0) ? dofs[b] : -1-dofs[b];
+         const real_t s = (dofs[b] >= 0) ? sa : -sa;
+         const int k = FindBlock(i, j);
+         MFEM_ASSERT(k >= 0, "block (" << i << ',' << j << ") is not in the "
+                     "sparsity pattern");
+         real_t *Ak = data + k*bs*bs;
+         for (int c = 0; c < bs; c++)
+         {
+            for (int d = 0; d < bs; d++)
+            {
+               Ak[c*bs + d] += s*elmat(a + nd*c, b + nd*d);
+            }
+         }
+      }
+   }
+}
+
+void BSRMatrix::Mult(const Vector &x, Vector &y) const
+{
+   y.UseDevice(true);
+   y = 0.0;
+   AddMult(x, y);
+}
+
+void BSRMatrix::AddMult(const Vector &x, Vector &y, const real_t a) const
+{
+   MFEM_ASSERT(x.Size() == width && y.Size() == height, "invalid sizes");
+   const int xn = byvdim ? bs : 1, xc = byvdim ? 1 : nbc;
+   const int yn = byvdim ? bs : 1, yc = byvdim ? 1 : nbr;
+   switch (bs)
+   {
+      case 1: BSRAddMult<1>(nbr, bs, I, J, A, x, y, xn, xc, yn, yc, a); break;
+      case 2: BSRAddMult<2>(nbr, bs, I, J, A, x, y, xn, xc, yn, yc, a); break;
+      case 3: BSRAddMult<3>(nbr, bs, I, J, A, x, y, xn, xc, yn, yc, a); break;
+      default: BSRAddMult(nbr, bs, I, J, A, x, y, xn, xc, yn, yc, a);
+   }
+}
+
+void BSRMatrix::MultTranspose(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMultTranspose(x, y);
+}
+
+void BSRMatrix::AddMultTranspose(const Vector &x, Vector &y,
+                                 const real_t a) const
+{
+   MFEM_ASSERT(x.Size() == height && y.Size() == width, "invalid sizes");
+   const int xn = byvdim ? bs : 1, xc = byvdim ? 1 : nbr;
+   const int yn = byvdim ? bs : 1, yc = byvdim ? 1 : nbc;
+   const int *Ip = I.HostRead(), *Jp = J.HostRead();
+   const real_t *Ap = A.HostRead();
+   const real_t *xp = x.HostRead();
+   real_t *yp = y.HostReadWrite();
+   for (int i = 0; i < nbr; i++)
+   {
+      for (int k = Ip[i]; k < Ip[i+1]; k++)
+      {
+         const int j = Jp[k];
+         const real_t *Ak = Ap + k*bs*bs;
+         for (int d = 0; d < bs; d++)
+         {
+            real_t sum = 0.0;
+            for (int c = 0; c < bs; c++)
+            {
+               sum += Ak[c*bs + d]*xp[i*xn + c*xc];
+            }
+            yp[j*yn + d*yc] += a*sum;
+         }
+      }
+   }
+}
+
+void BSRMatrix::AssembleDiagonal(Vector &diag) const
+{
+   MFEM_VERIFY(nbr == nbc, "the matrix must be square");
+   diag.SetSize(height);
+   const real_t *Ap = A.HostRead();
+   real_t *dp = diag.HostWrite();
+   for (int i = 0; i < nbr; i++)
+   {
+      const int k = FindBlock(i, i);
+      for (int c = 0; c < bs; c++)
+      {
+         dp[byvdim ? c + bs*i : i + nbr*c] = (k < 0) ? 0.0 :
+                                             Ap[(k*bs + c)*bs + c];
+      }
+   }
+}
+
+void BSRMatrix::GetDiagonalBlocks(DenseTensor &D) const
+{
+   MFEM_VERIFY(nbr == nbc, "the matrix must be square");
+   D.SetSize(bs, bs, nbr);
+   const real_t *Ap = A.HostRead();
+   real_t *Dp = D.HostWrite();
+   for (int i = 0; i < nbr; i++)
+   {
+      const int k = FindBlock(i, i);
+      real_t *Di = Dp + i*bs*bs;
+      for (int c = 0; c < bs; c++)
+      {
+         for (int d = 0; d < bs; d++)
+         {
+            // DenseTensor blocks are column-major
+            Di[c + bs*d] = (k < 0) ? 0.0 : Ap[(k*bs + c)*bs + d];
+         }
+      }
+   }
+}
+
+void BSRMatrix::EliminateBC(const Array<int> &ess_dofs,
+                            DiagonalPolicy diag_policy)
+{
+   MFEM_VERIFY(nbr == nbc, "the matrix must be square");
+   // Mark the eliminated components of each node
+   Array<bool> ess(height);
+   ess = false;
+   for (int k : ess_dofs) { ess[k] = true; }
+   auto is_ess = [&](int i, int c) { return ess[byvdim ? c + bs*i : i + nbr*c]; };
+
+   const int *Ip = I.HostRead(), *Jp = J.HostRead();
+   real_t *Ap = A.HostReadWrite();
+   for (int i = 0; i < nbr; i++)
+   {
+      for (int k = Ip[i]; k < Ip[i+1]; k++)
+      {
+         const int j = Jp[k];
+         real_t *Ak = Ap + k*bs*bs;
+         for (int c = 0; c < bs; c++)
+         {
+            for (int d = 0; d < bs; d++)
+            {
+               if (!is_ess(i, c) && !is_ess(j, d)) { continue; }
+               if (i == j && c == d)
+               {
+                  if (diag_policy == DIAG_ONE) { Ak[c*bs + d] = 1.0; }
+                  else if (diag_policy == DIAG_ZERO) { Ak[c*bs + d] = 0.0; }
+                  // else (diag_policy == DIAG_KEEP)
+               }
+               else
+               {
+                  Ak[c*bs + d] = 0.0;
+               }
+            }
+         }
+      }
+   }
+}
+
+SparseMatrix *BSRMatrix::ToSparseMatrix() const
+{
+   const int *Ip = I.HostRead(), *Jp = J.HostRead();
+   const real_t *Ap = A.HostRead();
+   int *mI = Memory<int>(height + 1);
+   int *mJ = Memory<int>(J.Size()*bs*bs);
+   real_t *mA = Memory<real_t>(J.Size()*bs*bs);
+   mI[0] = 0;
+   for (int i = 0; i < nbr; i++)
+   {
+      const int row_size = (Ip[i+1] - Ip[i])*bs;
+      for (int c = 0; c < bs; c++)
+      {
+         const int r = byvdim ? c + bs*i : i + nbr*c;
+         mI[r+1] = row_size;
+      }
+   }
+   for (int r = 0; r < height; r++) { mI[r+1] += mI[r]; }
+   // With byVDIM ordering, the columns of a row are sorted when the blocks are
+   // visited in order and the components inside each block; with byNODES
+   // ordering, when the components are the outer loop
+   for (int i = 0; i < nbr; i++)
+   {
+      for (int c = 0; c < bs; c++)
+      {
+         const int r = byvdim ? c + bs*i : i + nbr*c;
+         int pos = mI[r];
+         for (int outer = 0; outer < (byvdim ? 1 : bs); outer++)
+         {
+            for (int k = Ip[i]; k < Ip[i+1]; k++)
+            {
+               for (int inner = 0; inner < (byvdim ? bs : 1); inner++)
+               {
+                  const int d = byvdim ? inner : outer;
+                  mJ[pos] = byvdim ? d + bs*Jp[k] : Jp[k] + nbc*d;
+                  mA[pos] = Ap[(k*bs + c)*bs + d];
+                  pos++;
+               }
+            }
+         }
+      }
+   }
+   return new SparseMatrix(mI, mJ, mA, height, width, true, true, true);
+}
+
+} // namespace mfem
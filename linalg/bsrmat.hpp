@@ -0,0 +1,174 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BSRMAT
+#define MFEM_BSRMAT
+
+#include "../config/config.hpp"
+#include "../general/array.hpp"
+#include "../general/table.hpp"
+#include "operator.hpp"
+#include "densemat.hpp"
+
+namespace mfem
+{
+
+class SparseMatrix;
+
+/** @brief Sparse matrix in the block compressed sparse row (BSR) format, with
+    dense square blocks of a fixed size.
+
+    The matrix couples the vector components of pairs of nodes, e.g. the
+    scalar dofs of a vector FiniteElementSpace with vdim components: block
+    (i,j) is the bs x bs matrix of the entries with row (i,c) and column (j,d)
+    for the components c, d < bs. The block sparsity is stored once for all
+    the components, with one column index per block, and the blocks are stored
+    one after another, row-major. The products use small dense kernels for the
+    blocks, specialized for the block sizes 2 and 3.
+
+    The rows and columns of the matrix, as an Operator, are numbered as in a
+    vector FiniteElementSpace, with the components interleaved (byVDIM, index
+    c + bs*i) or stored one after another (byNODES, index i + n*c, where n is
+    the number of block rows or columns), see Ordering.
+
+    The matrix can be assembled directly with BilinearForm::AssembleBSR(), or
+    converted from a SparseMatrix. See ToSparseMatrix() and
+    ParBilinearForm::ParallelAssemble(const BSRMatrix &) for conversions to
+    SparseMatrix and HypreParMatrix. */
+class BSRMatrix : public Operator
+{
+protected:
+   /// Block size.
+   int bs;
+   /// Number of block rows and columns.
+   int nbr, nbc;
+   /// Ordering of the vector components, true for byVDIM.
+   bool byvdim;
+   /// Block sparsity pattern, with sorted column indices in each row.
+   Array<int> I, J;
+   /// Values of the blocks, bs*bs per block, row-major.
+   Array<real_t> A;
+
+   /// Return the position of block (i,j) in #J, or -1 if it is not stored.
+   int FindBlock(int i, int j) const;
+
+   /// Set the sizes of the Operator, see the constructors.
+   void InitSizes(int nbrows, int nbcols, int bs_, bool byvdim_);
+
+public:
+   /// Create an empty matrix.
+   BSRMatrix() : Operator(0), bs(1), nbr(0), nbc(0), byvdim(true) { }
+
+   /** @brief Create a matrix with @a nbrows block rows, @a nbcols block
+       columns and blocks of size @a bs_, with the block sparsity given by the
+       row-to-column connectivity @a pattern. All the blocks are set to zero.
+
+       The component ordering of the rows and columns is byVDIM if @a byvdim_
+       is true and byNODES otherwise. */
+   BSRMatrix(const Table &pattern, int nbcols, int bs_, bool byvdim_ = true);
+
+   /** @brief Convert the finalized SparseMatrix @a mat, whose rows and columns
+       are ordered byVDIM (if @a byvdim_ is true) or byNODES with @a bs_
+       components, to the BSR format. The size of @a mat must be divisible by
+       @a bs_. Entries missing in a stored block are set to zero. */
+   BSRMatrix(const SparseMatrix &mat, int bs_, bool byvdim_ = true);
+
+   /// Return the block size.
+   int BlockSize() const { return bs; }
+
+   /// Return the number of block rows.
+   int NumBlockRows() const { return nbr; }
+
+   /// Return the number of block columns.
+   int NumBlockCols() const { return nbc; }
+
+   /// Return the number of stored blocks.
+   int NumBlocks() const { return J.Size(); }
+
+   /// Return true if the components are interleaved (byVDIM ordering).
+   bool IsByVDim() const { return byvdim; }
+
+   /// Return the row offsets of the block sparsity pattern.
+   const Array<int> &GetBlockI() const { return I; }
+
+   /// Return the block column indices of the block sparsity pattern.
+   const Array<int> &GetBlockJ() const { return J; }
+
+   /// Return the block values, see GetBlock().
+   Array<real_t> &GetBlockData() { return A; }
+   /// Return the block values, see GetBlock().
+   const Array<real_t> &GetBlockData() const { return A; }
+
+   /** @brief Return a pointer to the values of block (i,j), stored row-major,
+       or NULL if the block is not stored. */
+   real_t *GetBlock(int i, int j);
+   /// Constant version of GetBlock().
+   const real_t *GetBlock(int i, int j) const;
+
+   /// Set all the values of the stored blocks to @a a.
+   BSRMatrix &operator=(real_t a);
+
+   /** @brief Add an element matrix of the vector space to the matrix.
+
+       The element matrix @a elmat couples the components of the nodes @a dofs
+       and is ordered byNODES locally, i.e. its size is bs*dofs.Size() and the
+       local index of component c of node k is k + dofs.Size()*c, as for the
+       element matrices of the vector integrators. Negative (signed) entries
+       -1-i of @a dofs refer to node i with a change of sign. All the blocks
+       coupling the nodes must be in the sparsity pattern. */
+   void AddElementMatrix(const Array<int> &dofs, const DenseMatrix &elmat);
+
+   /// Matrix vector multiplication, y = A x.
+   void Mult(const Vector &x, Vector &y) const override;
+
+   /// y += a A x
+   void AddMult(const Vector &x, Vector &y,
+                const real_t a = 1.0) const override;
+
+   /// Multiplication with the transposed matrix, y = A^T x. Host only.
+   void MultTranspose(const Vector &x, Vector &y) const override;
+
+   /// y += a A^T x. Host only.
+   void AddMultTranspose(const Vector &x, Vector &y,
+                         const real_t a = 1.0) const override;
+
+   /// Return the diagonal of the matrix, see Operator::AssembleDiagonal().
+   void AssembleDiagonal(Vector &diag) const override;
+
+   /** @brief Copy the diagonal blocks to @a D, of size bs x bs x nbr, e.g. for
+       block Jacobi smoothing with the inverses computed by BatchedLinAlg.
+       Missing diagonal blocks are set to zero. */
+   void GetDiagonalBlocks(DenseTensor &D) const;
+
+   /** @brief Eliminate the rows and columns of the essential (vector) dofs
+       @a ess_dofs, numbered in the ordering of the matrix, and set their
+       diagonal entries according to @a diag_policy, as in
+       SparseMatrix::EliminateBC(). The square matrix must store its diagonal
+       blocks. */
+   void EliminateBC(const Array<int> &ess_dofs,
+                    DiagonalPolicy diag_policy = DIAG_ONE);
+
+   /** @brief Return a new SparseMatrix with the entries of the stored blocks,
+       with the same row and column ordering. The column indices are sorted
+       and the explicit zeros of the blocks are kept. */
+   SparseMatrix *ToSparseMatrix() const;
+
+   /// Return the memory used by the matrix, in bytes.
+   std::size_t MemoryUsage() const
+   {
+      return (I.Capacity() + J.Capacity())*sizeof(int) +
+             A.Capacity()*sizeof(real_t);
+   }
+};
+
+} // namespace mfem
+
+#endif
@@ -18,6 +18,8 @@
 #include "operator.hpp"
 #include "matrix.hpp"
 #include "sparsemat.hpp"
+#include "sellmat.hpp"
+#include "bsrmat.hpp"
 #include "complex_operator.hpp"
 #include "complex_densemat.hpp"
 #include "blockvector.hpp"
@@ -28,6 +30,7 @@
 #include "symmat.hpp"
 #include "ode.hpp"
 #include "solvers.hpp"
+#include "amg.hpp"
 #include "handle.hpp"
 #include "invariants.hpp"
 #include "constraints.hpp"
@@ -15,6 +15,7 @@
 
 #include <iostream>
 #include <iomanip>
+#include <vector>
 
 namespace mfem
 {
@@ -508,6 +509,33 @@ TripleProductOperator::~TripleProductOperator()
 }
 
 
+void RAPOperator::ArrayMult(const Array<const Vector *> &X,
+                            Array<Vector *> &Y) const
+{
+   MFEM_ASSERT(X.Size() == Y.Size(), "Number of columns mismatch!");
+   const int nvec = X.Size();
+   const int np = P.Height(), na = A.Height();
+   PX_batch.SetSize(nvec*np, Px.GetMemory().GetMemoryType());
+   APX_batch.SetSize(nvec*na, APx.GetMemory().GetMemoryType());
+   PX_batch.UseDevice(true);
+   APX_batch.UseDevice(true);
+   std::vector<Vector> px(nvec), apx(nvec);
+   Array<Vector *> PX(nvec), APX(nvec);
+   Array<const Vector *> cPX(nvec), cAPX(nvec);
+   for (int v = 0; v < nvec; v++)
+   {
+      px[v].MakeRef(PX_batch, v*np, np);
+      apx[v].MakeRef(APX_batch, v*na, na);
+      PX[v] = &px[v];
+      APX[v] = &apx[v];
+      cPX[v] = &px[v];
+      cAPX[v] = &apx[v];
+   }
+   P.ArrayMult(X, PX);
+   A.ArrayMult(cPX, APX);
+   Rt.ArrayMultTranspose(cAPX, Y);
+}
+
 ConstrainedOperator::ConstrainedOperator(Operator *A, const Array<int> &list,
                                          bool own_A_,
                                          DiagonalPolicy diag_policy_)
@@ -651,6 +679,50 @@ void ConstrainedOperator::Mult(const Vector &x, Vector &y) const
    ConstrainedMult(x, y, transpose);
 }
 
+void ConstrainedOperator::ArrayMult(const Array<const Vector *> &X,
+                                    Array<Vector *> &Y) const
+{
+   const int csz = constraint_list.Size();
+   if (csz == 0)
+   {
+      A->ArrayMult(X, Y);
+      return;
+   }
+   MFEM_ASSERT(X.Size() == Y.Size(), "Number of columns mismatch!");
+   MFEM_VERIFY(diag_policy == DIAG_ONE || diag_policy == DIAG_ZERO,
+               "ConstrainedOperator::ArrayMult: unsupported diagonal policy");
+
+   const int nvec = X.Size();
+   z_batch.SetSize(nvec*width, z.GetMemory().GetMemoryType());
+   z_batch.UseDevice(true);
+   std::vector<Vector> zv(nvec);
+   Array<const Vector *> Z(nvec);
+   auto idx = constraint_list.Read();
+   for (int v = 0; v < nvec; v++)
+   {
+      zv[v].MakeRef(z_batch, v*width, width);
+      zv[v] = *X[v];
+      auto d_z = zv[v].ReadWrite();
+      mfem::forall(csz, [=] MFEM_HOST_DEVICE (int i) { d_z[idx[i]] = 0.0; });
+      Z[v] = &zv[v];
+   }
+
+   A->ArrayMult(Z, Y);
+
+   const bool diag_one = (diag_policy == DIAG_ONE);
+   for (int v = 0; v < nvec; v++)
+   {
+      auto d_x = X[v]->Read();
+      // Use read+write access - we are modifying sub-vector of y
+      auto d_y = Y[v]->ReadWrite();
+      mfem::forall(csz, [=] MFEM_HOST_DEVICE (int i)
+      {
+         const int id = idx[i];
+         d_y[id] = diag_one ? d_x[id] : 0.0;
+      });
+   }
+}
+
 void ConstrainedOperator::MultTranspose(const Vector &x, Vector &y) const
 {
    constexpr bool transpose = true;
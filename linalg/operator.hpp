@@ -918,6 +918,7 @@ private:
    const Operator & P;
    mutable Vector Px;
    mutable Vector APx;
+   mutable Vector PX_batch, APX_batch; // Work vectors of ArrayMult()
    MemoryClass mem_class;
 
 public:
@@ -930,6 +931,11 @@ public:
    void Mult(const Vector & x, Vector & y) const override
    { P.Mult(x, Px); A.Mult(Px, APx); Rt.MultTranspose(APx, y); }
 
+   /** @brief Operator application on multiple vectors, using the ArrayMult()
+       methods of the three operators. */
+   void ArrayMult(const Array<const Vector *> &X,
+                  Array<Vector *> &Y) const override;
+
    /// Approximate diagonal of the RAP Operator.
    /** Returns the diagonal of A, as returned by its AssembleDiagonal method,
        multiplied be P^T.
@@ -995,6 +1001,7 @@ protected:
    Operator *A;                 ///< The unconstrained Operator.
    bool own_A;                  ///< Ownership flag for A.
    mutable Vector z, w;         ///< Auxiliary vectors.
+   mutable Vector z_batch;      ///< Auxiliary vectors of ArrayMult().
    MemoryClass mem_class;
    DiagonalPolicy diag_policy;  ///< Diagonal policy for constrained dofs
 
@@ -1043,6 +1050,11 @@ public:
        the vectors, and "_i" -- the rest of the entries. */
    void Mult(const Vector &x, Vector &y) const override;
 
+   /** @brief Constrained operator action on multiple vectors, see Mult(). The
+       unconstrained Operator is applied with its ArrayMult() method. */
+   void ArrayMult(const Array<const Vector *> &X,
+                  Array<Vector *> &Y) const override;
+
    void AddMult(const Vector &x, Vector &y, const real_t a = 1.0) const override;
 
    void MultTranspose(const Vector &x, Vector &y) const override;
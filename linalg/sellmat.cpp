@@ -0,0 +1,175 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "sellmat.hpp"
+#include "sparsemat.hpp"
+
+#include <algorithm>
+
+namespace mfem
+{
+
+SellMatrix::SellMatrix(const SparseMatrix &A, int sigma_)
+   : Operator(A.Height(), A.Width())
+{
+   MFEM_VERIFY(A.Finalized(), "The matrix must be finalized.");
+   constexpr int C = chunk_size;
+   sigma = std::max(C, ((sigma_ + C - 1)/C)*C);
+
+   const int n = height;
+   const int *I = A.HostReadI();
+   const int *J = A.HostReadJ();
+   const real_t *data = A.HostReadData();
+   nnz = I[n];
+   auto row_size = [&](int i) { return (i < 0) ? 0 : I[i+1] - I[i]; };
+
+   // Sort the rows by decreasing length within the windows of sigma rows; the
+   // padding rows at the end have index -1
+   num_chunks = (n + C - 1)/C;
+   perm.SetSize(num_chunks*C);
+   for (int i = 0; i < perm.Size(); i++) { perm[i] = (i < n) ? i : -1; }
+   for (int w = 0; w < n; w += sigma)
+   {
+      std::stable_sort(perm.begin() + w, perm.begin() + std::min(w + sigma, n),
+                       [&](int i, int j) { return row_size(i) > row_size(j); });
+   }
+
+   chunk_ptr.SetSize(num_chunks + 1);
+   chunk_ptr[0] = 0;
+   for (int c = 0; c < num_chunks; c++)
+   {
+      int len = 0;
+      for (int l = 0; l < C; l++)
+      {
+         len = std::max(len, row_size(perm[c*C + l]));
+      }
+      chunk_ptr[c+1] = chunk_ptr[c] + len;
+   }
+
+   // The padding entries repeat the last column of the row (or use column 0
+   // for empty rows) with a zero value, so they do not read outside of x
+   col.SetSize(chunk_ptr[num_chunks]*C);
+   val.SetSize(chunk_ptr[num_chunks]*C);
+   for (int c = 0; c < num_chunks; c++)
+   {
+      for (int l = 0; l < C; l++)
+      {
+         const int r = perm[c*C + l];
+         const int len = row_size(r);
+         for (int k = 0; k < chunk_ptr[c+1] - chunk_ptr[c]; k++)
+         {
+            const int pos = (chunk_ptr[c] + k)*C + l;
+            if (k < len)
+            {
+               col[pos] = J[I[r] + k];
+               val[pos] = data[I[r] + k];
+            }
+            else
+            {
+               col[pos] = (len > 0) ? J[I[r] + len - 1] : 0;
+               val[pos] = 0.0;
+            }
+         }
+      }
+   }
+}
+
+void SellMatrix::Mult(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMult(x, y);
+}
+
+void SellMatrix::AddMult(const Vector &x, Vector &y, const real_t a) const
+{
+   MFEM_ASSERT(x.Size() == width && y.Size() == height, "invalid sizes");
+   constexpr int C = chunk_size;
+   const real_t *xp = x.HostRead();
+   real_t *yp = y.HostReadWrite();
+   const int *cp = col.GetData();
+   const real_t *vp = val.GetData();
+
+   for (int c = 0; c < num_chunks; c++)
+   {
+      simd_t sum;
+      sum = 0.0;
+      for (int k = chunk_ptr[c]; k < chunk_ptr[c+1]; k++)
+      {
+         const int *ck = cp + k*C;
+         const real_t *vk = vp + k*C;
+         simd_t v, xk;
+         MFEM_VECTORIZE_LOOP
+         for (int l = 0; l < C; l++)
+         {
+            v[l] = vk[l];
+            xk[l] = xp[ck[l]];
+         }
+         sum.fma(v, xk);
+      }
+      const int *pc = perm.GetData() + c*C;
+      for (int l = 0; l < C; l++)
+      {
+         if (pc[l] >= 0) { yp[pc[l]] += a*sum[l]; }
+      }
+   }
+}
+
+void SellMatrix::MultTranspose(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMultTranspose(x, y);
+}
+
+void SellMatrix::AddMultTranspose(const Vector &x, Vector &y,
+                                  const real_t a) const
+{
+   MFEM_ASSERT(x.Size() == height && y.Size() == width, "invalid sizes");
+   constexpr int C = chunk_size;
+   const real_t *xp = x.HostRead();
+   real_t *yp = y.HostReadWrite();
+   const int *cp = col.GetData();
+   const real_t *vp = val.GetData();
+
+   for (int c = 0; c < num_chunks; c++)
+   {
+      const int *pc = perm.GetData() + c*C;
+      simd_t xc;
+      for (int l = 0; l < C; l++)
+      {
+         xc[l] = (pc[l] >= 0) ? a*xp[pc[l]] : 0.0;
+      }
+      for (int k = chunk_ptr[c]; k < chunk_ptr[c+1]; k++)
+      {
+         const int *ck = cp + k*C;
+         const real_t *vk = vp + k*C;
+         simd_t v, prod;
+         MFEM_VECTORIZE_LOOP
+         for (int l = 0; l < C; l++) { v[l] = vk[l]; }
+         prod.mul(v, xc);
+         // The columns of the rows of a chunk may coincide, so the scatter is
+         // done one lane at a time
+         for (int l = 0; l < C; l++) { yp[ck[l]] += prod[l]; }
+      }
+   }
+}
+
+bool SellMatrix::IsBeneficial(const SparseMatrix &A)
+{
+   // Average row length below which the CSR loops vectorize poorly, and the
+   // minimum number of rows for the conversion to pay off
+   const int max_avg_row_size = 32;
+   const int min_rows = 16*chunk_size;
+   const int n = A.Height();
+   if (!A.Finalized() || n < min_rows) { return false; }
+   return A.NumNonZeroElems() <= max_avg_row_size*n;
+}
+
+} // namespace mfem
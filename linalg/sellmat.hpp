@@ -0,0 +1,113 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_SELLMAT
+#define MFEM_SELLMAT
+
+#include "../config/config.hpp"
+#include "../general/array.hpp"
+#include "operator.hpp"
+#include "simd.hpp"
+
+namespace mfem
+{
+
+class SparseMatrix;
+
+/** @brief Sparse matrix in the sliced ELLPACK (SELL-C-σ) format, built from a
+    finalized SparseMatrix.
+
+    The rows are sorted by decreasing length within windows of σ rows and
+    grouped in chunks of C consecutive (sorted) rows. The entries of a chunk
+    are stored column by column: the k-th entries of the C rows are contiguous,
+    padded with zeros up to the length of the longest row of the chunk. The
+    products with the matrix and its transpose then process C rows at once with
+    the SIMD types of linalg/simd (AutoSIMD), using C = #chunk_size entries per
+    SIMD register.
+
+    The format pays off for short and irregular rows, e.g. from low-order or
+    LOR discretizations, for which the row by row CSR loops vectorize poorly.
+    The sorting keeps the padding small. The matrix is a host (CPU) operator
+    and a snapshot of the values: it has to be rebuilt when the values of the
+    original matrix change. See SparseMatrix::UseSellFormat() for using it
+    automatically in the products with a SparseMatrix. */
+class SellMatrix : public Operator
+{
+public:
+   /// Number of rows in a chunk, i.e. the SIMD width (at least 4).
+   static constexpr int chunk_size =
+      (MFEM_SIMD_BYTES/sizeof(real_t) < 4) ? 4 : MFEM_SIMD_BYTES/sizeof(real_t);
+
+   /// Default size of the sorting windows, σ, in number of rows.
+   static constexpr int default_sigma = 32*chunk_size;
+
+protected:
+   using simd_t = AutoSIMD<real_t, chunk_size, chunk_size*sizeof(real_t)>;
+
+   int sigma;
+   int num_chunks;
+   /// Offsets of the chunks in #col and #val, in units of #chunk_size entries.
+   Array<int> chunk_ptr;
+   /// Original row of each sorted row, padded to a multiple of #chunk_size.
+   Array<int> perm;
+   Array<int> col;
+   Array<real_t> val;
+   /// Number of nonzeros of the original matrix.
+   int nnz;
+
+public:
+   /** @brief Build the SELL-C-σ representation of the finalized matrix @a A,
+       sorting the rows within windows of @a sigma_ rows (rounded up to a
+       multiple of #chunk_size). */
+   SellMatrix(const SparseMatrix &A, int sigma_ = default_sigma);
+
+   /// Matrix vector multiplication, y = A x.
+   void Mult(const Vector &x, Vector &y) const override;
+
+   /// y += a A x
+   void AddMult(const Vector &x, Vector &y,
+                const real_t a = 1.0) const override;
+
+   /// Multiplication with the transposed matrix, y = A^T x.
+   void MultTranspose(const Vector &x, Vector &y) const override;
+
+   /// y += a A^T x
+   void AddMultTranspose(const Vector &x, Vector &y,
+                         const real_t a = 1.0) const override;
+
+   /// Return the size of the sorting windows, σ.
+   int GetSigma() const { return sigma; }
+
+   /// Return the number of stored entries, including the padding.
+   int NumStoredEntries() const { return val.Size(); }
+
+   /** @brief Return the ratio of the number of nonzeros of the original matrix
+       to the number of stored entries (1 means no padding). */
+   real_t GetEfficiency() const
+   { return val.Size() ? real_t(nnz)/val.Size() : 1.0; }
+
+   /** @brief Return true if the products with @a A are expected to be faster
+       in the SELL-C-σ format than in the CSR format.
+
+       This is the case when the rows are short on average, so that the CSR
+       inner loops are too short to be vectorized efficiently, and when the
+       matrix is large enough to amortize the conversion. The padding of the
+       sorted chunks is small for such matrices, and it is checked after the
+       conversion, see GetEfficiency(). */
+   static bool IsBeneficial(const SparseMatrix &A);
+
+   /// Minimum value of GetEfficiency() for the format to be used automatically.
+   static constexpr real_t min_efficiency = 0.75;
+};
+
+} // namespace mfem
+
+#endif
@@ -20,6 +20,9 @@
 #include <algorithm>
 #include <cmath>
 #include <set>
+#include <limits>
+#include <vector>
+#include <memory>
 
 namespace mfem
 {
@@ -69,6 +72,32 @@ real_t IterativeSolver::Dot(const Vector &x, const Vector &y) const
 #endif
 }
 
+void IterativeSolver::StartGlobalSum(real_t *buf, int n) const
+{
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type != 0)
+   {
+      MFEM_VERIFY(sum_request == MPI_REQUEST_NULL,
+                  "a global sum is already in progress");
+      MPI_Iallreduce(MPI_IN_PLACE, buf, n, MPITypeMap<real_t>::mpi_type,
+                     MPI_SUM, comm, &sum_request);
+   }
+#else
+   MFEM_CONTRACT_VAR(buf);
+   MFEM_CONTRACT_VAR(n);
+#endif
+}
+
+void IterativeSolver::FinishGlobalSum() const
+{
+#ifdef MFEM_USE_MPI
+   if (sum_request != MPI_REQUEST_NULL)
+   {
+      MPI_Wait(&sum_request, MPI_STATUS_IGNORE);
+   }
+#endif
+}
+
 void IterativeSolver::SetPrintLevel(int print_lvl)
 {
    print_options = FromLegacyPrintLevel(print_lvl);
@@ -551,6 +580,8 @@ void SLISolver::UpdateVectors()
 
 void SLISolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_SCOPE("SLISolver::Mult");
+
    const bool zero_b = (b.Size() == 0);
    int i;
 
@@ -750,6 +781,8 @@ void CGSolver::UpdateVectors()
 
 void CGSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_SCOPE("CGSolver::Mult");
+
    int i;
    real_t r0, den, nom, nom0, betanom, alpha, beta;
 
@@ -963,295 +996,2279 @@ void PCG(const Operator &A, Solver &B, const Vector &b, Vector &x,
 }
 
 
-inline void GeneratePlaneRotation(real_t &dx, real_t &dy,
-                                  real_t &cs, real_t &sn)
+namespace
 {
-   if (dy == 0.0)
-   {
-      cs = 1.0;
-      sn = 0.0;
-   }
-   else if (fabs(dy) > fabs(dx))
+
+/// Sum of the two local inner products computed by PipelinedCGSolver
+struct DotPairReducer
+{
+   using value_type = DevicePair<real_t, real_t>;
+   static MFEM_HOST_DEVICE void Join(value_type &a, const value_type &b)
    {
-      real_t temp = dx / dy;
-      sn = 1.0 / sqrt( 1.0 + temp*temp );
-      cs = temp * sn;
+      a.first += b.first;
+      a.second += b.second;
    }
-   else
+   static MFEM_HOST_DEVICE void SetInitialValue(value_type &a)
    {
-      real_t temp = dy / dx;
-      cs = 1.0 / sqrt( 1.0 + temp*temp );
-      sn = temp * cs;
+      a.first = 0.0;
+      a.second = 0.0;
    }
-}
+};
 
-inline void ApplyPlaneRotation(real_t &dx, real_t &dy, real_t &cs, real_t &sn)
+Array<DevicePair<real_t, real_t>> &dot_pair_workspace()
 {
-   real_t temp = cs * dx + sn * dy;
-   dy = -sn * dx + cs * dy;
-   dx = temp;
+   static Array<DevicePair<real_t, real_t>> instance;
+   return instance;
 }
 
-inline void Update(Vector &x, int k, DenseMatrix &h, Vector &s,
-                   Array<Vector*> &v)
+/// Compute the local inner products (r, u) and (w, u) in one pass.
+void LocalDotPair(const Vector &r, const Vector &u, const Vector &w,
+                  real_t *dots)
 {
-   Vector y(s);
+   const auto R = r.Read(), U = u.Read(), W = w.Read();
+   DevicePair<real_t, real_t> res;
+   res.first = res.second = 0.0;
+   reduce(r.Size(), res,
+          [=] MFEM_HOST_DEVICE (int k, DevicePair<real_t, real_t> &d)
+   {
+      d.first += R[k]*U[k];
+      d.second += W[k]*U[k];
+   }, DotPairReducer{}, true, dot_pair_workspace());
+   dots[0] = res.first;
+   dots[1] = res.second;
+}
 
-   // Backsolve:
-   for (int i = k; i >= 0; i--)
-   {
-      y(i) /= h(i,i);
-      for (int j = i - 1; j >= 0; j--)
-      {
-         y(j) -= h(j,i) * y(i);
-      }
-   }
+}
 
-   for (int j = 0; j <= k; j++)
+void PipelinedCGSolver::UpdateVectors()
+{
+   MemoryType mt = GetMemoryType(oper->GetMemoryClass());
+   const bool pipelined = (variant == PIPELINED);
+
+   for (Vector *v : {&r, &u, &w, &p, &s, &q, &z, &m, &n})
    {
-      x.Add(y(j), *v[j]);
+      const bool used = pipelined || v == &r || v == &u || v == &w ||
+                        v == &p || v == &s;
+      v->SetSize(used ? width : 0, mt);
+      v->UseDevice(true);
    }
 }
 
-void GMRESSolver::Mult(const Vector &b, Vector &x) const
+void PipelinedCGSolver::Mult(const Vector &b, Vector &x) const
 {
-   // Generalized Minimum Residual method following the algorithm
-   // on p. 20 of the SIAM Templates book.
-
-   int n = width;
+   MFEM_PERF_SCOPE("PipelinedCGSolver::Mult");
 
-   DenseMatrix H(m+1, m);
-   Vector s(m+1), cs(m+1), sn(m+1);
-   Vector r(n), w(n), x_monitor;
-   Array<Vector *> v;
+   const bool pipelined = (variant == PIPELINED);
+   const char *name = pipelined ? "PIPECG" : "SRCG";
+   const bool pr = (prec != nullptr);
+   const int N = width;
+   int i;
+   real_t r0, den, nom, nom0, betanom, alpha, beta, delta;
+   real_t dots[2];
 
-   b.UseDevice(true);
-   x.UseDevice(true);
-   r.UseDevice(true);
-   w.UseDevice(true);
+   // The preconditioned residual, u = B r, is r itself without preconditioner
+   const Vector &ur = pr ? u : r;
 
-   if (ControllerRequiresUpdate())
-   {
-      x_monitor.SetSize(n);
-      x_monitor.UseDevice(true);
-   }
-   else
+   // Apply m = B w and n = A m, the work overlapped with the global sum
+   auto ApplyPrecOper = [&]()
    {
-      x_monitor.MakeRef(x, 0, n);
-   }
-
-   int i, j, k;
+      if (pr)
+      {
+         prec->Mult(w, m);
+         oper->Mult(m, n);
+      }
+      else
+      {
+         oper->Mult(w, n);
+      }
+   };
 
+   x.UseDevice(true);
    if (iterative_mode)
    {
       oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
    }
    else
    {
+      r = b;
       x = 0.0;
    }
 
-   if (prec)
+   if (pr) { prec->Mult(r, u); } // u = B r
+   oper->Mult(ur, w);              // w = A u
+   LocalDotPair(r, ur, w, dots);
+   StartGlobalSum(dots, 2);
+   if (pipelined) { ApplyPrecOper(); }
+   FinishGlobalSum();
+   nom0 = nom = dots[0];
+   den = delta = dots[1];
+
+   if (nom0 >= 0.0) { initial_norm = sqrt(nom0); }
+   MFEM_VERIFY(IsFinite(nom), "nom = " << nom);
+   if (print_options.iterations || print_options.first_and_last)
    {
-      if (iterative_mode)
-      {
-         subtract(b, r, w);
-         prec->Mult(w, r);    // r = M (b - A x)
-      }
-      else
-      {
-         prec->Mult(b, r);
-      }
+      mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                << nom << (print_options.first_and_last ? " ...\n" : "\n");
    }
-   else
+
+   if (nom < 0.0)
    {
-      if (iterative_mode)
-      {
-         subtract(b, r, r);
-      }
-      else
+      if (print_options.warnings)
       {
-         r = b;
+         mfem::out << name << ": The preconditioner is not positive definite."
+                   << " (Br, r) = " << nom << '\n';
       }
-   }
-   real_t beta = initial_norm = Norm(r);  // beta = ||r||
-   MFEM_VERIFY(IsFinite(beta), "beta = " << beta);
-
-   final_norm = std::max(rel_tol*beta, abs_tol);
+      converged = false;
+      final_iter = 0;
+      initial_norm = nom;
+      final_norm = nom;
 
-   if (Monitor(0, beta, r, x) || beta <= final_norm)
+      Monitor(0, nom, r, x, true);
+      return;
+   }
+   r0 = std::max(nom*rel_tol*rel_tol, abs_tol*abs_tol);
+   if (Monitor(0, nom, r, x) || nom <= r0)
    {
-      final_norm = beta;
-      final_iter = 0;
       converged = true;
-      j = 0;
-      goto finish;
-   }
+      final_iter = 0;
+      final_norm = sqrt(nom);
 
-   if (print_options.iterations || print_options.first_and_last)
-   {
-      mfem::out << "   Pass : " << setw(2) << 1
-                << "   Iteration : " << setw(3) << 0
-                << "  ||B r|| = " << beta
-                << (print_options.first_and_last ? " ...\n" : "\n");
+      Monitor(0, nom, r, x, true);
+      return;
    }
 
-   v.SetSize(m+1, NULL);
-
-   for (j = 1; j <= max_iter; )
+   MFEM_VERIFY(IsFinite(den), "den = " << den);
+   if (den <= 0.0)
    {
-      if (v[0] == NULL)
+      if (den < 0.0 && print_options.warnings)
       {
-         v[0] = new Vector(n);
-         v[0]->UseDevice(true);
+         mfem::out << name << ": The operator is not positive definite."
+                   << " (Ad, d) = " << den << '\n';
       }
-      v[0]->Set(1.0/beta, r);
-      s = 0.0; s(0) = beta;
-
-      for (i = 0; i < m && j <= max_iter; i++, j++)
+      if (den == 0.0)
       {
-         if (prec)
-         {
-            oper->Mult(*v[i], r);
-            prec->Mult(r, w);        // w = M A v[i]
-         }
-         else
-         {
-            oper->Mult(*v[i], w);
-         }
-
-         for (k = 0; k <= i; k++)
-         {
-            H(k,i) = Dot(w, *v[k]);  // H(k,i) = w * v[k]
-            w.Add(-H(k,i), *v[k]);   // w -= H(k,i) * v[k]
-         }
-
-         H(i+1,i) = Norm(w);           // H(i+1,i) = ||w||
-         MFEM_VERIFY(IsFinite(H(i+1,i)), "Norm(w) = " << H(i+1,i));
-         if (v[i+1] == NULL) { v[i+1] = new Vector(n); }
-         v[i+1]->Set(1.0/H(i+1,i), w); // v[i+1] = w / H(i+1,i)
-
-         for (k = 0; k < i; k++)
-         {
-            ApplyPlaneRotation(H(k,i), H(k+1,i), cs(k), sn(k));
-         }
+         converged = false;
+         final_iter = 0;
+         final_norm = sqrt(nom);
 
-         GeneratePlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
-         ApplyPlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
-         ApplyPlaneRotation(s(i), s(i+1), cs(i), sn(i));
+         Monitor(0, nom, r, x, true);
+         return;
+      }
+   }
 
-         const real_t resid = fabs(s(i+1));
-         MFEM_VERIFY(IsFinite(resid), "resid = " << resid);
+   // The search direction p and s = A p (and z = A q, q = B s) start at zero
+   p = 0.0;
+   s = 0.0;
+   if (pipelined)
+   {
+      z = 0.0;
+      q = 0.0;
+   }
+   alpha = nom/den;
+   beta = 0.0;
 
-         if (ControllerRequiresUpdate())
+   // start iteration
+   converged = false;
+   final_iter = max_iter;
+   betanom = nom;
+   for (i = 1; true; )
+   {
+      if (pipelined)
+      {
+         // All vector updates and the local inner products in a single pass
+         const auto M = pr ? m.Read() : nullptr;
+         const auto Nv = n.Read();
+         auto Z = z.ReadWrite(), Q = pr ? q.ReadWrite() : nullptr;
+         auto S = s.ReadWrite(), P = p.ReadWrite(), X = x.ReadWrite();
+         auto R = r.ReadWrite(), U = pr ? u.ReadWrite() : nullptr;
+         auto W = w.ReadWrite();
+         DevicePair<real_t, real_t> res;
+         res.first = res.second = 0.0;
+         reduce(N, res,
+                [=] MFEM_HOST_DEVICE (int k, DevicePair<real_t, real_t> &d)
          {
-            x_monitor = x;
-            Update(x_monitor, i, H, s, v);
-         }
-
-         if (Monitor(j, resid, r, x_monitor) || resid <= final_norm)
+            Z[k] = Nv[k] + beta*Z[k];  // z = n + beta z
+            S[k] = W[k] + beta*S[k];   // s = w + beta s
+            if (pr)
+            {
+               Q[k] = M[k] + beta*Q[k]; // q = m + beta q
+               P[k] = U[k] + beta*P[k]; // p = u + beta p
+            }
+            else
+            {
+               P[k] = R[k] + beta*P[k];
+            }
+            X[k] += alpha*P[k];        // x = x + alpha p
+            R[k] -= alpha*S[k];        // r = r - alpha s
+            if (pr) { U[k] -= alpha*Q[k]; } // u = u - alpha q
+            W[k] -= alpha*Z[k];        // w = w - alpha z
+            const real_t uk = pr ? U[k] : R[k];
+            d.first += R[k]*uk;
+            d.second += W[k]*uk;
+         }, DotPairReducer{}, true, dot_pair_workspace());
+         dots[0] = res.first;
+         dots[1] = res.second;
+
+         // Overlap the global sum with the preconditioner and operator
+         StartGlobalSum(dots, 2);
+         ApplyPrecOper();
+         FinishGlobalSum();
+      }
+      else
+      {
+         const auto U = ur.Read(), W = w.Read();
+         auto P = p.ReadWrite(), S = s.ReadWrite(), X = x.ReadWrite();
+         auto R = r.ReadWrite();
+         mfem::forall(N, [=] MFEM_HOST_DEVICE (int k)
          {
-            Update(x, i, H, s, v);
-            final_norm = resid;
-            final_iter = j;
-            converged = true;
-            goto finish;
-         }
+            P[k] = U[k] + beta*P[k];   // p = u + beta p
+            S[k] = W[k] + beta*S[k];   // s = w + beta s
+            X[k] += alpha*P[k];        // x = x + alpha p
+            R[k] -= alpha*S[k];        // r = r - alpha s
+         });
+         if (pr) { prec->Mult(r, u); } // u = B r
+         oper->Mult(ur, w);              // w = A u
+         LocalDotPair(r, ur, w, dots);
+         StartGlobalSum(dots, 2);
+         FinishGlobalSum();
+      }
+      betanom = dots[0];
+      delta = dots[1];
 
-         if (print_options.iterations)
+      MFEM_VERIFY(IsFinite(betanom), "betanom = " << betanom);
+      if (betanom < 0.0)
+      {
+         if (print_options.warnings)
          {
-            mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
-                      << "   Iteration : " << setw(3) << j
-                      << "  ||B r|| = " << resid << '\n';
+            mfem::out << name << ": The preconditioner is not positive "
+                      << "definite. (Br, r) = " << betanom << '\n';
          }
+         converged = false;
+         final_iter = i;
+         break;
       }
 
-      if (print_options.iterations && j <= max_iter)
+      if (print_options.iterations)
       {
-         mfem::out << "Restarting..." << '\n';
+         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                   << betanom << std::endl;
       }
 
-      Update(x, i-1, H, s, v);
-
-      oper->Mult(x, r);
-      if (prec)
+      if (Monitor(i, betanom, r, x) || betanom <= r0)
       {
-         subtract(b, r, w);
-         prec->Mult(w, r);    // r = M (b - A x)
+         converged = true;
+         final_iter = i;
+         break;
       }
-      else
+
+      if (++i > max_iter)
       {
-         subtract(b, r, r);
+         break;
+      }
+
+      // (A p, p) for the new direction p = u + beta p, from the recurrences
+      beta = betanom/nom;
+      den = delta - beta*betanom/alpha;
+      MFEM_VERIFY(IsFinite(den), "den = " << den);
+      if (den <= 0.0)
+      {
+         if (den < 0.0 && print_options.warnings)
+         {
+            mfem::out << name << ": The operator is not positive definite."
+                      << " (Ad, d) = " << den << '\n';
+         }
+         if (den == 0.0)
+         {
+            final_iter = i;
+            break;
+         }
+      }
+      alpha = betanom/den;
+      nom = betanom;
+   }
+   if (print_options.first_and_last && !print_options.iterations)
+   {
+      mfem::out << "   Iteration : " << setw(3) << final_iter << "  (B r, r) = "
+                << betanom << '\n';
+   }
+   if (print_options.summary || (print_options.warnings && !converged))
+   {
+      mfem::out << name << ": Number of iterations: " << final_iter << '\n';
+   }
+   if (print_options.summary || print_options.iterations ||
+       print_options.first_and_last)
+   {
+      const auto arf = pow (betanom/nom0, 0.5/final_iter);
+      mfem::out << "Average reduction factor = " << arf << '\n';
+   }
+   if (print_options.warnings && !converged)
+   {
+      mfem::out << name << ": No convergence!" << '\n';
+   }
+
+   final_norm = sqrt(betanom);
+
+   Monitor(final_iter, final_norm, r, x, true);
+}
+
+namespace
+{
+
+/// Number of rows of the blocks summed by one thread in BlockDots()
+constexpr int block_dots_rows = 256;
+
+/** Compute the local s x s matrix G = U^T V, where the blocks @a U and @a V
+    store s columns of size n one after another, in one pass over U and V. The
+    partial sums over blocks of rows are added in a fixed order, so the result
+    does not depend on the device. */
+void BlockDots(const int n, const int s, const Vector &U, const Vector &V,
+               Vector &part, DenseMatrix &G)
+{
+   const int ss = s*s;
+   const int nb = (n + block_dots_rows - 1)/block_dots_rows;
+   part.SetSize(ss*(nb + 1));
+   part.UseDevice(true);
+
+   const auto u = U.Read();
+   const auto v = V.Read();
+   auto P = Reshape(part.Write(), ss, nb + 1);
+   mfem::forall(nb, [=] MFEM_HOST_DEVICE (int blk)
+   {
+      const int begin = blk*block_dots_rows;
+      const int end = (begin + block_dots_rows < n) ?
+                      begin + block_dots_rows : n;
+      for (int c = 0; c < ss; c++) { P(c, blk) = 0.0; }
+      for (int i = begin; i < end; i++)
+      {
+         for (int l = 0; l < s; l++)
+         {
+            const real_t vil = v[i + l*n];
+            for (int k = 0; k < s; k++)
+            {
+               P(k + s*l, blk) += u[i + k*n]*vil;
+            }
+         }
+      }
+   });
+   mfem::forall(ss, [=] MFEM_HOST_DEVICE (int c)
+   {
+      real_t sum = 0.0;
+      for (int blk = 0; blk < nb; blk++) { sum += P(c, blk); }
+      P(c, nb) = sum;
+   });
+   const real_t *h_part = part.HostRead();
+   G.SetSize(s);
+   std::copy(h_part + ss*nb, h_part + ss*(nb + 1), G.Data());
+}
+
+/** Compute Y += V C in one pass over V and Y, where the blocks @a V and @a Y
+    store s columns of size n one after another. */
+void BlockAddMult(const int n, const int s, const Vector &V,
+                  const DenseMatrix &C, Vector &Y)
+{
+   Vector c(s*s);
+   c.UseDevice(true);
+   std::copy(C.Data(), C.Data() + s*s, c.HostWrite());
+   const auto v = V.Read();
+   const auto d_c = c.Read();
+   auto y = Y.ReadWrite();
+   mfem::forall(n, [=] MFEM_HOST_DEVICE (int i)
+   {
+      for (int j = 0; j < s; j++)
+      {
+         real_t sum = 0.0;
+         for (int k = 0; k < s; k++) { sum += v[i + k*n]*d_c[k + s*j]; }
+         y[i + j*n] += sum;
+      }
+   });
+}
+
+/** Solve G X = H with the Cholesky factorization of the small SPD matrix G,
+    overwriting G and H. Return false if a pivot is not larger than @a tol
+    times the corresponding diagonal entry, i.e. if G is numerically singular
+    or not positive definite. */
+bool CholeskySolve(DenseMatrix &G, DenseMatrix &H, const real_t tol)
+{
+   const int s = G.Height();
+   for (int j = 0; j < s; j++)
+   {
+      real_t d = G(j, j);
+      for (int k = 0; k < j; k++) { d -= G(j, k)*G(j, k); }
+      if (!(d > tol*G(j, j))) { return false; }
+      G(j, j) = sqrt(d);
+      for (int i = j + 1; i < s; i++)
+      {
+         real_t a = G(i, j);
+         for (int k = 0; k < j; k++) { a -= G(i, k)*G(j, k); }
+         G(i, j) = a/G(j, j);
+      }
+   }
+   for (int c = 0; c < H.Width(); c++)
+   {
+      for (int i = 0; i < s; i++) // L y = h
+      {
+         real_t a = H(i, c);
+         for (int k = 0; k < i; k++) { a -= G(i, k)*H(k, c); }
+         H(i, c) = a/G(i, i);
+      }
+      for (int i = s - 1; i >= 0; i--) // L^T x = y
+      {
+         real_t a = H(i, c);
+         for (int k = i + 1; k < s; k++) { a -= G(k, i)*H(k, c); }
+         H(i, c) = a/G(i, i);
+      }
+   }
+   return true;
+}
+
+/// Make the @a s columns of size @a n of @a block reference vectors in @a cols.
+void BlockColumns(Vector &block, const int n, const int s,
+                  std::vector<Vector> &cols)
+{
+   cols.resize(s);
+   for (int j = 0; j < s; j++) { cols[j].MakeRef(block, j*n, n); }
+}
+
+/// Apply @a op (or its inverse, if it is a Solver) to the columns of a block.
+void BlockApply(const Operator &op, std::vector<Vector> &in,
+                std::vector<Vector> &out, const int s)
+{
+   Array<const Vector *> X(s);
+   Array<Vector *> Y(s);
+   for (int j = 0; j < s; j++)
+   {
+      X[j] = &in[j];
+      Y[j] = &out[j];
+   }
+   op.ArrayMult(X, Y);
+}
+
+}
+
+void BlockCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   Array<const Vector *> B(1);
+   Array<Vector *> X(1);
+   B[0] = &b;
+   X[0] = &x;
+   ArrayMult(B, X);
+}
+
+void BlockCGSolver::ArrayMult(const Array<const Vector *> &B,
+                              Array<Vector *> &X) const
+{
+   MFEM_PERF_SCOPE("BlockCGSolver::ArrayMult");
+
+   MFEM_VERIFY(B.Size() == X.Size(), "Number of columns mismatch!");
+   const int n = width;
+   const int nrhs = B.Size();
+   // Below this relative size of a pivot, the inner product matrices are
+   // considered singular
+   const real_t breakdown_tol = sqrt(std::numeric_limits<real_t>::epsilon());
+
+   // (B r, r) of each column: initial, current and convergence threshold
+   Vector nom0(nrhs), nom(nrhs), r0(nrhs);
+   Array<bool> done(nrhs);
+   done = false;
+   for (int j = 0; j < nrhs; j++)
+   {
+      X[j]->UseDevice(true);
+      if (!iterative_mode) { *X[j] = 0.0; }
+   }
+
+   // The columns in the current block, and those postponed after a breakdown
+   Array<int> act(nrhs), pending;
+   for (int j = 0; j < nrhs; j++) { act[j] = j; }
+
+   std::vector<Vector> x_cols, r_cols, z_cols, p_cols, q_cols, pn_cols;
+   DenseMatrix H, Hn, G, alpha;
+   bool first = true, stop = false;
+   int it = 0;
+   converged = false;
+
+   // Copy the solution of the block back to the columns of X
+   auto StoreSolution = [&](const int s)
+   {
+      for (int j = 0; j < s; j++) { *X[act[j]] = x_cols[j]; }
+   };
+
+   // Handle a singular inner product matrix: the operator or the
+   // preconditioner is not SPD if there is one column, otherwise the columns
+   // of the block are postponed and solved one at a time
+   auto Breakdown = [&](const int s)
+   {
+      StoreSolution(s);
+      if (s == 1)
+      {
+         if (print_options.warnings)
+         {
+            mfem::out << "BlockCG: The operator is not positive definite.\n";
+         }
+         stop = true;
+      }
+      else
+      {
+         if (print_options.warnings)
+         {
+            mfem::out << "BlockCG: Rank deficient block, solving the "
+                      << "remaining columns one at a time.\n";
+         }
+         for (int j = s - 1; j > 0; j--) { pending.Prepend(act[j]); }
+         act.SetSize(1);
+      }
+   };
+
+   while (!stop)
+   {
+      if (act.Size() == 0)
+      {
+         if (pending.Size() == 0) { converged = true; break; }
+         act.Append(pending[0]);
+         pending.DeleteFirst(pending[0]);
+      }
+
+      // (Re)start the iteration with the columns in act: R = B - A X, Z = M R,
+      // P = Z and H = Z^T R
+      const int s = act.Size();
+      for (Vector *v : {&X_blk, &R_blk, &Z_blk, &P_blk, &Q_blk, &Pn_blk})
+      {
+         v->SetSize((v == &Z_blk && !prec) ? 0 : s*n);
+         v->UseDevice(true);
+      }
+      BlockColumns(X_blk, n, s, x_cols);
+      BlockColumns(R_blk, n, s, r_cols);
+      BlockColumns(prec ? Z_blk : R_blk, n, s, z_cols);
+      BlockColumns(P_blk, n, s, p_cols);
+      BlockColumns(Q_blk, n, s, q_cols);
+      BlockColumns(Pn_blk, n, s, pn_cols);
+      const Vector &Zb = prec ? Z_blk : R_blk;
+
+      for (int j = 0; j < s; j++) { x_cols[j] = *X[act[j]]; }
+      BlockApply(*oper, x_cols, r_cols, s);
+      for (int j = 0; j < s; j++)
+      {
+         subtract(*B[act[j]], r_cols[j], r_cols[j]); // r = b - A x
+      }
+      if (prec) { BlockApply(*prec, r_cols, z_cols, s); } // z = B r
+      P_blk = Zb;
+      BlockDots(n, s, Zb, R_blk, part, H);
+      StartGlobalSum(H.Data(), s*s);
+      FinishGlobalSum();
+
+      if (first)
+      {
+         first = false;
+         real_t max_nom = 0.0;
+         for (int j = 0; j < s; j++)
+         {
+            nom0(j) = H(j, j);
+            r0(j) = std::max(nom0(j)*rel_tol*rel_tol, abs_tol*abs_tol);
+            max_nom = std::max(max_nom, nom0(j));
+         }
+         initial_norm = sqrt(max_nom);
+         if (print_options.iterations || print_options.first_and_last)
+         {
+            mfem::out << "   Iteration : " << setw(3) << 0
+                      << "  max (B r, r) = " << max_nom
+                      << (print_options.first_and_last ? " ...\n" : "\n");
+         }
+      }
+
+      while (true)
+      {
+         // Remove the converged columns from the block
+         bool deflate = false;
+         for (int j = 0; j < s; j++)
+         {
+            const int c = act[j];
+            nom(c) = H(j, j);
+            MFEM_VERIFY(IsFinite(nom(c)), "nom = " << nom(c));
+            if (nom(c) < 0.0)
+            {
+               if (print_options.warnings)
+               {
+                  mfem::out << "BlockCG: The preconditioner is not positive "
+                            << "definite. (Br, r) = " << nom(c) << '\n';
+               }
+               stop = true;
+            }
+            else if (nom(c) <= r0(c))
+            {
+               done[c] = true;
+               deflate = true;
+            }
+         }
+         if (stop || deflate || it >= max_iter)
+         {
+            StoreSolution(s);
+            if (it >= max_iter) { stop = true; }
+            if (deflate)
+            {
+               Array<int> remaining;
+               for (int c : act) { if (!done[c]) { remaining.Append(c); } }
+               remaining.Copy(act);
+            }
+            break;
+         }
+
+         // alpha = (P^T A P)^{-1} (Z^T R)
+         BlockApply(*oper, p_cols, q_cols, s); // Q = A P
+         BlockDots(n, s, P_blk, Q_blk, part, G);
+         StartGlobalSum(G.Data(), s*s);
+         FinishGlobalSum();
+         alpha = H;
+         if (!CholeskySolve(G, alpha, breakdown_tol))
+         {
+            Breakdown(s);
+            break;
+         }
+         BlockAddMult(n, s, P_blk, alpha, X_blk); // X = X + P alpha
+         alpha.Neg();
+         BlockAddMult(n, s, Q_blk, alpha, R_blk); // R = R - A P alpha
+         if (prec) { BlockApply(*prec, r_cols, z_cols, s); } // Z = B R
+         BlockDots(n, s, Zb, R_blk, part, Hn);
+         StartGlobalSum(Hn.Data(), s*s);
+         FinishGlobalSum();
+         it++;
+
+         if (print_options.iterations)
+         {
+            real_t max_nom = 0.0;
+            for (int j = 0; j < s; j++)
+            {
+               max_nom = std::max(max_nom, Hn(j, j));
+            }
+            mfem::out << "   Iteration : " << setw(3) << it
+                      << "  max (B r, r) = " << max_nom << '\n';
+         }
+
+         // P = Z + P beta, with beta = H^{-1} Hn
+         DenseMatrix beta(Hn);
+         if (!CholeskySolve(H, beta, breakdown_tol))
+         {
+            Breakdown(s);
+            break;
+         }
+         Pn_blk = Zb;
+         BlockAddMult(n, s, P_blk, beta, Pn_blk);
+         P_blk.Swap(Pn_blk);
+         std::swap(p_cols, pn_cols);
+         H = Hn;
+      }
+   }
+
+   final_iter = it;
+   real_t max_nom = 0.0;
+   for (int c = 0; c < nrhs; c++) { max_nom = std::max(max_nom, nom(c)); }
+   final_norm = sqrt(max_nom);
+   if (print_options.first_and_last && !print_options.iterations)
+   {
+      mfem::out << "   Iteration : " << setw(3) << final_iter
+                << "  max (B r, r) = " << max_nom << '\n';
+   }
+   if (print_options.summary || (print_options.warnings && !converged))
+   {
+      mfem::out << "BlockCG: Number of iterations: " << final_iter << '\n';
+   }
+   if (print_options.warnings && !converged)
+   {
+      mfem::out << "BlockCG: No convergence!" << '\n';
+   }
+}
+
+namespace
+{
+
+/** Compute the local p x q matrix G = U^T V, where the blocks @a U and @a V
+    store at least p and q columns of size n one after another, with the same
+    summation order as BlockDots(). */
+void BlockInnerProducts(const int n, const int p, const Vector &U,
+                        const int q, const Vector &V, Vector &part,
+                        DenseMatrix &G)
+{
+   const int pq = p*q;
+   G.SetSize(p, q);
+   if (pq == 0) { return; }
+   const int nb = (n + block_dots_rows - 1)/block_dots_rows;
+   part.SetSize(pq*(nb + 1));
+   part.UseDevice(true);
+
+   const auto u = U.Read();
+   const auto v = V.Read();
+   auto P = Reshape(part.Write(), pq, nb + 1);
+   mfem::forall(nb, [=] MFEM_HOST_DEVICE (int blk)
+   {
+      const int begin = blk*block_dots_rows;
+      const int end = (begin + block_dots_rows < n) ?
+                      begin + block_dots_rows : n;
+      for (int c = 0; c < pq; c++) { P(c, blk) = 0.0; }
+      for (int i = begin; i < end; i++)
+      {
+         for (int l = 0; l < q; l++)
+         {
+            const real_t vil = v[i + l*n];
+            for (int k = 0; k < p; k++)
+            {
+               P(k + p*l, blk) += u[i + k*n]*vil;
+            }
+         }
+      }
+   });
+   mfem::forall(pq, [=] MFEM_HOST_DEVICE (int c)
+   {
+      real_t sum = 0.0;
+      for (int blk = 0; blk < nb; blk++) { sum += P(c, blk); }
+      P(c, nb) = sum;
+   });
+   const real_t *h_part = part.HostRead();
+   std::copy(h_part + pq*nb, h_part + pq*(nb + 1), G.Data());
+}
+
+/** Compute Y += V C in one pass over V and Y, where the blocks @a V and @a Y
+    store at least C.Height() and C.Width() columns of size n. */
+void BlockAddMult(const int n, const Vector &V, const DenseMatrix &C,
+                  Vector &Y)
+{
+   const int p = C.Height(), q = C.Width();
+   if (p*q == 0) { return; }
+   Vector c(p*q);
+   c.UseDevice(true);
+   std::copy(C.Data(), C.Data() + p*q, c.HostWrite());
+   const auto v = V.Read();
+   const auto d_c = c.Read();
+   auto y = Y.ReadWrite();
+   mfem::forall(n, [=] MFEM_HOST_DEVICE (int i)
+   {
+      for (int j = 0; j < q; j++)
+      {
+         real_t sum = 0.0;
+         for (int k = 0; k < p; k++) { sum += v[i + k*n]*d_c[k + p*j]; }
+         y[i + j*n] += sum;
+      }
+   });
+}
+
+/// Compute y += a V c, where @a V stores at least c.Size() columns of size n.
+void AddColumns(const int n, const Vector &V, const Vector &c, const real_t a,
+                Vector &y)
+{
+   DenseMatrix C(c.Size(), 1);
+   for (int i = 0; i < c.Size(); i++) { C(i, 0) = a*c(i); }
+   BlockAddMult(n, V, C, y);
+}
+
+/// Replace the first q columns of size n of @a V with V T, where T is p x q.
+void TransformColumns(const int n, Vector &V, const DenseMatrix &T)
+{
+   const int q = T.Width();
+   Vector VT(q*n, V.GetMemory().GetMemoryType());
+   VT.UseDevice(true);
+   VT = 0.0;
+   BlockAddMult(n, V, T, VT);
+   Vector V_q(V, 0, q*n);
+   V_q = VT;
+}
+
+/** Resize the block @a V to s columns of size n, keeping its first k
+    columns. */
+void ResizeColumns(Vector &V, const int n, const int k, const int s,
+                   const MemoryType mt)
+{
+   if (V.Size() == s*n) { return; }
+   MFEM_VERIFY(V.Size() >= k*n, "invalid recycled subspace");
+   Vector V_k(k*n, mt);
+   V_k.UseDevice(true);
+   if (k > 0) { V_k = Vector(V, 0, k*n); }
+   V.SetSize(s*n, mt);
+   V.UseDevice(true);
+   if (k > 0) { Vector(V, 0, k*n) = V_k; }
+}
+
+/** Compute the eigenvalues @a lam, in increasing order, and the orthonormal
+    eigenvectors @a Q of the small symmetric matrix @a A with the cyclic Jacobi
+    method. */
+void SymmetricEigensystem(DenseMatrix A, Vector &lam, DenseMatrix &Q)
+{
+   const int s = A.Height();
+   DenseMatrix J(s);
+   J = 0.0;
+   for (int i = 0; i < s; i++) { J(i, i) = 1.0; }
+   const real_t eps = std::numeric_limits<real_t>::epsilon();
+   for (int sweep = 0; sweep < 50; sweep++)
+   {
+      real_t off = 0.0, diag = 0.0;
+      for (int j = 0; j < s; j++)
+      {
+         diag += A(j, j)*A(j, j);
+         for (int i = 0; i < j; i++) { off += 2.0*A(i, j)*A(i, j); }
+      }
+      if (off <= eps*eps*diag) { break; }
+      for (int p = 0; p < s; p++)
+      {
+         for (int q = p + 1; q < s; q++)
+         {
+            const real_t apq = A(p, q);
+            if (apq == 0.0) { continue; }
+            // Rotation zeroing A(p,q), see Golub and Van Loan, Sec. 8.5
+            const real_t theta = (A(q, q) - A(p, p))/(2.0*apq);
+            const real_t t = (theta >= 0.0 ? 1.0 : -1.0)/
+                             (fabs(theta) + sqrt(theta*theta + 1.0));
+            const real_t c = 1.0/sqrt(t*t + 1.0), sn = t*c;
+            for (int i = 0; i < s; i++)
+            {
+               const real_t aip = A(i, p), aiq = A(i, q);
+               A(i, p) = c*aip - sn*aiq;
+               A(i, q) = sn*aip + c*aiq;
+            }
+            for (int i = 0; i < s; i++)
+            {
+               const real_t api = A(p, i), aqi = A(q, i);
+               A(p, i) = c*api - sn*aqi;
+               A(q, i) = sn*api + c*aqi;
+            }
+            for (int i = 0; i < s; i++)
+            {
+               const real_t jip = J(i, p), jiq = J(i, q);
+               J(i, p) = c*jip - sn*jiq;
+               J(i, q) = sn*jip + c*jiq;
+            }
+         }
+      }
+   }
+   std::vector<int> perm(s);
+   for (int i = 0; i < s; i++) { perm[i] = i; }
+   std::sort(perm.begin(), perm.end(),
+             [&](int i, int j) { return A(i, i) < A(j, j); });
+   lam.SetSize(s);
+   Q.SetSize(s);
+   for (int j = 0; j < s; j++)
+   {
+      lam(j) = A(perm[j], perm[j]);
+      for (int i = 0; i < s; i++) { Q(i, j) = J(i, perm[j]); }
+   }
+}
+
+/** Compute a matrix T with T^T F T = I whose columns span the numerical range
+    of the small symmetric positive semi-definite matrix @a F. The directions
+    in which the diagonally scaled F is numerically singular are discarded. */
+void Whitening(const DenseMatrix &F, DenseMatrix &T)
+{
+   const int s = F.Height();
+   Vector d(s), lam;
+   for (int i = 0; i < s; i++)
+   {
+      d(i) = (F(i, i) > 0.0) ? 1.0/sqrt(F(i, i)) : 0.0;
+   }
+   DenseMatrix DFD(s), Q;
+   for (int j = 0; j < s; j++)
+   {
+      for (int i = 0; i < s; i++) { DFD(i, j) = d(i)*F(i, j)*d(j); }
+   }
+   SymmetricEigensystem(DFD, lam, Q);
+   const real_t tol = sqrt(std::numeric_limits<real_t>::epsilon());
+   int first = 0;
+   while (first < s && !(lam(first) > tol*lam(s - 1))) { first++; }
+   T.SetSize(s, s - first);
+   for (int j = 0; j < s - first; j++)
+   {
+      const real_t scale = 1.0/sqrt(lam(first + j));
+      for (int i = 0; i < s; i++) { T(i, j) = d(i)*Q(i, first + j)*scale; }
+   }
+}
+
+/** Compute in the columns of @a Y the eigenvectors of the (at most) @a kmax
+    smallest eigenvalues of G y = theta F y, where G is symmetric and F is
+    symmetric positive semi-definite, normalized with Y^T F Y = I. If @a G_spd
+    is true, G must be positive semi-definite and the eigenvectors are
+    computed from the largest eigenvalues 1/theta of F y = 1/theta G y, with
+    Y^T G Y = I, which is more accurate when G is ill-conditioned. Return the
+    number of columns of Y. */
+int SmallestEigenvectors(const DenseMatrix &G, const DenseMatrix &F,
+                         const int kmax, DenseMatrix &Y,
+                         const bool G_spd = false)
+{
+   const int s = G.Height();
+   DenseMatrix T;
+   Whitening(G_spd ? G : F, T);
+   const int r = T.Width();
+   DenseMatrix MT(s, r), TMT(r), S;
+   Vector theta;
+   mfem::Mult(G_spd ? F : G, T, MT);
+   MultAtB(T, MT, TMT);
+   TMT.Symmetrize();
+   SymmetricEigensystem(TMT, theta, S);
+   const int kk = std::min(kmax, r);
+   Y.SetSize(s, kk);
+   for (int j = 0; j < kk; j++)
+   {
+      const int js = G_spd ? r - 1 - j : j;
+      for (int i = 0; i < s; i++)
+      {
+         real_t sum = 0.0;
+         for (int l = 0; l < r; l++) { sum += T(i, l)*S(l, js); }
+         Y(i, j) = sum;
+      }
+   }
+   return kk;
+}
+
+}
+
+void DeflatedCGSolver::UpdateVectors()
+{
+   MemoryType mt = GetMemoryType(oper->GetMemoryClass());
+
+   r.SetSize(width, mt);
+   r.UseDevice(true);
+
+   z.SetSize(width, mt);
+   z.UseDevice(true);
+
+   p.SetSize(width, mt);
+   p.UseDevice(true);
+
+   q.SetSize(width, mt);
+   q.UseDevice(true);
+}
+
+void DeflatedCGSolver::SetOperator(const Operator &op)
+{
+   MFEM_VERIFY(k == 0 || op.Height() == height,
+               "the size of the operator changed, call ClearRecycleSpace()");
+   IterativeSolver::SetOperator(op);
+   UpdateVectors();
+   aw_valid = false;
+}
+
+void DeflatedCGSolver::UpdateDeflation() const
+{
+   const int n = width;
+   for (int j = 0; j < k; j++)
+   {
+      Vector w(Z, j*n, n), aw(AZ, j*n, n);
+      oper->Mult(w, aw);
+   }
+   BlockInnerProducts(n, k, Z, k, AZ, part, E);
+   StartGlobalSum(E.Data(), k*k);
+   FinishGlobalSum();
+   E.Symmetrize();
+
+   DenseMatrix L(E), H(k, 0);
+   if (!CholeskySolve(L, H, 1e-12))
+   {
+      if (print_options.warnings)
+      {
+         mfem::out << "DeflatedCG: W^T A W is not positive definite, "
+                   "the recycled subspace is discarded.\n";
+      }
+      k = 0;
+   }
+   aw_valid = true;
+}
+
+void DeflatedCGSolver::UpdateRecycleSpace(int s) const
+{
+   const int n = width;
+   DenseMatrix G, F, Y;
+   BlockInnerProducts(n, s, Z, s, AZ, part, G);
+   StartGlobalSum(G.Data(), s*s);
+   FinishGlobalSum();
+   BlockInnerProducts(n, s, Z, s, Z, part, F);
+   StartGlobalSum(F.Data(), s*s);
+   FinishGlobalSum();
+   G.Symmetrize();
+   F.Symmetrize();
+
+   // A-orthonormal Ritz vectors W = Z Y of the smallest Ritz values, with
+   // A W = (A Z) Y
+   k = SmallestEigenvectors(G, F, recycle_dim, Y, true);
+   TransformColumns(n, Z, Y);
+   TransformColumns(n, AZ, Y);
+
+   DenseMatrix GY(s, k), L, H(k, 0);
+   mfem::Mult(G, Y, GY);
+   E.SetSize(k);
+   MultAtB(Y, GY, E);
+   E.Symmetrize();
+   L = E;
+   if (!CholeskySolve(L, H, 1e-12)) { k = 0; }
+   aw_valid = true;
+}
+
+void DeflatedCGSolver::ProjectionCoefficients(const Vector &V,
+                                              const Vector &u,
+                                              Vector &c) const
+{
+   DenseMatrix G, L(E);
+   BlockInnerProducts(width, k, V, 1, u, part, G);
+   StartGlobalSum(G.Data(), k);
+   FinishGlobalSum();
+   CholeskySolve(L, G, 0.0);
+   c.SetSize(k);
+   for (int i = 0; i < k; i++) { c(i) = G(i, 0); }
+}
+
+void DeflatedCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_PERF_SCOPE("DeflatedCGSolver::Mult");
+
+   int i;
+   real_t r0, den, nom, nom0, betanom, alpha, beta;
+   const int n = width;
+
+   if (k > recycle_dim)
+   {
+      k = recycle_dim;
+      aw_valid = false;
+   }
+   const MemoryType mt = GetMemoryType(oper->GetMemoryClass());
+   if (Z.Size() != (recycle_dim + num_stored)*n) { aw_valid = false; }
+   ResizeColumns(Z, n, k, recycle_dim + num_stored, mt);
+   ResizeColumns(AZ, n, 0, recycle_dim + num_stored, mt);
+   if (k > 0 && !aw_valid) { UpdateDeflation(); }
+
+   Vector c;
+   x.UseDevice(true);
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+   if (prec)
+   {
+      prec->Mult(r, z); // z = B r
+   }
+   else
+   {
+      z = r;
+   }
+   // The tolerance is relative to the initial residual, as in CGSolver
+   nom0 = nom = Dot(z, r);
+   if (nom0 >= 0.0) { initial_norm = sqrt(nom0); }
+   MFEM_VERIFY(IsFinite(nom), "nom = " << nom);
+   if (k > 0 && nom0 > 0.0)
+   {
+      // Galerkin projection onto W: x += W c, r -= A W c, c = E^{-1} W^T r
+      ProjectionCoefficients(Z, r, c);
+      AddColumns(n, Z, c, 1.0, x);
+      AddColumns(n, AZ, c, -1.0, r);
+      if (prec)
+      {
+         prec->Mult(r, z);
+      }
+      else
+      {
+         z = r;
+      }
+      nom = Dot(z, r);
+      MFEM_VERIFY(IsFinite(nom), "nom = " << nom);
+   }
+   p = z;
+   if (k > 0)
+   {
+      // p = z - W E^{-1} (A W)^T z is A-orthogonal to W
+      ProjectionCoefficients(AZ, z, c);
+      AddColumns(n, Z, c, -1.0, p);
+   }
+   if (print_options.iterations || print_options.first_and_last)
+   {
+      mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                << nom << (print_options.first_and_last ? " ...\n" : "\n");
+   }
+
+   if (nom < 0.0)
+   {
+      if (print_options.warnings)
+      {
+         mfem::out << "DeflatedCG: The preconditioner is not positive "
+                   "definite. (Br, r) = " << nom << '\n';
+      }
+      converged = false;
+      final_iter = 0;
+      initial_norm = nom;
+      final_norm = nom;
+
+      Monitor(0, nom, r, x, true);
+      return;
+   }
+   r0 = std::max(nom0*rel_tol*rel_tol, abs_tol*abs_tol);
+   if (Monitor(0, nom, r, x) || nom <= r0)
+   {
+      converged = true;
+      final_iter = 0;
+      final_norm = sqrt(nom);
+
+      Monitor(0, nom, r, x, true);
+      return;
+   }
+
+   oper->Mult(p, q);  // q = A p
+   den = Dot(p, q);
+   MFEM_VERIFY(IsFinite(den), "den = " << den);
+
+   // start iteration
+   converged = false;
+   final_iter = max_iter;
+   betanom = nom;
+   int stored = 0;
+   for (i = 1; den > 0.0; )
+   {
+      if (stored < num_stored && recycle_dim > 0)
+      {
+         // Keep the first search directions for the update of W
+         Vector z_s(Z, (k + stored)*n, n), az_s(AZ, (k + stored)*n, n);
+         z_s = p;
+         az_s = q;
+         stored++;
+      }
+
+      alpha = nom/den;
+      add(x,  alpha, p, x);     //  x = x + alpha p
+      add(r, -alpha, q, r);     //  r = r - alpha A p
+
+      if (prec)
+      {
+         prec->Mult(r, z);      //  z = B r
+      }
+      else
+      {
+         z = r;
+      }
+      betanom = Dot(r, z);
+      MFEM_VERIFY(IsFinite(betanom), "betanom = " << betanom);
+      if (betanom < 0.0)
+      {
+         if (print_options.warnings)
+         {
+            mfem::out << "DeflatedCG: The preconditioner is not positive "
+                      "definite. (Br, r) = " << betanom << '\n';
+         }
+         converged = false;
+         final_iter = i;
+         break;
+      }
+
+      if (print_options.iterations)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                   << betanom << std::endl;
+      }
+
+      if (Monitor(i, betanom, r, x) || betanom <= r0)
+      {
+         converged = true;
+         final_iter = i;
+         break;
+      }
+
+      if (++i > max_iter)
+      {
+         break;
+      }
+
+      beta = betanom/nom;
+      add(z, beta, p, p);       //  p = z + beta p
+      if (k > 0)
+      {
+         ProjectionCoefficients(AZ, z, c);
+         AddColumns(n, Z, c, -1.0, p);
+      }
+      oper->Mult(p, q);         //  q = A p
+      den = Dot(p, q);
+      MFEM_VERIFY(IsFinite(den), "den = " << den);
+      nom = betanom;
+   }
+   if (den <= 0.0)
+   {
+      if (print_options.warnings)
+      {
+         mfem::out << "DeflatedCG: The operator is not positive definite. "
+                   "(Ap, p) = " << den << '\n';
+      }
+      final_iter = i - 1;
+   }
+   if (print_options.first_and_last && !print_options.iterations)
+   {
+      mfem::out << "   Iteration : " << setw(3) << final_iter << "  (B r, r) = "
+                << betanom << '\n';
+   }
+   if (print_options.summary || (print_options.warnings && !converged))
+   {
+      mfem::out << "DeflatedCG: Number of iterations: " << final_iter << '\n';
+   }
+   if (print_options.warnings && !converged)
+   {
+      mfem::out << "DeflatedCG: No convergence!" << '\n';
+   }
+
+   if (stored > 0) { UpdateRecycleSpace(k + stored); }
+
+   final_norm = sqrt(betanom);
+
+   Monitor(final_iter, final_norm, r, x, true);
+}
+
+
+inline void GeneratePlaneRotation(real_t &dx, real_t &dy,
+                                  real_t &cs, real_t &sn)
+{
+   if (dy == 0.0)
+   {
+      cs = 1.0;
+      sn = 0.0;
+   }
+   else if (fabs(dy) > fabs(dx))
+   {
+      real_t temp = dx / dy;
+      sn = 1.0 / sqrt( 1.0 + temp*temp );
+      cs = temp * sn;
+   }
+   else
+   {
+      real_t temp = dy / dx;
+      cs = 1.0 / sqrt( 1.0 + temp*temp );
+      sn = temp * cs;
+   }
+}
+
+inline void ApplyPlaneRotation(real_t &dx, real_t &dy, real_t &cs, real_t &sn)
+{
+   real_t temp = cs * dx + sn * dy;
+   dy = -sn * dx + cs * dy;
+   dx = temp;
+}
+
+inline void Update(Vector &x, int k, DenseMatrix &h, Vector &s,
+                   Array<Vector*> &v)
+{
+   Vector y(s);
+
+   // Backsolve:
+   for (int i = k; i >= 0; i--)
+   {
+      y(i) /= h(i,i);
+      for (int j = i - 1; j >= 0; j--)
+      {
+         y(j) -= h(j,i) * y(i);
+      }
+   }
+
+   for (int j = 0; j <= k; j++)
+   {
+      x.Add(y(j), *v[j]);
+   }
+}
+
+void GMRESSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_PERF_SCOPE("GMRESSolver::Mult");
+
+   // Generalized Minimum Residual method following the algorithm
+   // on p. 20 of the SIAM Templates book.
+
+   int n = width;
+
+   DenseMatrix H(m+1, m);
+   Vector s(m+1), cs(m+1), sn(m+1);
+   Vector r(n), w(n), x_monitor;
+   Array<Vector *> v;
+
+   b.UseDevice(true);
+   x.UseDevice(true);
+   r.UseDevice(true);
+   w.UseDevice(true);
+
+   if (ControllerRequiresUpdate())
+   {
+      x_monitor.SetSize(n);
+      x_monitor.UseDevice(true);
+   }
+   else
+   {
+      x_monitor.MakeRef(x, 0, n);
+   }
+
+   int i, j, k;
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+   }
+   else
+   {
+      x = 0.0;
+   }
+
+   if (prec)
+   {
+      if (iterative_mode)
+      {
+         subtract(b, r, w);
+         prec->Mult(w, r);    // r = M (b - A x)
+      }
+      else
+      {
+         prec->Mult(b, r);
+      }
+   }
+   else
+   {
+      if (iterative_mode)
+      {
+         subtract(b, r, r);
+      }
+      else
+      {
+         r = b;
+      }
+   }
+   real_t beta = initial_norm = Norm(r);  // beta = ||r||
+   MFEM_VERIFY(IsFinite(beta), "beta = " << beta);
+
+   final_norm = std::max(rel_tol*beta, abs_tol);
+
+   if (Monitor(0, beta, r, x) || beta <= final_norm)
+   {
+      final_norm = beta;
+      final_iter = 0;
+      converged = true;
+      j = 0;
+      goto finish;
+   }
+
+   if (print_options.iterations || print_options.first_and_last)
+   {
+      mfem::out << "   Pass : " << setw(2) << 1
+                << "   Iteration : " << setw(3) << 0
+                << "  ||B r|| = " << beta
+                << (print_options.first_and_last ? " ...\n" : "\n");
+   }
+
+   v.SetSize(m+1, NULL);
+
+   for (j = 1; j <= max_iter; )
+   {
+      if (v[0] == NULL)
+      {
+         v[0] = new Vector(n);
+         v[0]->UseDevice(true);
+      }
+      v[0]->Set(1.0/beta, r);
+      s = 0.0; s(0) = beta;
+
+      for (i = 0; i < m && j <= max_iter; i++, j++)
+      {
+         if (prec)
+         {
+            oper->Mult(*v[i], r);
+            prec->Mult(r, w);        // w = M A v[i]
+         }
+         else
+         {
+            oper->Mult(*v[i], w);
+         }
+
+         for (k = 0; k <= i; k++)
+         {
+            H(k,i) = Dot(w, *v[k]);  // H(k,i) = w * v[k]
+            w.Add(-H(k,i), *v[k]);   // w -= H(k,i) * v[k]
+         }
+
+         H(i+1,i) = Norm(w);           // H(i+1,i) = ||w||
+         MFEM_VERIFY(IsFinite(H(i+1,i)), "Norm(w) = " << H(i+1,i));
+         if (v[i+1] == NULL) { v[i+1] = new Vector(n); }
+         v[i+1]->Set(1.0/H(i+1,i), w); // v[i+1] = w / H(i+1,i)
+
+         for (k = 0; k < i; k++)
+         {
+            ApplyPlaneRotation(H(k,i), H(k+1,i), cs(k), sn(k));
+         }
+
+         GeneratePlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
+         ApplyPlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
+         ApplyPlaneRotation(s(i), s(i+1), cs(i), sn(i));
+
+         const real_t resid = fabs(s(i+1));
+         MFEM_VERIFY(IsFinite(resid), "resid = " << resid);
+
+         if (ControllerRequiresUpdate())
+         {
+            x_monitor = x;
+            Update(x_monitor, i, H, s, v);
+         }
+
+         if (Monitor(j, resid, r, x_monitor) || resid <= final_norm)
+         {
+            Update(x, i, H, s, v);
+            final_norm = resid;
+            final_iter = j;
+            converged = true;
+            goto finish;
+         }
+
+         if (print_options.iterations)
+         {
+            mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
+                      << "   Iteration : " << setw(3) << j
+                      << "  ||B r|| = " << resid << '\n';
+         }
+      }
+
+      if (print_options.iterations && j <= max_iter)
+      {
+         mfem::out << "Restarting..." << '\n';
+      }
+
+      Update(x, i-1, H, s, v);
+
+      oper->Mult(x, r);
+      if (prec)
+      {
+         subtract(b, r, w);
+         prec->Mult(w, r);    // r = M (b - A x)
+      }
+      else
+      {
+         subtract(b, r, r);
       }
       beta = Norm(r);         // beta = ||r||
       MFEM_VERIFY(IsFinite(beta), "beta = " << beta);
       if (beta <= final_norm)
       {
          final_norm = beta;
-         final_iter = j;
+         final_iter = j;
+         converged = true;
+         goto finish;
+      }
+   }
+
+   final_norm = beta;
+   final_iter = max_iter;
+   converged = false;
+
+finish:
+   if ((print_options.iterations && converged) || print_options.first_and_last)
+   {
+      mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
+                << "   Iteration : " << setw(3) << final_iter
+                << "  ||B r|| = " << final_norm << '\n';
+   }
+   if (print_options.summary || (print_options.warnings && !converged))
+   {
+      mfem::out << "GMRES: Number of iterations: " << final_iter << '\n';
+   }
+   if (print_options.warnings && !converged)
+   {
+      mfem::out << "GMRES: No convergence!\n";
+   }
+
+   Monitor(final_iter, final_norm, r, x, true);
+
+   for (i = 0; i < v.Size(); i++)
+   {
+      delete v[i];
+   }
+}
+
+void FGMRESSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_PERF_SCOPE("FGMRESSolver::Mult");
+
+   DenseMatrix H(m+1,m);
+   Vector s(m+1), cs(m+1), sn(m+1);
+   Vector r(b.Size()), x_monitor;
+
+   b.UseDevice(true);
+   x.UseDevice(true);
+   r.UseDevice(true);
+
+   if (ControllerRequiresUpdate())
+   {
+      x_monitor.SetSize(x.Size());
+      x_monitor.UseDevice(true);
+   }
+   else
+   {
+      x_monitor.MakeRef(x, 0, x.Size());
+   }
+
+   int i, j, k;
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b,r,r);
+   }
+   else
+   {
+      x = 0.;
+      r = b;
+   }
+   real_t beta = initial_norm = Norm(r);  // beta = ||r||
+   MFEM_VERIFY(IsFinite(beta), "beta = " << beta);
+
+   final_norm = std::max(rel_tol*beta, abs_tol);
+
+   if (Monitor(0, beta, r, x) || beta <= final_norm)
+   {
+      converged = true;
+      final_norm = beta;
+      final_iter = 0;
+
+      Monitor(0, beta, r, x, true);
+      return;
+   }
+
+   // initialize the first pass
+   converged = false;
+
+   if (print_options.iterations || print_options.first_and_last)
+   {
+      mfem::out << "   Pass : " << setw(2) << 1
+                << "   Iteration : " << setw(3) << 0
+                << "  || r || = " << beta
+                << (print_options.first_and_last ? " ...\n" : "\n");
+   }
+
+   Array<Vector*> v(m+1);
+   Array<Vector*> z(m+1);
+   for (i= 0; i<=m; i++)
+   {
+      v[i] = NULL;
+      z[i] = NULL;
+   }
+
+   j = 1;
+   while (j <= max_iter)
+   {
+      if (v[0] == NULL)
+      {
+         v[0] = new Vector(b.Size());
+         v[0]->UseDevice(true);
+      }
+      (*v[0]) = 0.0;
+      v[0] -> Add (1.0/beta, r);   // v[0] = r / ||r||
+      s = 0.0; s(0) = beta;
+
+      for (i = 0; i < m && j <= max_iter; i++, j++)
+      {
+
+         if (z[i] == NULL)
+         {
+            z[i] = new Vector(b.Size());
+            z[i]->UseDevice(true);
+         }
+         (*z[i]) = 0.0;
+
+         if (prec)
+         {
+            prec->Mult(*v[i], *z[i]);
+         }
+         else
+         {
+            (*z[i]) = (*v[i]);
+         }
+         oper->Mult(*z[i], r);
+
+         for (k = 0; k <= i; k++)
+         {
+            H(k,i) = Dot( r, *v[k]); // H(k,i) = r * v[k]
+            r.Add(-H(k,i), (*v[k])); // r -= H(k,i) * v[k]
+         }
+
+         H(i+1,i)  = Norm(r);       // H(i+1,i) = ||r||
+         if (v[i+1] == NULL)
+         {
+            v[i+1] = new Vector(b.Size());
+            v[i+1]->UseDevice(true);
+         }
+         (*v[i+1]) = 0.0;
+         v[i+1] -> Add (1.0/H(i+1,i), r); // v[i+1] = r / H(i+1,i)
+
+         for (k = 0; k < i; k++)
+         {
+            ApplyPlaneRotation(H(k,i), H(k+1,i), cs(k), sn(k));
+         }
+
+         GeneratePlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
+         ApplyPlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
+         ApplyPlaneRotation(s(i), s(i+1), cs(i), sn(i));
+
+         const real_t resid = fabs(s(i+1));
+         MFEM_VERIFY(IsFinite(resid), "resid = " << resid);
+         if (print_options.iterations || (print_options.first_and_last &&
+                                          resid <= final_norm))
+         {
+            mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
+                      << "   Iteration : " << setw(3) << j
+                      << "  || r || = " << resid << endl;
+         }
+
+         if (ControllerRequiresUpdate())
+         {
+            x_monitor = x;
+            Update(x_monitor, i, H, s, z);
+         }
+
+         if (Monitor(j, resid, r, x_monitor) || resid <= final_norm)
+         {
+            Update(x, i, H, s, z);
+            final_norm = resid;
+            final_iter = j;
+            converged = true;
+
+            if (print_options.summary)
+            {
+               mfem::out << "FGMRES: Number of iterations: " << final_iter << '\n';
+            }
+
+            for (i= 0; i<=m; i++)
+            {
+               if (v[i]) { delete v[i]; }
+               if (z[i]) { delete z[i]; }
+            }
+
+            Monitor(j, resid, r, x, true);
+            return;
+         }
+      }
+
+      if (print_options.iterations)
+      {
+         mfem::out << "Restarting..." << endl;
+      }
+
+      Update(x, i-1, H, s, z);
+
+      oper->Mult(x, r);
+      subtract(b,r,r);
+      beta = Norm(r);
+      MFEM_VERIFY(IsFinite(beta), "beta = " << beta);
+      if (beta <= final_norm)
+      {
+         converged = true;
+
+         break;
+      }
+   }
+
+   // Clean buffers up
+   for (i = 0; i <= m; i++)
+   {
+      if (v[i]) { delete v[i]; }
+      if (z[i]) { delete z[i]; }
+   }
+
+   final_norm = beta;
+   final_iter = converged ? j : max_iter;
+
+   // Note: j is off by one when we arrive here
+   if (!print_options.iterations && print_options.first_and_last)
+   {
+      mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
+                << "   Iteration : " << setw(3) << j-1
+                << "  || r || = " << final_norm << endl;
+   }
+   if (print_options.summary || (print_options.warnings && !converged))
+   {
+      mfem::out << "FGMRES: Number of iterations: " << final_iter << '\n';
+   }
+   if (print_options.warnings && !converged)
+   {
+      mfem::out << "FGMRES: No convergence!\n";
+   }
+
+   Monitor(final_iter, final_norm, r, x, true);
+}
+
+
+namespace
+{
+
+/// Number of rows of the basis summed by one thread in BasisDots()
+constexpr int basis_dots_block = 256;
+
+/** Compute, in one pass over the first @a j columns of the contiguous basis
+    @a V, the local inner products [V^T u, u.u] and, if @a w is not NULL,
+    [V^T w, u.w, w.w]. The partial sums over blocks of rows are added in a
+    fixed order, so the result does not depend on the device. */
+void BasisDots(const int n, const int j, const Vector &V, const Vector &u,
+               const Vector *w, Vector &part, Vector &dots)
+{
+   const bool has_w = (w != nullptr);
+   const int nv = has_w ? 2*j + 3 : j + 1;
+   const int nb = (n + basis_dots_block - 1)/basis_dots_block;
+   part.SetSize(nv*nb);
+   part.UseDevice(true);
+   dots.SetSize(nv);
+   dots.UseDevice(true);
+
+   const auto B = V.Read();
+   const auto U = u.Read();
+   const auto W = has_w ? w->Read() : nullptr;
+   auto P = Reshape(part.Write(), nv, nb);
+   mfem::forall(nb, [=] MFEM_HOST_DEVICE (int blk)
+   {
+      const int begin = blk*basis_dots_block;
+      const int end = (begin + basis_dots_block < n) ?
+                      begin + basis_dots_block : n;
+      for (int c = 0; c < nv; c++) { P(c, blk) = 0.0; }
+      for (int i = begin; i < end; i++)
+      {
+         const real_t ui = U[i];
+         const real_t wi = has_w ? W[i] : 0.0;
+         for (int k = 0; k < j; k++)
+         {
+            const real_t vik = B[i + k*n];
+            P(k, blk) += vik*ui;
+            if (has_w) { P(j + 1 + k, blk) += vik*wi; }
+         }
+         P(j, blk) += ui*ui;
+         if (has_w)
+         {
+            P(2*j + 1, blk) += ui*wi;
+            P(2*j + 2, blk) += wi*wi;
+         }
+      }
+   });
+   auto D = dots.Write();
+   mfem::forall(nv, [=] MFEM_HOST_DEVICE (int c)
+   {
+      real_t sum = 0.0;
+      for (int blk = 0; blk < nb; blk++) { sum += P(c, blk); }
+      D[c] = sum;
+   });
+}
+
+/** Add to @a x the combination of the first k+1 columns of the contiguous
+    basis @a V, with the coefficients solving the upper triangular system with
+    the matrix @a R and right-hand side @a s. */
+void UpdateFromBasis(Vector &x, const int k, const DenseMatrix &R,
+                     const Vector &s, const Vector &V)
+{
+   Vector y(k + 1);
+   y.UseDevice(true);
+   real_t *Y = y.HostWrite();
+   for (int i = k; i >= 0; i--)
+   {
+      Y[i] = s(i);
+      for (int l = i + 1; l <= k; l++) { Y[i] -= R(i, l)*Y[l]; }
+      Y[i] /= R(i, i);
+   }
+
+   const int n = x.Size();
+   const auto B = V.Read();
+   const auto Yd = y.Read();
+   auto X = x.ReadWrite();
+   mfem::forall(n, [=] MFEM_HOST_DEVICE (int i)
+   {
+      real_t sum = 0.0;
+      for (int l = 0; l <= k; l++) { sum += B[i + l*n]*Yd[l]; }
+      X[i] += sum;
+   });
+}
+
+}
+
+void LowSyncGMRESSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_PERF_SCOPE("LowSyncGMRESSolver::Mult");
+
+   const int n = width;
+   const char *name = flexible ? "LowSyncFGMRES" : "LowSyncGMRES";
+   const char *norm_name = flexible ? "|| r ||" : "||B r||";
+   // Below this relative size, the norm of the new basis vector obtained from
+   // the Pythagorean identity is inaccurate and it is computed explicitly
+   const real_t pythagoras_tol = sqrt(std::numeric_limits<real_t>::epsilon());
+
+   // H is the Hessenberg matrix of the Arnoldi relation and R its rotated,
+   // upper triangular, version
+   DenseMatrix H(m+1, m), R(m+1, m);
+   Vector s(m+1), cs(m+1), sn(m+1);
+   Vector a(m+1), d(m+1), qw(m+1), Ha(m+1), dots, part;
+   Vector r(n), w(n), x_monitor;
+   // Contiguous bases: V(:,k) is column k of V and, if flexible, Z(:,k) is the
+   // preconditioned V(:,k)
+   Vector V((m+1)*n), Z(flexible ? m*n : 0), vj, zj;
+
+   b.UseDevice(true);
+   x.UseDevice(true);
+   r.UseDevice(true);
+   w.UseDevice(true);
+   V.UseDevice(true);
+   Z.UseDevice(true);
+   a.UseDevice(true);
+   d.UseDevice(true);
+
+   if (ControllerRequiresUpdate())
+   {
+      x_monitor.SetSize(n);
+      x_monitor.UseDevice(true);
+   }
+   else
+   {
+      x_monitor.MakeRef(x, 0, n);
+   }
+
+   // r = b - A x, or r = B (b - A x) with left preconditioning
+   auto Residual = [&]()
+   {
+      if (!flexible && prec)
+      {
+         oper->Mult(x, r);
+         subtract(b, r, w);
+         prec->Mult(w, r);
+      }
+      else
+      {
+         oper->Mult(x, r);
+         subtract(b, r, r);
+      }
+   };
+
+   if (iterative_mode)
+   {
+      Residual();
+   }
+   else
+   {
+      x = 0.0;
+      if (!flexible && prec) { prec->Mult(b, r); }
+      else { r = b; }
+   }
+   real_t beta = initial_norm = Norm(r);
+   MFEM_VERIFY(IsFinite(beta), "beta = " << beta);
+
+   final_norm = std::max(rel_tol*beta, abs_tol);
+   converged = false;
+   int it = 0; // total number of iterations
+   real_t resid = beta;
+
+   if (Monitor(0, beta, r, x) || beta <= final_norm)
+   {
+      final_norm = beta;
+      final_iter = 0;
+      converged = true;
+      goto finish;
+   }
+
+   if (print_options.iterations || print_options.first_and_last)
+   {
+      mfem::out << "   Pass : " << setw(2) << 1
+                << "   Iteration : " << setw(3) << 0
+                << "  " << norm_name << " = " << beta
+                << (print_options.first_and_last ? " ...\n" : "\n");
+   }
+
+   while (true)
+   {
+      // V(:,0) = r / ||r||
+      vj.MakeRef(V, 0, n);
+      vj.UseDevice(true);
+      vj.Set(1.0/beta, r);
+      s = 0.0; s(0) = beta;
+      H = 0.0;
+
+      // At the beginning of step j, the columns 0..j-1 of V are orthonormal,
+      // V(:,j) is orthogonalized once and normalized approximately (with the
+      // factor nu), and the columns 0..j-2 of H are final. Step j applies the
+      // operator to V(:,j), completes V(:,j) and column j-1 of H, and computes
+      // the next basis vector V(:,j+1), all with a single global reduction.
+      real_t nu = 1.0;
+      bool breakdown = false;
+      int j = 0;
+      while (true)
+      {
+         const bool last = (j == m) || (it == max_iter) || breakdown;
+         vj.MakeRef(V, j*n, n);
+         vj.UseDevice(true);
+         if (!last)
+         {
+            if (flexible)
+            {
+               zj.MakeRef(Z, j*n, n);
+               zj.UseDevice(true);
+               if (prec) { prec->Mult(vj, zj); }
+               else { zj = vj; }
+               oper->Mult(zj, w);
+            }
+            else if (prec)
+            {
+               oper->Mult(vj, r);
+               prec->Mult(r, w);
+            }
+            else
+            {
+               oper->Mult(vj, w);
+            }
+         }
+
+         // The single global reduction of the step
+         real_t *D = nullptr;
+         real_t omega = 1.0;
+         real_t *A = a.HostWrite();
+         if (!breakdown)
+         {
+            BasisDots(n, j, V, vj, last ? nullptr : &w, part, dots);
+            D = dots.HostReadWrite();
+            StartGlobalSum(D, dots.Size());
+            FinishGlobalSum();
+            real_t omega2 = D[j];
+            for (int k = 0; k < j; k++)
+            {
+               A[k] = D[k];
+               omega2 -= A[k]*A[k];
+            }
+            MFEM_VERIFY(IsFinite(omega2), "omega^2 = " << omega2);
+            // A nonpositive omega^2 means that V(:,j) is numerically in the
+            // span of the previous columns: the Krylov space is exhausted or
+            // the orthogonality is lost, and the iteration stops below.
+            omega = (omega2 > 0.0) ? sqrt(omega2) : 0.0;
+         }
+         else
+         {
+            for (int k = 0; k < j; k++) { A[k] = 0.0; }
+         }
+
+         if (j > 0)
+         {
+            // Complete column j-1 of H, with the reorthogonalization of V(:,j)
+            const int i = j - 1;
+            for (int k = 0; k < j; k++) { H(k, i) += nu*A[k]; }
+            H(j, i) = nu*omega;
+
+            for (int k = 0; k <= j; k++) { R(k, i) = H(k, i); }
+            for (int k = 0; k < i; k++)
+            {
+               ApplyPlaneRotation(R(k, i), R(k+1, i), cs(k), sn(k));
+            }
+            GeneratePlaneRotation(R(i, i), R(i+1, i), cs(i), sn(i));
+            ApplyPlaneRotation(R(i, i), R(i+1, i), cs(i), sn(i));
+            ApplyPlaneRotation(s(i), s(i+1), cs(i), sn(i));
+
+            resid = fabs(s(i+1));
+            MFEM_VERIFY(IsFinite(resid), "resid = " << resid);
+
+            if (omega == 0.0)
+            {
+               // Breakdown: the estimate above is not reliable, stop with the
+               // norm of the true residual
+               UpdateFromBasis(x, i, R, s, flexible ? Z : V);
+               Residual();
+               resid = Norm(r);
+               MFEM_VERIFY(IsFinite(resid), "resid = " << resid);
+               if (print_options.warnings)
+               {
+                  mfem::out << name << ": breakdown at iteration " << it
+                            << ", " << norm_name << " = " << resid << '\n';
+               }
+               converged = (resid <= final_norm);
+               final_norm = resid;
+               final_iter = it;
+               goto finish;
+            }
+
+            if (ControllerRequiresUpdate())
+            {
+               x_monitor = x;
+               UpdateFromBasis(x_monitor, i, R, s, flexible ? Z : V);
+            }
+
+            if (Monitor(it, resid, r, x_monitor) || resid <= final_norm)
+            {
+               UpdateFromBasis(x, i, R, s, flexible ? Z : V);
+               final_norm = resid;
+               final_iter = it;
+               converged = true;
+               goto finish;
+            }
+
+            if (print_options.iterations)
+            {
+               mfem::out << "   Pass : " << setw(2) << (it-1)/m+1
+                         << "   Iteration : " << setw(3) << it
+                         << "  " << norm_name << " = " << resid << '\n';
+            }
+         }
+
+         if (last)
+         {
+            if (j > 0) { UpdateFromBasis(x, j-1, R, s, flexible ? Z : V); }
+            break;
+         }
+
+         // The projection of A V(:,j) onto the completed basis V(:,0..j),
+         // computed from the reduction with A V(:,j) = (w - V H a)/omega.
+         real_t ab = 0.0;
+         for (int k = 0; k < j; k++)
+         {
+            qw(k) = D[j+1+k];
+            ab += A[k]*D[j+1+k];
+         }
+         qw(j) = (D[2*j+1] - ab)/omega;
+         for (int k = 0; k <= j; k++)
+         {
+            Ha(k) = 0.0;
+            for (int l = 0; l < j; l++) { Ha(k) += H(k, l)*A[l]; }
+         }
+         real_t wn2 = D[2*j+2], cc = 0.0;
+         real_t *Dd = d.HostWrite();
+         for (int k = 0; k <= j; k++)
+         {
+            wn2 += Ha(k)*Ha(k) - 2.0*qw(k)*Ha(k);
+            H(k, j) = (qw(k) - Ha(k))/omega;
+            cc += H(k, j)*H(k, j);
+            Dd[k] = Ha(k) + omega*H(k, j);
+         }
+         wn2 /= omega*omega;
+         const real_t nu2 = wn2 - cc;
+         const bool explicit_norm = !(nu2 > pythagoras_tol*wn2);
+         nu = explicit_norm ? 1.0 : sqrt(nu2);
+
+         // Complete V(:,j) (and Z(:,j)) and compute V(:,j+1), in one pass
+         {
+            const int jj = j;
+            const bool flex = flexible;
+            const real_t inv_omega = 1.0/omega;
+            const real_t inv_scale = 1.0/(omega*nu);
+            const auto Ad = a.Read();
+            const auto Dv = d.Read();
+            const auto Wd = w.Read();
+            auto Vd = V.ReadWrite();
+            auto Zd = flex ? Z.ReadWrite() : nullptr;
+            mfem::forall(n, [=] MFEM_HOST_DEVICE (int i)
+            {
+               real_t q = Vd[i + jj*n];
+               real_t t = Wd[i];
+               for (int k = 0; k < jj; k++)
+               {
+                  const real_t vik = Vd[i + k*n];
+                  q -= vik*Ad[k];
+                  t -= vik*Dv[k];
+               }
+               q *= inv_omega;
+               Vd[i + jj*n] = q;
+               Vd[i + (jj+1)*n] = (t - q*Dv[jj])*inv_scale;
+               if (flex)
+               {
+                  real_t z = Zd[i + jj*n];
+                  for (int k = 0; k < jj; k++) { z -= Zd[i + k*n]*Ad[k]; }
+                  Zd[i + jj*n] = z*inv_omega;
+               }
+            });
+         }
+         if (explicit_norm)
+         {
+            // Additional reduction when the Pythagorean identity is inaccurate
+            vj.MakeRef(V, (j+1)*n, n);
+            vj.UseDevice(true);
+            nu = Norm(vj);
+            MFEM_VERIFY(IsFinite(nu), "nu = " << nu);
+            if (nu > 0.0) { vj *= 1.0/nu; }
+            else { breakdown = true; }
+         }
+
+         j++;
+         it++;
+      }
+
+      if (it >= max_iter) { break; }
+
+      if (print_options.iterations)
+      {
+         mfem::out << "Restarting..." << '\n';
+      }
+
+      Residual();
+      resid = beta = Norm(r);
+      MFEM_VERIFY(IsFinite(beta), "beta = " << beta);
+      if (beta <= final_norm)
+      {
+         final_norm = beta;
+         final_iter = it;
          converged = true;
          goto finish;
       }
    }
 
-   final_norm = beta;
+   final_norm = resid;
    final_iter = max_iter;
    converged = false;
 
 finish:
    if ((print_options.iterations && converged) || print_options.first_and_last)
    {
-      mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
+      mfem::out << "   Pass : " << setw(2) << (final_iter > 0 ?
+                                                (final_iter-1)/m+1 : 1)
                 << "   Iteration : " << setw(3) << final_iter
-                << "  ||B r|| = " << final_norm << '\n';
+                << "  " << norm_name << " = " << final_norm << '\n';
    }
    if (print_options.summary || (print_options.warnings && !converged))
    {
-      mfem::out << "GMRES: Number of iterations: " << final_iter << '\n';
+      mfem::out << name << ": Number of iterations: " << final_iter << '\n';
    }
    if (print_options.warnings && !converged)
    {
-      mfem::out << "GMRES: No convergence!\n";
+      mfem::out << name << ": No convergence!\n";
    }
 
    Monitor(final_iter, final_norm, r, x, true);
+}
 
-   for (i = 0; i < v.Size(); i++)
+void GCRODRSolver::SetOperator(const Operator &op)
+{
+   MFEM_VERIFY(k == 0 || op.Height() == height,
+               "the size of the operator changed, call ClearRecycleSpace()");
+   IterativeSolver::SetOperator(op);
+   c_valid = false;
+}
+
+void GCRODRSolver::SetPreconditioner(Solver &pr)
+{
+   IterativeSolver::SetPreconditioner(pr);
+   c_valid = false;
+}
+
+void GCRODRSolver::UpdateRecycleSpace() const
+{
+   const int n = width;
+   Vector t(n, U.GetMemory().GetMemoryType()), part;
+   t.UseDevice(true);
+   for (int j = 0; j < k; j++)
    {
-      delete v[i];
+      Vector u(U, j*n, n), c(C, j*n, n);
+      if (prec)
+      {
+         prec->Mult(u, t);
+         oper->Mult(t, c);
+      }
+      else
+      {
+         oper->Mult(u, c);
+      }
    }
+   // Orthonormalize C, with the same transformation of U
+   DenseMatrix F, T;
+   BlockInnerProducts(n, k, C, k, C, part, F);
+   StartGlobalSum(F.Data(), k*k);
+   FinishGlobalSum();
+   F.Symmetrize();
+   Whitening(F, T);
+   TransformColumns(n, U, T);
+   TransformColumns(n, C, T);
+   k = T.Width();
+   c_valid = true;
+}
+
+void GCRODRSolver::UpdateFromCycle(int j, const Vector &V,
+                                   const DenseMatrix &H,
+                                   const DenseMatrix &Bc) const
+{
+   const int n = width, s = k + j;
+   Vector part;
+
+   // A B [U, V_j] = [C, V_{j+1}] Gh with Gh = [I, Bc; 0, H]
+   DenseMatrix Gh(k + j + 1, s);
+   Gh = 0.0;
+   for (int i = 0; i < k; i++)
+   {
+      Gh(i, i) = 1.0;
+      for (int l = 0; l < j; l++) { Gh(i, k + l) = Bc(i, l); }
+   }
+   for (int i = 0; i <= j; i++)
+   {
+      for (int l = 0; l < j; l++) { Gh(k + i, k + l) = H(i, l); }
+   }
+
+   // F = [U, V_j]^T [U, V_j]
+   DenseMatrix F(s), UU, UV;
+   F = 0.0;
+   if (k > 0)
+   {
+      BlockInnerProducts(n, k, U, k, U, part, UU);
+      BlockInnerProducts(n, k, U, j, V, part, UV);
+      for (int i = 0; i < k; i++)
+      {
+         for (int l = 0; l < k; l++) { F(i, l) = UU(i, l); }
+         for (int l = 0; l < j; l++) { F(i, k + l) = F(k + l, i) = UV(i, l); }
+      }
+      StartGlobalSum(F.Data(), s*s);
+      FinishGlobalSum();
+      F.Symmetrize();
+   }
+   for (int i = k; i < s; i++) { F(i, i) = 1.0; }
+
+   // The vectors z of span [U, V_j] with the smallest || A B z ||/|| z ||
+   DenseMatrix G(s), Y;
+   MultAtB(Gh, Gh, G);
+   const int k_max = SmallestEigenvectors(G, F, recycle_dim, Y);
+
+   // Orthonormalize Gh Y, then U = [U, V_j] Y T and C = [C, V_{j+1}] Gh Y T
+   DenseMatrix GhY(k + j + 1, k_max), M(k_max), T;
+   mfem::Mult(Gh, Y, GhY);
+   MultAtB(GhY, GhY, M);
+   Whitening(M, T);
+   const int k_new = T.Width();
+   DenseMatrix YT(s, k_new), GhYT(k + j + 1, k_new), top, bottom;
+   mfem::Mult(Y, T, YT);
+   mfem::Mult(GhY, T, GhYT);
+
+   Vector U_new(k_new*n, U.GetMemory().GetMemoryType());
+   Vector C_new(k_new*n, C.GetMemory().GetMemoryType());
+   U_new.UseDevice(true);
+   C_new.UseDevice(true);
+   U_new = 0.0;
+   C_new = 0.0;
+   top.CopyMN(YT, k, k_new, 0, 0);
+   bottom.CopyMN(YT, j, k_new, k, 0);
+   BlockAddMult(n, U, top, U_new);
+   BlockAddMult(n, V, bottom, U_new);
+   top.CopyMN(GhYT, k, k_new, 0, 0);
+   bottom.CopyMN(GhYT, j + 1, k_new, k, 0);
+   BlockAddMult(n, C, top, C_new);
+   BlockAddMult(n, V, bottom, C_new);
+
+   Vector(U, 0, k_new*n) = U_new;
+   Vector(C, 0, k_new*n) = C_new;
+   k = k_new;
+   c_valid = true;
 }
 
-void FGMRESSolver::Mult(const Vector &b, Vector &x) const
+void GCRODRSolver::Mult(const Vector &b, Vector &x) const
 {
-   DenseMatrix H(m+1,m);
-   Vector s(m+1), cs(m+1), sn(m+1);
-   Vector r(b.Size()), x_monitor;
-
+   MFEM_PERF_SCOPE("GCRODRSolver::Mult");
+
+   const int n = width;
+   const MemoryType mt = GetMemoryType(oper->GetMemoryClass());
+   if (k > recycle_dim) { k = recycle_dim; }
+   ResizeColumns(U, n, k, recycle_dim, mt);
+   ResizeColumns(C, n, k, recycle_dim, mt);
+   if (k > 0 && !c_valid) { UpdateRecycleSpace(); }
+
+   DenseMatrix H(m+1, m), R(m+1, m), Bc;
+   Vector s(m+1), cs(m+1), sn(m+1), y, c, g, part;
+   Vector V((m+1)*n, mt), r(n, mt), w(n, mt), t(n, mt);
+   V.UseDevice(true);
+   r.UseDevice(true);
+   w.UseDevice(true);
+   t.UseDevice(true);
    b.UseDevice(true);
    x.UseDevice(true);
-   r.UseDevice(true);
-
-   if (ControllerRequiresUpdate())
-   {
-      x_monitor.SetSize(x.Size());
-      x_monitor.UseDevice(true);
-   }
-   else
-   {
-      x_monitor.MakeRef(x, 0, x.Size());
-   }
-
-   int i, j, k;
 
    if (iterative_mode)
    {
       oper->Mult(x, r);
-      subtract(b,r,r);
+      subtract(b, r, r);
    }
    else
    {
-      x = 0.;
+      x = 0.0;
       r = b;
    }
    real_t beta = initial_norm = Norm(r);  // beta = ||r||
@@ -1269,9 +3286,6 @@ void FGMRESSolver::Mult(const Vector &b, Vector &x) const
       return;
    }
 
-   // initialize the first pass
-   converged = false;
-
    if (print_options.iterations || print_options.first_and_last)
    {
       mfem::out << "   Pass : " << setw(2) << 1
@@ -1280,152 +3294,180 @@ void FGMRESSolver::Mult(const Vector &b, Vector &x) const
                 << (print_options.first_and_last ? " ...\n" : "\n");
    }
 
-   Array<Vector*> v(m+1);
-   Array<Vector*> z(m+1);
-   for (i= 0; i<=m; i++)
-   {
-      v[i] = NULL;
-      z[i] = NULL;
-   }
-
-   j = 1;
-   while (j <= max_iter)
+   if (k > 0)
    {
-      if (v[0] == NULL)
+      // Minimize the residual in the recycled subspace: with c = C^T r,
+      // x += B U c and r -= C c
+      DenseMatrix Cr;
+      BlockInnerProducts(n, k, C, 1, r, part, Cr);
+      StartGlobalSum(Cr.Data(), k);
+      FinishGlobalSum();
+      c.SetSize(k);
+      for (int i = 0; i < k; i++) { c(i) = Cr(i, 0); }
+      t = 0.0;
+      AddColumns(n, U, c, 1.0, t);
+      if (prec)
       {
-         v[0] = new Vector(b.Size());
-         v[0]->UseDevice(true);
+         prec->Mult(t, w);
+         x += w;
       }
-      (*v[0]) = 0.0;
-      v[0] -> Add (1.0/beta, r);   // v[0] = r / ||r||
-      s = 0.0; s(0) = beta;
-
-      for (i = 0; i < m && j <= max_iter; i++, j++)
+      else
       {
+         x += t;
+      }
+      AddColumns(n, C, c, -1.0, r);
+      beta = Norm(r);
+   }
 
-         if (z[i] == NULL)
-         {
-            z[i] = new Vector(b.Size());
-            z[i]->UseDevice(true);
-         }
-         (*z[i]) = 0.0;
-
+   converged = false;
+   bool stop = false;
+   int it = 0, pass = 0;
+   while (beta > final_norm && it < max_iter && !stop)
+   {
+      pass++;
+      Vector v0(V, 0, n);
+      v0.Set(1.0/beta, r);
+      s = 0.0;
+      s(0) = beta;
+      H = 0.0;
+      Bc.SetSize(k, m);
+
+      // Arnoldi process with the operator (I - C C^T) A B
+      int j = 0;
+      real_t resid = beta;
+      while (j < m && it < max_iter)
+      {
+         Vector vj(V, j*n, n), vj1(V, (j+1)*n, n);
          if (prec)
          {
-            prec->Mult(*v[i], *z[i]);
+            prec->Mult(vj, t);
+            oper->Mult(t, w);
          }
          else
          {
-            (*z[i]) = (*v[i]);
+            oper->Mult(vj, w);
          }
-         oper->Mult(*z[i], r);
-
-         for (k = 0; k <= i; k++)
+         if (k > 0)
          {
-            H(k,i) = Dot( r, *v[k]); // H(k,i) = r * v[k]
-            r.Add(-H(k,i), (*v[k])); // r -= H(k,i) * v[k]
+            DenseMatrix Cw;
+            BlockInnerProducts(n, k, C, 1, w, part, Cw);
+            StartGlobalSum(Cw.Data(), k);
+            FinishGlobalSum();
+            c.SetSize(k);
+            for (int i = 0; i < k; i++) { c(i) = Bc(i, j) = Cw(i, 0); }
+            AddColumns(n, C, c, -1.0, w);
          }
-
-         H(i+1,i)  = Norm(r);       // H(i+1,i) = ||r||
-         if (v[i+1] == NULL)
+         // Classical Gram-Schmidt with reorthogonalization
+         for (int cgs = 0; cgs < 2; cgs++)
          {
-            v[i+1] = new Vector(b.Size());
-            v[i+1]->UseDevice(true);
+            DenseMatrix h;
+            BlockInnerProducts(n, j + 1, V, 1, w, part, h);
+            StartGlobalSum(h.Data(), j + 1);
+            FinishGlobalSum();
+            c.SetSize(j + 1);
+            for (int i = 0; i <= j; i++)
+            {
+               c(i) = h(i, 0);
+               H(i, j) += c(i);
+            }
+            AddColumns(n, V, c, -1.0, w);
          }
-         (*v[i+1]) = 0.0;
-         v[i+1] -> Add (1.0/H(i+1,i), r); // v[i+1] = r / H(i+1,i)
-
-         for (k = 0; k < i; k++)
+         H(j+1, j) = Norm(w);
+         if (H(j+1, j) > 0.0)
          {
-            ApplyPlaneRotation(H(k,i), H(k+1,i), cs(k), sn(k));
+            vj1.Set(1.0/H(j+1, j), w);
+         }
+         else
+         {
+            vj1 = 0.0; // lucky breakdown
          }
 
-         GeneratePlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
-         ApplyPlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
-         ApplyPlaneRotation(s(i), s(i+1), cs(i), sn(i));
+         for (int i = 0; i <= j + 1; i++) { R(i, j) = H(i, j); }
+         for (int i = 0; i < j; i++)
+         {
+            ApplyPlaneRotation(R(i, j), R(i+1, j), cs(i), sn(i));
+         }
+         GeneratePlaneRotation(R(j, j), R(j+1, j), cs(j), sn(j));
+         ApplyPlaneRotation(R(j, j), R(j+1, j), cs(j), sn(j));
+         ApplyPlaneRotation(s(j), s(j+1), cs(j), sn(j));
 
-         const real_t resid = fabs(s(i+1));
+         resid = fabs(s(j+1));
          MFEM_VERIFY(IsFinite(resid), "resid = " << resid);
+         j++;
+         it++;
          if (print_options.iterations || (print_options.first_and_last &&
                                           resid <= final_norm))
          {
-            mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
-                      << "   Iteration : " << setw(3) << j
+            mfem::out << "   Pass : " << setw(2) << pass
+                      << "   Iteration : " << setw(3) << it
                       << "  || r || = " << resid << endl;
          }
+         stop = Monitor(it, resid, r, x);
+         if (stop || resid <= final_norm || H(j, j-1) == 0.0) { break; }
+      }
 
-         if (ControllerRequiresUpdate())
-         {
-            x_monitor = x;
-            Update(x_monitor, i, H, s, z);
-         }
+      // Least squares solution: R y = s
+      y.SetSize(j);
+      for (int i = j - 1; i >= 0; i--)
+      {
+         real_t a = s(i);
+         for (int l = i + 1; l < j; l++) { a -= R(i, l)*y(l); }
+         y(i) = a/R(i, i);
+      }
 
-         if (Monitor(j, resid, r, x_monitor) || resid <= final_norm)
+      // x += B (V_j y - U Bc y)
+      t = 0.0;
+      AddColumns(n, V, y, 1.0, t);
+      if (k > 0)
+      {
+         c.SetSize(k);
+         for (int i = 0; i < k; i++)
          {
-            Update(x, i, H, s, z);
-            final_norm = resid;
-            final_iter = j;
-            converged = true;
-
-            if (print_options.summary)
-            {
-               mfem::out << "FGMRES: Number of iterations: " << final_iter << '\n';
-            }
-
-            for (i= 0; i<=m; i++)
-            {
-               if (v[i]) { delete v[i]; }
-               if (z[i]) { delete z[i]; }
-            }
-
-            Monitor(j, resid, r, x, true);
-            return;
+            c(i) = 0.0;
+            for (int l = 0; l < j; l++) { c(i) += Bc(i, l)*y(l); }
          }
+         AddColumns(n, U, c, -1.0, t);
+      }
+      if (prec)
+      {
+         prec->Mult(t, w);
+         x += w;
+      }
+      else
+      {
+         x += t;
       }
 
-      if (print_options.iterations)
+      // r = V_{j+1} (beta e_1 - H y), which is orthogonal to C
+      g.SetSize(j + 1);
+      for (int i = 0; i <= j; i++)
       {
-         mfem::out << "Restarting..." << endl;
+         g(i) = (i == 0) ? beta : 0.0;
+         for (int l = 0; l < j; l++) { g(i) -= H(i, l)*y(l); }
       }
+      r = 0.0;
+      AddColumns(n, V, g, 1.0, r);
+      beta = resid;
 
-      Update(x, i-1, H, s, z);
+      if (recycle_dim > 0) { UpdateFromCycle(j, V, H, Bc); }
 
-      oper->Mult(x, r);
-      subtract(b,r,r);
-      beta = Norm(r);
-      MFEM_VERIFY(IsFinite(beta), "beta = " << beta);
-      if (beta <= final_norm)
+      if (print_options.iterations && beta > final_norm && it < max_iter &&
+          !stop)
       {
-         converged = true;
-
-         break;
+         mfem::out << "Restarting..." << endl;
       }
    }
-
-   // Clean buffers up
-   for (i = 0; i <= m; i++)
-   {
-      if (v[i]) { delete v[i]; }
-      if (z[i]) { delete z[i]; }
-   }
-
+   converged = (beta <= final_norm);
+   final_iter = it;
    final_norm = beta;
-   final_iter = converged ? j : max_iter;
 
-   // Note: j is off by one when we arrive here
-   if (!print_options.iterations && print_options.first_and_last)
-   {
-      mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
-                << "   Iteration : " << setw(3) << j-1
-                << "  || r || = " << final_norm << endl;
-   }
    if (print_options.summary || (print_options.warnings && !converged))
    {
-      mfem::out << "FGMRES: Number of iterations: " << final_iter << '\n';
+      mfem::out << "GCRODR: Number of iterations: " << final_iter << '\n';
    }
    if (print_options.warnings && !converged)
    {
-      mfem::out << "FGMRES: No convergence!\n";
+      mfem::out << "GCRODR: No convergence!" << '\n';
    }
 
    Monitor(final_iter, final_norm, r, x, true);
@@ -1487,6 +3529,8 @@ void BiCGSTABSolver::UpdateVectors()
 
 void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_SCOPE("BiCGSTABSolver::Mult");
+
    // BiConjugate Gradient Stabilized method following the algorithm
    // on p. 27 of the SIAM Templates book.
 
@@ -1736,6 +3780,8 @@ void MINRESSolver::SetOperator(const Operator &op)
 
 void MINRESSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_SCOPE("MINRESSolver::Mult");
+
    // Based on the MINRES algorithm on p. 86, Fig. 6.9 in
    // "Iterative Krylov Methods for Large Linear Systems",
    // by Henk A. van der Vorst, 2003.
@@ -2924,18 +4970,29 @@ void BlockILU::SetOperator(const Operator &op)
       A = &A_par_diag;
    }
 #endif
+   std::unique_ptr<SparseMatrix> A_bsr;
+   if (auto bsr = dynamic_cast<const BSRMatrix *>(&op))
+   {
+      MFEM_VERIFY(bsr->IsByVDim() && bsr->BlockSize() == block_size,
+                  "BlockILU requires a BSRMatrix with byVDIM ordering and the "
+                  "same block size");
+      A_bsr.reset(bsr->ToSparseMatrix());
+      A = A_bsr.get();
+   }
    if (A == NULL)
    {
       A = dynamic_cast<const SparseMatrix *>(&op);
       if (A == NULL)
       {
-         MFEM_ABORT("BlockILU must be created with a SparseMatrix or HypreParMatrix");
+         MFEM_ABORT("BlockILU must be created with a SparseMatrix, BSRMatrix "
+                    "or HypreParMatrix");
       }
    }
    height = op.Height();
    width = op.Width();
    MFEM_VERIFY(A->Finalized(), "Matrix must be finalized.");
    CreateBlockPattern(*A);
+   ComputeLevels();
    Factorize();
 }
 
@@ -3082,73 +5139,296 @@ void BlockILU::CreateBlockPattern(const SparseMatrix &A)
    }
 }
 
+// Sort the rows by level, keeping the order of the rows within a level.
+static void BucketLevels(const Array<int> &level, int nlevels,
+                         Array<int> &rows, Array<int> &offsets)
+{
+   const int n = level.Size();
+   offsets.SetSize(nlevels + 1);
+   offsets = 0;
+   for (int i = 0; i < n; i++) { offsets[level[i] + 1]++; }
+   offsets.PartialSum();
+   rows.SetSize(n);
+   Array<int> count(nlevels);
+   count = 0;
+   for (int i = 0; i < n; i++)
+   {
+      rows[offsets[level[i]] + count[level[i]]++] = i;
+   }
+}
+
+void BlockILU::ComputeLevels()
+{
+   const int nblockrows = IB.Size() - 1;
+   Array<int> level(nblockrows);
+
+   // Block row i of L depends on the rows j < i of its nonzero blocks
+   int nlevels = 0;
+   for (int i = 0; i < nblockrows; ++i)
+   {
+      int lev = 0;
+      for (int k = IB[i]; k < ID[i]; ++k)
+      {
+         lev = std::max(lev, level[JB[k]] + 1);
+      }
+      level[i] = lev;
+      nlevels = std::max(nlevels, lev + 1);
+   }
+   BucketLevels(level, nlevels, lower_rows, lower_offsets);
+
+   // Block row i of U depends on the rows j > i of its nonzero blocks
+   nlevels = 0;
+   for (int i = nblockrows - 1; i >= 0; --i)
+   {
+      int lev = 0;
+      for (int k = ID[i] + 1; k < IB[i+1]; ++k)
+      {
+         lev = std::max(lev, level[JB[k]] + 1);
+      }
+      level[i] = lev;
+      nlevels = std::max(nlevels, lev + 1);
+   }
+   BucketLevels(level, nlevels, upper_rows, upper_offsets);
+}
+
 void BlockILU::Factorize()
 {
    int nblockrows = Height()/block_size;
 
    // Precompute LU factorization of diagonal blocks
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
    for (int i=0; i<nblockrows; ++i)
    {
       LUFactors factorization(DB.GetData(i), &ipiv[i*block_size]);
       factorization.Factor(block_size);
    }
 
+   // The rows of a level only depend on the rows of the previous levels, so
+   // they are factorized in parallel. The rows of the first level have no
+   // block lower triangular part.
+   for (int l=1; l<lower_offsets.Size()-1; ++l)
+   {
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for schedule(dynamic, 16)
+#endif
+      for (int r=lower_offsets[l]; r<lower_offsets[l+1]; ++r)
+      {
+         FactorizeRow(lower_rows[r]);
+      }
+   }
+}
+
+void BlockILU::FactorizeRow(int i)
+{
    // Note: we use UseExternalData to extract submatrices from the tensor AB
    // instead of the DenseTensor call operator, because the call operator does
    // not allow for two simultaneous submatrix views into the same tensor
    DenseMatrix A_ik, A_ij, A_kj;
-   // Loop over block rows (starting with second block row)
-   for (int i=1; i<nblockrows; ++i)
-   {
-      // Find all nonzeros to the left of the diagonal in row i
-      for (int kk=IB[i]; kk<IB[i+1]; ++kk)
-      {
-         int k = JB[kk];
-         // Make sure we're still to the left of the diagonal
-         if (k == i) { break; }
-         if (k > i)
-         {
-            MFEM_ABORT("Matrix must be sorted with nonzero diagonal");
-         }
-         LUFactors A_kk_inv(DB.GetData(k), &ipiv[k*block_size]);
-         A_ik.UseExternalData(&AB(0,0,kk), block_size, block_size);
-         // A_ik = A_ik * A_kk^{-1}
-         A_kk_inv.RightSolve(block_size, block_size, A_ik.GetData());
-         // Modify everything to the right of k in row i
-         for (int jj=kk+1; jj<IB[i+1]; ++jj)
-         {
-            int j = JB[jj];
-            if (j <= k) { continue; } // Superfluous because JB is sorted?
-            A_ij.UseExternalData(&AB(0,0,jj), block_size, block_size);
-            for (int ll=IB[k]; ll<IB[k+1]; ++ll)
+   // Find all nonzeros to the left of the diagonal in row i
+   for (int kk=IB[i]; kk<IB[i+1]; ++kk)
+   {
+      int k = JB[kk];
+      // Make sure we're still to the left of the diagonal
+      if (k == i) { break; }
+      if (k > i)
+      {
+         MFEM_ABORT("Matrix must be sorted with nonzero diagonal");
+      }
+      LUFactors A_kk_inv(DB.GetData(k), &ipiv[k*block_size]);
+      A_ik.UseExternalData(&AB(0,0,kk), block_size, block_size);
+      // A_ik = A_ik * A_kk^{-1}
+      A_kk_inv.RightSolve(block_size, block_size, A_ik.GetData());
+      // Modify everything to the right of k in row i
+      for (int jj=kk+1; jj<IB[i+1]; ++jj)
+      {
+         int j = JB[jj];
+         if (j <= k) { continue; } // Superfluous because JB is sorted?
+         A_ij.UseExternalData(&AB(0,0,jj), block_size, block_size);
+         for (int ll=IB[k]; ll<IB[k+1]; ++ll)
+         {
+            int l = JB[ll];
+            if (l == j)
             {
-               int l = JB[ll];
-               if (l == j)
+               A_kj.UseExternalData(&AB(0,0,ll), block_size, block_size);
+               // A_ij = A_ij - A_ik*A_kj;
+               AddMult_a(-1.0, A_ik, A_kj, A_ij);
+               // If we need to, update diagonal factorization
+               if (j == i)
                {
-                  A_kj.UseExternalData(&AB(0,0,ll), block_size, block_size);
-                  // A_ij = A_ij - A_ik*A_kj;
-                  AddMult_a(-1.0, A_ik, A_kj, A_ij);
-                  // If we need to, update diagonal factorization
-                  if (j == i)
-                  {
-                     DB(i) = A_ij;
-                     LUFactors factorization(DB.GetData(i), &ipiv[i*block_size]);
-                     factorization.Factor(block_size);
-                  }
-                  break;
+                  // Copy the block without DenseTensor::operator()(int),
+                  // which is not thread-safe
+                  std::copy(A_ij.Data(), A_ij.Data() + block_size*block_size,
+                            DB.GetData(i));
+                  LUFactors factorization(DB.GetData(i), &ipiv[i*block_size]);
+                  factorization.Factor(block_size);
                }
+               break;
             }
          }
       }
    }
 }
 
+void BlockILU::LowerRow(int i, const real_t *b, const real_t *y_in,
+                        real_t *y_out) const
+{
+   const int bs = block_size;
+   real_t *yi = y_out + i*bs;
+   for (int ib=0; ib<bs; ++ib)
+   {
+      yi[ib] = b[ib + P[i]*bs];
+   }
+   for (int k=IB[i]; k<ID[i]; ++k)
+   {
+      // y_i = y_i - L_ij*y_j, with the column-major block L_ij
+      const real_t *L_ij = AB.GetData(k);
+      const real_t *yj = y_in + JB[k]*bs;
+      for (int jb=0; jb<bs; ++jb)
+      {
+         for (int ib=0; ib<bs; ++ib)
+         {
+            yi[ib] -= L_ij[ib + jb*bs]*yj[jb];
+         }
+      }
+   }
+}
+
+void BlockILU::UpperRow(int i, const real_t *y_, const real_t *z_in,
+                        real_t *z_out) const
+{
+   const int bs = block_size;
+   real_t *zi = z_out + i*bs;
+   for (int ib=0; ib<bs; ++ib)
+   {
+      zi[ib] = y_[ib + i*bs];
+   }
+   for (int k=ID[i]+1; k<IB[i+1]; ++k)
+   {
+      // z_i = z_i - U_ij*z_j, with the column-major block U_ij
+      const real_t *U_ij = AB.GetData(k);
+      const real_t *zj = z_in + JB[k]*bs;
+      for (int jb=0; jb<bs; ++jb)
+      {
+         for (int ib=0; ib<bs; ++ib)
+         {
+            zi[ib] -= U_ij[ib + jb*bs]*zj[jb];
+         }
+      }
+   }
+   LUFactors A_ii_inv(DB.GetData(i), &ipiv[i*block_size]);
+   // z_i = D_ii^{-1} z_i
+   A_ii_inv.Solve(bs, 1, zi);
+}
+
 void BlockILU::Mult(const Vector &b, Vector &x) const
 {
    MFEM_VERIFY(height > 0, "BlockILU(0) preconditioner is not constructed");
    int nblockrows = Height()/block_size;
    y.SetSize(Height());
 
+   if (tri_solve != TriangularSolve::SEQUENTIAL)
+   {
+      z.SetSize(Height());
+      const real_t *bd = b.HostRead();
+      real_t *yd = y.HostWrite();
+      real_t *zd = z.HostWrite();
+      if (tri_solve == TriangularSolve::LEVEL_SCHEDULED)
+      {
+         // Forward substitution to solve Ly = b, then backward substitution
+         // to solve Uz = y, one level at a time
+         for (int l=0; l<lower_offsets.Size()-1; ++l)
+         {
+#ifdef MFEM_USE_OPENMP
+            #pragma omp parallel for schedule(static)
+#endif
+            for (int r=lower_offsets[l]; r<lower_offsets[l+1]; ++r)
+            {
+               LowerRow(lower_rows[r], bd, yd, yd);
+            }
+         }
+         for (int l=0; l<upper_offsets.Size()-1; ++l)
+         {
+#ifdef MFEM_USE_OPENMP
+            #pragma omp parallel for schedule(static)
+#endif
+            for (int r=upper_offsets[l]; r<upper_offsets[l+1]; ++r)
+            {
+               UpperRow(upper_rows[r], yd, zd, zd);
+            }
+         }
+      }
+      else
+      {
+         // Jacobi iterations y <- P b - L y, starting from y = P b, then
+         // z <- D^{-1} (y - U z), starting from z = D^{-1} y
+         y_tmp.SetSize(Height());
+         real_t *td = y_tmp.HostWrite();
+#ifdef MFEM_USE_OPENMP
+         #pragma omp parallel for schedule(static)
+#endif
+         for (int i=0; i<nblockrows; ++i)
+         {
+            for (int ib=0; ib<block_size; ++ib)
+            {
+               yd[ib + i*block_size] = bd[ib + P[i]*block_size];
+            }
+         }
+         for (int it=0; it<jacobi_iter; ++it)
+         {
+#ifdef MFEM_USE_OPENMP
+            #pragma omp parallel for schedule(static)
+#endif
+            for (int i=0; i<nblockrows; ++i)
+            {
+               LowerRow(i, bd, yd, td);
+            }
+            std::swap(yd, td);
+         }
+#ifdef MFEM_USE_OPENMP
+         #pragma omp parallel for schedule(static)
+#endif
+         for (int i=0; i<nblockrows; ++i)
+         {
+            real_t *zi = zd + i*block_size;
+            for (int ib=0; ib<block_size; ++ib)
+            {
+               zi[ib] = yd[ib + i*block_size];
+            }
+            LUFactors A_ii_inv(DB.GetData(i), &ipiv[i*block_size]);
+            A_ii_inv.Solve(block_size, 1, zi);
+         }
+         // The y iterate may be stored in either vector: use the other one
+         // for the z iterations
+         real_t *wd = (yd == y.GetData()) ? td : y.GetData();
+         for (int it=0; it<jacobi_iter; ++it)
+         {
+#ifdef MFEM_USE_OPENMP
+            #pragma omp parallel for schedule(static)
+#endif
+            for (int i=0; i<nblockrows; ++i)
+            {
+               UpperRow(i, yd, zd, wd);
+            }
+            std::swap(zd, wd);
+         }
+      }
+      // Undo the permutation, x = P^T z
+      real_t *xd = x.HostWrite();
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for schedule(static)
+#endif
+      for (int i=0; i<nblockrows; ++i)
+      {
+         for (int ib=0; ib<block_size; ++ib)
+         {
+            xd[ib + P[i]*block_size] = zd[ib + i*block_size];
+         }
+      }
+      return;
+   }
+
    DenseMatrix B;
    Vector yi, yj, xi, xj;
    Vector tmp(block_size);
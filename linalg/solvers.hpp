@@ -139,6 +139,7 @@ public:
 private:
    int dot_prod_type; // 0 - local, 1 - global over 'comm'
    MPI_Comm comm = MPI_COMM_NULL;
+   mutable MPI_Request sum_request = MPI_REQUEST_NULL;
 #endif
 
 protected:
@@ -204,6 +205,17 @@ protected:
    /// Return the inner product norm of @a x, using the inner product defined by Dot()
    real_t Norm(const Vector &x) const { return sqrt(Dot(x, x)); }
 
+   /** @brief Start the in-place global sum of the @a n values in @a buf, see
+       FinishGlobalSum().
+       @details The sum is non-blocking, so that solvers can overlap it with
+       other work. The values in @a buf must not be accessed before the call
+       to FinishGlobalSum(). Nothing is done in serial or if the solver uses a
+       local inner product. */
+   void StartGlobalSum(real_t *buf, int n) const;
+
+   /// Complete the global sum started by StartGlobalSum().
+   void FinishGlobalSum() const;
+
    /// Indicated if the controller requires an update of the solution
    bool ControllerRequiresUpdate() const { return controller && controller->RequiresUpdatedSolution(); }
 
@@ -567,6 +579,184 @@ public:
    void Mult(const Vector &b, Vector &x) const override;
 };
 
+/** @brief Conjugate gradient method with one global reduction per iteration,
+    for latency bound (strongly scaled) parallel runs.
+
+    Two reformulations of the preconditioned conjugate gradient method are
+    available, see Variant. In both, the two inner products of an iteration are
+    computed in a single pass over the vectors and summed with a single global
+    reduction, and the vector updates of an iteration are fused into one pass.
+
+    The PIPELINED variant (Ghysels and Vanroose, 2014) additionally overlaps
+    the non-blocking global reduction with the application of the
+    preconditioner and of the operator. It needs more vectors and one extra
+    preconditioner and operator application (in the last iteration), and the
+    recurrences for the residual may limit the attainable accuracy slightly.
+
+    The SINGLE_REDUCTION variant (Chronopoulos and Gear, 1989) is the
+    non-pipelined version with one blocking reduction per iteration.
+
+    The convergence criterion and the arguments of Monitor() are the same as
+    in CGSolver, i.e. they are based on (B r, r). The inner products are always
+    the standard l2 ones: an override of Dot() is not used. */
+class PipelinedCGSolver : public IterativeSolver
+{
+public:
+   /// Variants of the method, see PipelinedCGSolver.
+   enum Variant
+   {
+      PIPELINED,       ///< Ghysels-Vanroose pipelined CG
+      SINGLE_REDUCTION ///< Chronopoulos-Gear single reduction CG
+   };
+
+protected:
+   Variant variant;
+   mutable Vector r, u, w, p, s, q, z, m, n;
+
+   void UpdateVectors();
+
+public:
+   PipelinedCGSolver(Variant variant_ = PIPELINED) : variant(variant_) { }
+
+#ifdef MFEM_USE_MPI
+   PipelinedCGSolver(MPI_Comm comm_, Variant variant_ = PIPELINED)
+      : IterativeSolver(comm_), variant(variant_) { }
+#endif
+
+   /// Set the variant of the method, PIPELINED by default.
+   void SetVariant(Variant variant_)
+   { variant = variant_; if (oper) { UpdateVectors(); } }
+
+   Variant GetVariant() const { return variant; }
+
+   void SetOperator(const Operator &op) override
+   { IterativeSolver::SetOperator(op); UpdateVectors(); }
+
+   /** @brief Iterative solution of the linear system using the selected
+       variant of the Conjugate Gradient method. */
+   void Mult(const Vector &b, Vector &x) const override;
+};
+
+/** @brief Block conjugate gradient method (O'Leary, 1980) for multiple
+    right-hand sides.
+
+    ArrayMult() solves A X = B for all the columns of B at once: the search
+    directions of all columns are combined in one Krylov block, the operator
+    and the preconditioner are applied to the whole block with their
+    ArrayMult() methods (see e.g. BilinearForm::ArrayMult(), which reads the PA
+    data once for a batch of vectors), and the s x s inner product matrices of
+    an iteration are computed in one pass over the block and summed with a
+    single global reduction.
+
+    Each column is checked for convergence as in CGSolver, using (B r, r) and
+    the relative and absolute tolerances. Converged columns are removed from
+    the block, and the iteration is restarted with the remaining columns. If
+    the block becomes numerically rank deficient (e.g. for linearly dependent
+    right-hand sides), the remaining columns are solved one at a time. The
+    number of iterations, GetNumIterations(), counts the iterations of all the
+    blocks, GetInitialNorm() and GetFinalNorm() are the maximum over the
+    columns, and GetConverged() is true if all the columns converged. The inner
+    products are always the standard l2 ones: an override of Dot() is not
+    used. */
+class BlockCGSolver : public IterativeSolver
+{
+protected:
+   /// Blocks of column vectors, stored one after another
+   mutable Vector X_blk, R_blk, Z_blk, P_blk, Q_blk, Pn_blk;
+   /// Partial sums of the block inner products
+   mutable Vector part;
+
+public:
+   BlockCGSolver() { }
+
+#ifdef MFEM_USE_MPI
+   BlockCGSolver(MPI_Comm comm_) : IterativeSolver(comm_) { }
+#endif
+
+   /// Iterative solution of the linear system A x = b with one column.
+   void Mult(const Vector &b, Vector &x) const override;
+
+   /** @brief Iterative solution of the linear systems A X[i] = B[i] using the
+       block Conjugate Gradient method. */
+   void ArrayMult(const Array<const Vector *> &B,
+                  Array<Vector *> &X) const override;
+};
+
+/** @brief Deflated conjugate gradient method with a recycled subspace, for
+    sequences of related SPD systems, e.g. in time stepping or Newton methods.
+
+    The solver keeps a deflation subspace W between the calls to Mult(). The
+    initial guess is corrected with the Galerkin projection onto W and the
+    search directions are kept A-orthogonal to W (Saad, Yeung, Erhel and
+    Guyomarc'h, 2000), so that the eigenvalues of the modes in W, typically
+    the smallest ones, do not slow down the convergence. After each solve, W
+    is replaced by the approximate eigenvectors of the smallest eigenvalues
+    (Ritz vectors) in the span of W and of the first search directions of the
+    solve, see SetRecycleDim().
+
+    SetOperator() keeps the subspace W, and A W is recomputed in the next
+    Mult(), so the subspace is recycled when the operator changes slowly. The
+    convergence criterion and the arguments of Monitor() are the same as in
+    CGSolver. */
+class DeflatedCGSolver : public IterativeSolver
+{
+protected:
+   int recycle_dim = 10; // see SetRecycleDim()
+   int num_stored = 40;
+
+   mutable Vector r, z, p, q;
+   /** The recycled subspace W and A W are the first k columns of the
+       contiguous blocks Z and AZ, followed by the stored search directions
+       and their images by A. */
+   mutable Vector Z, AZ, part;
+   mutable int k = 0;
+   /// Galerkin matrix W^T A W.
+   mutable DenseMatrix E;
+   /// True if the columns of AZ are A W for the current operator.
+   mutable bool aw_valid = false;
+
+   void UpdateVectors();
+
+   /// Recompute A W and W^T A W after a change of the operator.
+   void UpdateDeflation() const;
+
+   /** Replace W by the Ritz vectors of the smallest Ritz values in the span
+       of the first @a s columns of Z. */
+   void UpdateRecycleSpace(int s) const;
+
+   /// Compute c = E^{-1} V^T u, where V has the first k columns of @a V.
+   void ProjectionCoefficients(const Vector &V, const Vector &u,
+                               Vector &c) const;
+
+public:
+   DeflatedCGSolver() { }
+
+#ifdef MFEM_USE_MPI
+   DeflatedCGSolver(MPI_Comm comm_) : IterativeSolver(comm_) { }
+#endif
+
+   /** @brief Set the dimension of the recycled subspace (default 10) and the
+       number of search directions of a solve used to update it (default
+       40). */
+   void SetRecycleDim(int dim, int stored_directions = 40)
+   { recycle_dim = dim; num_stored = stored_directions; }
+
+   /// Return the current dimension of the recycled subspace.
+   int GetRecycleDim() const { return k; }
+
+   /// Discard the recycled subspace.
+   void ClearRecycleSpace() { k = 0; aw_valid = false; }
+
+   /** @brief Set the operator, keeping the recycled subspace. The operator
+       may change between the calls to Mult(), but its size may not, unless
+       ClearRecycleSpace() is called. */
+   void SetOperator(const Operator &op) override;
+
+   /** @brief Iterative solution of the linear system using the deflated
+       Conjugate Gradient method, updating the recycled subspace. */
+   void Mult(const Vector &b, Vector &x) const override;
+};
+
 /// Conjugate gradient method. (tolerances are squared)
 void CG(const Operator &A, const Vector &b, Vector &x,
         int print_iter = 0, int max_num_iter = 1000,
@@ -617,6 +807,118 @@ public:
    void Mult(const Vector &b, Vector &x) const override;
 };
 
+/** @brief GMRES method with low-synchronization orthogonalization.
+
+    The Krylov basis is stored contiguously and orthogonalized with classical
+    Gram-Schmidt with delayed reorthogonalization (DCGS2, see Swirydowicz et
+    al., "Low synchronization Gram-Schmidt and GMRES algorithms", 2020). All
+    inner products of an iteration are computed in one pass over the basis
+    and summed with a single global reduction, compared to one reduction per
+    basis vector for the modified Gram-Schmidt of GMRESSolver and FGMRESSolver.
+    The projections and the (re)orthogonalization are applied in one pass over
+    the basis. Since the orthogonalization of a basis vector is completed in
+    the next iteration, the residual norm lags one operator application
+    behind, and restarts need one additional reduction.
+
+    By default the method uses left preconditioning and the convergence is
+    measured with the norm of the preconditioned residual, as in GMRESSolver.
+    With SetFlexible(), it uses flexible right preconditioning and the norm of
+    the residual, as in FGMRESSolver. The inner products are always the
+    standard l2 ones: an override of Dot() is not used in the iterations. */
+class LowSyncGMRESSolver : public IterativeSolver
+{
+protected:
+   int m = 50; // see SetKDim()
+   bool flexible = false; // see SetFlexible()
+
+public:
+   LowSyncGMRESSolver() { }
+
+#ifdef MFEM_USE_MPI
+   LowSyncGMRESSolver(MPI_Comm comm_) : IterativeSolver(comm_) { }
+#endif
+
+   /// Set the number of iteration to perform between restarts, default is 50.
+   void SetKDim(int dim) { m = dim; }
+
+   /** @brief Use flexible right preconditioning, as in FGMRESSolver, instead
+       of left preconditioning. */
+   void SetFlexible(bool flex = true) { flexible = flex; }
+
+   /// Iterative solution of the linear system using the GMRES method
+   void Mult(const Vector &b, Vector &x) const override;
+};
+
+/** @brief GCRO-DR, restarted GMRES with deflated restarting and recycling of
+    a subspace between the calls to Mult(), for sequences of related
+    nonsymmetric systems.
+
+    The solver keeps a subspace U with C = A B U orthonormal, where B is the
+    (right) preconditioner, see Parks, de Sturler, Mackey, Johnson and Maiti,
+    "Recycling Krylov subspaces for sequences of linear systems", SIAM J. Sci.
+    Comput. 28 (2006). The residual is first projected onto the orthogonal
+    complement of C, and each cycle runs m Arnoldi steps with the operator
+    (I - C C^T) A B. At the end of each cycle, U is replaced by the k vectors
+    of the span of U and of the Arnoldi basis with the smallest singular
+    values of A B (in the Rayleigh-Ritz sense), which are also the harmonic
+    Ritz vectors for normal operators. This choice only needs the symmetric
+    eigenvalue problems of small matrices.
+
+    SetOperator() and SetPreconditioner() keep U, and C is recomputed in the
+    next Mult(). The norm used in the convergence criterion and in Monitor()
+    is the norm of the true residual, || b - A x ||, as in FGMRESSolver. */
+class GCRODRSolver : public IterativeSolver
+{
+protected:
+   int m = 30; // see SetKDim()
+   int recycle_dim = 10; // see SetRecycleDim()
+
+   /// Contiguous recycled subspaces U and C = A B U, with k columns.
+   mutable Vector U, C;
+   mutable int k = 0;
+   /// True if C = A B U for the current operator and preconditioner.
+   mutable bool c_valid = false;
+
+   /// Recompute C = A B U and orthonormalize it, after a change of A or B.
+   void UpdateRecycleSpace() const;
+
+   /** Replace U and C after a cycle of @a j Arnoldi steps with the basis @a V,
+       the Hessenberg matrix @a H and the projections @a Bc = C^T A B V. */
+   void UpdateFromCycle(int j, const Vector &V, const DenseMatrix &H,
+                        const DenseMatrix &Bc) const;
+
+public:
+   GCRODRSolver() { }
+
+#ifdef MFEM_USE_MPI
+   GCRODRSolver(MPI_Comm comm_) : IterativeSolver(comm_) { }
+#endif
+
+   /// Set the number of Arnoldi steps of a cycle (default 30).
+   void SetKDim(int dim) { m = dim; }
+
+   /// Set the dimension of the recycled subspace (default 10).
+   void SetRecycleDim(int dim) { recycle_dim = dim; }
+
+   /// Return the current dimension of the recycled subspace.
+   int GetRecycleDim() const { return k; }
+
+   /// Discard the recycled subspace.
+   void ClearRecycleSpace() { k = 0; c_valid = false; }
+
+   /** @brief Set the operator, keeping the recycled subspace. The operator
+       may change between the calls to Mult(), but its size may not, unless
+       ClearRecycleSpace() is called. */
+   void SetOperator(const Operator &op) override;
+
+   /// Set the (right) preconditioner, keeping the recycled subspace.
+   void SetPreconditioner(Solver &pr) override;
+
+   /** @brief Iterative solution of the linear system using GCRO-DR, updating
+       the recycled subspace. */
+   void Mult(const Vector &b, Vector &x) const override;
+};
+
 /// GMRES method. (tolerances are squared)
 int GMRES(const Operator &A, Vector &x, const Vector &b, Solver &M,
           int &max_iter, int m, real_t &tol, real_t atol, int printit);
@@ -1032,6 +1334,23 @@ public:
       NONE
    };
 
+   /// The method used for the block triangular solves in Mult().
+   enum class TriangularSolve
+   {
+      /// Sequential forward and backward substitution (default).
+      SEQUENTIAL,
+      /** Substitution by level sets (wavefronts): the block rows of a level
+          only depend on the rows of the previous levels, and are solved in
+          parallel with OpenMP threads. The result is the same as with
+          SEQUENTIAL. */
+      LEVEL_SCHEDULED,
+      /** Approximate triangular solves with a fixed number of Jacobi
+          iterations, each of them parallel over all the block rows. The
+          preconditioner is no longer the exact inverse of the ILU factors,
+          but it is still a fixed linear operator. */
+      JACOBI
+   };
+
    /** Create an "empty" BlockILU solver. SetOperator must be called later to
     *  actually form the factorization
     */
@@ -1042,18 +1361,35 @@ public:
    /** Create a block ILU approximate factorization for the matrix @a op.
     *  @a op should be of type either SparseMatrix or HypreParMatrix. In the
     *  case that @a op is a HypreParMatrix, the ILU factorization is performed
-    *  on the diagonal blocks of the parallel decomposition.
+    *  on the diagonal blocks of the parallel decomposition. A BSRMatrix with
+    *  byVDIM ordering and block size @a block_size_ is also accepted.
     */
    BlockILU(const Operator &op, int block_size_ = 1,
             Reordering reordering_ = Reordering::MINIMUM_DISCARDED_FILL,
             int k_fill_ = 0);
 
    /** Perform the block ILU factorization for the matrix @a op.
-    *  As in the constructor, @a op must either be a SparseMatrix or
-    *  HypreParMatrix
+    *  As in the constructor, @a op must either be a SparseMatrix,
+    *  HypreParMatrix or BSRMatrix
     */
    void SetOperator(const Operator &op);
 
+   /** @brief Set the method of the block triangular solves in Mult(), see
+       TriangularSolve. With TriangularSolve::JACOBI, @a jacobi_iter_ is the
+       number of Jacobi iterations of each of the two solves. */
+   void SetTriangularSolve(TriangularSolve ts, int jacobi_iter_ = 3)
+   { tri_solve = ts; jacobi_iter = jacobi_iter_; }
+
+   /** @brief Return the number of level sets of the block lower triangular
+       factor, i.e. the length of the longest chain of dependent block rows in
+       the factorization and the forward solve.
+
+       The factorization is computed level by level, with the rows of a level
+       factorized in parallel with OpenMP threads. Reordering::NONE keeps the
+       ordering of the matrix, e.g. of the elements of a DG space, which may
+       give fewer levels than the default reordering. */
+   int GetNumLevels() const { return lower_offsets.Size() - 1; }
+
    /// Solve the system `LUx = b`, where `L` and `U` are the block ILU factors.
    void Mult(const Vector &b, Vector &x) const;
 
@@ -1076,9 +1412,27 @@ private:
    /// Set up the block CSR structure corresponding to a sparse matrix @a A
    void CreateBlockPattern(const class SparseMatrix &A);
 
+   /// Compute the level sets of the block triangular factors
+   void ComputeLevels();
+
    /// Perform the block ILU factorization
    void Factorize();
 
+   /// Eliminate the block lower triangular part of the block row @a i
+   void FactorizeRow(int i);
+
+   /** Compute block row @a i of y_out = P b - L y_in, where L is the strictly
+    *  block lower triangular part of the factorization.
+    */
+   void LowerRow(int i, const real_t *b, const real_t *y_in,
+                 real_t *y_out) const;
+
+   /** Compute block row @a i of z_out = D^{-1} (y - U z_in), where U is the
+    *  strictly block upper triangular part of the factorization.
+    */
+   void UpperRow(int i, const real_t *y, const real_t *z_in,
+                 real_t *z_out) const;
+
    int block_size;
 
    /// Fill level for block ILU(k) factorizations. Only k=0 is supported.
@@ -1086,9 +1440,22 @@ private:
 
    Reordering reordering;
 
+   TriangularSolve tri_solve = TriangularSolve::SEQUENTIAL;
+
+   /// Number of Jacobi iterations for TriangularSolve::JACOBI.
+   int jacobi_iter = 3;
+
    /// Temporary vector used in the Mult() function.
    mutable Vector y;
 
+   /// Temporary vectors used by the parallel triangular solves.
+   mutable Vector z, y_tmp;
+
+   /** Block rows of the level sets of the L (lower) and U (upper) factors,
+    *  and the offsets of the levels in the rows arrays.
+    */
+   Array<int> lower_rows, lower_offsets, upper_rows, upper_offsets;
+
    /// Permutation and inverse permutation vectors for the block reordering.
    Array<int> P, Pinv;
 
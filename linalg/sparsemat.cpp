@@ -333,6 +333,8 @@ void SparseMatrix::SetEmpty()
    ColPtrJ = NULL;
    ColPtrNode = NULL;
    At = NULL;
+   sell = nullptr;
+   sellChecked = false;
 #ifdef MFEM_USE_MEMALLOC
    NodesMem = NULL;
 #endif
@@ -789,6 +791,12 @@ void SparseMatrix::AddMult(const Vector &x, Vector &y, const real_t a) const
       return;
    }
 
+   if (const SellMatrix *S = GetSellMatrix())
+   {
+      S->AddMult(x, y, a);
+      return;
+   }
+
 #ifndef MFEM_USE_LEGACY_OPENMP
    const int height = this->height;
    const int nnz = J.Capacity();
@@ -991,6 +999,10 @@ void SparseMatrix::AddMultTranspose(const Vector &x, Vector &y,
    {
       At->AddMult(x, y, a);
    }
+   else if (const SellMatrix *S = GetSellMatrix())
+   {
+      S->AddMultTranspose(x, y, a);
+   }
    else
    {
       real_t *yp = y.HostReadWrite();
@@ -1028,6 +1040,35 @@ void SparseMatrix::ResetTranspose() const
    At = NULL;
 }
 
+const SellMatrix *SparseMatrix::GetSellMatrix() const
+{
+   if (!useSell || !Finalized() || Device::Allows(~Backend::CPU_MASK))
+   {
+      return nullptr;
+   }
+   if (!sellChecked)
+   {
+      sellChecked = true;
+      if (SellMatrix::IsBeneficial(*this))
+      {
+         sell = new SellMatrix(*this);
+         if (sell->GetEfficiency() < SellMatrix::min_efficiency)
+         {
+            ResetSellFormat();
+            sellChecked = true;
+         }
+      }
+   }
+   return sell;
+}
+
+void SparseMatrix::ResetSellFormat() const
+{
+   delete sell;
+   sell = nullptr;
+   sellChecked = false;
+}
+
 void SparseMatrix::EnsureMultTranspose() const
 {
    if (Device::Allows(~Backend::CPU_MASK))
@@ -3629,6 +3670,7 @@ void SparseMatrix::Destroy()
    delete NodesMem;
 #endif
    delete At;
+   delete sell;
 
    ClearGPUSparse();
 }
@@ -4358,6 +4400,8 @@ void SparseMatrix::Swap(SparseMatrix &other)
    mfem::Swap(ColPtrJ, other.ColPtrJ);
    mfem::Swap(ColPtrNode, other.ColPtrNode);
    mfem::Swap(At, other.At);
+   mfem::Swap(sell, other.sell);
+   mfem::Swap(sellChecked, other.sellChecked);
 
 #ifdef MFEM_USE_MEMALLOC
    mfem::Swap(NodesMem, other.NodesMem);
@@ -34,6 +34,8 @@
 namespace mfem
 {
 
+class SellMatrix;
+
 class
 #if defined(__alignas_is_defined)
    alignas(real_t)
@@ -92,6 +94,16 @@ protected:
 
    bool useGPUSparse = true; // Use cuSPARSE or hipSPARSE if available
 
+   bool useSell = false; // Use the SELL-C-sigma format if beneficial
+   /// SELL-C-sigma copy of the matrix, see UseSellFormat(). Owned.
+   mutable SellMatrix *sell = nullptr;
+   /// Was the SELL-C-sigma format checked (and #sell built) for this matrix?
+   mutable bool sellChecked = false;
+
+   /// Return the SELL-C-sigma copy of the matrix to use in the host products,
+   /// building it on the first call, or NULL if it is not used.
+   const SellMatrix *GetSellMatrix() const;
+
    // Initialize cuSPARSE/hipSPARSE
    void InitGPUSparse();
 
@@ -193,6 +205,25 @@ public:
    MFEM_DEPRECATED
    void UseCuSparse(bool useCuSparse_ = true) { UseGPUSparse(useCuSparse_); }
 
+   /** @brief Runtime option to use a SELL-C-sigma copy of the matrix (see
+       class SellMatrix) in Mult(), AddMult(), MultTranspose() and
+       AddMultTranspose() when it is expected to be faster than the CSR format.
+       Only used with the serial CPU backends.
+
+       The copy is built in the first product after the matrix is finalized, if
+       SellMatrix::IsBeneficial() and the padding is small. It is a snapshot of
+       the matrix: after changing the matrix, call ResetSellFormat(), as for
+       the internal transpose, see BuildTranspose(). */
+   void UseSellFormat(bool useSell_ = true)
+   { useSell = useSell_; ResetSellFormat(); }
+
+   /// Return true if the products use the SELL-C-sigma format.
+   bool UsesSellFormat() const { return GetSellMatrix() != nullptr; }
+
+   /** Reset (destroy) the SELL-C-sigma copy of the matrix. If UseSellFormat()
+       is enabled, it is rebuilt from the current values when needed. */
+   void ResetSellFormat() const;
+
    /// Assignment operator: deep copy
    SparseMatrix& operator=(const SparseMatrix &rhs);
 
@@ -15,7 +15,14 @@
 #include "matrix.hpp"
 #include "sparsemat.hpp"
 #include "sparsesmoothers.hpp"
+#include "../general/forall.hpp"
 #include <iostream>
+#include <algorithm>
+#include <memory>
+
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
 
 namespace mfem
 {
@@ -31,6 +38,132 @@ void SparseSmoother::SetOperator(const Operator &a)
    width = oper->Width();
 }
 
+void GSSmoother::SetOperator(const Operator &a)
+{
+   SparseSmoother::SetOperator(a);
+   coloring_valid = false;
+}
+
+void GSSmoother::ComputeColoring() const
+{
+   MFEM_VERIFY(oper->Finalized(), "The matrix must be finalized.");
+   const int n = oper->Height();
+   const int *I = oper->HostReadI(), *J = oper->HostReadJ();
+   // Rows coupled in either direction must have different colors
+   std::unique_ptr<SparseMatrix> At(Transpose(*oper));
+   const int *It = At->HostReadI(), *Jt = At->HostReadJ();
+
+   // Greedy (first-fit) coloring in the natural order of the rows; used[c] is
+   // i if color c is used by a neighbor of row i
+   Array<int> color(n), used;
+   for (int i = 0; i < n; i++)
+   {
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         if (J[k] < i) { used[color[J[k]]] = i; }
+      }
+      for (int k = It[i]; k < It[i+1]; k++)
+      {
+         if (Jt[k] < i) { used[color[Jt[k]]] = i; }
+      }
+      int c = 0;
+      while (c < used.Size() && used[c] == i) { c++; }
+      if (c == used.Size()) { used.Append(-1); }
+      color[i] = c;
+   }
+
+   const int num_colors = used.Size();
+   color_offsets.SetSize(num_colors + 1);
+   color_offsets = 0;
+   for (int i = 0; i < n; i++) { color_offsets[color[i] + 1]++; }
+   color_offsets.PartialSum();
+   color_rows.SetSize(n);
+   used = 0;
+   for (int i = 0; i < n; i++)
+   {
+      color_rows[color_offsets[color[i]] + used[color[i]]++] = i;
+   }
+   coloring_valid = true;
+}
+
+int GSSmoother::GetNumColors() const
+{
+   if (!coloring_valid) { ComputeColoring(); }
+   return color_offsets.Size() - 1;
+}
+
+// Relax row i of the Gauss-Seidel iteration, reading the columns in [b0,b1)
+// from y and the others from y_ext. Rows with a zero diagonal are skipped.
+static MFEM_HOST_DEVICE inline
+void GSRelaxRow(const int i, const int *I, const int *J, const real_t *A,
+                const real_t *x, const real_t *y_ext, real_t *y, const int b0,
+                const int b1)
+{
+   real_t sum = 0.0, diag = 0.0;
+   for (int k = I[i]; k < I[i+1]; k++)
+   {
+      const int j = J[k];
+      if (j == i) { diag += A[k]; }
+      else { sum += A[k]*((j >= b0 && j < b1) ? y[j] : y_ext[j]); }
+   }
+   if (diag != 0.0) { y[i] = (x[i] - sum)/diag; }
+}
+
+void GSSmoother::ParallelSweep(const Vector &x, Vector &y, bool forward) const
+{
+   const int n = oper->Height();
+   const auto I = oper->ReadI();
+   const auto J = oper->ReadJ();
+   const auto A = oper->ReadData();
+   const auto X = x.Read();
+
+   if (parallelism == Parallelism::MULTICOLOR)
+   {
+      auto Y = y.ReadWrite();
+      const auto rows = color_rows.Read();
+      const int nc = color_offsets.Size() - 1;
+      for (int k = 0; k < nc; k++)
+      {
+         // The rows of one color are not coupled, so they can be relaxed in
+         // any order
+         const int c = forward ? k : nc - 1 - k;
+         const int begin = color_offsets[c];
+         mfem::forall(color_offsets[c+1] - begin, [=] MFEM_HOST_DEVICE (int r)
+         {
+            GSRelaxRow(rows[begin + r], I, J, A, X, Y, Y, 0, n);
+         });
+      }
+   }
+   else
+   {
+      int nb = num_blocks;
+      if (nb <= 0)
+      {
+#ifdef MFEM_USE_OPENMP
+         nb = omp_get_max_threads();
+#else
+         nb = 1;
+#endif
+      }
+      nb = std::max(1, std::min(nb, n));
+      y_old.SetSize(n);
+      y_old.UseDevice(true);
+      y_old = y;
+      const auto Y_old = y_old.Read();
+      auto Y = y.ReadWrite();
+      mfem::forall(nb, [=] MFEM_HOST_DEVICE (int b)
+      {
+         const int b0 = (int)(((long long)b*n)/nb);
+         const int b1 = (int)(((long long)(b + 1)*n)/nb);
+         for (int r = 0; r < b1 - b0; r++)
+         {
+            const int i = forward ? b0 + r : b1 - 1 - r;
+            GSRelaxRow(i, I, J, A, X, Y_old, Y, b0, b1);
+         }
+      });
+   }
+}
+
 /// Matrix vector multiplication with GS Smoother.
 void GSSmoother::Mult(const Vector &x, Vector &y) const
 {
@@ -38,6 +171,20 @@ void GSSmoother::Mult(const Vector &x, Vector &y) const
    {
       y = 0.0;
    }
+   if (parallelism != Parallelism::NONE)
+   {
+      if (parallelism == Parallelism::MULTICOLOR &&
+          (!coloring_valid || !cache_coloring))
+      {
+         ComputeColoring();
+      }
+      for (int i = 0; i < iterations; i++)
+      {
+         if (type != 2) { ParallelSweep(x, y, true); }
+         if (type != 1) { ParallelSweep(x, y, false); }
+      }
+      return;
+   }
    for (int i = 0; i < iterations; i++)
    {
       if (type != 2)
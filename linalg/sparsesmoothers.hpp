@@ -35,10 +35,44 @@ public:
 /// Data type for Gauss-Seidel smoother of sparse matrix
 class GSSmoother : public SparseSmoother
 {
+public:
+   /// Parallel variants of the Gauss-Seidel sweeps, see SetParallelism().
+   enum class Parallelism
+   {
+      /// Sequential sweeps over the rows in their natural order (default).
+      NONE,
+      /** Multicolor Gauss-Seidel: the rows are colored so that rows of the
+          same color are not coupled, and the rows of each color are relaxed
+          in parallel, one color after another. This is Gauss-Seidel for the
+          matrix with the rows and columns permuted by color. */
+      MULTICOLOR,
+      /** Hybrid block Jacobi/Gauss-Seidel: the rows are split into contiguous
+          blocks, relaxed in parallel with Gauss-Seidel inside each block,
+          using the values from the beginning of the sweep for the columns
+          outside of the block. */
+      HYBRID
+   };
+
 protected:
    int type; // 0, 1, 2 - symmetric, forward, backward
    int iterations;
 
+   Parallelism parallelism = Parallelism::NONE;
+   int num_blocks = 0; // number of blocks of the HYBRID variant
+   bool cache_coloring = true;
+
+   /// Rows sorted by color, and the offsets of the colors in #color_rows.
+   mutable Array<int> color_rows, color_offsets;
+   mutable bool coloring_valid = false;
+   /// Copy of the solution at the beginning of a HYBRID sweep.
+   mutable Vector y_old;
+
+   /// Compute a greedy coloring of the graph of the matrix and its transpose.
+   void ComputeColoring() const;
+
+   /// One forward or backward parallel sweep.
+   void ParallelSweep(const Vector &x, Vector &y, bool forward) const;
+
 public:
    /// Create GSSmoother.
    GSSmoother(int t = 0, int it = 1) { type = t; iterations = it; }
@@ -47,6 +81,34 @@ public:
    GSSmoother(const SparseMatrix &a, int t = 0, int it = 1)
       : SparseSmoother(a) { type = t; iterations = it; }
 
+   /** @brief Use a parallel variant of the sweeps, see Parallelism. The
+       threads of the mfem::forall loops are used, e.g. with the "omp" device,
+       and the result does not depend on the number of threads.
+
+       With Parallelism::HYBRID, the rows are split into @a num_blocks_ blocks.
+       If @a num_blocks_ is not positive, the number of OpenMP threads is used
+       (one block without OpenMP), in which case the result depends on the
+       number of threads.
+
+       The symmetric smoother (type 0) stays symmetric for symmetric matrices
+       with both variants: the backward sweep visits the colors, or the rows
+       of the blocks, in the reverse order of the forward sweep. It can be
+       used as a preconditioner for CGSolver. Rows with a zero diagonal entry
+       are not changed by the parallel variants. */
+   void SetParallelism(Parallelism p, int num_blocks_ = 0)
+   { parallelism = p; num_blocks = num_blocks_; }
+
+   /** @brief Keep the coloring of Parallelism::MULTICOLOR across the calls to
+       Mult() (default), or recompute it in every call if @a cache is false,
+       e.g. when the sparsity of the matrix changes between the calls. The
+       coloring is always recomputed after SetOperator(). */
+   void SetColoringCache(bool cache = true) { cache_coloring = cache; }
+
+   /// Return the number of colors of Parallelism::MULTICOLOR.
+   int GetNumColors() const;
+
+   void SetOperator(const Operator &a) override;
+
    /// Matrix vector multiplication with GS Smoother.
    void Mult(const Vector &x, Vector &y) const override;
 };
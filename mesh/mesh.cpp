@@ -16,13 +16,16 @@
 #include "../fem/fem.hpp"
 #include "../general/sort_pairs.hpp"
 #include "../general/binaryio.hpp"
+#include "../general/binaryfile.hpp"
 #include "../general/text.hpp"
 #include "../general/device.hpp"
 #include "../general/tic_toc.hpp"
+#include "../general/annotation.hpp"
 #include "../general/gecko.hpp"
 #include "../general/kdtree.hpp"
 #include "../general/sets.hpp"
 #include "../fem/quadinterpolator.hpp"
+#include "../fem/qdata_cache.hpp"
 
 // headers already included by mesh.hpp: <iostream>, <array>, <map>, <memory>
 #include <sstream>
@@ -4463,6 +4466,58 @@ Mesh Mesh::LoadFromFile(const std::string &filename, int generate_edges,
    return mesh;
 }
 
+// The binary mesh entries are: "info" = {Dim, spaceDim, NumOfVertices,
+// NumOfElements, NumOfBdrElements, curved}, "vertices" with three coordinates
+// per vertex, "elements" and "boundary" with {attribute, geometry, vertices}
+// for every element and, for curved meshes, the "nodes" grid function.
+Mesh Mesh::LoadFromBinary(const BinaryFile &file, const std::string &name,
+                          int refine, bool fix_orientation)
+{
+   const char *msg = "invalid binary mesh ";
+   uint64_t n;
+   const int *info = file.GetEntry<int>(name + "/info", n);
+   MFEM_VERIFY(n == 6, msg << name);
+
+   Mesh mesh;
+   mesh.InitMesh(info[0], info[1], 0, info[3], info[4]);
+
+   real_t *coords = file.GetEntry<real_t>(name + "/vertices", n);
+   MFEM_VERIFY(n == 3*uint64_t(info[2]), msg << name);
+   // assuming Vertex is POD
+   mesh.vertices.MakeRef(reinterpret_cast<Vertex*>(coords), info[2]);
+   mesh.NumOfVertices = info[2];
+
+   auto load_elements = [&](const std::string &entry, Array<Element*> &els,
+                            int num_elements)
+   {
+      const int *data = file.GetEntry<int>(name + entry, n);
+      const int *end = data + n;
+      for (int i = 0; i < num_elements; i++)
+      {
+         MFEM_VERIFY(data + 2 <= end, msg << name);
+         els[i] = mesh.NewElement(data[1]);
+         els[i]->SetAttribute(data[0]);
+         MFEM_VERIFY(data + 2 + els[i]->GetNVertices() <= end, msg << name);
+         els[i]->SetVertices(data + 2);
+         data += 2 + els[i]->GetNVertices();
+      }
+   };
+   load_elements("/elements", mesh.elements, info[3]);
+   mesh.NumOfElements = info[3];
+   load_elements("/boundary", mesh.boundary, info[4]);
+   mesh.NumOfBdrElements = info[4];
+
+   mesh.FinalizeTopology(false);
+   if (info[5])
+   {
+      // the vertices were saved consistent with the nodes
+      mesh.Nodes = new GridFunction(&mesh, file, name + "/nodes");
+      mesh.own_nodes = 1;
+   }
+   mesh.Finalize(refine, fix_orientation);
+   return mesh;
+}
+
 Mesh Mesh::MakeCartesian1D(int n, real_t sx)
 {
    Mesh mesh;
@@ -8553,6 +8608,44 @@ int *Mesh::CartesianPartitioning(int nxyz[])
    return partitioning;
 }
 
+int *Mesh::SpaceFillingCurvePartitioning(int nparts, const Vector *weights)
+{
+   MFEM_VERIFY(nparts > 0, "invalid number of parts: " << nparts);
+   MFEM_VERIFY(!weights || weights->Size() == NumOfElements,
+               "the size of the weights must be the number of elements");
+
+   int *partitioning = new int[NumOfElements];
+   if (NumOfElements == 0) { return partitioning; }
+
+   // the sequence of the elements along the Hilbert curve
+   Array<int> ordering, sequence(NumOfElements);
+   GetHilbertElementOrdering(ordering);
+   for (int el = 0; el < NumOfElements; el++) { sequence[ordering[el]] = el; }
+
+   real_t total = 0.0;
+   for (int el = 0; el < NumOfElements; el++)
+   {
+      const real_t w = weights ? (*weights)(el) : 1.0;
+      MFEM_VERIFY(w >= 0.0, "negative element weight: " << w);
+      total += w;
+   }
+   MFEM_VERIFY(total > 0.0, "the sum of the element weights is zero");
+
+   // split the sequence into nparts pieces of (almost) equal weight, assigning
+   // each element to the part containing the middle of its weight
+   real_t prefix = 0.0;
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      const int el = sequence[i];
+      const real_t w = weights ? (*weights)(el) : 1.0;
+      const int part = (int)floor((prefix + 0.5*w)*nparts/total);
+      partitioning[el] = std::min(std::max(part, 0), nparts-1);
+      prefix += w;
+   }
+
+   return partitioning;
+}
+
 void FindPartitioningComponents(Table &elem_elem,
                                 const Array<int> &partitioning,
                                 Array<int> &component,
@@ -8878,10 +8971,8 @@ int *Mesh::GeneratePartitioning(int nparts, int part_method)
 
 #else
 
-   mfem_error("Mesh::GeneratePartitioning(...): "
-              "MFEM was compiled without Metis.");
-
-   return NULL;
+   // without METIS, split the elements along a space-filling curve
+   return SpaceFillingCurvePartitioning(nparts);
 
 #endif
 }
@@ -10657,6 +10748,8 @@ void Mesh::LocalRefinement(const Array<int> &marked_el, int type)
 void Mesh::NonconformingRefinement(const Array<Refinement> &refinements,
                                    int nc_limit)
 {
+   MFEM_PERF_SCOPE("Mesh::NonconformingRefinement");
+
    MFEM_VERIFY(!NURBSext, "Nonconforming refinement of NURBS meshes is "
                "not supported. Project the NURBS to Nodes first.");
 
@@ -10942,6 +11035,8 @@ static Array<int>& AllElements(Array<int> &list, int nelem)
 
 void Mesh::UniformRefinement(int ref_algo)
 {
+   MFEM_PERF_SCOPE("Mesh::UniformRefinement");
+
    Array<int> list;
 
    if (NURBSext)
@@ -11028,6 +11123,8 @@ void Mesh::NURBSCoarsening(int cf, real_t tol)
 void Mesh::GeneralRefinement(const Array<Refinement> &refinements,
                              int nonconforming, int nc_limit)
 {
+   MFEM_PERF_SCOPE("Mesh::GeneralRefinement");
+
    if (ncmesh)
    {
       nonconforming = 1;
@@ -11955,6 +12052,37 @@ void Mesh::Save(const std::string &fname, int precision) const
    Print(ofs);
 }
 
+void Mesh::SaveBinary(BinaryFileWriter &out, const std::string &name) const
+{
+   MFEM_VERIFY(!ncmesh && !NURBSext,
+               "nonconforming and NURBS meshes are not supported");
+   const int info[6] = { Dim, spaceDim, NumOfVertices, NumOfElements,
+                         NumOfBdrElements, Nodes != nullptr
+                       };
+   out.Write(name + "/info", info, 6);
+   out.Write(name + "/vertices",
+             reinterpret_cast<const real_t*>(vertices.GetData()),
+             3*uint64_t(NumOfVertices));
+
+   Array<int> data;
+   auto save_elements = [&](const std::string &entry,
+                            const Array<Element*> &els, int num_elements)
+   {
+      data.SetSize(0);
+      for (int i = 0; i < num_elements; i++)
+      {
+         data.Append(els[i]->GetAttribute());
+         data.Append(els[i]->GetGeometryType());
+         data.Append(els[i]->GetVertices(), els[i]->GetNVertices());
+      }
+      out.Write(name + entry, data.GetData(), data.Size());
+   };
+   save_elements("/elements", elements, NumOfElements);
+   save_elements("/boundary", boundary, NumOfBdrElements);
+
+   if (Nodes) { Nodes->SaveBinary(out, name + "/nodes"); }
+}
+
 #ifdef MFEM_USE_ADIOS2
 void Mesh::Print(adios2stream &os) const
 {
@@ -14730,6 +14858,16 @@ void GeometricFactors::Compute(const GridFunction &nodes,
       eval_flags |= QuadratureInterpolator::DETERMINANTS;
    }
 
+   // Read the factors from the on-disk cache, if enabled and available
+   std::vector<Vector*> factors;
+   if (computed_factors & COORDINATES) { factors.push_back(&X); }
+   if (computed_factors & JACOBIANS) { factors.push_back(&J); }
+   if (computed_factors & DETERMINANTS) { factors.push_back(&detJ); }
+   const std::string cache_key = QuadratureDataCache::GetKey(
+                                    "GeometricFactors", nodes, *IntRule,
+                                    nullptr, computed_factors);
+   if (QuadratureDataCache::Load(cache_key, factors)) { return; }
+
    const QuadratureInterpolator *qi = fespace->GetQuadratureInterpolator(*IntRule);
    // All X, J, and detJ use this layout:
    qi->SetOutputLayout(QVectorLayout::byNODES);
@@ -14752,6 +14890,8 @@ void GeometricFactors::Compute(const GridFunction &nodes,
    {
       qi->Mult(nodes, eval_flags, X, J, detJ);
    }
+   QuadratureDataCache::Save(
+      cache_key, std::vector<const Vector*>(factors.begin(), factors.end()));
 }
 
 FaceGeometricFactors::FaceGeometricFactors(const Mesh *mesh,
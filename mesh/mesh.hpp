@@ -38,6 +38,8 @@ namespace mfem
 
 class GeometricFactors;
 class FaceGeometricFactors;
+class BinaryFile;
+class BinaryFileWriter;
 class KnotVector;
 class NURBSExtension;
 class FiniteElementSpace;
@@ -810,6 +812,16 @@ public:
                             int generate_edges = 0, int refine = 1,
                             bool fix_orientation = true);
 
+   /** @brief Creates a mesh from the entries @a name of the binary file
+       @a file, written with SaveBinary().
+
+       The vertex coordinates and the nodes, if any, are not copied: they
+       refer to the memory-mapped data of @a file, which must outlive the
+       mesh. */
+   static Mesh LoadFromBinary(const BinaryFile &file,
+                              const std::string &name = "mesh",
+                              int refine = 1, bool fix_orientation = true);
+
    /// Creates 1D mesh, divided into n equal intervals.
    static Mesh MakeCartesian1D(int n, real_t sx = 1.0);
 
@@ -2179,7 +2191,19 @@ public:
 
    /// @note The returned array should be deleted by the caller.
    int *CartesianPartitioning(int nxyz[]);
-   /// @note The returned array should be deleted by the caller.
+   /** @brief Partition the elements into @a nparts pieces of (almost) equal
+       weight, which are contiguous along the Hilbert curve through the element
+       centers, see GetHilbertElementOrdering().
+
+       The optional @a weights, one per element, default to one, e.g. the
+       weights can account for variable polynomial orders or measured costs.
+       @note The returned array should be deleted by the caller. */
+   int *SpaceFillingCurvePartitioning(int nparts,
+                                      const Vector *weights = NULL);
+   /** @brief Partition the elements into @a nparts pieces with METIS. When
+       MFEM is built without METIS, the partitioning is computed with
+       SpaceFillingCurvePartitioning() instead and @a part_method is ignored.
+       @note The returned array should be deleted by the caller. */
    int *GeneratePartitioning(int nparts, int part_method = 1);
    /// @todo This method needs a proper description
    void CheckPartitioning(int *partitioning_);
@@ -2464,6 +2488,12 @@ public:
    /// used for ASCII output.
    virtual void Save(const std::string &fname, int precision=16) const;
 
+   /** @brief Write the mesh as the entries @a name of the binary file @a out,
+       see LoadFromBinary(). Nonconforming and NURBS meshes are not
+       supported. */
+   void SaveBinary(BinaryFileWriter &out,
+                   const std::string &name = "mesh") const;
+
    /// Print the mesh to the given stream using the adios2 bp format
 #ifdef MFEM_USE_ADIOS2
    virtual void Print(adios2stream &os) const;
@@ -12,6 +12,7 @@
 #include "mesh_headers.hpp"
 #include "../general/sort_pairs.hpp"
 #include "../general/text.hpp"
+#include "../general/annotation.hpp"
 
 #include <string>
 #include <cmath>
@@ -364,7 +365,7 @@ int NCMesh::GetMidFaceNode(int en1, int en2, int en3, int en4)
    return nodes.GetId(en2, en4);
 }
 
-void NCMesh::ReferenceElement(int elem)
+void NCMesh::ReferenceElement(int elem, int *face_ids)
 {
    const Element &el = elements[elem];
    const int* node = el.node;
@@ -387,7 +388,9 @@ void NCMesh::ReferenceElement(int elem)
    for (int i = 0; i < gi.nf; i++)
    {
       const int* fv = gi.faces[i];
-      faces.GetId(node[fv[0]], node[fv[1]], node[fv[2]], node[fv[3]]);
+      const int id = faces.GetId(node[fv[0]], node[fv[1]],
+                                 node[fv[2]], node[fv[3]]);
+      if (face_ids) { face_ids[i] = id; }
 
       // NOTE: face->RegisterElement called separately to avoid having to store
       // 3 element indices  temporarily in the face when refining. See also
@@ -438,14 +441,14 @@ void NCMesh::UnreferenceElement(int elem, Array<int> &elemFaces)
    }
 }
 
-void NCMesh::RegisterFaces(int elem, int* fattr)
+void NCMesh::RegisterFaces(int elem, int* fattr, const int *face_ids)
 {
    Element &el = elements[elem];
    GeomInfo &gi = GI[el.Geom()];
 
    for (int i = 0; i < gi.nf; i++)
    {
-      Face* face = GetFace(el, i);
+      Face* face = face_ids ? &faces[face_ids[i]] : GetFace(el, i);
       MFEM_ASSERT(face, "face not found.");
       face->RegisterElement(elem);
       if (fattr) { face->attribute = fattr[i]; }
@@ -1907,9 +1910,10 @@ void NCMesh::RefineElement(const Refinement & ref)
    }
 
    // start using the nodes of the children, create edges & faces
+   int child_faces[MaxElemChildren][MaxElemFaces];
    for (int i = 0; i < MaxElemChildren && child[i] >= 0; i++)
    {
-      ReferenceElement(child[i]);
+      ReferenceElement(child[i], child_faces[i]);
    }
 
    int buf[MaxElemFaces];
@@ -1919,10 +1923,11 @@ void NCMesh::RefineElement(const Refinement & ref)
    // sign off of all nodes of the parent, clean up unused nodes, but keep faces
    UnreferenceElement(elem, parentFaces);
 
-   // register the children in their faces
+   // register the children in their faces (the faces of the children are
+   // kept by UnreferenceElement, so their ids are still valid)
    for (int i = 0; i < MaxElemChildren && child[i] >= 0; i++)
    {
-      RegisterFaces(child[i]);
+      RegisterFaces(child[i], NULL, child_faces[i]);
    }
 
    // clean up parent faces, if unused
@@ -1944,6 +1949,8 @@ void NCMesh::RefineElement(const Refinement & ref)
 
 void NCMesh::Refine(const Array<Refinement>& refinements)
 {
+   MFEM_PERF_SCOPE("NCMesh::Refine");
+
    // push all refinements on the stack in reverse order
    ref_stack.Reserve(refinements.Size());
    for (int i = refinements.Size()-1; i >= 0; i--)
@@ -2201,7 +2208,8 @@ void NCMesh::DerefineElement(int elem)
    }
 
    // sign in to all nodes
-   ReferenceElement(elem);
+   int elem_faces[MaxElemFaces];
+   ReferenceElement(elem, elem_faces);
 
    int buf[MaxElemChildren*MaxElemFaces];
    Array<int> childFaces(buf, MaxElemChildren*MaxElemFaces);
@@ -2216,7 +2224,7 @@ void NCMesh::DerefineElement(int elem)
       FreeElement(child[i]);
    }
 
-   RegisterFaces(elem, faces_attribute);
+   RegisterFaces(elem, faces_attribute, elem_faces);
 
    // delete unused faces
    childFaces.Sort();
@@ -2306,6 +2314,8 @@ void NCMesh::CheckDerefinementNCLevel(const Table &deref_table,
 
 void NCMesh::Derefine(const Array<int> &derefs)
 {
+   MFEM_PERF_SCOPE("NCMesh::Derefine");
+
    MFEM_VERIFY(Dim < 3 || Iso,
                "derefinement of 3D anisotropic meshes not implemented yet.");
 
@@ -6853,14 +6863,14 @@ void NCMesh::Trim()
 
 long NCMesh::NCList::MemoryUsage() const
 {
-   int pm_size = 0;
+   long pm_size = 0;
    for (int i = 0; i < Geometry::NumGeom; i++)
    {
-      for (int j = 0; j < point_matrices[i].Size(); i++)
+      for (int j = 0; j < point_matrices[i].Size(); j++)
       {
-         pm_size += static_cast<int>(point_matrices[i][j]->MemoryUsage());
+         pm_size += point_matrices[i][j]->MemoryUsage();
       }
-      pm_size += static_cast<int>(point_matrices[i].MemoryUsage());
+      pm_size += point_matrices[i].MemoryUsage();
    }
 
    return conforming.MemoryUsage() +
@@ -6879,27 +6889,28 @@ long CoarseFineTransformations::MemoryUsage() const
    return mem;
 }
 
-long NCMesh::MemoryUsage() const
-{
-   return nodes.MemoryUsage() +
-          faces.MemoryUsage() +
-          elements.MemoryUsage() +
-          free_element_ids.MemoryUsage() +
-          root_state.MemoryUsage() +
-          coordinates.MemoryUsage() +
-          leaf_elements.MemoryUsage() +
-          leaf_sfc_index.MemoryUsage() +
-          vertex_nodeId.MemoryUsage() +
-          face_list.MemoryUsage() +
-          edge_list.MemoryUsage() +
-          vertex_list.MemoryUsage() +
-          boundary_faces.MemoryUsage() +
-          element_vertex.MemoryUsage() +
-          ref_stack.MemoryUsage() +
-          derefinements.MemoryUsage() +
-          transforms.MemoryUsage() +
-          coarse_elements.MemoryUsage() +
-          sizeof(*this);
+NCMesh::MemoryUsageInfo NCMesh::GetMemoryUsage() const
+{
+   MemoryUsageInfo info;
+   info.nodes = nodes.MemoryUsage();
+   info.faces = faces.MemoryUsage();
+   info.elements = elements.MemoryUsage() + free_element_ids.MemoryUsage();
+   info.leaves = leaf_elements.MemoryUsage() +
+                 leaf_sfc_index.MemoryUsage() +
+                 vertex_nodeId.MemoryUsage() +
+                 element_vertex.MemoryUsage();
+   info.lists = face_list.MemoryUsage() +
+                edge_list.MemoryUsage() +
+                vertex_list.MemoryUsage() +
+                boundary_faces.MemoryUsage();
+   info.refinement = ref_stack.MemoryUsage() +
+                     derefinements.MemoryUsage() +
+                     transforms.MemoryUsage() +
+                     coarse_elements.MemoryUsage();
+   info.other = root_state.MemoryUsage() +
+                coordinates.MemoryUsage() +
+                sizeof(*this);
+   return info;
 }
 
 int NCMesh::PrintMemoryDetail() const
@@ -478,8 +478,29 @@ public:
    /// Save memory by releasing all non-essential and cached data.
    virtual void Trim();
 
+   /// Number of bytes allocated by the main components of the NCMesh.
+   struct MemoryUsageInfo
+   {
+      long nodes;      ///< Node storage, hash table and free list
+      long faces;      ///< Face storage, hash table and free list
+      long elements;   ///< refinement tree: Element storage and free list
+      long leaves;     ///< leaf element ordering and vertex maps
+      long lists;      ///< face, edge and vertex lists, boundary faces
+      long refinement; ///< refinement stack and (de)refinement transforms
+      long other;      ///< root data, coordinates and the NCMesh object
+
+      /// Return the total number of bytes, equal to NCMesh::MemoryUsage().
+      long Total() const
+      {
+         return nodes + faces + elements + leaves + lists + refinement + other;
+      }
+   };
+
+   /// Return the number of bytes allocated by each component of the NCMesh.
+   MemoryUsageInfo GetMemoryUsage() const;
+
    /// Return total number of bytes allocated.
-   long MemoryUsage() const;
+   long MemoryUsage() const { return GetMemoryUsage().Total(); }
 
    int PrintMemoryDetail() const;
 
@@ -538,11 +559,16 @@ protected: // implementation
        off" its nodes by decrementing the ref counts. */
    struct Node : public Hashed2
    {
+      // NOTE: the members are ordered so that the small ones share the word
+      // after the hash links, which avoids padding (32 bytes with doubles).
       char vert_refc, edge_refc;
+   private:
+      bool scaleSet; ///< Indicates whether scale is set and cannot be changed
+   public:
       int vert_index, edge_index;
 
-      Node() : vert_refc(0), edge_refc(0), vert_index(-1), edge_index(-1),
-         scale(0.5), scaleSet(false) {}
+      Node() : vert_refc(0), edge_refc(0), scaleSet(false), vert_index(-1),
+         edge_index(-1), scale(0.5) {}
       ~Node();
 
       bool HasVertex() const { return vert_refc > 0; }
@@ -557,7 +583,6 @@ protected: // implementation
 
    private:
       real_t scale;  ///< Scale from struct Refinement, default 0.5
-      bool scaleSet; ///< Indicates whether scale is set and cannot be changed
 #ifdef MFEM_USE_DOUBLE
       static constexpr real_t scaleTol = 1.0e-8; ///< Scale comparison tolerance
 #else
@@ -958,12 +983,16 @@ protected:
     * @brief Add references to all nodes, edges and faces of the element
     *
     * @param elem index into elements
+    * @param face_ids if not NULL, returns the ids of the element's faces
     */
-   void ReferenceElement(int elem);
+   void ReferenceElement(int elem, int *face_ids = NULL);
    void UnreferenceElement(int elem, Array<int> &elemFaces);
 
    Face* GetFace(Element &elem, int face_no);
-   void RegisterFaces(int elem, int *fattr = NULL);
+   /** Register the element in its faces. The @a face_ids returned by
+       ReferenceElement() can be given to avoid looking up the faces again. */
+   void RegisterFaces(int elem, int *fattr = NULL,
+                      const int *face_ids = NULL);
    void DeleteUnusedFaces(const Array<int> &elemFaces);
 
    void CollectDerefinements(int elem, Array<Connection> &list);
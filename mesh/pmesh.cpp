@@ -20,8 +20,14 @@
 #include "../general/text.hpp"
 #include "../general/globals.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <unordered_map>
+#include <vector>
 
 using namespace std;
 
@@ -1525,6 +1531,437 @@ ParMesh ParMesh::MakeSimplicial(ParMesh &orig_mesh)
    return mesh;
 }
 
+namespace
+{
+
+// Choose a px x py x pz grid of nranks processors, with at least one cell per
+// processor in each direction, minimizing the area of the interfaces.
+void CartesianProcessorGrid(int nranks, const int n[3], int p[3])
+{
+   long long best_area = -1;
+   for (int px = 1; px <= nranks; px++)
+   {
+      if (nranks % px != 0 || px > n[0]) { continue; }
+      for (int py = 1; py <= nranks/px; py++)
+      {
+         if ((nranks/px) % py != 0 || py > n[1]) { continue; }
+         const int pz = nranks/(px*py);
+         if (pz > n[2]) { continue; }
+         const long long area = (px-1)*(long long)n[1]*n[2] +
+                                (py-1)*(long long)n[0]*n[2] +
+                                (pz-1)*(long long)n[0]*n[1];
+         if (best_area < 0 || area < best_area)
+         {
+            best_area = area;
+            p[0] = px; p[1] = py; p[2] = pz;
+         }
+      }
+   }
+   MFEM_VERIFY(best_area >= 0, "a " << n[0] << " x " << n[1] << " x " << n[2]
+               << " mesh can not be split into " << nranks << " blocks");
+}
+
+// First cell of the block p, when n cells are split into np blocks.
+inline int CartesianBlockStart(int p, int n, int np)
+{
+   return (int)(((long long)p*n)/np);
+}
+
+// The block containing the cell c, see CartesianBlockStart().
+inline int CartesianCellBlock(int c, int n, int np)
+{
+   return (int)(((long long)(c+1)*np - 1)/n);
+}
+
+// Fill the table group -> shared entities from the list of shared entities
+// sorted by group, where ents[i][0] is the group of the entity i.
+template <typename T>
+void MakeGroupTable(int ngroups, const std::vector<T> &ents, Table &group_ent)
+{
+   group_ent.MakeI(ngroups);
+   for (const auto &ent : ents) { group_ent.AddAColumnInRow(int(ent[0])-1); }
+   group_ent.MakeJ();
+   for (int i = 0; i < (int)ents.size(); i++)
+   {
+      group_ent.AddConnection(int(ents[i][0])-1, i);
+   }
+   group_ent.ShiftUpI();
+}
+
+} // anonymous namespace
+
+ParMesh ParMesh::MakeCartesian3D(MPI_Comm comm, int nx, int ny, int nz,
+                                 Element::Type type, real_t sx, real_t sy,
+                                 real_t sz, const int *nxyz_proc)
+{
+   MFEM_VERIFY(type == Element::HEXAHEDRON || type == Element::TETRAHEDRON ||
+               type == Element::WEDGE, "unsupported element type: " << type);
+
+   ParMesh mesh;
+   mesh.MyComm = comm;
+   MPI_Comm_size(comm, &mesh.NRanks);
+   MPI_Comm_rank(comm, &mesh.MyRank);
+   mesh.gtopo.SetComm(comm);
+
+   const int n[3] = { nx, ny, nz };
+   int np[3];
+   if (nxyz_proc)
+   {
+      for (int d = 0; d < 3; d++) { np[d] = nxyz_proc[d]; }
+      MFEM_VERIFY(np[0]*np[1]*np[2] == mesh.NRanks, "the processor grid "
+                  << np[0] << " x " << np[1] << " x " << np[2]
+                  << " does not match the number of ranks " << mesh.NRanks);
+      MFEM_VERIFY(np[0] <= nx && np[1] <= ny && np[2] <= nz,
+                  "more processors than cells in a direction");
+   }
+   else
+   {
+      CartesianProcessorGrid(mesh.NRanks, n, np);
+   }
+
+   // The block of this rank: cells c0[d] <= c < c1[d] in direction d. The
+   // ranks are ordered as in Mesh::CartesianPartitioning().
+   const int q[3] = { mesh.MyRank % np[0], (mesh.MyRank/np[0]) % np[1],
+                      mesh.MyRank/(np[0]*np[1])
+                    };
+   int c0[3], c1[3], nv[3];
+   // Range of the blocks containing each local vertex, in each direction
+   Array<int> vb_min[3], vb_max[3];
+   for (int d = 0; d < 3; d++)
+   {
+      c0[d] = CartesianBlockStart(q[d], n[d], np[d]);
+      c1[d] = CartesianBlockStart(q[d]+1, n[d], np[d]);
+      nv[d] = c1[d] - c0[d] + 1;
+      vb_min[d].SetSize(nv[d]);
+      vb_max[d].SetSize(nv[d]);
+      for (int i = 0; i < nv[d]; i++)
+      {
+         const int c = c0[d] + i;
+         vb_min[d][i] = CartesianCellBlock(std::max(c-1, 0), n[d], np[d]);
+         vb_max[d][i] = CartesianCellBlock(std::min(c, n[d]-1), n[d], np[d]);
+      }
+   }
+   const int ex = nv[0]-1, ey = nv[1]-1, ez = nv[2]-1;
+
+   int NElem = ex*ey*ez;
+   int NBdrElem = 0;
+   if (c0[2] == 0) { NBdrElem += ex*ey; }
+   if (c1[2] == nz) { NBdrElem += ex*ey; }
+   if (c0[0] == 0) { NBdrElem += ey*ez; }
+   if (c1[0] == nx) { NBdrElem += ey*ez; }
+   if (c0[1] == 0) { NBdrElem += ex*ez; }
+   if (c1[1] == ny) { NBdrElem += ex*ez; }
+   if (type == Element::TETRAHEDRON)
+   {
+      NElem *= 6;
+      NBdrElem *= 2;
+   }
+   else if (type == Element::WEDGE)
+   {
+      NElem *= 2;
+   }
+   mesh.InitMesh(3, 3, nv[0]*nv[1]*nv[2], NElem, NBdrElem);
+
+   // Local vertex with the global grid coordinates (x,y,z). The local
+   // numbering is lexicographic, in the same order as the global numbering.
+#define VTX(XC, YC, ZC) \
+   (((XC)-c0[0]) + (((YC)-c0[1]) + ((ZC)-c0[2])*nv[1])*nv[0])
+
+   real_t coord[3];
+   for (int z = c0[2]; z <= c1[2]; z++)
+   {
+      coord[2] = ((real_t) z / nz) * sz;
+      for (int y = c0[1]; y <= c1[1]; y++)
+      {
+         coord[1] = ((real_t) y / ny) * sy;
+         for (int x = c0[0]; x <= c1[0]; x++)
+         {
+            coord[0] = ((real_t) x / nx) * sx;
+            mesh.AddVertex(coord);
+         }
+      }
+   }
+
+   // Same elements and boundary elements as in Mesh::Make3D()
+   int ind[8];
+   for (int z = c0[2]; z < c1[2]; z++)
+   {
+      for (int y = c0[1]; y < c1[1]; y++)
+      {
+         for (int x = c0[0]; x < c1[0]; x++)
+         {
+            // *INDENT-OFF*
+            ind[0] = VTX(x  , y  , z  );
+            ind[1] = VTX(x+1, y  , z  );
+            ind[2] = VTX(x+1, y+1, z  );
+            ind[3] = VTX(x  , y+1, z  );
+            ind[4] = VTX(x  , y  , z+1);
+            ind[5] = VTX(x+1, y  , z+1);
+            ind[6] = VTX(x+1, y+1, z+1);
+            ind[7] = VTX(x  , y+1, z+1);
+            // *INDENT-ON*
+            if (type == Element::TETRAHEDRON)
+            {
+               mesh.AddHexAsTets(ind, 1);
+            }
+            else if (type == Element::WEDGE)
+            {
+               mesh.AddHexAsWedges(ind, 1);
+            }
+            else
+            {
+               mesh.AddHex(ind, 1);
+            }
+         }
+      }
+   }
+
+   // The boundary quadrilaterals on the bottom and top are split into
+   // triangles for tetrahedra and wedges, on the other sides for tetrahedra
+   auto add_bdr_quad = [&](bool split, int attr)
+   {
+      if (split) { mesh.AddBdrQuadAsTriangles(ind, attr); }
+      else { mesh.AddBdrQuad(ind, attr); }
+   };
+   const bool split_z = (type != Element::HEXAHEDRON);
+   const bool split_xy = (type == Element::TETRAHEDRON);
+   // bottom, bdr. attribute 1
+   if (c0[2] == 0)
+   {
+      for (int y = c0[1]; y < c1[1]; y++)
+      {
+         for (int x = c0[0]; x < c1[0]; x++)
+         {
+            // *INDENT-OFF*
+            ind[0] = VTX(x  , y  , 0);
+            ind[1] = VTX(x  , y+1, 0);
+            ind[2] = VTX(x+1, y+1, 0);
+            ind[3] = VTX(x+1, y  , 0);
+            // *INDENT-ON*
+            add_bdr_quad(split_z, 1);
+         }
+      }
+   }
+   // top, bdr. attribute 6
+   if (c1[2] == nz)
+   {
+      for (int y = c0[1]; y < c1[1]; y++)
+      {
+         for (int x = c0[0]; x < c1[0]; x++)
+         {
+            // *INDENT-OFF*
+            ind[0] = VTX(x  , y  , nz);
+            ind[1] = VTX(x+1, y  , nz);
+            ind[2] = VTX(x+1, y+1, nz);
+            ind[3] = VTX(x  , y+1, nz);
+            // *INDENT-ON*
+            add_bdr_quad(split_z, 6);
+         }
+      }
+   }
+   // left, bdr. attribute 5
+   if (c0[0] == 0)
+   {
+      for (int z = c0[2]; z < c1[2]; z++)
+      {
+         for (int y = c0[1]; y < c1[1]; y++)
+         {
+            // *INDENT-OFF*
+            ind[0] = VTX(0  , y  , z  );
+            ind[1] = VTX(0  , y  , z+1);
+            ind[2] = VTX(0  , y+1, z+1);
+            ind[3] = VTX(0  , y+1, z  );
+            // *INDENT-ON*
+            add_bdr_quad(split_xy, 5);
+         }
+      }
+   }
+   // right, bdr. attribute 3
+   if (c1[0] == nx)
+   {
+      for (int z = c0[2]; z < c1[2]; z++)
+      {
+         for (int y = c0[1]; y < c1[1]; y++)
+         {
+            // *INDENT-OFF*
+            ind[0] = VTX(nx, y  , z  );
+            ind[1] = VTX(nx, y+1, z  );
+            ind[2] = VTX(nx, y+1, z+1);
+            ind[3] = VTX(nx, y  , z+1);
+            // *INDENT-ON*
+            add_bdr_quad(split_xy, 3);
+         }
+      }
+   }
+   // front, bdr. attribute 2
+   if (c0[1] == 0)
+   {
+      for (int x = c0[0]; x < c1[0]; x++)
+      {
+         for (int z = c0[2]; z < c1[2]; z++)
+         {
+            // *INDENT-OFF*
+            ind[0] = VTX(x  , 0, z  );
+            ind[1] = VTX(x+1, 0, z  );
+            ind[2] = VTX(x+1, 0, z+1);
+            ind[3] = VTX(x  , 0, z+1);
+            // *INDENT-ON*
+            add_bdr_quad(split_xy, 2);
+         }
+      }
+   }
+   // back, bdr. attribute 4
+   if (c1[1] == ny)
+   {
+      for (int x = c0[0]; x < c1[0]; x++)
+      {
+         for (int z = c0[2]; z < c1[2]; z++)
+         {
+            // *INDENT-OFF*
+            ind[0] = VTX(x  , ny, z  );
+            ind[1] = VTX(x  , ny, z+1);
+            ind[2] = VTX(x+1, ny, z+1);
+            ind[3] = VTX(x+1, ny, z  );
+            // *INDENT-ON*
+            add_bdr_quad(split_xy, 4);
+         }
+      }
+   }
+
+#undef VTX
+
+   mesh.FinalizeTopology(false);
+   mesh.ReduceMeshGen();
+
+   // The shared entities. A vertex belongs to the blocks in the tensor product
+   // of its block ranges in each direction; an edge or a face belongs to the
+   // blocks containing all of its vertices, i.e. to the intersection of the
+   // ranges of its vertices. The entities are shared if they belong to more
+   // than one block.
+   ListOfIntegerSets groups;
+   {
+      // the first group is the local one
+      IntegerSet group;
+      group.Recreate(1, &mesh.MyRank);
+      groups.Insert(group);
+   }
+   Array<int> ranks;
+   auto entity_group = [&](const int *v, int num_v)
+   {
+      int lo[3] = { 0, 0, 0 }, hi[3] = { np[0], np[1], np[2] };
+      for (int k = 0; k < num_v; k++)
+      {
+         int i[3];
+         i[0] = v[k] % nv[0];
+         i[1] = (v[k]/nv[0]) % nv[1];
+         i[2] = v[k]/(nv[0]*nv[1]);
+         for (int d = 0; d < 3; d++)
+         {
+            lo[d] = std::max(lo[d], vb_min[d][i[d]]);
+            hi[d] = std::min(hi[d], vb_max[d][i[d]]);
+         }
+      }
+      if (lo[0] == hi[0] && lo[1] == hi[1] && lo[2] == hi[2]) { return 0; }
+      ranks.SetSize(0);
+      for (int pz = lo[2]; pz <= hi[2]; pz++)
+      {
+         for (int py = lo[1]; py <= hi[1]; py++)
+         {
+            for (int px = lo[0]; px <= hi[0]; px++)
+            {
+               ranks.Append((pz*np[1] + py)*np[0] + px);
+            }
+         }
+      }
+      IntegerSet group(ranks.Size(), ranks.GetData());
+      return groups.Insert(group);
+   };
+
+   // The shared entities of each group are listed in the same order on all
+   // the ranks of the group: they are sorted by their (local) vertices, whose
+   // order is the same as the order of the global vertices. The vertices of
+   // the shared edges and faces are also listed in the same global order.
+   std::vector<std::array<int,2>> sverts;
+   for (int v = 0; v < mesh.GetNV(); v++)
+   {
+      const int g = entity_group(&v, 1);
+      if (g) { sverts.push_back({g, v}); }
+   }
+   std::vector<std::array<int,3>> sedges;
+   Array<int> ev;
+   for (int e = 0; e < mesh.GetNEdges(); e++)
+   {
+      mesh.GetEdgeVertices(e, ev);
+      const int g = entity_group(ev.GetData(), 2);
+      if (g)
+      {
+         sedges.push_back({g, std::min(ev[0], ev[1]), std::max(ev[0], ev[1])});
+      }
+   }
+   std::vector<std::array<int,5>> sfaces[2]; // triangles, quadrilaterals
+   Array<int> fv;
+   for (int f = 0; f < mesh.GetNumFaces(); f++)
+   {
+      mesh.GetFaceVertices(f, fv);
+      const int g = entity_group(fv.GetData(), fv.Size());
+      if (!g) { continue; }
+      // Start from the smallest vertex, towards its smallest neighbor
+      const int nfv = fv.Size();
+      const int m = int(std::min_element(fv.begin(), fv.end()) - fv.begin());
+      const int dir = (fv[(m+1)%nfv] < fv[(m+nfv-1)%nfv]) ? 1 : nfv-1;
+      std::array<int,5> sf = {g, -1, -1, -1, -1};
+      for (int k = 0; k < nfv; k++) { sf[1+k] = fv[(m + k*dir) % nfv]; }
+      sfaces[nfv == 3 ? 0 : 1].push_back(sf);
+   }
+   std::sort(sverts.begin(), sverts.end());
+   std::sort(sedges.begin(), sedges.end());
+   std::sort(sfaces[0].begin(), sfaces[0].end());
+   std::sort(sfaces[1].begin(), sfaces[1].end());
+
+   // build the group communication topology
+   mesh.gtopo.Create(groups, 822);
+   const int ngroups = groups.Size()-1;
+
+   MakeGroupTable(ngroups, sverts, mesh.group_svert);
+   mesh.svert_lvert.SetSize((int)sverts.size());
+   for (int i = 0; i < mesh.svert_lvert.Size(); i++)
+   {
+      mesh.svert_lvert[i] = sverts[i][1];
+   }
+
+   MakeGroupTable(ngroups, sedges, mesh.group_sedge);
+   mesh.shared_edges.SetSize((int)sedges.size());
+   for (int i = 0; i < mesh.shared_edges.Size(); i++)
+   {
+      mesh.shared_edges[i] = new Segment(sedges[i][1], sedges[i][2], 1);
+   }
+
+   MakeGroupTable(ngroups, sfaces[0], mesh.group_stria);
+   mesh.shared_trias.SetSize((int)sfaces[0].size());
+   for (int i = 0; i < mesh.shared_trias.Size(); i++)
+   {
+      for (int k = 0; k < 3; k++)
+      {
+         mesh.shared_trias[i].v[k] = sfaces[0][i][1+k];
+      }
+   }
+   MakeGroupTable(ngroups, sfaces[1], mesh.group_squad);
+   mesh.shared_quads.SetSize((int)sfaces[1].size());
+   for (int i = 0; i < mesh.shared_quads.Size(); i++)
+   {
+      for (int k = 0; k < 4; k++)
+      {
+         mesh.shared_quads[i].v[k] = sfaces[1][i][1+k];
+      }
+   }
+
+   // Marks the tetrahedra for refinement consistently across the ranks, and
+   // sets sedge_ledge and sface_lface
+   mesh.Finalize(true);
+
+   return mesh;
+}
+
 void ParMesh::Finalize(bool refine, bool fix_orientation)
 {
    const int meshgen_save = meshgen; // Mesh::Finalize() may call SetMeshGen()
@@ -4010,6 +4447,106 @@ bool ParMesh::NonconformingDerefinement(Array<real_t> &elem_error,
 }
 
 
+namespace
+{
+
+// Index along the Hilbert curve of the point with integer coordinates X[i],
+// 0 <= i < dim, each with 'bits' bits. The coordinates are overwritten. This
+// is the algorithm of J. Skilling, "Programming the Hilbert curve", AIP Conf.
+// Proc. 707 (2004) 381-387.
+std::uint64_t HilbertKey(std::uint32_t X[], int dim, int bits)
+{
+   if (dim == 1) { return X[0]; }
+
+   const std::uint32_t M = std::uint32_t(1) << (bits-1);
+   // inverse undo
+   for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+   {
+      const std::uint32_t P = Q - 1;
+      for (int i = 0; i < dim; i++)
+      {
+         if (X[i] & Q) { X[0] ^= P; }
+         else
+         {
+            const std::uint32_t t = (X[0] ^ X[i]) & P;
+            X[0] ^= t;
+            X[i] ^= t;
+         }
+      }
+   }
+   // Gray encode
+   for (int i = 1; i < dim; i++) { X[i] ^= X[i-1]; }
+   std::uint32_t t = 0;
+   for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+   {
+      if (X[dim-1] & Q) { t ^= Q - 1; }
+   }
+   for (int i = 0; i < dim; i++) { X[i] ^= t; }
+
+   // interleave the bits of the coordinates, most significant first
+   std::uint64_t key = 0;
+   for (int b = bits-1; b >= 0; b--)
+   {
+      for (int i = 0; i < dim; i++)
+      {
+         key = (key << 1) | ((X[i] >> b) & 1);
+      }
+   }
+   return key;
+}
+
+// An element in the parallel sort along the space-filling curve.
+struct SFCItem
+{
+   std::uint64_t key;
+   real_t weight;
+   int rank, index; // the owner of the element and its local index
+
+   bool operator<(const SFCItem &other) const
+   {
+      if (key != other.key) { return key < other.key; }
+      if (rank != other.rank) { return rank < other.rank; }
+      return index < other.index;
+   }
+};
+
+// Send the trivially copyable items send[p] to the rank p. On return, the
+// items received from the rank p are recv[offsets[p]], ...,
+// recv[offsets[p+1]-1].
+template <typename T>
+void ExchangeItems(MPI_Comm comm, const std::vector<std::vector<T>> &send,
+                   std::vector<T> &recv, std::vector<int> &offsets)
+{
+   const int nranks = (int)send.size();
+   std::vector<int> send_cnt(nranks), send_dsp(nranks+1, 0);
+   std::vector<int> recv_cnt(nranks), recv_dsp(nranks+1, 0);
+   for (int p = 0; p < nranks; p++)
+   {
+      send_cnt[p] = (int)(send[p].size()*sizeof(T));
+      send_dsp[p+1] = send_dsp[p] + send_cnt[p];
+   }
+   MPI_Alltoall(send_cnt.data(), 1, MPI_INT, recv_cnt.data(), 1, MPI_INT, comm);
+   for (int p = 0; p < nranks; p++)
+   {
+      recv_dsp[p+1] = recv_dsp[p] + recv_cnt[p];
+   }
+
+   std::vector<T> send_buf;
+   send_buf.reserve(send_dsp[nranks]/sizeof(T));
+   for (int p = 0; p < nranks; p++)
+   {
+      send_buf.insert(send_buf.end(), send[p].begin(), send[p].end());
+   }
+   recv.resize(recv_dsp[nranks]/sizeof(T));
+   MPI_Alltoallv(send_buf.data(), send_cnt.data(), send_dsp.data(), MPI_BYTE,
+                 recv.data(), recv_cnt.data(), recv_dsp.data(), MPI_BYTE, comm);
+
+   offsets.resize(nranks+1);
+   for (int p = 0; p <= nranks; p++) { offsets[p] = recv_dsp[p]/sizeof(T); }
+}
+
+} // anonymous namespace
+
 void ParMesh::Rebalance()
 {
    RebalanceImpl(NULL); // default SFC-based partition
@@ -4020,12 +4557,38 @@ void ParMesh::Rebalance(const Array<int> &partition)
    RebalanceImpl(&partition);
 }
 
-void ParMesh::RebalanceImpl(const Array<int> *partition)
+bool ParMesh::Rebalance(const Vector &weights, real_t max_imbalance)
+{
+   if (GetLoadImbalance(weights) <= max_imbalance) { return false; }
+   RebalanceImpl(NULL, &weights);
+   return true;
+}
+
+real_t ParMesh::GetLoadImbalance(const Vector &weights) const
+{
+   MFEM_VERIFY(weights.Size() == NumOfElements,
+               "the size of the weights must be the number of elements");
+
+   const MPI_Datatype mpi_real = MPITypeMap<real_t>::mpi_type;
+   real_t local_weight = weights.Sum(), max_weight, total_weight;
+   MPI_Allreduce(&local_weight, &max_weight, 1, mpi_real, MPI_MAX, MyComm);
+   MPI_Allreduce(&local_weight, &total_weight, 1, mpi_real, MPI_SUM, MyComm);
+   if (total_weight <= 0.0) { return 1.0; }
+   return max_weight * NRanks / total_weight;
+}
+
+void ParMesh::RebalanceImpl(const Array<int> *partition, const Vector *weights)
 {
    if (Conforming())
    {
-      MFEM_ABORT("Load balancing is currently not supported for conforming"
-                 " meshes.");
+      Array<int> sfc_partition;
+      if (!partition)
+      {
+         ParSpaceFillingCurvePartitioning(sfc_partition, weights);
+         partition = &sfc_partition;
+      }
+      RebalanceConforming(*partition);
+      return;
    }
 
    if (Nodes)
@@ -4037,7 +4600,7 @@ void ParMesh::RebalanceImpl(const Array<int> *partition)
 
    DeleteFaceNbrData();
 
-   pncmesh->Rebalance(partition);
+   pncmesh->Rebalance(partition, weights);
 
    ParMesh* pmesh2 = new ParMesh(*pncmesh);
    pncmesh->OnMeshUpdated(pmesh2);
@@ -4062,6 +4625,542 @@ void ParMesh::RebalanceImpl(const Array<int> *partition)
    UpdateNodes();
 }
 
+void ParMesh::ParSpaceFillingCurvePartitioning(Array<int> &partition,
+                                               const Vector *weights)
+{
+   MFEM_VERIFY(spaceDim <= 3, "invalid space dimension: " << spaceDim);
+   MFEM_VERIFY(!weights || weights->Size() == NumOfElements,
+               "the size of the weights must be the number of elements");
+
+   // the element centers and their global bounding box
+   const MPI_Datatype mpi_real = MPITypeMap<real_t>::mpi_type;
+   DenseMatrix centers(spaceDim, NumOfElements);
+   real_t box[6]; // the minimum and minus the maximum of the coordinates
+   for (int d = 0; d < 2*spaceDim; d++) { box[d] = infinity(); }
+   Vector center;
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      GetElementCenter(i, center);
+      for (int d = 0; d < spaceDim; d++)
+      {
+         centers(d, i) = center(d);
+         box[d] = std::min(box[d], center(d));
+         box[spaceDim+d] = std::min(box[spaceDim+d], -center(d));
+      }
+   }
+   MPI_Allreduce(MPI_IN_PLACE, box, 2*spaceDim, mpi_real, MPI_MIN, MyComm);
+
+   // the keys of the elements along the Hilbert curve, with 21 bits per
+   // coordinate in 3D and 32 bits in 1D and 2D
+   const int bits = (spaceDim == 3) ? 21 : 32;
+   const real_t scale = (real_t)((std::uint64_t(1) << bits) - 1);
+   std::vector<SFCItem> items(NumOfElements);
+   real_t local_weight = 0.0;
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      std::uint32_t X[3];
+      for (int d = 0; d < spaceDim; d++)
+      {
+         const real_t len = -box[spaceDim+d] - box[d];
+         const real_t x = (len > 0.0) ? (centers(d, i) - box[d])/len : 0.0;
+         X[d] = (std::uint32_t)(std::min(std::max(x, (real_t)0.0),
+                                         (real_t)1.0)*scale);
+      }
+      const real_t w = weights ? (*weights)(i) : 1.0;
+      MFEM_VERIFY(w >= 0.0, "negative element weight: " << w);
+      items[i] = {HilbertKey(X, spaceDim, bits), w, MyRank, i};
+      local_weight += w;
+   }
+   real_t total_weight;
+   MPI_Allreduce(&local_weight, &total_weight, 1, mpi_real, MPI_SUM, MyComm);
+   MFEM_VERIFY(total_weight > 0.0, "the sum of the element weights is zero");
+
+   // parallel sample sort: the splitters between the ranks are chosen among
+   // regular samples of the sorted local keys
+   std::sort(items.begin(), items.end());
+   const int max_samples = std::min(NRanks, 32);
+   std::vector<std::uint64_t> samples;
+   for (int i = 0; NumOfElements > 0 && i < max_samples; i++)
+   {
+      samples.push_back(items[(long long)i*NumOfElements/max_samples].key);
+   }
+   const int num_samples = (int)samples.size();
+   std::vector<int> samples_cnt(NRanks), samples_dsp(NRanks+1, 0);
+   MPI_Allgather(&num_samples, 1, MPI_INT, samples_cnt.data(), 1, MPI_INT,
+                 MyComm);
+   for (int p = 0; p < NRanks; p++)
+   {
+      samples_dsp[p+1] = samples_dsp[p] + samples_cnt[p];
+   }
+   std::vector<std::uint64_t> all_samples(samples_dsp[NRanks]);
+   MPI_Allgatherv(samples.data(), num_samples, MPI_UINT64_T,
+                  all_samples.data(), samples_cnt.data(), samples_dsp.data(),
+                  MPI_UINT64_T, MyComm);
+   std::sort(all_samples.begin(), all_samples.end());
+   std::vector<std::uint64_t> splitters;
+   for (int p = 1; p < NRanks && !all_samples.empty(); p++)
+   {
+      splitters.push_back(all_samples[(long long)p*all_samples.size()/NRanks]);
+   }
+
+   std::vector<std::vector<SFCItem>> send_items(NRanks);
+   for (const SFCItem &item : items)
+   {
+      const int p = int(std::upper_bound(splitters.begin(), splitters.end(),
+                                         item.key) - splitters.begin());
+      send_items[p].push_back(item);
+   }
+   std::vector<int> offsets;
+   ExchangeItems(MyComm, send_items, items, offsets);
+   std::sort(items.begin(), items.end());
+
+   // split the global sequence into pieces of (almost) equal weight,
+   // assigning each element to the piece containing the middle of its weight
+   real_t prefix = 0.0;
+   local_weight = 0.0;
+   for (const SFCItem &item : items) { local_weight += item.weight; }
+   MPI_Exscan(&local_weight, &prefix, 1, mpi_real, MPI_SUM, MyComm);
+   if (MyRank == 0) { prefix = 0.0; }
+
+   std::vector<std::vector<std::array<int,2>>> send_parts(NRanks);
+   for (const SFCItem &item : items)
+   {
+      int part = (int)std::floor((prefix + 0.5*item.weight)*NRanks/
+                                 total_weight);
+      part = std::min(std::max(part, 0), NRanks-1);
+      send_parts[item.rank].push_back({item.index, part});
+      prefix += item.weight;
+   }
+   std::vector<std::array<int,2>> parts;
+   ExchangeItems(MyComm, send_parts, parts, offsets);
+
+   partition.SetSize(NumOfElements);
+   for (const auto &part : parts) { partition[part[0]] = part[1]; }
+}
+
+void ParMesh::RebalanceConforming(const Array<int> &partition)
+{
+   MFEM_VERIFY(partition.Size() == NumOfElements,
+               "Size of the partition array must match the number of local "
+               "mesh elements (ParMesh::GetNE()).");
+   MFEM_VERIFY(NURBSext == NULL, "NURBS meshes are not supported.");
+
+   const FiniteElementSpace *nodes_fes = Nodes ? Nodes->FESpace() : NULL;
+   if (Nodes)
+   {
+      // check that Nodes use a parallel FE space, so we can update them below
+      MFEM_VERIFY(dynamic_cast<const ParFiniteElementSpace*>(nodes_fes)
+                  != NULL, "internal error");
+   }
+
+   DeleteFaceNbrData();
+
+   // The elements are sent to their new ranks with their attributes, their
+   // vertices (global numbers) and their refinement flags (tetrahedra), the
+   // boundary elements follow their adjacent element, and the vertices are
+   // sent with their coordinates. The message to each rank is
+   //   ints:  ne, nbe, nv, nv x vertex,
+   //          ne x (geom, attr, flag, number of nodal values, vertices),
+   //          nbe x (geom, attr, vertices)
+   //   reals: nv x coordinates, ne x nodal values (for curved meshes)
+   Array<HYPRE_BigInt> vert_gid;
+   GetGlobalVertexIndices(vert_gid);
+
+   Table dest_elem, dest_bdr_elem;
+   dest_elem.MakeI(NRanks);
+   dest_bdr_elem.MakeI(NRanks);
+   Array<int> bdr_partition(NumOfBdrElements);
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      MFEM_VERIFY(partition[i] >= 0 && partition[i] < NRanks,
+                  "invalid rank " << partition[i] << " for element " << i);
+      dest_elem.AddAColumnInRow(partition[i]);
+   }
+   for (int i = 0; i < NumOfBdrElements; i++)
+   {
+      int el, info;
+      GetBdrElementAdjacentElement(i, el, info);
+      bdr_partition[i] = partition[el];
+      dest_bdr_elem.AddAColumnInRow(bdr_partition[i]);
+   }
+   dest_elem.MakeJ();
+   dest_bdr_elem.MakeJ();
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      dest_elem.AddConnection(partition[i], i);
+   }
+   for (int i = 0; i < NumOfBdrElements; i++)
+   {
+      dest_bdr_elem.AddConnection(bdr_partition[i], i);
+   }
+   dest_elem.ShiftUpI();
+   dest_bdr_elem.ShiftUpI();
+
+   std::vector<std::vector<long long>> send_ints(NRanks);
+   std::vector<std::vector<real_t>> send_reals(NRanks);
+   Array<int> vert_dest(NumOfVertices), verts, vdofs;
+   vert_dest = -1;
+   Vector nodes_el;
+   for (int p = 0; p < NRanks; p++)
+   {
+      std::vector<long long> &ints = send_ints[p];
+      std::vector<real_t> &reals = send_reals[p];
+      const int ne = dest_elem.RowSize(p), nbe = dest_bdr_elem.RowSize(p);
+      if (ne == 0) { continue; }
+      const int *elems = dest_elem.GetRow(p);
+      const int *bdr_elems = dest_bdr_elem.GetRow(p);
+
+      ints.push_back(ne);
+      ints.push_back(nbe);
+      ints.push_back(0); // number of vertices, set below
+      for (int k = 0; k < ne; k++)
+      {
+         elements[elems[k]]->GetVertices(verts);
+         for (int v : verts)
+         {
+            if (vert_dest[v] == p) { continue; }
+            vert_dest[v] = p;
+            ints.push_back(vert_gid[v]);
+            reals.insert(reals.end(), vertices[v](), vertices[v]() + spaceDim);
+            ints[2]++;
+         }
+      }
+      for (int k = 0; k < ne; k++)
+      {
+         const Element *el = elements[elems[k]];
+         const Element::Type type = el->GetType();
+         ints.push_back(el->GetGeometryType());
+         ints.push_back(el->GetAttribute());
+         ints.push_back(type == Element::TETRAHEDRON ?
+                        static_cast<const Tetrahedron*>(el)
+                        ->GetRefinementFlag() : 0);
+         nodes_el.SetSize(0);
+         if (Nodes)
+         {
+            nodes_fes->GetElementVDofs(elems[k], vdofs);
+            Nodes->GetSubVector(vdofs, nodes_el);
+            reals.insert(reals.end(), nodes_el.begin(), nodes_el.end());
+         }
+         ints.push_back(nodes_el.Size());
+         el->GetVertices(verts);
+         for (int v : verts) { ints.push_back(vert_gid[v]); }
+      }
+      for (int k = 0; k < nbe; k++)
+      {
+         const Element *bel = boundary[bdr_elems[k]];
+         ints.push_back(bel->GetGeometryType());
+         ints.push_back(bel->GetAttribute());
+         bel->GetVertices(verts);
+         for (int v : verts) { ints.push_back(vert_gid[v]); }
+      }
+   }
+
+   std::vector<long long> recv_ints;
+   std::vector<real_t> recv_reals;
+   std::vector<int> int_offsets, real_offsets;
+   ExchangeItems(MyComm, send_ints, recv_ints, int_offsets);
+   ExchangeItems(MyComm, send_reals, recv_reals, real_offsets);
+   send_ints.clear();
+   send_reals.clear();
+
+   // Build the new local mesh, with the elements and the boundary elements in
+   // the order of their previous ranks and local numbers.
+   ParMesh pmesh2;
+   Array<int> nodes_offset;
+   pmesh2.BuildConforming(MyComm, Dim, spaceDim, meshgen, recv_ints,
+                          int_offsets, recv_reals, real_offsets, nodes_offset);
+   attributes.Copy(pmesh2.attributes);
+   bdr_attributes.Copy(pmesh2.bdr_attributes);
+
+   // replace the local mesh, keeping the Nodes
+   Mesh::Swap(pmesh2, false);
+   gtopo.Swap(pmesh2.gtopo);
+   group_svert.Swap(pmesh2.group_svert);
+   group_sedge.Swap(pmesh2.group_sedge);
+   group_stria.Swap(pmesh2.group_stria);
+   group_squad.Swap(pmesh2.group_squad);
+   mfem::Swap(shared_edges, pmesh2.shared_edges);
+   mfem::Swap(shared_trias, pmesh2.shared_trias);
+   mfem::Swap(shared_quads, pmesh2.shared_quads);
+   mfem::Swap(svert_lvert, pmesh2.svert_lvert);
+   mfem::Swap(sedge_ledge, pmesh2.sedge_ledge);
+   mfem::Swap(sface_lface, pmesh2.sface_lface);
+
+   rebalance_partition = partition;
+   last_operation = Mesh::REBALANCE;
+   sequence++;
+
+   if (Nodes)
+   {
+      // the nodal values were sent with the elements: the space is updated
+      // without the transfer operator, and the values are set element by
+      // element
+      Nodes->FESpace()->Update(false);
+      Nodes->Update();
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         Nodes->FESpace()->GetElementVDofs(i, vdofs);
+         Nodes->SetSubVector(vdofs, &recv_reals[nodes_offset[i]]);
+      }
+   }
+}
+
+void ParMesh::BuildConforming(MPI_Comm comm, int dim, int space_dim,
+                              int mesh_gen,
+                              const std::vector<long long> &block_ints,
+                              const std::vector<int> &int_offsets,
+                              const std::vector<real_t> &block_reals,
+                              const std::vector<int> &real_offsets,
+                              Array<int> &nodes_offset)
+{
+   MyComm = comm;
+   MPI_Comm_size(MyComm, &NRanks);
+   MPI_Comm_rank(MyComm, &MyRank);
+   gtopo.SetComm(MyComm);
+   const int nblocks = (int)int_offsets.size() - 1;
+
+   // the vertices of several blocks are merged
+   int ne = 0, nbe = 0;
+   std::unordered_map<long long, int> gid_to_local;
+   std::vector<long long> new_vert_gid;
+   std::vector<const real_t*> new_vert_coord;
+   for (int p = 0; p < nblocks; p++)
+   {
+      if (int_offsets[p] == int_offsets[p+1]) { continue; }
+      const long long *ints = &block_ints[int_offsets[p]];
+      const real_t *reals = &block_reals[real_offsets[p]];
+      ne += (int)ints[0];
+      nbe += (int)ints[1];
+      for (int k = 0; k < ints[2]; k++)
+      {
+         const long long gid = ints[3+k];
+         if (gid_to_local.emplace(gid, (int)new_vert_gid.size()).second)
+         {
+            new_vert_gid.push_back(gid);
+            new_vert_coord.push_back(reals + k*space_dim);
+         }
+      }
+   }
+   InitMesh(dim, space_dim, (int)new_vert_gid.size(), ne, nbe);
+   for (const real_t *coord : new_vert_coord) { AddVertex(coord); }
+   // the offset in block_reals of the nodal values of each new element
+   nodes_offset.SetSize(0);
+   nodes_offset.Reserve(ne);
+   for (int p = 0; p < nblocks; p++)
+   {
+      if (int_offsets[p] == int_offsets[p+1]) { continue; }
+      const long long *ints = &block_ints[int_offsets[p]];
+      int offset = real_offsets[p] + (int)ints[2]*spaceDim;
+      const int rne = (int)ints[0], rnbe = (int)ints[1];
+      ints += 3 + ints[2];
+      for (int k = 0; k < rne; k++)
+      {
+         const Geometry::Type geom = (Geometry::Type)ints[0];
+         Element *el = NewElement(geom);
+         el->SetAttribute((int)ints[1]);
+         if (el->GetType() == Element::TETRAHEDRON)
+         {
+            static_cast<Tetrahedron*>(el)->SetRefinementFlag((int)ints[2]);
+         }
+         nodes_offset.Append(offset);
+         offset += (int)ints[3];
+         int *v = el->GetVertices();
+         for (int j = 0; j < Geometry::NumVerts[geom]; j++)
+         {
+            v[j] = gid_to_local[ints[4+j]];
+         }
+         ints += 4 + Geometry::NumVerts[geom];
+         AddElement(el);
+      }
+      for (int k = 0; k < rnbe; k++)
+      {
+         const Geometry::Type geom = (Geometry::Type)ints[0];
+         Element *bel = NewElement(geom);
+         bel->SetAttribute((int)ints[1]);
+         int *v = bel->GetVertices();
+         for (int j = 0; j < Geometry::NumVerts[geom]; j++)
+         {
+            v[j] = gid_to_local[ints[2+j]];
+         }
+         ints += 2 + Geometry::NumVerts[geom];
+         AddBdrElement(bel);
+      }
+   }
+
+   FinalizeTopology(false);
+   meshgen = mesh_gen; // the global 'meshgen'
+
+   // The shared vertices, edges and faces are on the faces of the local
+   // elements without a local neighbor. Each of these candidates is reported
+   // with its (sorted) global vertices to a "home" rank, which returns the
+   // list of the ranks having the entity to these ranks.
+   typedef std::array<long long,4> EntityKey; // the unused entries are -1
+   std::map<EntityKey, int> candidates; // key -> local vertex, edge or face
+   auto entity_key = [&](const Array<int> &ev)
+   {
+      EntityKey key = {-1, -1, -1, -1};
+      for (int j = 0; j < ev.Size(); j++) { key[j] = new_vert_gid[ev[j]]; }
+      std::sort(key.begin(), key.begin() + ev.Size());
+      return key;
+   };
+   Array<int> fv, fe, fo, ev;
+   for (int f = 0; f < GetNumFaces(); f++)
+   {
+      if (faces_info[f].Elem2No >= 0) { continue; }
+      GetFaceVertices(f, fv);
+      for (int v : fv)
+      {
+         const EntityKey key = {new_vert_gid[v], -1, -1, -1};
+         candidates[key] = v;
+      }
+      if (Dim > 1) { candidates[entity_key(fv)] = f; } // in 2D, f is an edge
+      if (Dim == 3)
+      {
+         GetFaceEdges(f, fe, fo);
+         for (int e : fe)
+         {
+            GetEdgeVertices(e, ev);
+            candidates[entity_key(ev)] = e;
+         }
+      }
+   }
+
+   std::vector<std::vector<EntityKey>> send_keys(NRanks);
+   for (const auto &cand : candidates)
+   {
+      send_keys[cand.first[0] % NRanks].push_back(cand.first);
+   }
+   std::vector<EntityKey> recv_keys;
+   std::vector<int> offsets;
+   ExchangeItems(MyComm, send_keys, recv_keys, offsets);
+   send_keys.clear();
+
+   std::map<EntityKey, std::vector<int>> entity_ranks;
+   for (int p = 0; p < NRanks; p++)
+   {
+      for (int k = offsets[p]; k < offsets[p+1]; k++)
+      {
+         entity_ranks[recv_keys[k]].push_back(p);
+      }
+   }
+   std::vector<std::vector<long long>> send_shared(NRanks);
+   for (const auto &ent : entity_ranks)
+   {
+      const std::vector<int> &ranks = ent.second;
+      if (ranks.size() < 2) { continue; }
+      for (int p : ranks)
+      {
+         std::vector<long long> &msg = send_shared[p];
+         msg.insert(msg.end(), ent.first.begin(), ent.first.end());
+         msg.push_back((long long)ranks.size());
+         msg.insert(msg.end(), ranks.begin(), ranks.end());
+      }
+   }
+   entity_ranks.clear();
+   std::vector<long long> recv_shared;
+   ExchangeItems(MyComm, send_shared, recv_shared, offsets);
+   send_shared.clear();
+
+   // The shared entities as (group, key, local index, lowest rank), sorted by
+   // group and key, which gives the same order on all the ranks of a group.
+   ListOfIntegerSets groups;
+   {
+      // the first group is the local one
+      IntegerSet group;
+      group.Recreate(1, &MyRank);
+      groups.Insert(group);
+   }
+   typedef std::array<long long,7> SharedEntity;
+   std::vector<SharedEntity> sverts, sedges, sfaces[2];
+   Array<int> ranks;
+   for (std::size_t k = 0; k < recv_shared.size(); )
+   {
+      const long long *msg = &recv_shared[k];
+      k += 5 + msg[4];
+      ranks.SetSize((int)msg[4]);
+      for (int j = 0; j < ranks.Size(); j++) { ranks[j] = (int)msg[5+j]; }
+      IntegerSet group(ranks.Size(), ranks.GetData());
+      const EntityKey key = {msg[0], msg[1], msg[2], msg[3]};
+      const SharedEntity ent = {groups.Insert(group), key[0], key[1], key[2],
+                                key[3], candidates.at(key), ranks.Min()
+                               };
+      const int nkey = int(std::count_if(key.begin(), key.end(),
+                                         [](long long g) { return g >= 0; }));
+      if (nkey == 1) { sverts.push_back(ent); }
+      else if (nkey == 2) { sedges.push_back(ent); }
+      else { sfaces[nkey-3].push_back(ent); }
+   }
+   recv_shared.clear();
+   std::sort(sverts.begin(), sverts.end());
+   std::sort(sedges.begin(), sedges.end());
+   std::sort(sfaces[0].begin(), sfaces[0].end());
+   std::sort(sfaces[1].begin(), sfaces[1].end());
+
+   // build the group communication topology
+   gtopo.Create(groups, 822);
+   const int ngroups = groups.Size()-1;
+
+   MakeGroupTable(ngroups, sverts, group_svert);
+   svert_lvert.SetSize((int)sverts.size());
+   for (int i = 0; i < svert_lvert.Size(); i++)
+   {
+      svert_lvert[i] = (int)sverts[i][5];
+   }
+
+   // the vertices of the shared edges are in increasing global order
+   MakeGroupTable(ngroups, sedges, group_sedge);
+   shared_edges.SetSize((int)sedges.size());
+   for (int i = 0; i < shared_edges.Size(); i++)
+   {
+      shared_edges[i] = new Segment(gid_to_local[sedges[i][1]],
+                                    gid_to_local[sedges[i][2]], 1);
+   }
+
+   // The vertices of the shared faces start from the smallest global vertex,
+   // towards its smallest neighbor. For marked tetrahedra, the shared
+   // triangles are oriented according to the refinement flag of the local
+   // tetrahedron, as in BuildSharedFaceElems(), and flipped on the rank which
+   // is not the lowest one of the face.
+   auto shared_face_vertices = [&](const SharedEntity &ent, int *v)
+   {
+      const int lface = (int)ent[5];
+      const Mesh::FaceInfo &face_info = faces_info[lface];
+      const Element *el = elements[face_info.Elem1No];
+      if (meshgen == 1 && el->GetType() == Element::TETRAHEDRON &&
+          static_cast<const Tetrahedron*>(el)->GetRefinementFlag())
+      {
+         static_cast<const Tetrahedron*>(el)->GetMarkedFace(
+            face_info.Elem1Inf/64, v);
+         if (MyRank != ent[6]) { std::swap(v[0], v[1]); }
+         return;
+      }
+      GetFaceVertices(lface, fv);
+      const int nfv = fv.Size();
+      int m = 0;
+      for (int j = 1; j < nfv; j++)
+      {
+         if (new_vert_gid[fv[j]] < new_vert_gid[fv[m]]) { m = j; }
+      }
+      const int dir = (new_vert_gid[fv[(m+1)%nfv]] <
+                       new_vert_gid[fv[(m+nfv-1)%nfv]]) ? 1 : nfv-1;
+      for (int j = 0; j < nfv; j++) { v[j] = fv[(m + j*dir) % nfv]; }
+   };
+   MakeGroupTable(ngroups, sfaces[0], group_stria);
+   shared_trias.SetSize((int)sfaces[0].size());
+   for (int i = 0; i < shared_trias.Size(); i++)
+   {
+      shared_face_vertices(sfaces[0][i], shared_trias[i].v);
+   }
+   MakeGroupTable(ngroups, sfaces[1], group_squad);
+   shared_quads.SetSize((int)sfaces[1].size());
+   for (int i = 0; i < shared_quads.Size(); i++)
+   {
+      shared_face_vertices(sfaces[1][i], shared_quads[i].v);
+   }
+
+   FinalizeParTopo();
+}
+
 void ParMesh::RefineGroups(const DSTable &v_to_v, int *middle)
 {
    // Refine groups after LocalRefinement in 2D (triangle meshes)
@@ -5621,6 +6720,384 @@ void ParMesh::SaveAsOne(const std::string &fname, int precision) const
    PrintAsOne(ofs);
 }
 
+// Files written by ParMesh::SaveParallelFile start with the line below,
+// followed by the 64-bit unsigned integers
+//   {format, number of parts, Dim, spaceDim, meshgen, sizeof(real_t),
+//    vdim of the Nodes (0: no Nodes), ordering of the Nodes,
+//    length of the name of the Nodes collection},
+// the name of the Nodes collection and one entry for each part. With the
+// binary format (conforming meshes) the entry is
+//   {number of elements, offset, number of ints, number of reals}
+// and the part consists of the index {int offset, real offset} of every
+// element, the ints (int64) and the reals (real_t) of the elements. Every
+// element is stored with its boundary elements and its vertices, as
+//   ints:  geom, attr, refinement flag, nbe, number of nodal values,
+//          vertices (global numbers), nbe x (geom, attr, vertices)
+//   reals: vertex coordinates, nodal values (curved meshes)
+// so that any range of elements can be read on its own. With the ParPrint
+// format (nonconforming meshes) the entry is {0, offset, size, 0} and the part
+// is the output of ParPrint(). Offsets are from the start of the file.
+static const char parallel_file_magic[] = "MFEM binary parallel mesh v2.0\n";
+static const MPI_Offset parallel_file_magic_size =
+   sizeof(parallel_file_magic) - 1;
+static constexpr int parallel_file_header_size = 9;
+enum { PARALLEL_FILE_BINARY = 0, PARALLEL_FILE_PARPRINT = 1 };
+
+// MPI-IO counts are int: transfer large buffers in chunks.
+static constexpr uint64_t max_mpi_io_chunk = uint64_t(1) << 30;
+
+static void ParallelFileWrite(MPI_File fh, uint64_t offset, const void *data,
+                              uint64_t size)
+{
+   const char *bytes = static_cast<const char*>(data);
+   for (uint64_t done = 0; done < size; done += max_mpi_io_chunk)
+   {
+      const int count = int(std::min(size - done, max_mpi_io_chunk));
+      MPI_File_write_at(fh, MPI_Offset(offset + done), bytes + done, count,
+                        MPI_BYTE, MPI_STATUS_IGNORE);
+   }
+}
+
+static void ParallelFileRead(MPI_File fh, uint64_t offset, void *data,
+                             uint64_t size)
+{
+   char *bytes = static_cast<char*>(data);
+   for (uint64_t done = 0; done < size; done += max_mpi_io_chunk)
+   {
+      const int count = int(std::min(size - done, max_mpi_io_chunk));
+      MPI_Status status;
+      MPI_File_read_at(fh, MPI_Offset(offset + done), bytes + done, count,
+                       MPI_BYTE, &status);
+      int read;
+      MPI_Get_count(&status, MPI_BYTE, &read);
+      MFEM_VERIFY(read == count, "unexpected end of parallel mesh file");
+   }
+}
+
+void ParMesh::SaveParallelFile(const std::string &fname, int precision) const
+{
+   MFEM_VERIFY(NURBSext == NULL, "NURBS meshes are not supported.");
+
+   const int format =
+      pncmesh ? PARALLEL_FILE_PARPRINT : PARALLEL_FILE_BINARY;
+   std::vector<uint64_t> index;
+   std::vector<int64_t> ints;
+   std::vector<real_t> reals;
+   std::string part;
+   if (format == PARALLEL_FILE_BINARY)
+   {
+      Array<HYPRE_BigInt> vert_gid;
+      GetGlobalVertexIndices(vert_gid);
+
+      // the boundary elements are stored with their adjacent element
+      Table elem_bdr;
+      elem_bdr.MakeI(NumOfElements);
+      Array<int> bdr_elem(NumOfBdrElements);
+      for (int i = 0; i < NumOfBdrElements; i++)
+      {
+         int info;
+         GetBdrElementAdjacentElement(i, bdr_elem[i], info);
+         elem_bdr.AddAColumnInRow(bdr_elem[i]);
+      }
+      elem_bdr.MakeJ();
+      for (int i = 0; i < NumOfBdrElements; i++)
+      {
+         elem_bdr.AddConnection(bdr_elem[i], i);
+      }
+      elem_bdr.ShiftUpI();
+
+      const FiniteElementSpace *nodes_fes = Nodes ? Nodes->FESpace() : NULL;
+      Array<int> verts, vdofs;
+      Vector nodes_el;
+      index.reserve(2*NumOfElements);
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         index.push_back(ints.size());
+         index.push_back(reals.size());
+         const Element *el = elements[i];
+         nodes_el.SetSize(0);
+         if (Nodes)
+         {
+            nodes_fes->GetElementVDofs(i, vdofs);
+            Nodes->GetSubVector(vdofs, nodes_el);
+         }
+         ints.push_back(el->GetGeometryType());
+         ints.push_back(el->GetAttribute());
+         ints.push_back(el->GetType() == Element::TETRAHEDRON ?
+                        static_cast<const Tetrahedron*>(el)
+                        ->GetRefinementFlag() : 0);
+         ints.push_back(elem_bdr.RowSize(i));
+         ints.push_back(nodes_el.Size());
+         el->GetVertices(verts);
+         for (int v : verts)
+         {
+            ints.push_back(vert_gid[v]);
+            reals.insert(reals.end(), vertices[v](), vertices[v]() + spaceDim);
+         }
+         for (int k = 0; k < elem_bdr.RowSize(i); k++)
+         {
+            const Element *bel = boundary[elem_bdr.GetRow(i)[k]];
+            ints.push_back(bel->GetGeometryType());
+            ints.push_back(bel->GetAttribute());
+            bel->GetVertices(verts);
+            for (int v : verts) { ints.push_back(vert_gid[v]); }
+         }
+         reals.insert(reals.end(), nodes_el.begin(), nodes_el.end());
+      }
+   }
+   else
+   {
+      std::ostringstream os;
+      os.precision(precision);
+      ParPrint(os);
+      part = os.str();
+   }
+
+   // Offsets of the parts, in rank order after the header and the table
+   std::string fec_name;
+   uint64_t header[parallel_file_header_size] =
+   {
+      uint64_t(format), uint64_t(NRanks), uint64_t(Dim), uint64_t(spaceDim),
+      uint64_t(meshgen), sizeof(real_t), 0, 0, 0
+   };
+   if (Nodes && format == PARALLEL_FILE_BINARY)
+   {
+      fec_name = Nodes->FESpace()->FEColl()->Name();
+      header[6] = Nodes->FESpace()->GetVDim();
+      header[7] = Nodes->FESpace()->GetOrdering();
+      header[8] = fec_name.size();
+   }
+   const uint64_t table_offset =
+      parallel_file_magic_size + sizeof(header) + fec_name.size();
+   const uint64_t part_size = (format == PARALLEL_FILE_BINARY) ?
+                              index.size()*sizeof(uint64_t) +
+                              ints.size()*sizeof(int64_t) +
+                              reals.size()*sizeof(real_t) : part.size();
+   uint64_t part_offset = 0;
+   MPI_Exscan(&part_size, &part_offset, 1, MPI_UINT64_T, MPI_SUM, MyComm);
+   if (MyRank == 0) { part_offset = 0; }
+   part_offset += table_offset + 4*NRanks*sizeof(uint64_t);
+
+   const uint64_t entry[4] =
+   {
+      (format == PARALLEL_FILE_BINARY) ? uint64_t(NumOfElements) : 0,
+      part_offset,
+      (format == PARALLEL_FILE_BINARY) ? ints.size() : part.size(),
+      reals.size()
+   };
+   std::vector<uint64_t> table(MyRank == 0 ? 4*NRanks : 0);
+   MPI_Gather(entry, 4, MPI_UINT64_T, table.data(), 4, MPI_UINT64_T, 0,
+              MyComm);
+
+   MPI_File fh;
+   const int err = MPI_File_open(MyComm, fname.c_str(),
+                                 MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                                 MPI_INFO_NULL, &fh);
+   MFEM_VERIFY(err == MPI_SUCCESS, "unable to open file " << fname);
+   MPI_File_set_size(fh, 0);
+   if (MyRank == 0)
+   {
+      ParallelFileWrite(fh, 0, parallel_file_magic, parallel_file_magic_size);
+      ParallelFileWrite(fh, parallel_file_magic_size, header, sizeof(header));
+      ParallelFileWrite(fh, parallel_file_magic_size + sizeof(header),
+                        fec_name.data(), fec_name.size());
+      ParallelFileWrite(fh, table_offset, table.data(),
+                        table.size()*sizeof(uint64_t));
+   }
+   if (format == PARALLEL_FILE_BINARY)
+   {
+      uint64_t offset = part_offset;
+      ParallelFileWrite(fh, offset, index.data(),
+                        index.size()*sizeof(uint64_t));
+      offset += index.size()*sizeof(uint64_t);
+      ParallelFileWrite(fh, offset, ints.data(), ints.size()*sizeof(int64_t));
+      offset += ints.size()*sizeof(int64_t);
+      ParallelFileWrite(fh, offset, reals.data(), reals.size()*sizeof(real_t));
+   }
+   else
+   {
+      ParallelFileWrite(fh, part_offset, part.data(), part.size());
+   }
+   MPI_File_close(&fh);
+}
+
+ParMesh ParMesh::LoadParallelFile(MPI_Comm comm, const std::string &fname)
+{
+   int rank, nranks;
+   MPI_Comm_rank(comm, &rank);
+   MPI_Comm_size(comm, &nranks);
+
+   MPI_File fh;
+   const int err = MPI_File_open(comm, fname.c_str(), MPI_MODE_RDONLY,
+                                 MPI_INFO_NULL, &fh);
+   MFEM_VERIFY(err == MPI_SUCCESS, "unable to open file " << fname);
+
+   std::string magic(parallel_file_magic_size, '\0');
+   uint64_t header[parallel_file_header_size];
+   ParallelFileRead(fh, 0, &magic[0], magic.size());
+   MFEM_VERIFY(magic == parallel_file_magic,
+               fname << " is not a binary parallel mesh file");
+   ParallelFileRead(fh, parallel_file_magic_size, header, sizeof(header));
+   const uint64_t format = header[0], nparts = header[1];
+   std::string fec_name(header[8], '\0');
+   ParallelFileRead(fh, parallel_file_magic_size + sizeof(header),
+                    &fec_name[0], fec_name.size());
+   const uint64_t table_offset =
+      parallel_file_magic_size + sizeof(header) + fec_name.size();
+
+   if (format == PARALLEL_FILE_PARPRINT)
+   {
+      MFEM_VERIFY(nparts == uint64_t(nranks), "the nonconforming mesh in "
+                  << fname << " has " << nparts << " parts: it can not be "
+                  "loaded on " << nranks << " ranks");
+      uint64_t entry[4];
+      ParallelFileRead(fh, table_offset + 4*uint64_t(rank)*sizeof(uint64_t),
+                       entry, sizeof(entry));
+      std::string data(entry[2], '\0');
+      ParallelFileRead(fh, entry[1], &data[0], data.size());
+      MPI_File_close(&fh);
+      std::istringstream is(data);
+      return ParMesh(comm, is);
+   }
+   MFEM_VERIFY(format == PARALLEL_FILE_BINARY, "unknown format " << format
+               << " of the parallel mesh file " << fname);
+   MFEM_VERIFY(header[5] == sizeof(real_t), "the parallel mesh file " << fname
+               << " was written with sizeof(real_t) = " << header[5]);
+   const int dim = int(header[2]), sdim = int(header[3]);
+
+   // With the number of ranks of the file, every rank reads its own part.
+   // Otherwise, the elements are split evenly in the order of the parts.
+   std::vector<uint64_t> table(4*nparts);
+   ParallelFileRead(fh, table_offset, table.data(),
+                    table.size()*sizeof(uint64_t));
+   std::vector<uint64_t> part_first(nparts+1, 0);
+   for (uint64_t p = 0; p < nparts; p++)
+   {
+      part_first[p+1] = part_first[p] + table[4*p];
+   }
+   uint64_t first = part_first[nparts]*rank/nranks;
+   uint64_t last = part_first[nparts]*(rank+1)/nranks;
+   if (nparts == uint64_t(nranks))
+   {
+      first = part_first[rank];
+      last = part_first[rank+1];
+   }
+
+   // read the element records in [first, last)
+   std::vector<int64_t> rec_ints;
+   std::vector<real_t> rec_reals;
+   std::vector<uint64_t> index;
+   for (uint64_t p = 0; p < nparts; p++)
+   {
+      const uint64_t ne = table[4*p], offset = table[4*p+1];
+      const uint64_t nints = table[4*p+2], nreals = table[4*p+3];
+      if (last <= part_first[p] || first >= part_first[p+1]) { continue; }
+      const uint64_t a = std::max(first, part_first[p]) - part_first[p];
+      const uint64_t b = std::min(last, part_first[p+1]) - part_first[p];
+      index.resize(2*(b - a + 1));
+      ParallelFileRead(fh, offset + 2*a*sizeof(uint64_t), index.data(),
+                       2*(std::min(b + 1, ne) - a)*sizeof(uint64_t));
+      if (b == ne)
+      {
+         index[2*(b - a)] = nints;
+         index[2*(b - a) + 1] = nreals;
+      }
+      const uint64_t ints_offset = offset + 2*ne*sizeof(uint64_t);
+      const uint64_t reals_offset = ints_offset + nints*sizeof(int64_t);
+      const uint64_t int_size = index[2*(b - a)] - index[0];
+      const uint64_t real_size = index[2*(b - a) + 1] - index[1];
+      rec_ints.resize(rec_ints.size() + int_size);
+      rec_reals.resize(rec_reals.size() + real_size);
+      ParallelFileRead(fh, ints_offset + index[0]*sizeof(int64_t),
+                       rec_ints.data() + rec_ints.size() - int_size,
+                       int_size*sizeof(int64_t));
+      ParallelFileRead(fh, reals_offset + index[1]*sizeof(real_t),
+                       rec_reals.data() + rec_reals.size() - real_size,
+                       real_size*sizeof(real_t));
+   }
+   MPI_File_close(&fh);
+
+   // Convert the element records to one block of BuildConforming(), see
+   // RebalanceConforming(); the repeated vertices are merged there.
+   const int ne = int(last - first);
+   std::vector<long long> ints = { ne, 0, 0 };
+   std::vector<real_t> reals;
+   std::vector<const int64_t*> rec_int(ne);
+   std::vector<const real_t*> rec_real(ne);
+   {
+      const int64_t *ri = rec_ints.data();
+      const real_t *rr = rec_reals.data();
+      for (int k = 0; k < ne; k++)
+      {
+         rec_int[k] = ri;
+         rec_real[k] = rr;
+         const int nv = Geometry::NumVerts[ri[0]];
+         ints[1] += ri[3];
+         ints[2] += nv;
+         rr += nv*sdim + ri[4];
+         ri += 5 + nv;
+         for (int j = 0; j < rec_int[k][3]; j++)
+         {
+            ri += 2 + Geometry::NumVerts[ri[0]];
+         }
+      }
+   }
+   for (int k = 0; k < ne; k++)
+   {
+      const int nv = Geometry::NumVerts[rec_int[k][0]];
+      ints.insert(ints.end(), rec_int[k] + 5, rec_int[k] + 5 + nv);
+      reals.insert(reals.end(), rec_real[k], rec_real[k] + nv*sdim);
+   }
+   for (int k = 0; k < ne; k++)
+   {
+      const int64_t *ri = rec_int[k];
+      const int nv = Geometry::NumVerts[ri[0]];
+      ints.insert(ints.end(), { ri[0], ri[1], ri[2], ri[4] });
+      ints.insert(ints.end(), ri + 5, ri + 5 + nv);
+      reals.insert(reals.end(), rec_real[k] + nv*sdim,
+                   rec_real[k] + nv*sdim + ri[4]);
+   }
+   for (int k = 0; k < ne; k++)
+   {
+      const int64_t *ri = rec_int[k];
+      const int nbe = int(ri[3]);
+      ri += 5 + Geometry::NumVerts[ri[0]];
+      for (int j = 0; j < nbe; j++)
+      {
+         const int nv = Geometry::NumVerts[ri[0]];
+         ints.insert(ints.end(), ri, ri + 2 + nv);
+         ri += 2 + nv;
+      }
+   }
+   rec_ints.clear();
+   rec_reals.clear();
+
+   ParMesh pmesh;
+   const std::vector<int> int_offsets = { 0, int(ints.size()) };
+   const std::vector<int> real_offsets = { 0, int(reals.size()) };
+   Array<int> nodes_offset;
+   pmesh.BuildConforming(comm, dim, sdim, int(header[4]), ints, int_offsets,
+                         reals, real_offsets, nodes_offset);
+   if (header[6] > 0)
+   {
+      FiniteElementCollection *fec =
+         FiniteElementCollection::New(fec_name.c_str());
+      ParFiniteElementSpace *pfes =
+         new ParFiniteElementSpace(&pmesh, fec, int(header[6]),
+                                   Ordering::Type(header[7]));
+      ParGridFunction *nodes = new ParGridFunction(pfes);
+      nodes->MakeOwner(fec); // nodes will own fec and pfes
+      Array<int> vdofs;
+      for (int i = 0; i < pmesh.GetNE(); i++)
+      {
+         pfes->GetElementVDofs(i, vdofs);
+         nodes->SetSubVector(vdofs, &reals[nodes_offset[i]]);
+      }
+      pmesh.NewNodes(*nodes, true);
+   }
+   return pmesh;
+}
+
 void ParMesh::PrintAsOneXG(std::ostream &os)
 {
    MFEM_ASSERT(Dim == spaceDim, "2D Manifolds not supported.");
@@ -6838,6 +8315,7 @@ void ParMesh::Swap(ParMesh &other)
 
    // Nodes, NCMesh, and NURBSExtension are taken care of by Mesh::Swap
    mfem::Swap(pncmesh, other.pncmesh);
+   mfem::Swap(rebalance_partition, other.rebalance_partition);
 
    print_shared = other.print_shared;
 }
@@ -100,6 +100,10 @@ protected:
    // for visualization purposes)
    bool print_shared = true;
 
+   // The new rank of each previous local element, after a conforming
+   // Rebalance(), see GetRebalancePartition().
+   Array<int> rebalance_partition;
+
    /// Create from a nonconforming mesh.
    ParMesh(const ParNCMesh &pncmesh);
 
@@ -202,7 +206,25 @@ protected:
                                   real_t threshold, int nc_limit = 0,
                                   int op = 1) override;
 
-   void RebalanceImpl(const Array<int> *partition);
+   void RebalanceImpl(const Array<int> *partition,
+                      const Vector *weights = NULL);
+
+   /** Migrate the elements of a conforming mesh: the local element 'i' is sent
+       to the rank 'partition[i]', with its boundary elements. */
+   void RebalanceConforming(const Array<int> &partition);
+
+   /** Build the local mesh of a conforming ParMesh on @a comm, with its shared
+       entities, from the element blocks of RebalanceConforming(): block 'b'
+       is [int_offsets[b], int_offsets[b+1]) of @a block_ints and starts at
+       real_offsets[b] in @a block_reals. The vertices are given with global
+       numbers and the duplicates are merged. Returns, in @a nodes_offset, the
+       offset in @a block_reals of the nodal values of every local element. */
+   void BuildConforming(MPI_Comm comm, int dim, int space_dim, int mesh_gen,
+                        const std::vector<long long> &block_ints,
+                        const std::vector<int> &int_offsets,
+                        const std::vector<real_t> &block_reals,
+                        const std::vector<int> &real_offsets,
+                        Array<int> &nodes_offset);
 
    void DeleteFaceNbrData();
 
@@ -340,9 +362,10 @@ public:
    /** The mesh is partitioned automatically or using external partitioning data
        (the optional parameter 'partitioning_[i]' contains the desired MPI rank
        for element 'i'). Automatic partitioning uses METIS for conforming meshes
-       and quick space-filling curve equipartitioning for nonconforming meshes
-       (elements of nonconforming meshes should ideally be ordered as a sequence
-       of face-neighbors). */
+       (or Mesh::SpaceFillingCurvePartitioning() when MFEM is built without
+       METIS) and quick space-filling curve equipartitioning for nonconforming
+       meshes (elements of nonconforming meshes should ideally be ordered as a
+       sequence of face-neighbors). */
    ParMesh(MPI_Comm comm, Mesh &mesh, const int *partitioning_ = nullptr,
            int part_method = 1);
 
@@ -392,6 +415,36 @@ public:
        See @a Mesh::MakeSimplicial for more details. */
    static ParMesh MakeSimplicial(ParMesh &orig_mesh);
 
+   /** @brief Create a distributed Cartesian mesh of the box [0,sx]x[0,sy]x[0,sz]
+       with the same vertices, elements and attributes as
+       Mesh::MakeCartesian3D() (hexahedra, tetrahedra or wedges), without
+       building the serial mesh.
+
+       The ranks form a px x py x pz processor grid, given by @a nxyz_proc or
+       chosen to minimize the area of the interfaces, ordered as in
+       Mesh::CartesianPartitioning(). Each rank generates only its block of
+       cells, and the shared entities and the group topology are computed from
+       the grid, so the memory and the time are proportional to the number of
+       local elements. The result is a partition of the serial mesh into
+       blocks, equivalent to ParMesh(MPI_Comm, Mesh &, const int *) with that
+       partitioning; the local element ordering is lexicographic. Collective on
+       @a comm. */
+   static ParMesh MakeCartesian3D(MPI_Comm comm, int nx, int ny, int nz,
+                                  Element::Type type, real_t sx = 1.0,
+                                  real_t sy = 1.0, real_t sz = 1.0,
+                                  const int *nxyz_proc = nullptr);
+
+   /** @brief Load a mesh written with SaveParallelFile().
+
+       Every rank reads, with MPI-IO, the file header, the part table and only
+       the elements it gets, so no rank reads or broadcasts the whole mesh. A
+       conforming mesh can be loaded on any number of ranks: if the size of
+       @a comm is the number of parts in the file, every rank gets its part,
+       otherwise the elements are split evenly in the order of the parts. A
+       nonconforming mesh can only be loaded on the number of ranks it was
+       saved from. Collective on @a comm. */
+   static ParMesh LoadParallelFile(MPI_Comm comm, const std::string &fname);
+
    void Finalize(bool refine = false, bool fix_orientation = false) override;
 
    void SetAttributes() override;
@@ -468,6 +521,15 @@ public:
 
    ParNCMesh* pncmesh;
 
+   /** @brief After a conforming Rebalance(), return the rank each element of
+       the previous local mesh was sent to.
+
+       The elements received by a rank are ordered by their previous rank and
+       then by their previous local number. Used by ParFiniteElementSpace to
+       migrate the grid functions. */
+   const Array<int> &GetRebalancePartition() const
+   { return rebalance_partition; }
+
    int GetNGroups() const { return gtopo.NGroups(); }
 
    ///@{ @name These methods require group > 0
@@ -712,14 +774,59 @@ public:
    long long ReduceInt(int value) const override;
 
    /** Load balance the mesh by equipartitioning the global space-filling
-       sequence of elements. Works for nonconforming meshes only. */
+       sequence of elements. For nonconforming meshes, the sequence follows the
+       refinement trees, see ParNCMesh::Rebalance(). For conforming meshes, it
+       follows the Hilbert curve through the element centers, see
+       ParSpaceFillingCurvePartitioning().
+
+       @note For conforming meshes, the mesh Nodes are migrated with the
+       elements, and the other grid functions are migrated by
+       ParFiniteElementSpace::Update() and ParGridFunction::Update(), as for
+       nonconforming meshes. */
    void Rebalance();
 
-   /** Load balance a nonconforming mesh using a user-defined partition. Each
-       local element 'i' is migrated to processor rank 'partition[i]', for 0 <=
-       i < GetNE(). */
+   /** Load balance the mesh using a user-defined partition. Each local element
+       'i' is migrated to processor rank 'partition[i]', for 0 <= i < GetNE().
+       See the note in Rebalance() for conforming meshes. */
    void Rebalance(const Array<int> &partition);
 
+   /** @brief Load balance the mesh by splitting the global space-filling
+       sequence of elements into pieces of equal total weight, e.g. with
+       weights from the polynomial orders or measured costs, see
+       ElementCostRecorder. The @a weights, one per local element, must be
+       nonnegative.
+
+       The mesh is changed only if the current imbalance, see
+       GetLoadImbalance(), is larger than @a max_imbalance, so the migration
+       can be skipped when it would not pay off, e.g. with @a max_imbalance =
+       1.1 when a 10% imbalance is acceptable. Returns true if the mesh was
+       rebalanced. The finite element spaces can be updated in both cases,
+       ParFiniteElementSpace::Update() is a no-op if the mesh did not change.
+
+       For nonconforming meshes, the sequence follows the refinement trees, as
+       in Rebalance(), and the grid functions can be transferred; the element
+       orders of variable-order spaces migrate with the elements. See the note
+       in Rebalance() for conforming meshes. */
+   bool Rebalance(const Vector &weights, real_t max_imbalance = 1.0);
+
+   /** @brief Return the load imbalance of the element @a weights, one per
+       local element: the maximum over the ranks of their total weight divided
+       by the average. The value is 1 for a perfectly balanced mesh. */
+   real_t GetLoadImbalance(const Vector &weights) const;
+
+   /** @brief Compute a partitioning of the elements along the Hilbert curve
+       through their centers: on return, @a partition[i] is the new rank of the
+       local element 'i'.
+
+       The elements are sorted with a parallel sample sort of their Hilbert
+       keys in the global bounding box, and the sequence is split into pieces
+       of (almost) equal total weight. The optional @a weights, one per local
+       element, default to one. This is the parallel version of
+       Mesh::SpaceFillingCurvePartitioning(), the result can be passed to
+       Rebalance(const Array<int>&). */
+   void ParSpaceFillingCurvePartitioning(Array<int> &partition,
+                                         const Vector *weights = NULL);
+
    /** Save the mesh in a parallel mesh format. If @a comments is non-empty, it
        will be printed after the first line of the file, and each line should
        begin with '#'. */
@@ -777,6 +884,18 @@ public:
    /// @a precision is used for ASCII output.
    void SaveAsOne(const std::string &fname, int precision=16) const;
 
+   /** @brief Save the mesh as a single binary parallel mesh file, which can be
+       loaded with LoadParallelFile().
+
+       The file consists of a header, a table with the size and the offset of
+       the part of every rank, and the parts themselves, which are written
+       concurrently with MPI-IO. The part of a conforming mesh is binary and
+       stores every element with its vertices, boundary elements and nodal
+       values, so that the file can be loaded on a different number of ranks.
+       The part of a nonconforming mesh is the output of ParPrint(), with the
+       given @a precision. NURBS meshes are not supported. Collective. */
+   void SaveParallelFile(const std::string &fname, int precision = 16) const;
+
    /// Old mesh format (Netgen/Truegrid) version of 'PrintAsOne'
    void PrintAsOneXG(std::ostream &out = mfem::out);
 
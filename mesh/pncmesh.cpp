@@ -1944,8 +1944,12 @@ void ParNCMesh::CheckDerefinementNCLevel(const Table &deref_table,
 
 //// Rebalance /////////////////////////////////////////////////////////////////
 
-void ParNCMesh::Rebalance(const Array<int> *custom_partition)
+void ParNCMesh::Rebalance(const Array<int> *custom_partition,
+                          const Vector *weights)
 {
+   MFEM_VERIFY(!custom_partition || !weights,
+               "a partition and weights cannot be used together");
+
    send_rebalance_dofs.clear();
    recv_rebalance_dofs.clear();
 
@@ -1956,25 +1960,68 @@ void ParNCMesh::Rebalance(const Array<int> *custom_partition)
    {
       Array<int> new_ranks(leaf_elements.Size());
       new_ranks = -1;
+      int target_elements;
 
-      // figure out new assignments for Element::rank
-      long local_elems = NElements, total_elems = 0;
-      MPI_Allreduce(&local_elems, &total_elems, 1, MPI_LONG, MPI_SUM, MyComm);
+      if (!weights)
+      {
+         // figure out new assignments for Element::rank
+         long local_elems = NElements, total_elems = 0;
+         MPI_Allreduce(&local_elems, &total_elems, 1, MPI_LONG, MPI_SUM,
+                       MyComm);
 
-      long first_elem_global = 0;
-      MPI_Scan(&local_elems, &first_elem_global, 1, MPI_LONG, MPI_SUM, MyComm);
-      first_elem_global -= local_elems;
+         long first_elem_global = 0;
+         MPI_Scan(&local_elems, &first_elem_global, 1, MPI_LONG, MPI_SUM,
+                  MyComm);
+         first_elem_global -= local_elems;
 
-      for (int i = 0, j = 0; i < leaf_elements.Size(); i++)
-      {
-         if (elements[leaf_elements[i]].rank == MyRank)
+         for (int i = 0, j = 0; i < leaf_elements.Size(); i++)
          {
-            new_ranks[i] = Partition(first_elem_global + (j++), total_elems);
+            if (elements[leaf_elements[i]].rank == MyRank)
+            {
+               new_ranks[i] = Partition(first_elem_global + (j++), total_elems);
+            }
          }
+
+         target_elements = PartitionFirstIndex(MyRank+1, total_elems)
+                           - PartitionFirstIndex(MyRank, total_elems);
       }
+      else
+      {
+         MFEM_VERIFY(weights->Size() == NElements, "Size of the weights must "
+                     "match the number of local mesh elements.");
+
+         // an element goes to the rank owning the midpoint of its interval in
+         // the cumulative weight along the space-filling sequence
+         const MPI_Datatype mpi_real = MPITypeMap<real_t>::mpi_type;
+         real_t local_weight = weights->Sum(), total_weight = 0, prefix = 0;
+         MPI_Allreduce(&local_weight, &total_weight, 1, mpi_real, MPI_SUM,
+                       MyComm);
+         MPI_Scan(&local_weight, &prefix, 1, mpi_real, MPI_SUM, MyComm);
+         prefix -= local_weight;
+         MFEM_VERIFY(total_weight > 0, "the total weight must be positive");
+
+         Array<int> rank_elements(NRanks);
+         rank_elements = 0;
+         for (int i = 0; i < leaf_elements.Size(); i++)
+         {
+            const Element &el = elements[leaf_elements[i]];
+            if (el.rank == MyRank)
+            {
+               const real_t w = (*weights)(el.index);
+               MFEM_ASSERT(w >= 0, "negative weight: " << w);
+               int rank = (int) std::floor((prefix + 0.5*w) * NRanks
+                                           / total_weight);
+               rank = std::min(std::max(rank, 0), NRanks-1);
+               new_ranks[i] = rank;
+               rank_elements[rank]++;
+               prefix += w;
+            }
+         }
 
-      int target_elements = PartitionFirstIndex(MyRank+1, total_elems)
-                            - PartitionFirstIndex(MyRank, total_elems);
+         // the number of elements each rank will own
+         MPI_Reduce_scatter_block(rank_elements.GetData(), &target_elements, 1,
+                                  MPI_INT, MPI_SUM, MyComm);
+      }
 
       // assign the new ranks and send elements (plus ghosts) to new owners
       RedistributeElements(new_ranks, target_elements, true);
@@ -2352,6 +2399,37 @@ void ParNCMesh::RecvRebalanceDofs(Array<int> &elements, Array<long> &dofs)
 }
 
 
+void ParNCMesh::SendRebalanceValues(const Array<int> &old_values)
+{
+   // fill messages (prepared by Rebalance) with one value per element
+   for (auto &kv : send_rebalance_dofs)
+   {
+      RebalanceDofMessage &msg = kv.second;
+      msg.dofs.resize(msg.elem_ids.size());
+      for (unsigned i = 0; i < msg.elem_ids.size(); i++)
+      {
+         msg.dofs[i] = old_values[msg.elem_ids[i]];
+      }
+      msg.dof_offset = 0;
+   }
+
+   RebalanceDofMessage::IsendAll(send_rebalance_dofs, MyComm);
+}
+
+void ParNCMesh::RecvRebalanceValues(Array<int> &elements, Array<int> &values)
+{
+   Array<long> long_values;
+   RecvRebalanceDofs(elements, long_values);
+
+   MFEM_ASSERT(elements.Size() == long_values.Size(), "");
+   values.SetSize(long_values.Size());
+   for (int i = 0; i < values.Size(); i++)
+   {
+      values[i] = static_cast<int>(long_values[i]);
+   }
+}
+
+
 //// ElementSet ////////////////////////////////////////////////////////////////
 
 ParNCMesh::ElementSet::ElementSet(const ElementSet &other)
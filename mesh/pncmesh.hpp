@@ -107,8 +107,10 @@ public:
        The default partitioning strategy is based on equal splitting of the
        space-filling sequence of leaf elements (custom_partition == NULL).
        Alternatively, a used-defined element-rank assignment array can be
-       passed. */
-   void Rebalance(const Array<int> *custom_partition = NULL);
+       passed. If @a weights are given, one per local element, the sequence is
+       split into pieces of (almost) equal total weight instead. */
+   void Rebalance(const Array<int> *custom_partition = NULL,
+                  const Vector *weights = NULL);
 
    // Interface for ParFiniteElementSpace
    int GetNElements() const { return NElements; }
@@ -220,6 +222,15 @@ public:
    /// Receive element DOFs sent by SendRebalanceDofs().
    void RecvRebalanceDofs(Array<int> &elements, Array<long> &dofs);
 
+   /** Use the communication pattern from last Rebalance() to send one value
+       per element, e.g. the polynomial order, where @a old_values[i] is the
+       value of the old (pre-Rebalance) local element 'i'. */
+   void SendRebalanceValues(const Array<int> &old_values);
+
+   /** Receive the values sent by SendRebalanceValues(): @a values[i] is the
+       value of the current local element @a elements[i]. */
+   void RecvRebalanceValues(Array<int> &elements, Array<int> &values);
+
    /** Get previous indices (pre-Rebalance) of current elements. Index of -1
        indicates that an element didn't exist in the mesh before. */
    const Array<int>& GetRebalanceOldIndex() const { return old_index_or_rank; }
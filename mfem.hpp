@@ -20,12 +20,14 @@
 #include "general/arrays_by_name.hpp"
 #include "general/sets.hpp"
 #include "general/hash.hpp"
+#include "general/binaryfile.hpp"
 #include "general/mem_alloc.hpp"
 #include "general/sort_pairs.hpp"
 #include "general/stable3d.hpp"
 #include "general/table.hpp"
 #include "general/tic_toc.hpp"
 #include "general/annotation.hpp"
+#include "general/profiler.hpp"
 #ifdef MFEM_USE_ADIOS2
 #include "general/adios2stream.hpp"
 #endif // MFEM_USE_ADIOS2
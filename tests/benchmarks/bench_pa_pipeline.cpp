@@ -0,0 +1,190 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "bench.hpp"
+
+#ifdef MFEM_USE_BENCHMARK
+
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
+/*
+  This benchmark measures the throughput of the matrix-free operator pipeline:
+  the action of a partially assembled diffusion operator (element restriction,
+  PA kernel and transpose restriction, PA_Action), and the vector operations of
+  a CG iteration (BLAS1), on 3D H1 spaces with about 'target_dofs' dofs.
+  PA_Action_Fused applies the restrictions inside the PA kernel, see
+  BilinearForm::UseFusedPA(), and PA_Action_Single also stores the quadrature
+  data in single precision, see BilinearForm::UseSinglePrecisionPA().
+
+  Besides the total throughput, "MDof/s", the throughput per thread is reported
+  as "MDof/s/core", which shows the scaling of the 'omp' device with the number
+  of OpenMP threads (OMP_NUM_THREADS). On NUMA systems, run with
+  OMP_PROC_BIND=close/spread and OMP_PLACES=cores.
+
+   * --benchmark_filter=[PA_Action[_Fused/_Single]/BLAS1]/[1-max_order]
+   * --benchmark_context=device=[cpu/omp/cuda/hip]
+*/
+
+// The maximum polynomial order used for benchmarking
+constexpr int max_order = 6;
+// The approximate number of dofs for benchmarking
+constexpr int target_dofs = 1000000;
+
+/// Number of host threads used by the configured device
+static int NumThreads()
+{
+#ifdef MFEM_USE_OPENMP
+   if (Device::Allows(Backend::OMP)) { return omp_get_max_threads(); }
+#endif
+   return 1;
+}
+
+struct PAPipeline
+{
+   static constexpr int DIM = 3;
+   const int p, N;
+   Mesh mesh;
+   H1_FECollection fec;
+   FiniteElementSpace fes;
+   ConstantCoefficient one;
+   const int dofs;
+   GridFunction x, y;
+   BilinearForm a;
+
+   PAPipeline(int p, bool fused = false, bool single = false):
+      p(p),
+      N(std::max(1, (int)std::cbrt(target_dofs)/p)),
+      mesh(Mesh::MakeCartesian3D(N, N, N, Element::HEXAHEDRON)),
+      fec(p, DIM),
+      fes(&mesh, &fec),
+      one(1.0),
+      dofs(fes.GetVSize()),
+      x(&fes),
+      y(&fes),
+      a(&fes)
+   {
+      x.Randomize(1);
+      y = 0.0;
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a.UseFusedPA(fused);
+      a.UseSinglePrecisionPA(single);
+      a.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a.Assemble();
+      a.Mult(x, y);
+      MFEM_DEVICE_SYNC;
+   }
+};
+
+static void SetCounters(bm::State &state, int dofs)
+{
+   const double mdofs = 1e-6 * dofs * state.iterations();
+   state.counters["MDof/s"] = bm::Counter(mdofs, bm::Counter::kIsRate);
+   state.counters["MDof/s/core"] =
+      bm::Counter(mdofs / NumThreads(), bm::Counter::kIsRate);
+   state.counters["Threads"] = NumThreads();
+}
+
+/// Action of the PA operator: restriction, PA kernel and transpose restriction
+static void PA_Action(bm::State &state)
+{
+   PAPipeline pb(state.range(0));
+   for (auto _ : state)
+   {
+      pb.a.Mult(pb.x, pb.y);
+      MFEM_DEVICE_SYNC;
+   }
+   SetCounters(state, pb.dofs);
+}
+BENCHMARK(PA_Action)->DenseRange(1, max_order)->Unit(bm::kMillisecond)
+->UseRealTime();
+
+/// Action of the PA operator with the restrictions fused into the PA kernel
+static void PA_Action_Fused(bm::State &state)
+{
+   PAPipeline pb(state.range(0), true);
+   for (auto _ : state)
+   {
+      pb.a.Mult(pb.x, pb.y);
+      MFEM_DEVICE_SYNC;
+   }
+   SetCounters(state, pb.dofs);
+}
+BENCHMARK(PA_Action_Fused)->DenseRange(1, max_order)->Unit(bm::kMillisecond)
+->UseRealTime();
+
+/// Fused action of the PA operator with single precision quadrature data
+static void PA_Action_Single(bm::State &state)
+{
+   PAPipeline pb(state.range(0), true, true);
+   for (auto _ : state)
+   {
+      pb.a.Mult(pb.x, pb.y);
+      MFEM_DEVICE_SYNC;
+   }
+   SetCounters(state, pb.dofs);
+}
+BENCHMARK(PA_Action_Single)->DenseRange(1, max_order)->Unit(bm::kMillisecond)
+->UseRealTime();
+
+/// Vector operations of a CG iteration: two dot products and three updates
+static void BLAS1(bm::State &state)
+{
+   PAPipeline pb(state.range(0));
+   Vector r(pb.x), d(pb.x), z(pb.y);
+   r.UseDevice(true); d.UseDevice(true); z.UseDevice(true);
+   for (auto _ : state)
+   {
+      const real_t den = z * d;
+      const real_t alpha = 1.0 / (den + 1.0);
+      pb.y.Add(alpha, d);
+      r.Add(-alpha, z);
+      const real_t nom = r * r;
+      add(r, 1e-3 * nom / (den + 1.0), d, d);
+      MFEM_DEVICE_SYNC;
+   }
+   SetCounters(state, pb.dofs);
+}
+BENCHMARK(BLAS1)->DenseRange(1, max_order)->Unit(bm::kMillisecond)
+->UseRealTime();
+
+/**
+ * @brief main entry point
+ * --benchmark_filter=PA_Action/6
+ * --benchmark_context=device=omp
+ */
+int main(int argc, char *argv[])
+{
+   bm::ConsoleReporter CR;
+   bm::Initialize(&argc, argv);
+
+   // Device setup, cpu by default
+   std::string device_config = "cpu";
+   auto global_context = bmi::GetGlobalContext();
+   if (global_context != nullptr)
+   {
+      const auto device = global_context->find("device");
+      if (device != global_context->end())
+      {
+         mfem::out << device->first << " : " << device->second << std::endl;
+         device_config = device->second;
+      }
+   }
+   Device device(device_config.c_str());
+   device.Print();
+
+   if (bm::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+   bm::RunSpecifiedBenchmarks(&CR);
+   return 0;
+}
+
+#endif // MFEM_USE_BENCHMARK
@@ -14,6 +14,12 @@
 
 #include <iostream>
 
+#if defined(MFEM_THREAD_SAFE) && \
+    (defined(MFEM_USE_OPENMP) || defined(MFEM_USE_LEGACY_OPENMP))
+#define MFEM_TEST_THREADED_ASSEMBLY
+#include <omp.h>
+#endif
+
 using namespace mfem;
 
 TEST_CASE("Test order of boundary integrators",
@@ -184,3 +190,168 @@ TEST_CASE("BilinearForm print", "[SparseMatrix][BilinearForm]")
    a.Print(ss);
    REQUIRE(ss.str().length() > 0);
 }
+
+// Compare the assembly with UseThreadedAssembly() to the serial assembly; the
+// threaded form is assembled by the function 'assemble'.
+template <typename AssembleFunc>
+static void TestThreadedAssembly(int fe_type, AssembleFunc assemble)
+{
+   const int order = 2;
+   Mesh mesh = Mesh::MakeCartesian3D(2, 2, 2, Element::TETRAHEDRON);
+   for (int i = 0; i < mesh.GetNE(); i++) { mesh.SetAttribute(i, 1 + i%2); }
+   mesh.SetAttributes();
+
+   std::unique_ptr<FiniteElementCollection> fec;
+   if (fe_type == 0) { fec.reset(new H1_FECollection(order, 3)); }
+   else { fec.reset(new ND_FECollection(order, 3)); }
+   FiniteElementSpace fes(&mesh, fec.get());
+
+   ConstantCoefficient one(1.0), two(2.0);
+   Array<int> attr2(2); attr2 = 0; attr2[1] = 1;
+   auto add_integs = [&](BilinearForm &a)
+   {
+      if (fe_type == 0)
+      {
+         a.AddDomainIntegrator(new DiffusionIntegrator(one));
+         a.AddDomainIntegrator(new MassIntegrator(two), attr2);
+         a.AddBoundaryIntegrator(new MassIntegrator(one));
+      }
+      else
+      {
+         a.AddDomainIntegrator(new CurlCurlIntegrator(one));
+         a.AddDomainIntegrator(new VectorFEMassIntegrator(two), attr2);
+      }
+   };
+
+   BilinearForm a_ref(&fes), a_serial(&fes), a_threaded(&fes);
+   add_integs(a_ref);
+   add_integs(a_serial);
+   add_integs(a_threaded);
+
+   a_ref.Assemble();
+   a_ref.Finalize();
+
+   a_serial.UsePrecomputedSparsity();
+   a_serial.Assemble();
+   a_serial.Finalize();
+
+   a_threaded.UseThreadedAssembly();
+   assemble(a_threaded);
+   a_threaded.Finalize();
+
+   const SparseMatrix &A_serial = a_serial.SpMat();
+   const SparseMatrix &A_threaded = a_threaded.SpMat();
+   REQUIRE(A_serial.NumNonZeroElems() == A_threaded.NumNonZeroElems());
+   for (int k = 0; k < A_serial.NumNonZeroElems(); k++)
+   {
+      REQUIRE(A_serial.GetJ()[k] == A_threaded.GetJ()[k]);
+      REQUIRE(A_serial.GetData()[k] == A_threaded.GetData()[k]);
+   }
+
+   SparseMatrix *D = Add(1.0, a_ref.SpMat(), -1.0, A_threaded);
+   REQUIRE(D->MaxNorm() == MFEM_Approx(0.0));
+   delete D;
+}
+
+TEST_CASE("BilinearForm batched assembly", "[BilinearForm]")
+{
+   // Without threads, UseThreadedAssembly() runs the batched loop serially
+   auto fe_type = GENERATE(0, 1);
+   TestThreadedAssembly(fe_type, [](BilinearForm &a) { a.Assemble(); });
+}
+
+#ifdef MFEM_TEST_THREADED_ASSEMBLY
+TEST_CASE("BilinearForm threaded assembly", "[BilinearForm]")
+{
+   auto fe_type = GENERATE(0, 1);
+   const int max_threads = omp_get_max_threads();
+   const int dynamic = omp_get_dynamic();
+   omp_set_num_threads(4);
+
+   SECTION("Fixed number of threads")
+   {
+      TestThreadedAssembly(fe_type, [](BilinearForm &a) { a.Assemble(); });
+   }
+
+   SECTION("Dynamic number of threads")
+   {
+      omp_set_dynamic(1);
+      TestThreadedAssembly(fe_type, [](BilinearForm &a) { a.Assemble(); });
+   }
+
+   SECTION("Inside a parallel region")
+   {
+      // The nested region of the assembly has fewer threads than requested
+      TestThreadedAssembly(fe_type, [](BilinearForm &a)
+      {
+         #pragma omp parallel num_threads(2)
+         {
+            #pragma omp master
+            a.Assemble();
+         }
+      });
+   }
+
+   omp_set_dynamic(dynamic);
+   omp_set_num_threads(max_threads);
+}
+#endif
+
+TEST_CASE("BilinearForm frozen sparsity", "[BilinearForm]")
+{
+   const int order = 2;
+   Mesh mesh = Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL);
+   L2_FECollection dg_fec(order, 2);
+   H1_FECollection h1_fec(order, 2);
+   FiniteElementSpace dg_fes(&mesh, &dg_fec), h1_fes(&mesh, &h1_fec);
+
+   ConstantCoefficient kappa(1.0);
+   const real_t sigma = -1.0, eta = 2.0;
+   auto add_integs = [&](BilinearForm &a)
+   {
+      a.AddDomainIntegrator(new DiffusionIntegrator(kappa));
+      a.AddInteriorFaceIntegrator(new DGDiffusionIntegrator(kappa, sigma, eta));
+      a.AddBdrFaceIntegrator(new DGDiffusionIntegrator(kappa, sigma, eta));
+   };
+
+   BilinearForm a(&dg_fes);
+   add_integs(a);
+   a.UseFrozenSparsity();
+
+   MixedBilinearForm b(&h1_fes, &dg_fes);
+   b.AddDomainIntegrator(new MixedScalarMassIntegrator(kappa));
+   b.UseFrozenSparsity();
+
+   const real_t *a_data = nullptr;
+   for (real_t k : {1.0, 2.5, 0.5})
+   {
+      kappa.constant = k;
+
+      if (k != 1.0) { a = 0.0; }
+      a.Assemble();
+      a.Finalize();
+      // The CSR arrays are allocated only in the first assembly
+      if (!a_data) { a_data = a.SpMat().GetData(); }
+      REQUIRE(a.SpMat().GetData() == a_data);
+      if (k != 1.0) { b = 0.0; }
+      b.Assemble();
+      b.Finalize();
+
+      BilinearForm a_ref(&dg_fes);
+      add_integs(a_ref);
+      a_ref.Assemble();
+      a_ref.Finalize();
+
+      MixedBilinearForm b_ref(&h1_fes, &dg_fes);
+      b_ref.AddDomainIntegrator(new MixedScalarMassIntegrator(kappa));
+      b_ref.Assemble();
+      b_ref.Finalize();
+
+      SparseMatrix *D = Add(1.0, a.SpMat(), -1.0, a_ref.SpMat());
+      REQUIRE(D->MaxNorm() == MFEM_Approx(0.0));
+      delete D;
+      D = Add(1.0, b.SpMat(), -1.0, b_ref.SpMat());
+      REQUIRE(D->MaxNorm() == MFEM_Approx(0.0));
+      delete D;
+   }
+}
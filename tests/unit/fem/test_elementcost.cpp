@@ -0,0 +1,66 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+TEST_CASE("ElementCostRecorder", "[ElementCostRecorder]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(4, 4, Element::QUADRILATERAL);
+   mesh.EnsureNCMesh();
+   H1_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   for (int i = 0; i < mesh.GetNE(); i += 2) { fes.SetElementOrder(i, 3); }
+   fes.Update(false);
+
+   ElementCostRecorder recorder(mesh.GetNE());
+   REQUIRE(recorder.GetNE() == mesh.GetNE());
+   REQUIRE(recorder.GetCosts().Normlinf() == 0.0);
+
+   SECTION("Quadrature cost")
+   {
+      // Mass rule of order 2p + 1 on the affine quadrilaterals
+      recorder.AddQuadratureCost(fes);
+      for (int i = 0; i < mesh.GetNE(); i++)
+      {
+         const int p = fes.GetElementOrder(i);
+         const int nq1d = p + 1;
+         REQUIRE(recorder.GetCost(i) == (nq1d*nq1d)*(p+1)*(p+1));
+      }
+
+      recorder.AddQuadratureCost(fes, 0.5);
+      REQUIRE(recorder.GetCost(0) == 1.5*16*16);
+      REQUIRE(recorder.GetCost(1) == 1.5*4*4);
+
+      recorder.Reset(2);
+      REQUIRE(recorder.GetNE() == 2);
+      REQUIRE(recorder.GetCosts().Normlinf() == 0.0);
+   }
+
+   SECTION("Measured costs")
+   {
+      recorder.AddCost(3, 2.0);
+      recorder.Start(3);
+      recorder.Stop();
+      REQUIRE(recorder.GetCost(3) >= 2.0);
+      REQUIRE(recorder.GetCost(2) == 0.0);
+
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new DiffusionIntegrator);
+      a.AddDomainIntegrator(new MassIntegrator);
+      recorder.Reset(mesh.GetNE());
+      recorder.AddAssemblyTime(a);
+      REQUIRE(recorder.GetCosts().Min() >= 0.0);
+      REQUIRE(recorder.GetCosts().Sum() > 0.0);
+   }
+}
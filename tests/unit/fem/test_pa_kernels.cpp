@@ -188,7 +188,7 @@ void pa_divergence_transpose_testnd(int dim)
    pa_mixed_transpose_test<VectorDivergenceIntegrator>(fes1, fes2);
 }
 
-TEST_CASE("PA VectorDivergence", "[PartialAssembly], [CUDA]")
+TEST_CASE("PA VectorDivergence", "[PartialAssembly], [CUDA], [OpenMP]")
 {
    SECTION("2D")
    {
@@ -280,7 +280,7 @@ void pa_gradient_transpose_testnd(int dim, FECType fec_type)
    pa_mixed_transpose_test<GradientIntegrator>(fes1, fes2);
 }
 
-TEST_CASE("PA Gradient", "[PartialAssembly], [CUDA]")
+TEST_CASE("PA Gradient", "[PartialAssembly], [CUDA], [OpenMP]")
 {
    auto fec_type = GENERATE(FECType::H1, FECType::L2_VALUE,
                             FECType::L2_INTEGRAL);
@@ -329,7 +329,8 @@ real_t test_nl_convection_nd(int dim)
    return difference;
 }
 
-TEST_CASE("Nonlinear Convection", "[PartialAssembly], [NonlinearPA], [CUDA]")
+TEST_CASE("Nonlinear Convection",
+          "[PartialAssembly], [NonlinearPA], [CUDA], [OpenMP]")
 {
    SECTION("2D")
    {
@@ -371,7 +372,7 @@ real_t test_vector_pa_integrator(int dim)
    return difference;
 }
 
-TEST_CASE("PA Vector Mass", "[PartialAssembly], [VectorPA], [CUDA]")
+TEST_CASE("PA Vector Mass", "[PartialAssembly], [VectorPA], [CUDA], [OpenMP]")
 {
    SECTION("2D")
    {
@@ -384,7 +385,8 @@ TEST_CASE("PA Vector Mass", "[PartialAssembly], [VectorPA], [CUDA]")
    }
 }
 
-TEST_CASE("PA Vector Diffusion", "[PartialAssembly], [VectorPA], [CUDA]")
+TEST_CASE("PA Vector Diffusion",
+          "[PartialAssembly], [VectorPA], [CUDA], [OpenMP]")
 {
    SECTION("2D")
    {
@@ -507,7 +509,7 @@ void test_pa_convection(const std::string &meshname, int order, int prob,
 }
 
 // Basic unit tests for convection
-TEST_CASE("PA Convection", "[PartialAssembly], [CUDA]")
+TEST_CASE("PA Convection", "[PartialAssembly], [CUDA], [OpenMP]")
 {
    // prob:
    // - 0: CG,
@@ -533,7 +535,8 @@ TEST_CASE("PA Convection", "[PartialAssembly], [CUDA]")
 } // test case
 
 // Advanced unit tests for convection
-TEST_CASE("PA Convection advanced", "[PartialAssembly], [MFEMData], [CUDA]")
+TEST_CASE("PA Convection advanced",
+          "[PartialAssembly], [MFEMData], [CUDA], [OpenMP]")
 {
    if (launch_all_non_regression_tests)
    {
@@ -612,17 +615,301 @@ static void test_pa_integrator()
    REQUIRE(y_fa.Normlinf() == MFEM_Approx(0.0));
 }
 
-TEST_CASE("PA Mass", "[PartialAssembly], [CUDA]")
+TEST_CASE("PA Mass", "[PartialAssembly], [CUDA], [OpenMP]")
 {
    test_pa_integrator<MassIntegrator>();
 } // PA Mass test case
 
-TEST_CASE("PA Diffusion", "[PartialAssembly], [CUDA]")
+TEST_CASE("PA Diffusion", "[PartialAssembly], [CUDA], [OpenMP]")
 {
    test_pa_integrator<DiffusionIntegrator>();
 } // PA Diffusion test case
 
-TEST_CASE("PA Markers", "[PartialAssembly], [CUDA]")
+TEST_CASE("PA Operator Pipeline", "[PartialAssembly], [CUDA], [OpenMP]")
+{
+   // The matrix-free action (restriction, PA kernels, transpose restriction),
+   // the device full assembly and the vector reductions, compared with the
+   // legacy assembly and host loops. With the OpenMP backend, this checks that
+   // the whole pipeline is thread-safe.
+   const int dim = GENERATE(2, 3);
+   const int order = 3;
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(6, 6, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(4, 4, 4, Element::HEXAHEDRON);
+   mesh.SetCurvature(order);
+   GridFunction &nodes = *mesh.GetNodes();
+   for (int i = 0; i < nodes.Size(); i++)
+   {
+      nodes(i) += 0.01*std::sin(7.0*i);
+   }
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   ConstantCoefficient one(1.0), two(2.0);
+   auto add_integs = [&](BilinearForm &a)
+   {
+      a.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a.AddDomainIntegrator(new MassIntegrator(two));
+   };
+   BilinearForm a_ref(&fes), a_pa(&fes), a_fa(&fes);
+   add_integs(a_ref);
+   add_integs(a_pa);
+   add_integs(a_fa);
+   a_ref.Assemble();
+   a_ref.Finalize();
+   a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a_pa.Assemble();
+   a_fa.SetAssemblyLevel(AssemblyLevel::FULL);
+   a_fa.Assemble();
+   a_fa.Finalize();
+
+   GridFunction x(&fes), y_ref(&fes), y_pa(&fes), y_fa(&fes);
+   x.Randomize(1);
+   a_ref.Mult(x, y_ref);
+   a_pa.Mult(x, y_pa);
+   a_fa.Mult(x, y_fa);
+   y_pa -= y_ref;
+   y_fa -= y_ref;
+   REQUIRE(y_pa.Normlinf() == MFEM_Approx(0.0));
+   REQUIRE(y_fa.Normlinf() == MFEM_Approx(0.0));
+
+   const real_t *h_x = x.HostRead(), *h_y = y_ref.HostRead();
+   real_t sum = 0.0, dot = 0.0, nrm2 = 0.0;
+   real_t min = h_y[0], max = h_y[0];
+   for (int i = 0; i < y_ref.Size(); i++)
+   {
+      sum += h_y[i];
+      dot += h_x[i]*h_y[i];
+      nrm2 += h_y[i]*h_y[i];
+      min = std::min(min, h_y[i]);
+      max = std::max(max, h_y[i]);
+   }
+   REQUIRE(y_ref.Sum() == MFEM_Approx(sum));
+   REQUIRE(x*y_ref == MFEM_Approx(dot));
+   REQUIRE(y_ref.Norml2() == MFEM_Approx(std::sqrt(nrm2)));
+   REQUIRE(y_ref.Min() == min);
+   REQUIRE(y_ref.Max() == max);
+}
+
+TEST_CASE("PA Fused Restriction", "[PartialAssembly], [CUDA], [OpenMP]")
+{
+   // The fused kernels are used for the specialized sizes, which include the
+   // default rules on meshes with linear geometry
+   auto fname = GENERATE("../../data/star.mesh", "../../data/fichera.mesh");
+   auto order = GENERATE(1, 2, 4);
+   CAPTURE(fname, order);
+
+   Mesh mesh(fname);
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   FunctionCoefficient coeff([](const Vector &x) { return 1.0 + x*x; });
+   auto add_integs = [&](BilinearForm &a)
+   {
+      a.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+      a.AddDomainIntegrator(new MassIntegrator(coeff));
+   };
+   BilinearForm a_pa(&fes), a_fused(&fes);
+   add_integs(a_pa);
+   add_integs(a_fused);
+   a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a_pa.Assemble();
+   a_fused.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a_fused.UseFusedPA();
+   a_fused.Assemble();
+   for (BilinearFormIntegrator *integ : *a_fused.GetDBFI())
+   {
+      REQUIRE(integ->SupportsFusedPA());
+   }
+
+   GridFunction x(&fes), y_pa(&fes), y_fused(&fes);
+   x.Randomize(1);
+   y_fused = 1.0; // Mult() overwrites y
+   a_pa.Mult(x, y_pa);
+   a_fused.Mult(x, y_fused);
+   y_fused -= y_pa;
+   REQUIRE(y_fused.Normlinf() == MFEM_Approx(0.0));
+
+   // With element markers, the regular action is used
+   Array<int> marker(mesh.attributes.Max());
+   marker = 1;
+   BilinearForm a_marked(&fes);
+   a_marked.AddDomainIntegrator(new DiffusionIntegrator(coeff), marker);
+   a_marked.AddDomainIntegrator(new MassIntegrator(coeff));
+   a_marked.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a_marked.UseFusedPA();
+   a_marked.Assemble();
+   a_marked.Mult(x, y_fused);
+   y_fused -= y_pa;
+   REQUIRE(y_fused.Normlinf() == MFEM_Approx(0.0));
+}
+
+TEST_CASE("PA Single Precision Data", "[PartialAssembly], [CUDA], [OpenMP]")
+{
+   auto fname = GENERATE("../../data/star.mesh", "../../data/fichera.mesh");
+   auto fused = GENERATE(false, true);
+   const int order = 3;
+   CAPTURE(fname, fused);
+
+   Mesh mesh(fname);
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   FunctionCoefficient coeff([](const Vector &x) { return 1.0 + x*x; });
+   auto add_integs = [&](BilinearForm &a)
+   {
+      a.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+      a.AddDomainIntegrator(new MassIntegrator(coeff));
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a.UseFusedPA(fused);
+   };
+   BilinearForm a_dp(&fes), a_sp(&fes);
+   add_integs(a_dp);
+   add_integs(a_sp);
+   a_dp.Assemble();
+   a_sp.UseSinglePrecisionPA();
+   a_sp.Assemble();
+
+   // The action is perturbed at the level of the single precision round-off
+   GridFunction x(&fes), y_dp(&fes), y_sp(&fes);
+   x.Randomize(1);
+   a_dp.Mult(x, y_dp);
+   a_sp.Mult(x, y_sp);
+   y_sp -= y_dp;
+   const real_t rel_err = y_sp.Normlinf() / y_dp.Normlinf();
+   REQUIRE(rel_err < 1e-5);
+   if (std::is_same<real_t, double>::value) { REQUIRE(rel_err > 0.0); }
+
+   // The setting of the integrators is kept, unless the form sets it
+   auto single_integs = [&](BilinearForm &a)
+   {
+      add_integs(a);
+      for (BilinearFormIntegrator *integ : *a.GetDBFI())
+      {
+         integ->SetPASinglePrecision(true);
+      }
+   };
+   BilinearForm a_integ_sp(&fes), a_form_dp(&fes);
+   single_integs(a_integ_sp);
+   single_integs(a_form_dp);
+   a_form_dp.UseSinglePrecisionPA(false);
+   a_integ_sp.Assemble();
+   a_form_dp.Assemble();
+   GridFunction y(&fes);
+   a_integ_sp.Mult(x, y);
+   a_sp.Mult(x, y_sp);
+   y -= y_sp;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+   a_form_dp.Mult(x, y);
+   y -= y_dp;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+
+   Vector diag_dp(fes.GetVSize()), diag_sp(fes.GetVSize());
+   a_dp.AssembleDiagonal(diag_dp);
+   a_sp.AssembleDiagonal(diag_sp);
+   diag_sp -= diag_dp;
+   REQUIRE(diag_sp.Normlinf() / diag_dp.Normlinf() < 1e-5);
+
+   // A Chebyshev smoother of the single precision form preconditions CG for
+   // the full precision form, which converges to full precision accuracy
+   Array<int> ess_tdofs;
+   a_sp.AssembleDiagonal(diag_sp);
+   OperatorJacobiSmoother jacobi(diag_sp, ess_tdofs);
+   ProductOperator DA(&jacobi, &a_sp, false, false);
+   Vector v0(fes.GetVSize());
+   v0.Randomize(2);
+   PowerMethod power_method;
+   const real_t max_eig =
+      power_method.EstimateLargestEigenvalue(DA, v0, 20, 1e-6);
+   OperatorChebyshevSmoother cheb(a_sp, diag_sp, ess_tdofs, 3, 1.1*max_eig);
+
+   const real_t tol = std::is_same<real_t, double>::value ? 1e-12 : 1e-5;
+   CGSolver cg;
+   cg.SetOperator(a_dp);
+   cg.SetPreconditioner(cheb);
+   cg.SetRelTol(tol);
+   cg.SetMaxIter(200);
+   GridFunction u(&fes);
+   u = 0.0;
+   cg.Mult(y_dp, u);
+   REQUIRE(cg.GetConverged());
+   Vector r(fes.GetVSize());
+   a_dp.Mult(u, r);
+   r -= y_dp;
+   REQUIRE(r.Norml2() < 1e2*tol*y_dp.Norml2());
+}
+
+TEST_CASE("PA Multiple Right-Hand Sides",
+          "[PartialAssembly], [CUDA], [OpenMP]")
+{
+   auto fname = GENERATE("../../data/star.mesh", "../../data/fichera.mesh");
+   auto order = GENERATE(1, 3);
+   auto variant = GENERATE(0, 1, 2); // regular, fused, single precision
+   CAPTURE(fname, order, variant);
+
+   Mesh mesh(fname);
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   FiniteElementSpace vfes(&mesh, &fec, dim);
+
+   FunctionCoefficient coeff([](const Vector &x) { return 1.0 + x*x; });
+   BilinearForm a(&fes), a_vec(&vfes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+   a.AddDomainIntegrator(new MassIntegrator(coeff));
+   a_vec.AddDomainIntegrator(new ElasticityIntegrator(coeff, coeff));
+   for (BilinearForm *form : {&a, &a_vec})
+   {
+      form->SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      form->UseFusedPA(variant == 1);
+      if (variant == 2) { form->UseSinglePrecisionPA(); }
+      form->Assemble();
+   }
+
+   // More vectors than the size of the batches applied at once
+   const int nvec = 19;
+   const real_t tol = std::is_same<real_t, double>::value ? 1e-12 : 1e-5;
+   auto check = [&](const Operator &op)
+   {
+      std::vector<Vector> x(nvec), y(nvec);
+      Array<const Vector *> X(nvec);
+      Array<Vector *> Y(nvec);
+      for (int j = 0; j < nvec; j++)
+      {
+         x[j].SetSize(op.Width());
+         x[j].Randomize(j + 1);
+         y[j].SetSize(op.Height());
+         y[j] = 1.0; // ArrayMult() overwrites y
+         X[j] = &x[j];
+         Y[j] = &y[j];
+      }
+      op.ArrayMult(X, Y);
+      Vector y_ref(op.Height());
+      for (int j = 0; j < nvec; j++)
+      {
+         op.Mult(x[j], y_ref);
+         y[j] -= y_ref;
+         REQUIRE(y[j].Normlinf() <= tol*y_ref.Normlinf());
+      }
+   };
+   check(a);
+   check(a_vec);
+
+   // Constrained system operators
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdofs;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+   OperatorHandle A;
+   a.FormSystemMatrix(ess_tdofs, A);
+   check(*A);
+   vfes.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+   a_vec.FormSystemMatrix(ess_tdofs, A);
+   check(*A);
+}
+
+TEST_CASE("PA Markers", "[PartialAssembly], [CUDA], [OpenMP]")
 {
    const bool all_tests = launch_all_non_regression_tests;
    auto fname = GENERATE("../../data/star.mesh", "../../data/star-q3.mesh",
@@ -678,7 +965,7 @@ TEST_CASE("PA Markers", "[PartialAssembly], [CUDA]")
    REQUIRE(y_fa.Normlinf() == MFEM_Approx(0.0));
 }
 
-TEST_CASE("PA Boundary Mass", "[PartialAssembly], [CUDA]")
+TEST_CASE("PA Boundary Mass", "[PartialAssembly], [CUDA], [OpenMP]")
 {
    const bool all_tests = launch_all_non_regression_tests;
 
@@ -792,7 +1079,7 @@ std::vector<std::string> get_dg_test_meshes()
    return mesh_filenames;
 }
 
-TEST_CASE("PA DG Diffusion", "[PartialAssembly], [CUDA]")
+TEST_CASE("PA DG Diffusion", "[PartialAssembly], [CUDA], [OpenMP]")
 {
    const auto mesh_fname = GENERATE_COPY(from_range(get_dg_test_meshes()));
    const int order = GENERATE(1, 2);
@@ -860,3 +1147,157 @@ TEST_CASE("Dispatch Map Specializations")
    REQUIRE_FALSE(QI::EvalKernels::GetDispatchTable().empty());
    REQUIRE_FALSE(QI::CollocatedGradKernels::GetDispatchTable().empty());
 }
+
+TEST_CASE("Kernel Tuning", "[PartialAssembly]")
+{
+   const int order = 2;
+   Mesh mesh = Mesh::MakeCartesian2D(4, 4, Element::QUADRILATERAL);
+   H1_FECollection fec(order, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+   // Use D1D = Q1D = 3, for which a specialized kernel is registered
+   const IntegrationRule &ir = IntRules.Get(Geometry::SQUARE, 2*order);
+
+   BilinearForm a(&fes);
+   a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a.AddDomainIntegrator(new DiffusionIntegrator(&ir));
+   a.Assemble();
+
+   Vector x(fes.GetVSize()), y_ref(fes.GetVSize()), y(fes.GetVSize());
+   x.Randomize(1);
+   KernelTuner::Disable();
+   a.Mult(x, y_ref);
+
+   const std::string db_file = "kernel_tuning_test.db";
+   remove(db_file.c_str());
+   KernelTuner::Reset();
+   KernelTuner::SetNumTrials(2);
+   KernelTuner::Enable(db_file);
+
+   // Tuning phase (two variants) followed by calls to the selected variant
+   for (int i = 0; i < 6; i++)
+   {
+      a.Mult(x, y);
+      y -= y_ref;
+      REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+   }
+
+   std::string line;
+   {
+      std::ifstream in(db_file);
+      REQUIRE(std::getline(in, line));
+   }
+   const size_t tab = line.find('\t');
+   REQUIRE(tab != std::string::npos);
+   const std::string variant = line.substr(0, tab);
+   const std::string entry = line.substr(tab + 1);
+   REQUIRE((variant == "default" || variant == "registers"));
+   REQUIRE(KernelTuner::GetSelection(entry) == variant);
+
+   // The selection is reloaded from the database
+   KernelTuner::Reset();
+   REQUIRE(KernelTuner::GetSelection(entry).empty());
+   KernelTuner::Enable();
+   KernelTuner::Enable(db_file);
+   REQUIRE(KernelTuner::GetSelection(entry) == variant);
+   a.Mult(x, y);
+   y -= y_ref;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+
+   KernelTuner::Disable();
+   KernelTuner::Reset();
+   KernelTuner::SetNumTrials(3);
+   REQUIRE(remove(db_file.c_str()) == 0);
+}
+
+TEST_CASE("Quadrature Data Cache", "[PartialAssembly]")
+{
+   const int order = 2;
+   const IntegrationRule &ir = IntRules.Get(Geometry::SQUARE, 2*order);
+   ConstantCoefficient two(2.0);
+
+   auto make_mesh = [](real_t shift)
+   {
+      Mesh mesh = Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL);
+      mesh.SetCurvature(order);
+      (*mesh.GetNodes())(0) += shift;
+      return mesh;
+   };
+   // Apply diffusion + mass and return the cache keys of the PA data
+   auto apply = [&](Mesh &mesh, const Vector &x, Vector &y)
+   {
+      H1_FECollection fec(order, mesh.Dimension());
+      FiniteElementSpace fes(&mesh, &fec);
+      BilinearForm a(&fes);
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a.AddDomainIntegrator(new DiffusionIntegrator(two, &ir));
+      a.AddDomainIntegrator(new MassIntegrator(&ir));
+      a.Assemble();
+      y.SetSize(fes.GetVSize());
+      a.Mult(x, y);
+      const GridFunction &nodes = *mesh.GetNodes();
+      const int map_type = fec.GetFE(Geometry::SQUARE, order)->GetMapType();
+      return std::vector<std::string>
+      {
+         QuadratureDataCache::GetKey("DiffusionIntegrator", nodes, ir, &two),
+         QuadratureDataCache::GetKey("MassIntegrator", nodes, ir, nullptr,
+                                     map_type),
+         QuadratureDataCache::GetKey("GeometricFactors", nodes, ir, nullptr,
+                                     GeometricFactors::JACOBIANS),
+         QuadratureDataCache::GetKey("GeometricFactors", nodes, ir, nullptr,
+                                     GeometricFactors::DETERMINANTS)
+      };
+   };
+
+   Mesh mesh_ref = make_mesh(0.0), mesh_shift_ref = make_mesh(0.01);
+   H1_FECollection fec(order, 2);
+   FiniteElementSpace fes(&mesh_ref, &fec);
+   Vector x(fes.GetVSize()), y_ref, y_shift_ref, y;
+   x.Randomize(1);
+
+   QuadratureDataCache::Disable();
+   REQUIRE(apply(mesh_ref, x, y_ref)[0].empty());
+   apply(mesh_shift_ref, x, y_shift_ref);
+
+   QuadratureDataCache::Enable(".");
+   std::vector<std::string> keys;
+   for (int run = 0; run < 2; run++)
+   {
+      // The first run computes and saves the data, the second one reads it
+      Mesh mesh = make_mesh(0.0);
+      keys = apply(mesh, x, y);
+      y -= y_ref;
+      REQUIRE(y.Normlinf() == 0.0);
+      for (const std::string &key : keys)
+      {
+         REQUIRE(std::ifstream(key + ".qdata").good());
+      }
+
+      const GeometricFactors *geom =
+         mesh.GetGeometricFactors(ir, GeometricFactors::DETERMINANTS);
+      const GeometricFactors *geom_ref =
+         mesh_ref.GetGeometricFactors(ir, GeometricFactors::DETERMINANTS);
+      Vector diff(geom->detJ);
+      diff -= geom_ref->detJ;
+      REQUIRE(diff.Normlinf() == 0.0);
+   }
+
+   // Different nodes give different keys and the data is recomputed
+   Mesh mesh_shift = make_mesh(0.01);
+   std::vector<std::string> keys_shift = apply(mesh_shift, x, y);
+   y -= y_shift_ref;
+   REQUIRE(y.Normlinf() == 0.0);
+   REQUIRE(keys_shift[0] != keys[0]);
+
+   // Non-constant coefficients are not cached
+   FunctionCoefficient f([](const Vector &p) { return p(0); });
+   REQUIRE_FALSE(QuadratureDataCache::CanHash(&f));
+   REQUIRE(QuadratureDataCache::GetKey("DiffusionIntegrator",
+                                       *mesh_shift.GetNodes(), ir, &f).empty());
+
+   QuadratureDataCache::Disable();
+   for (const std::string &key : keys) { remove((key + ".qdata").c_str()); }
+   for (const std::string &key : keys_shift)
+   {
+      remove((key + ".qdata").c_str());
+   }
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+using namespace mfem;
+
+#include "unit_tests.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#ifndef MFEM_USE_CALIPER
+
+static void ProfiledFunction()
+{
+   MFEM_PERF_FUNCTION;
+   MFEM_PERF_BEGIN("inner");
+   MFEM_PERF_END("inner");
+}
+
+TEST_CASE("Profiler", "[General]")
+{
+   const bool was_enabled = Profiler::IsEnabled();
+   Profiler::Enable(true, true);
+   Profiler::Reset();
+
+   for (int i = 0; i < 3; i++)
+   {
+      MFEM_PERF_SCOPE("outer");
+      ProfiledFunction();
+   }
+   MFEM_PERF_BEGIN("not nested");
+   MFEM_PERF_END("not nested");
+
+   // Disabled regions are not recorded
+   Profiler::Enable(false);
+   ProfiledFunction();
+
+   SECTION("Tree report")
+   {
+      std::ostringstream os;
+      Profiler::PrintReport(os, Profiler::TREE);
+      const std::string report = os.str();
+      REQUIRE(report.find("outer\n") != std::string::npos);
+      REQUIRE(report.find("    inner\n") != std::string::npos);
+      REQUIRE(report.find("not nested\n") != std::string::npos);
+
+      // The function region is called 3 times, nested in "outer"
+      std::istringstream is(report);
+      std::string line;
+      bool found = false;
+      while (std::getline(is, line))
+      {
+         if (line.find("  ProfiledFunction") == std::string::npos) { continue; }
+         std::istringstream ls(line);
+         long long calls;
+         ls >> calls;
+         REQUIRE(calls == 3);
+         found = true;
+      }
+      REQUIRE(found);
+   }
+
+   SECTION("Trace")
+   {
+      const char *filename = "profiler_trace.json";
+      Profiler::SaveTrace(filename);
+      std::ifstream ifs(filename);
+      std::stringstream ss;
+      ss << ifs.rdbuf();
+      const std::string trace = ss.str();
+      REQUIRE(trace.rfind("{\"traceEvents\":[", 0) == 0);
+      int num_events = 0;
+      for (size_t p = trace.find("\"ph\":\"X\""); p != std::string::npos;
+           p = trace.find("\"ph\":\"X\"", p + 1)) { num_events++; }
+      REQUIRE(num_events == 3*3 + 1);
+      std::remove(filename);
+   }
+
+   Profiler::Reset();
+   Profiler::Enable(was_enabled);
+}
+
+#endif // MFEM_USE_CALIPER
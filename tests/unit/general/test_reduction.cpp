@@ -397,3 +397,50 @@ TEST_CASE("Reduce ArgMinMax", "[Reduction],[CUDA]")
       REQUIRE(a[res.max_loc] == res.max_val);
    }
 }
+
+#ifdef MFEM_USE_OPENMP
+TEST_CASE("Reduce Sum OpenMP Team Size", "[Reduction],[OpenMP]")
+{
+   Array<int> workspace;
+   Array<int> a(1000);
+   a.HostReadWrite();
+   for (int i = 0; i < a.Size(); ++i)
+   {
+      a[i] = i;
+   }
+   const int expected = (a[0] + a[a.Size() - 1]) * a.Size() / 2;
+   auto dptr = a.Read();
+   auto sum = [&]()
+   {
+      int res = 0;
+      mfem::reduce(
+      a.Size(), res, [=] MFEM_HOST_DEVICE(int i, int &r) { r += dptr[i]; },
+      SumReducer<int> {}, true, workspace);
+      return res;
+   };
+
+   SECTION("Dynamic adjustment")
+   {
+      const int dynamic = omp_get_dynamic();
+      omp_set_dynamic(1);
+      const int res = sum();
+      omp_set_dynamic(dynamic);
+      REQUIRE(res == expected);
+   }
+
+   SECTION("Enclosing parallel region")
+   {
+      // Without nested parallelism the inner team has a single thread, while
+      // omp_get_max_threads() still reports the outer setting.
+      int res = 0;
+      #pragma omp parallel num_threads(2)
+      {
+         #pragma omp master
+         {
+            res = sum();
+         }
+      }
+      REQUIRE(res == expected);
+   }
+}
+#endif
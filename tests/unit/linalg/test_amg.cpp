@@ -0,0 +1,174 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace amg_test
+{
+
+// Assemble the diffusion matrix with coefficient @a kappa and eliminated
+// Dirichlet boundary conditions
+void AssembleDiffusion(FiniteElementSpace &fes, Coefficient &kappa,
+                       SparseMatrix &A)
+{
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(kappa));
+   a.Assemble();
+   a.Finalize();
+   Array<int> ess_bdr(fes.GetMesh()->bdr_attributes.Max()), ess_dofs;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_dofs);
+   a.SpMat().EliminateBC(ess_dofs, Operator::DIAG_ONE);
+   A.Swap(a.SpMat());
+}
+
+int SolveCG(const SparseMatrix &A, Solver &prec)
+{
+   CGSolver cg;
+   cg.SetOperator(A);
+   cg.SetPreconditioner(prec);
+   cg.SetRelTol(1e-10);
+   cg.SetMaxIter(200);
+   Vector b(A.Height()), x(A.Height());
+   b.Randomize(1);
+   x = 0.0;
+   cg.Mult(b, x);
+   REQUIRE(cg.GetConverged());
+   return cg.GetNumIterations();
+}
+
+} // namespace amg_test
+
+TEST_CASE("SmoothedAggregationAMG", "[AMG]")
+{
+   using namespace amg_test;
+
+   Mesh mesh = Mesh::MakeCartesian2D(48, 48, Element::QUADRILATERAL);
+   H1_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   ConstantCoefficient one(1.0);
+   SparseMatrix A;
+   AssembleDiffusion(fes, one, A);
+
+   SmoothedAggregationAMG amg(A);
+   REQUIRE(amg.GetNumLevels() > 2);
+   REQUIRE(amg.GetLevelMatrix(amg.GetNumLevels() - 1).Height() <= 200);
+   REQUIRE(amg.GetOperatorComplexity() < 2.0);
+
+   // Aggregates of several nodes
+   const SparseMatrix &P = amg.GetProlongation(0);
+   REQUIRE(P.Height() == A.Height());
+   REQUIRE(P.Width() == amg.GetLevelMatrix(1).Height());
+   REQUIRE(amg.GetLevelMatrix(1).Height() < A.Height()/4);
+
+   // The V-cycle is a symmetric preconditioner
+   Vector u(A.Height()), v(A.Height()), Mu(A.Height()), Mv(A.Height());
+   u.Randomize(2);
+   v.Randomize(3);
+   amg.Mult(u, Mu);
+   amg.Mult(v, Mv);
+   REQUIRE(Mu*v == MFEM_Approx(u*Mv));
+
+   REQUIRE(SolveCG(A, amg) < 30);
+
+   SECTION("Chebyshev smoother")
+   {
+      SmoothedAggregationAMG amg_cheb;
+      amg_cheb.SetSmoother(SmoothedAggregationAMG::SmootherType::CHEBYSHEV);
+      amg_cheb.SetOperator(A);
+      REQUIRE(SolveCG(A, amg_cheb) < 30);
+   }
+
+   SECTION("Setup reuse")
+   {
+      // Same sparsity, scaled values: the patterns of the hierarchy are kept,
+      // and the result is the same as with a new setup
+      SparseMatrix A2(A);
+      A2 *= 2.0;
+      const int *J_P = amg.GetProlongation(0).GetJ();
+      const int num_levels = amg.GetNumLevels();
+      amg.SetOperator(A2);
+      REQUIRE(amg.GetNumLevels() == num_levels);
+      REQUIRE(amg.GetProlongation(0).GetJ() == J_P);
+
+      SmoothedAggregationAMG amg2(A2);
+      Vector x(A.Height()), x2(A.Height());
+      amg.Mult(u, x);
+      amg2.Mult(u, x2);
+      x -= x2;
+      REQUIRE(x.Normlinf() == MFEM_Approx(0.0));
+
+      // Variable coefficient with the reused aggregates
+      FunctionCoefficient kappa([](const Vector &p)
+      {
+         return 1.0 + p(0)*p(1);
+      });
+      SparseMatrix A3;
+      AssembleDiffusion(fes, kappa, A3);
+      amg.SetOperator(A3);
+      REQUIRE(amg.GetProlongation(0).GetJ() == J_P);
+      REQUIRE(SolveCG(A3, amg) < 30);
+   }
+
+#ifdef MFEM_USE_SUITESPARSE
+   SECTION("Sparse coarse solvers")
+   {
+      for (auto type : {SmoothedAggregationAMG::CoarseSolverType::UMFPACK,
+                        SmoothedAggregationAMG::CoarseSolverType::KLU})
+      {
+         SmoothedAggregationAMG amg_sp;
+         amg_sp.SetCoarseSolver(type);
+         amg_sp.SetOperator(A);
+         Vector x(A.Height()), x_ref(A.Height());
+         amg_sp.Mult(u, x);
+         amg.Mult(u, x_ref);
+         x -= x_ref;
+         REQUIRE(x.Normlinf() == MFEM_Approx(0.0));
+      }
+   }
+#endif
+}
+
+TEST_CASE("SmoothedAggregationAMG LOR", "[AMG]")
+{
+   // Preconditioning of a high order problem with AMG on the LOR matrix
+   Mesh mesh = Mesh::MakeCartesian2D(8, 8, Element::QUADRILATERAL);
+   H1_FECollection fec(4, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_dofs;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_dofs);
+
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a.Assemble();
+   OperatorPtr A;
+   a.FormSystemMatrix(ess_dofs, A);
+
+   LORSolver<SmoothedAggregationAMG> lor_amg(a, ess_dofs);
+   REQUIRE(lor_amg.GetSolver().GetNumLevels() > 1);
+
+   CGSolver cg;
+   cg.SetOperator(*A);
+   cg.SetPreconditioner(lor_amg);
+   cg.SetRelTol(1e-8);
+   cg.SetMaxIter(200);
+   Vector b(A->Height()), x(A->Height());
+   b.Randomize(1);
+   x = 0.0;
+   cg.Mult(b, x);
+   REQUIRE(cg.GetConverged());
+   REQUIRE(cg.GetNumIterations() < 60);
+}
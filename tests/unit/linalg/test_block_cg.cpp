@@ -0,0 +1,236 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace block_cg
+{
+
+/// Solve A X = B column by column with CGSolver and all at once with
+/// BlockCGSolver, and compare the solutions.
+static void CompareWithCG(const Operator &A, Solver *M,
+                          const std::vector<Vector> &b,
+                          CGSolver &cg, BlockCGSolver &bcg,
+                          bool check_iter = true)
+{
+   const real_t tol = 1e-10;
+   IterativeSolver *solvers[] = {&cg, &bcg};
+   for (IterativeSolver *solver : solvers)
+   {
+      solver->SetRelTol(tol);
+      solver->SetAbsTol(0.0);
+      solver->SetMaxIter(1000);
+      solver->SetOperator(A);
+      if (M) { solver->SetPreconditioner(*M); }
+   }
+
+   const int nrhs = b.size();
+   std::vector<Vector> x(nrhs), x_cg(nrhs);
+   Array<const Vector *> B(nrhs);
+   Array<Vector *> X(nrhs);
+   int cg_iter = 0;
+   for (int j = 0; j < nrhs; j++)
+   {
+      x_cg[j].SetSize(A.Width());
+      x_cg[j] = 0.0;
+      cg.Mult(b[j], x_cg[j]);
+      REQUIRE(cg.GetConverged());
+      cg_iter = std::max(cg_iter, cg.GetNumIterations());
+
+      x[j].SetSize(A.Width());
+      x[j] = 0.0;
+      B[j] = &b[j];
+      X[j] = &x[j];
+   }
+
+   bcg.ArrayMult(B, X);
+   CAPTURE(cg_iter, bcg.GetNumIterations());
+   REQUIRE(bcg.GetConverged());
+   // The block Krylov space contains the Krylov spaces of all the columns
+   if (check_iter) { REQUIRE(bcg.GetNumIterations() <= cg_iter + 2); }
+
+   Vector r(A.Height());
+   for (int j = 0; j < nrhs; j++)
+   {
+      A.Mult(x[j], r);
+      subtract(b[j], r, r);
+      const real_t b_norm = sqrt(InnerProduct(b[j], b[j]));
+      REQUIRE(sqrt(InnerProduct(r, r)) <= 1e-7*b_norm);
+
+      x[j] -= x_cg[j];
+      const real_t x_norm = sqrt(InnerProduct(x_cg[j], x_cg[j]));
+      REQUIRE(sqrt(InnerProduct(x[j], x[j])) <= 1e-7*x_norm);
+   }
+}
+
+TEST_CASE("BlockCGSolver", "[BlockCGSolver]")
+{
+   const int order = GENERATE(1, 3);
+   const bool use_prec = GENERATE(false, true);
+   const int nrhs = GENERATE(1, 4);
+   CAPTURE(order, use_prec, nrhs);
+
+   Mesh mesh = Mesh::MakeCartesian2D(8, 8, Element::QUADRILATERAL);
+   H1_FECollection fec(order, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_tdof_list;
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   ConstantCoefficient one(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.AddDomainIntegrator(new MassIntegrator(one));
+   a.Assemble();
+   a.Finalize();
+   SparseMatrix A;
+   a.FormSystemMatrix(ess_tdof_list, A);
+
+   std::vector<Vector> b(nrhs);
+   for (int j = 0; j < nrhs; j++)
+   {
+      b[j].SetSize(A.Height());
+      b[j].Randomize(j + 1);
+      for (int i : ess_tdof_list) { b[j](i) = 0.0; }
+   }
+
+   DSmoother jacobi(A);
+   CGSolver cg;
+   BlockCGSolver bcg;
+   CompareWithCG(A, use_prec ? &jacobi : nullptr, b, cg, bcg);
+}
+
+TEST_CASE("BlockCGSolver Dependent Columns", "[BlockCGSolver]")
+{
+   const int n = 50;
+   SparseMatrix A(n, n);
+   for (int i = 0; i < n; i++)
+   {
+      A.Add(i, i, 2.0 + 0.1*i);
+      if (i > 0) { A.Add(i, i - 1, -1.0); }
+      if (i < n - 1) { A.Add(i, i + 1, -1.0); }
+   }
+   A.Finalize();
+
+   // The third column is a combination of the first two and the fourth one
+   // is zero, so the block becomes rank deficient and the columns are solved
+   // one at a time
+   std::vector<Vector> b(4);
+   for (Vector &v : b) { v.SetSize(n); }
+   b[0].Randomize(1);
+   b[1].Randomize(2);
+   add(2.0, b[0], -1.0, b[1], b[2]);
+   b[3] = 0.0;
+
+   mfem::out << "===> BEGIN: Expected BlockCG warning messages" << std::endl;
+   CGSolver cg;
+   BlockCGSolver bcg;
+   bcg.SetPrintLevel(IterativeSolver::PrintLevel().Warnings());
+   CompareWithCG(A, nullptr, b, cg, bcg, false);
+   mfem::out << "===> END: Expected BlockCG warning messages" << std::endl;
+}
+
+TEST_CASE("BlockCGSolver Indefinite", "[BlockCGSolver]")
+{
+   mfem::out << "===> BEGIN: Expected BlockCG warning messages" << std::endl;
+
+   SparseMatrix indefinite(2, 2);
+   indefinite.Add(0, 0, -1.0);
+   indefinite.Add(1, 1, 1.0);
+   indefinite.Finalize();
+
+   Vector v(2), x(2);
+   v = 1.0;
+   BlockCGSolver bcg;
+   bcg.SetOperator(indefinite);
+   bcg.SetPrintLevel(1);
+   x = 0.0;
+   bcg.Mult(v, x);
+   REQUIRE(!bcg.GetConverged());
+
+   mfem::out << "===> END: Expected BlockCG warning messages" << std::endl;
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("BlockCGSolver Parallel", "[BlockCGSolver][Parallel]")
+{
+   const int order = GENERATE(1, 2);
+   CAPTURE(order);
+
+   Mesh serial_mesh = Mesh::MakeCartesian3D(4, 4, 4, Element::HEXAHEDRON);
+   ParMesh mesh(MPI_COMM_WORLD, serial_mesh);
+   serial_mesh.Clear();
+   H1_FECollection fec(order, mesh.Dimension());
+   ParFiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_tdof_list;
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   // A partially assembled operator, with a batched action
+   ConstantCoefficient one(1.0);
+   ParBilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a.Assemble();
+   OperatorPtr A;
+   a.FormSystemMatrix(ess_tdof_list, A);
+
+   const int nrhs = 3;
+   std::vector<Vector> b(nrhs), x(nrhs), x_cg(nrhs);
+   Array<const Vector *> B(nrhs);
+   Array<Vector *> X(nrhs);
+   for (int j = 0; j < nrhs; j++)
+   {
+      b[j].SetSize(A->Height());
+      b[j].Randomize(j + 1 + Mpi::WorldRank());
+      for (int i : ess_tdof_list) { b[j](i) = 0.0; }
+      x[j].SetSize(A->Width());
+      x[j] = 0.0;
+      x_cg[j].SetSize(A->Width());
+      B[j] = &b[j];
+      X[j] = &x[j];
+   }
+
+   CGSolver cg(MPI_COMM_WORLD);
+   BlockCGSolver bcg(MPI_COMM_WORLD);
+   const real_t tol = 1e-10;
+   IterativeSolver *solvers[] = {&cg, &bcg};
+   for (IterativeSolver *solver : solvers)
+   {
+      solver->SetRelTol(tol);
+      solver->SetMaxIter(1000);
+      solver->SetOperator(*A);
+   }
+
+   bcg.ArrayMult(B, X);
+   REQUIRE(bcg.GetConverged());
+   for (int j = 0; j < nrhs; j++)
+   {
+      x_cg[j] = 0.0;
+      cg.Mult(b[j], x_cg[j]);
+      REQUIRE(cg.GetConverged());
+      x[j] -= x_cg[j];
+      const real_t err = sqrt(InnerProduct(MPI_COMM_WORLD, x[j], x[j]));
+      const real_t x_norm =
+         sqrt(InnerProduct(MPI_COMM_WORLD, x_cg[j], x_cg[j]));
+      REQUIRE(err <= 1e-7*x_norm);
+   }
+}
+
+#endif // MFEM_USE_MPI
+
+} // namespace block_cg
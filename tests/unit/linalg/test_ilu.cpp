@@ -169,3 +169,57 @@ TEST_CASE("ILU Factorization", "[ILU]")
    REQUIRE(AB(0,1,6) == MFEM_Approx(-9.4));
    REQUIRE(AB(1,1,6) == MFEM_Approx(22552.0/245.0));
 }
+
+TEST_CASE("ILU Triangular Solves", "[ILU]")
+{
+   // DG matrix with one block row per element, in lexicographic order
+   const int nx = 5, ny = 4;
+   Mesh mesh = Mesh::MakeCartesian2D(nx, ny, Element::QUADRILATERAL, false,
+                                     1.0, 1.0, false);
+   DG_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   ConstantCoefficient one(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new MassIntegrator(one));
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.AddInteriorFaceIntegrator(new DGDiffusionIntegrator(one, -1.0, 4.0));
+   a.Assemble();
+   a.Finalize();
+   const SparseMatrix &A = a.SpMat();
+   const int bs = fes.GetFE(0)->GetDof();
+
+   // In the natural ordering, element (i,j) depends on (i-1,j) and (i,j-1)
+   BlockILU ilu_none(A, bs, BlockILU::Reordering::NONE);
+   REQUIRE(ilu_none.GetNumLevels() == nx + ny - 1);
+
+   BlockILU ilu(A, bs);
+   REQUIRE(ilu.GetNumLevels() <= mesh.GetNE());
+   Vector b(A.Height()), x(A.Width()), x_ref(A.Width());
+   b.Randomize(1);
+   ilu.Mult(b, x_ref);
+
+   // Level scheduling gives the exact triangular solves
+   ilu.SetTriangularSolve(BlockILU::TriangularSolve::LEVEL_SCHEDULED);
+   ilu.Mult(b, x);
+   x -= x_ref;
+   REQUIRE(x.Normlinf() == MFEM_Approx(0.0));
+
+   // The Jacobi iterations are exact after one iteration per level, since the
+   // strictly triangular parts are nilpotent
+   ilu.SetTriangularSolve(BlockILU::TriangularSolve::JACOBI, mesh.GetNE());
+   ilu.Mult(b, x);
+   x -= x_ref;
+   REQUIRE(x.Normlinf() == MFEM_Approx(0.0));
+
+   // A few Jacobi iterations still give a good preconditioner
+   ilu.SetTriangularSolve(BlockILU::TriangularSolve::JACOBI, 2);
+   GMRESSolver gmres;
+   gmres.SetOperator(A);
+   gmres.SetPreconditioner(ilu);
+   gmres.SetRelTol(1e-10);
+   gmres.SetMaxIter(100);
+   gmres.SetKDim(100);
+   x = 0.0;
+   gmres.Mult(b, x);
+   REQUIRE(gmres.GetConverged());
+}
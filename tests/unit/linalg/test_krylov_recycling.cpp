@@ -0,0 +1,168 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace krylov_recycling
+{
+
+static void velocity(const Vector &x, Vector &v)
+{
+   v(0) = 20.0*x(1);
+   v(1) = -20.0*x(0) + 5.0;
+}
+
+/** Assemble the diffusion matrix, plus the convection matrix with the given
+    scaling of the velocity, with eliminated Dirichlet boundary conditions. */
+void Assemble(FiniteElementSpace &fes, real_t convection, SparseMatrix &A)
+{
+   ConstantCoefficient one(1.0);
+   VectorFunctionCoefficient vel(2, velocity);
+   ScalarVectorProductCoefficient scaled_vel(convection, vel);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   if (convection != 0.0)
+   {
+      a.AddDomainIntegrator(new ConvectionIntegrator(scaled_vel));
+   }
+   a.Assemble();
+   a.Finalize();
+   Array<int> ess_bdr(fes.GetMesh()->bdr_attributes.Max()), ess_dofs;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_dofs);
+   a.SpMat().EliminateBC(ess_dofs, Operator::DIAG_ONE);
+   A.Swap(a.SpMat());
+}
+
+/// Solve A x = b for a random b and return the number of iterations.
+int Solve(IterativeSolver &solver, const SparseMatrix &A, int seed)
+{
+   Vector b(A.Height()), x(A.Height()), r(A.Height());
+   b.Randomize(seed);
+   x = 0.0;
+   solver.Mult(b, x);
+   REQUIRE(solver.GetConverged());
+   A.Mult(x, r);
+   r -= b;
+   REQUIRE(r.Norml2() <= 1e-7*b.Norml2());
+   return solver.GetNumIterations();
+}
+
+} // namespace krylov_recycling
+
+TEST_CASE("DeflatedCGSolver", "[DeflatedCGSolver]")
+{
+   using namespace krylov_recycling;
+
+   Mesh mesh = Mesh::MakeCartesian2D(32, 32, Element::QUADRILATERAL);
+   H1_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   SparseMatrix A;
+   Assemble(fes, 0.0, A);
+   DSmoother jacobi(A);
+
+   CGSolver cg;
+   cg.SetOperator(A);
+   cg.SetPreconditioner(jacobi);
+   cg.SetRelTol(1e-10);
+   cg.SetMaxIter(500);
+
+   DeflatedCGSolver dcg;
+   dcg.SetOperator(A);
+   dcg.SetPreconditioner(jacobi);
+   dcg.SetRelTol(1e-10);
+   dcg.SetMaxIter(500);
+   dcg.SetRecycleDim(20, 80);
+
+   // Without recycled subspace, the first solve is a PCG solve
+   const int it_cg = Solve(cg, A, 1);
+   REQUIRE(std::abs(Solve(dcg, A, 1) - it_cg) <= 1);
+   REQUIRE(dcg.GetRecycleDim() == 20);
+
+   // The recycled subspace improves over the sequence of right-hand sides
+   int it_dcg = 0;
+   for (int seed = 2; seed <= 5; seed++) { it_dcg = Solve(dcg, A, seed); }
+   REQUIRE(it_dcg < 0.75*Solve(cg, A, 5));
+
+   // The subspace is kept for a new operator of the same size
+   SparseMatrix A2(A);
+   A2 *= 1.5;
+   dcg.SetOperator(A2);
+   REQUIRE(dcg.GetRecycleDim() == 20);
+   cg.SetOperator(A2);
+   REQUIRE(Solve(dcg, A2, 6) < 0.75*Solve(cg, A2, 6));
+
+   dcg.ClearRecycleSpace();
+   REQUIRE(dcg.GetRecycleDim() == 0);
+   REQUIRE(std::abs(Solve(dcg, A2, 6) - Solve(cg, A2, 6)) <= 1);
+}
+
+TEST_CASE("GCRODRSolver", "[GCRODRSolver]")
+{
+   using namespace krylov_recycling;
+   const bool use_prec = GENERATE(false, true);
+   CAPTURE(use_prec);
+
+   Mesh mesh = Mesh::MakeCartesian2D(16, 16, Element::QUADRILATERAL);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   SparseMatrix A;
+   Assemble(fes, 1.0, A);
+   DSmoother jacobi(A);
+
+   GMRESSolver gmres;
+   gmres.SetOperator(A);
+   gmres.SetKDim(30);
+   gmres.SetRelTol(1e-10);
+   gmres.SetMaxIter(2000);
+
+   GCRODRSolver gcrodr;
+   gcrodr.SetOperator(A);
+   gcrodr.SetKDim(30);
+   gcrodr.SetRecycleDim(10);
+   gcrodr.SetRelTol(1e-10);
+   gcrodr.SetMaxIter(2000);
+   if (use_prec)
+   {
+      gmres.SetPreconditioner(jacobi);
+      gcrodr.SetPreconditioner(jacobi);
+   }
+
+   // The deflated restarts already improve over GMRES(m)
+   const int it_gmres = Solve(gmres, A, 1);
+   const int it_first = Solve(gcrodr, A, 1);
+   REQUIRE(it_first < it_gmres);
+   REQUIRE(gcrodr.GetRecycleDim() == 10);
+
+   // The recycled subspace speeds up the next solves
+   REQUIRE(Solve(gcrodr, A, 2) < it_first);
+
+   // Modified operator: C = A U is recomputed
+   SparseMatrix A2;
+   Assemble(fes, 1.2, A2);
+   DSmoother jacobi2(A2);
+   gcrodr.SetOperator(A2);
+   gmres.SetOperator(A2);
+   if (use_prec)
+   {
+      gcrodr.SetPreconditioner(jacobi2);
+      gmres.SetPreconditioner(jacobi2);
+   }
+   REQUIRE(gcrodr.GetRecycleDim() == 10);
+   REQUIRE(Solve(gcrodr, A2, 3) < Solve(gmres, A2, 3));
+
+   gcrodr.ClearRecycleSpace();
+   REQUIRE(gcrodr.GetRecycleDim() == 0);
+   REQUIRE(Solve(gcrodr, A2, 4) <= Solve(gmres, A2, 4));
+}
@@ -0,0 +1,238 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace lowsync_gmres
+{
+
+static void velocity(const Vector &x, Vector &v)
+{
+   v(0) = 20.0*x(1);
+   v(1) = -20.0*x(0) + 5.0;
+}
+
+/// Assemble a nonsymmetric advection-diffusion problem
+template <typename FES, typename BF, typename LF, typename MAT>
+static void Assemble(FES &fes, BF &a, LF &b, MAT &A, Vector &X, Vector &B)
+{
+   Array<int> ess_tdof_list;
+   Array<int> ess_bdr(fes.GetMesh()->bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   static ConstantCoefficient one(1.0);
+   static VectorFunctionCoefficient vel(2, velocity);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.AddDomainIntegrator(new ConvectionIntegrator(vel));
+   a.Assemble();
+
+   Vector x(fes.GetVSize());
+   x = 0.0;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+}
+
+TEST_CASE("LowSyncGMRESSolver", "[LowSyncGMRESSolver]")
+{
+   const bool flexible = GENERATE(false, true);
+   const bool use_prec = GENERATE(false, true);
+   const int kdim = GENERATE(10, 200);
+   CAPTURE(flexible, use_prec, kdim);
+
+   Mesh mesh = Mesh::MakeCartesian2D(12, 12, Element::QUADRILATERAL);
+   H1_FECollection fec(2, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+   BilinearForm a(&fes);
+   LinearForm b(&fes);
+   SparseMatrix A;
+   Vector X, B;
+   Assemble(fes, a, b, A, X, B);
+
+   const real_t tol = 1e-10;
+   DSmoother jacobi(A);
+   std::unique_ptr<IterativeSolver> ref;
+   if (flexible) { ref.reset(new FGMRESSolver); }
+   else { ref.reset(new GMRESSolver); }
+   LowSyncGMRESSolver gmres;
+   gmres.SetFlexible(flexible);
+   IterativeSolver *solvers[] = {ref.get(), &gmres};
+   for (IterativeSolver *solver : solvers)
+   {
+      solver->SetRelTol(tol);
+      solver->SetAbsTol(0.0);
+      solver->SetMaxIter(2000);
+      solver->SetOperator(A);
+      if (use_prec) { solver->SetPreconditioner(jacobi); }
+   }
+   if (flexible) { static_cast<FGMRESSolver&>(*ref).SetKDim(kdim); }
+   else { static_cast<GMRESSolver&>(*ref).SetKDim(kdim); }
+   gmres.SetKDim(kdim);
+
+   Vector x_ref(B.Size()), x(B.Size());
+   x_ref = 0.0;
+   ref->Mult(B, x_ref);
+   REQUIRE(ref->GetConverged());
+
+   x = 0.0;
+   gmres.Mult(B, x);
+   CAPTURE(ref->GetNumIterations(), gmres.GetNumIterations());
+   REQUIRE(gmres.GetConverged());
+   REQUIRE(gmres.GetInitialNorm() == MFEM_Approx(ref->GetInitialNorm()));
+   // Same Krylov spaces in exact arithmetic
+   const int diff = std::abs(gmres.GetNumIterations() -
+                             ref->GetNumIterations());
+   REQUIRE(diff <= std::max(2, ref->GetNumIterations()/20));
+
+   // The true residual of the solution
+   Vector r(B.Size());
+   A.Mult(x, r);
+   subtract(B, r, r);
+   if (!flexible && use_prec)
+   {
+      Vector Br(B.Size()), BB(B.Size());
+      jacobi.Mult(r, Br);
+      jacobi.Mult(B, BB);
+      REQUIRE(Br.Norml2() <= 10*tol*BB.Norml2());
+   }
+   else
+   {
+      REQUIRE(r.Norml2() <= 10*tol*B.Norml2());
+   }
+
+   x -= x_ref;
+   REQUIRE(x.Norml2() <= 1e-6*x_ref.Norml2());
+}
+
+TEST_CASE("LowSyncGMRESSolver Iterative Mode", "[LowSyncGMRESSolver]")
+{
+   // A diagonal matrix, with an invariant Krylov space of dimension 3
+   const int n = 30;
+   SparseMatrix A(n, n);
+   for (int i = 0; i < n; i++) { A.Add(i, i, 1.0 + (i % 3)); }
+   A.Finalize();
+   Vector b(n), x(n);
+   b.Randomize(1);
+
+   LowSyncGMRESSolver gmres;
+   gmres.SetOperator(A);
+   gmres.SetRelTol(1e-12);
+   gmres.SetMaxIter(100);
+   x = 0.0;
+   gmres.Mult(b, x);
+   REQUIRE(gmres.GetConverged());
+   REQUIRE(gmres.GetNumIterations() <= 3);
+
+   // Starting from the solution, no iterations are needed
+   gmres.iterative_mode = true;
+   gmres.SetAbsTol(1e-10);
+   gmres.Mult(b, x);
+   REQUIRE(gmres.GetConverged());
+   REQUIRE(gmres.GetNumIterations() == 0);
+
+   Vector r(n);
+   A.Mult(x, r);
+   r -= b;
+   REQUIRE(r.Norml2() <= 1e-10);
+}
+
+TEST_CASE("LowSyncGMRESSolver Breakdown", "[LowSyncGMRESSolver]")
+{
+   // With an unreachable tolerance, the Krylov space of dimension 3 of this
+   // operator is exhausted and the iteration stops without aborting
+   const int n = 30;
+   SparseMatrix A(n, n);
+   for (int i = 0; i < n; i++) { A.Add(i, i, 1.0 + (i % 3)); }
+   A.Finalize();
+   Vector b(n), x(n), r(n);
+   b.Randomize(1);
+
+   LowSyncGMRESSolver gmres;
+   gmres.SetOperator(A);
+   gmres.SetKDim(5);
+   gmres.SetRelTol(0.0);
+   gmres.SetAbsTol(0.0);
+   gmres.SetMaxIter(100);
+   x = 0.0;
+   gmres.Mult(b, x);
+   REQUIRE(gmres.GetNumIterations() < 100);
+
+   // The final norm is the norm of the true residual
+   A.Mult(x, r);
+   subtract(b, r, r);
+   REQUIRE(gmres.GetFinalNorm() == MFEM_Approx(r.Norml2()));
+   REQUIRE(r.Norml2() <= 1e-12*b.Norml2());
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("LowSyncGMRESSolver Parallel", "[LowSyncGMRESSolver][Parallel]")
+{
+   const bool flexible = GENERATE(false, true);
+   CAPTURE(flexible);
+
+   Mesh serial_mesh = Mesh::MakeCartesian2D(12, 12, Element::QUADRILATERAL);
+   ParMesh mesh(MPI_COMM_WORLD, serial_mesh);
+   serial_mesh.Clear();
+   H1_FECollection fec(2, mesh.Dimension());
+   ParFiniteElementSpace fes(&mesh, &fec);
+   ParBilinearForm a(&fes);
+   ParLinearForm b(&fes);
+   HypreParMatrix A;
+   Vector X, B;
+   Assemble(fes, a, b, A, X, B);
+
+   const real_t tol = 1e-10;
+   HypreSmoother jacobi(A, HypreSmoother::Jacobi);
+   FGMRESSolver fgmres(MPI_COMM_WORLD);
+   GMRESSolver gmres(MPI_COMM_WORLD);
+   IterativeSolver &ref = flexible ? (IterativeSolver&)fgmres : gmres;
+   LowSyncGMRESSolver lsgmres(MPI_COMM_WORLD);
+   lsgmres.SetFlexible(flexible);
+   IterativeSolver *solvers[] = {&ref, &lsgmres};
+   for (IterativeSolver *solver : solvers)
+   {
+      solver->SetRelTol(tol);
+      solver->SetMaxIter(2000);
+      solver->SetOperator(A);
+      solver->SetPreconditioner(jacobi);
+   }
+   fgmres.SetKDim(20);
+   gmres.SetKDim(20);
+   lsgmres.SetKDim(20);
+
+   Vector x_ref(B.Size()), x(B.Size());
+   x_ref = 0.0;
+   ref.Mult(B, x_ref);
+   REQUIRE(ref.GetConverged());
+
+   x = 0.0;
+   lsgmres.Mult(B, x);
+   CAPTURE(ref.GetNumIterations(), lsgmres.GetNumIterations());
+   REQUIRE(lsgmres.GetConverged());
+   REQUIRE(lsgmres.GetInitialNorm() == MFEM_Approx(ref.GetInitialNorm()));
+   const int diff = std::abs(lsgmres.GetNumIterations() -
+                             ref.GetNumIterations());
+   REQUIRE(diff <= std::max(2, ref.GetNumIterations()/20));
+
+   x -= x_ref;
+   const real_t err = sqrt(InnerProduct(MPI_COMM_WORLD, x, x));
+   const real_t x_norm = sqrt(InnerProduct(MPI_COMM_WORLD, x_ref, x_ref));
+   REQUIRE(err <= 1e-6*x_norm);
+}
+
+#endif // MFEM_USE_MPI
+
+} // namespace lowsync_gmres
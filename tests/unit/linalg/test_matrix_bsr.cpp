@@ -0,0 +1,226 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+TEST_CASE("BSRMatrix", "[BSRMatrix]")
+{
+   auto dim = GENERATE(2, 3);
+   auto ordering = GENERATE(Ordering::byNODES, Ordering::byVDIM);
+   CAPTURE(dim, ordering);
+
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(4, 3, Element::TRIANGLE) :
+               Mesh::MakeCartesian3D(2, 3, 2, Element::HEXAHEDRON);
+   H1_FECollection fec(2, dim);
+   FiniteElementSpace fes(&mesh, &fec, dim, ordering);
+   const bool byvdim = (ordering == Ordering::byVDIM);
+
+   ConstantCoefficient lambda(2.0), mu(1.0), one(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new ElasticityIntegrator(lambda, mu));
+   a.AddBoundaryIntegrator(new VectorMassIntegrator(one));
+   a.Assemble();
+   a.Finalize();
+   const SparseMatrix &A = a.SpMat();
+
+   BSRMatrix B;
+   a.AssembleBSR(B);
+   REQUIRE(B.BlockSize() == dim);
+   REQUIRE(B.NumBlockRows() == fes.GetNDofs());
+   REQUIRE(B.Height() == A.Height());
+   REQUIRE(B.IsByVDim() == byvdim);
+   // One column index per block instead of one per entry
+   REQUIRE(B.NumBlocks()*dim*dim >= A.NumNonZeroElems());
+   REQUIRE(B.GetBlockJ().Size() == B.NumBlocks());
+
+   // Same entries as the SparseMatrix with the same numbering
+   std::unique_ptr<SparseMatrix> B_sp(B.ToSparseMatrix());
+   B_sp->Add(-1.0, A);
+   REQUIRE(B_sp->MaxNorm() == MFEM_Approx(0.0));
+
+   // Conversion from the SparseMatrix gives the same blocks
+   BSRMatrix C(A, dim, byvdim);
+   REQUIRE(C.NumBlocks() == B.NumBlocks());
+   Vector diff(B.GetBlockData().Size());
+   for (int k = 0; k < diff.Size(); k++)
+   {
+      diff(k) = B.GetBlockData()[k] - C.GetBlockData()[k];
+   }
+   REQUIRE(diff.Normlinf() == MFEM_Approx(0.0));
+
+   // Products
+   Vector x(A.Width()), y(A.Height()), y_ref(A.Height());
+   x.Randomize(1);
+   A.Mult(x, y_ref);
+   y.Randomize(2);
+   B.Mult(x, y);
+   y -= y_ref;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+   y = y_ref;
+   B.AddMult(x, y, -0.5);
+   y.Add(-0.5, y_ref);
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+   A.MultTranspose(x, y_ref);
+   B.MultTranspose(x, y);
+   y -= y_ref;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+
+   // Diagonal and diagonal blocks
+   Vector d, d_ref;
+   B.AssembleDiagonal(d);
+   A.GetDiag(d_ref);
+   d -= d_ref;
+   REQUIRE(d.Normlinf() == MFEM_Approx(0.0));
+   DenseTensor D;
+   B.GetDiagonalBlocks(D);
+   REQUIRE(D.SizeK() == fes.GetNDofs());
+   for (int i = 0; i < fes.GetNDofs(); i++)
+   {
+      for (int c = 0; c < dim; c++)
+      {
+         for (int e = 0; e < dim; e++)
+         {
+            const int r = fes.DofToVDof(i, c), s = fes.DofToVDof(i, e);
+            REQUIRE(D(c, e, i) == MFEM_Approx(A(r, s)));
+         }
+      }
+   }
+
+   // Re-assembly reuses the sparsity
+   const int *J = B.GetBlockJ().GetData();
+   a.AssembleBSR(B);
+   REQUIRE(B.GetBlockJ().GetData() == J);
+   B.Mult(x, y);
+   A.Mult(x, y_ref);
+   y -= y_ref;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+
+   // Elimination of essential dofs
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_vdofs;
+   ess_bdr = 0;
+   ess_bdr[0] = 1;
+   fes.GetEssentialVDofs(ess_bdr, ess_vdofs);
+   Array<int> ess_dofs;
+   FiniteElementSpace::MarkerToList(ess_vdofs, ess_dofs);
+   SparseMatrix A_elim(A);
+   A_elim.EliminateBC(ess_dofs, Operator::DIAG_ONE);
+   B.EliminateBC(ess_dofs, Operator::DIAG_ONE);
+   B.Mult(x, y);
+   A_elim.Mult(x, y_ref);
+   y -= y_ref;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+}
+
+TEST_CASE("BSRMatrix Space Update", "[BSRMatrix]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(4, 3, Element::TRIANGLE);
+   // With nodes, ReorderElements() updates the sequence of the mesh
+   mesh.EnsureNodes();
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec, 2, Ordering::byVDIM);
+   ConstantCoefficient one(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new ElasticityIntegrator(one, one));
+   BSRMatrix B;
+   a.AssembleBSR(B);
+
+   // Reordering the mesh changes the connectivity, but not the size
+   Array<int> ordering;
+   mesh.GetHilbertElementOrdering(ordering);
+   mesh.ReorderElements(ordering);
+   fes.Update();
+   a.Update();
+   a.Assemble();
+   a.Finalize();
+   REQUIRE(B.NumBlockRows() == fes.GetNDofs());
+
+   a.AssembleBSR(B);
+   std::unique_ptr<SparseMatrix> B_sp(B.ToSparseMatrix());
+   B_sp->Add(-1.0, a.SpMat());
+   REQUIRE(B_sp->MaxNorm() == MFEM_Approx(0.0));
+}
+
+TEST_CASE("BSRMatrix BlockILU", "[BSRMatrix]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(6, 6, Element::QUADRILATERAL);
+   H1_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec, 2, Ordering::byVDIM);
+
+   ConstantCoefficient lambda(1.0), mu(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new ElasticityIntegrator(lambda, mu));
+   a.Assemble();
+   a.Finalize();
+
+   BSRMatrix B;
+   a.AssembleBSR(B);
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_dofs;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_dofs);
+   B.EliminateBC(ess_dofs);
+   SparseMatrix &A = a.SpMat();
+   A.EliminateBC(ess_dofs, Operator::DIAG_ONE);
+
+   BlockILU ilu_bsr(B, 2), ilu_sp(A, 2);
+   Vector b(A.Height()), x(A.Width()), x_ref(A.Width());
+   b.Randomize(1);
+   ilu_bsr.Mult(b, x);
+   ilu_sp.Mult(b, x_ref);
+   x -= x_ref;
+   REQUIRE(x.Normlinf() == MFEM_Approx(0.0));
+
+   // The BSRMatrix is an Operator for the Krylov solvers
+   CGSolver cg;
+   cg.SetOperator(B);
+   cg.SetRelTol(1e-12);
+   cg.SetMaxIter(500);
+   x = 0.0;
+   cg.Mult(b, x);
+   REQUIRE(cg.GetConverged());
+   Vector r(A.Height());
+   A.Mult(x, r);
+   r -= b;
+   REQUIRE(r.Norml2() <= 1e-10*b.Norml2());
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("BSRMatrix Parallel", "[BSRMatrix][Parallel]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(6, 6, Element::QUADRILATERAL);
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   H1_FECollection fec(2, 2);
+   ParFiniteElementSpace fes(&pmesh, &fec, 2);
+
+   ConstantCoefficient lambda(1.0), mu(1.0);
+   ParBilinearForm a(&fes);
+   a.AddDomainIntegrator(new ElasticityIntegrator(lambda, mu));
+   a.Assemble();
+   a.Finalize();
+   std::unique_ptr<HypreParMatrix> A(a.ParallelAssemble());
+
+   BSRMatrix B;
+   a.AssembleBSR(B);
+   std::unique_ptr<HypreParMatrix> A_bsr(a.ParallelAssemble(B));
+
+   Vector x(A->Width()), y(A->Height()), y_ref(A->Height());
+   x.Randomize(1);
+   A->Mult(x, y_ref);
+   A_bsr->Mult(x, y);
+   y -= y_ref;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+}
+
+#endif // MFEM_USE_MPI
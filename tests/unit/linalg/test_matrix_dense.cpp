@@ -12,6 +12,7 @@
 #include "mfem.hpp"
 #include "unit_tests.hpp"
 #include "linalg/dtensor.hpp"
+#include "linalg/batched/simd.hpp"
 
 using namespace mfem;
 
@@ -363,7 +364,8 @@ TEST_CASE("Batched Linear Algebra",
 {
    auto backend = GENERATE(BatchedLinAlg::NATIVE,
                            BatchedLinAlg::GPU_BLAS,
-                           BatchedLinAlg::MAGMA);
+                           BatchedLinAlg::MAGMA,
+                           BatchedLinAlg::SIMD);
    // Skip unavailable backends
    if (!BatchedLinAlg::IsAvailable(backend)) { return; }
    CAPTURE(backend);
@@ -465,6 +467,61 @@ TEST_CASE("Batched Linear Algebra",
    }
 }
 
+TEST_CASE("Batched Linear Algebra SIMD", "[DenseMatrix]")
+{
+   // Compare with the native backend, with a number of matrices that is not a
+   // multiple of the SIMD width, and matrices that need pivoting
+   const BatchedLinAlgBase &simd = BatchedLinAlg::Get(BatchedLinAlg::SIMD);
+   const BatchedLinAlgBase &native = BatchedLinAlg::Get(BatchedLinAlg::NATIVE);
+
+   auto n = GENERATE(1, 8, 13);
+   CAPTURE(n);
+   const int n_mat = 3*SIMDBatchedLinAlg::lanes + 1;
+   // Enough right-hand sides for the vectorized solve
+   const int n_rhs = SIMDBatchedLinAlg::lanes + 1;
+
+   DenseTensor A(n, n, n_mat);
+   A.HostWrite();
+   for (int e = 0; e < n_mat; e++)
+   {
+      Vector A_e(A.Data() + e*n*n, n*n);
+      A_e.Randomize(e + 1);
+      // Small diagonal, the pivots are not on the diagonal
+      for (int i = 0; i < n; i++) { A(i, i, e) *= 1e-3; }
+   }
+
+   DenseTensor LU(A), LU_ref(A);
+   Array<int> P, P_ref;
+   simd.LUFactor(LU, P);
+   native.LUFactor(LU_ref, P_ref);
+   for (int i = 0; i < P.Size(); i++) { REQUIRE(P[i] == P_ref[i]); }
+   Vector d(LU.Data(), LU.TotalSize()), d_ref(LU_ref.Data(), LU.TotalSize());
+   d -= d_ref;
+   REQUIRE(d.Normlinf() == MFEM_Approx(0.0));
+
+   Vector x(n*n_rhs*n_mat), y(x.Size()), y_ref(x.Size());
+   x.Randomize(1);
+   y = x;
+   y_ref = x;
+   simd.LUSolve(LU_ref, P_ref, y);
+   native.LUSolve(LU_ref, P_ref, y_ref);
+   y -= y_ref;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+
+   DenseTensor A_inv(A), A_inv_ref(A);
+   simd.Invert(A_inv);
+   native.Invert(A_inv_ref);
+   for (int e = 0; e < n_mat; e++)
+   {
+      DenseMatrix I(n);
+      Mult(A(e), A_inv(e), I);
+      for (int i = 0; i < n; i++) { I(i, i) -= 1.0; }
+      REQUIRE(I.MaxMaxNorm() == MFEM_Approx(0.0, 1e-10));
+      A_inv(e) -= A_inv_ref(e);
+      REQUIRE(A_inv(e).MaxMaxNorm() == MFEM_Approx(0.0, 1e-10));
+   }
+}
+
 TEST_CASE("DenseTensor copy", "[DenseMatrix][DenseTensor]")
 {
    DenseTensor t1(2,3,4);
@@ -78,6 +78,123 @@ TEST_CASE("SparseMatrixAbsMult", "[SparseMatrixAbsMult]")
    }
 }
 
+TEST_CASE("SellMatrix", "[SparseMatrix]")
+{
+   // A rectangular matrix with rows of different lengths
+   auto order = GENERATE(1, 3);
+   auto sigma = GENERATE(1, 64, 1 << 20);
+   CAPTURE(order, sigma);
+
+   Mesh mesh = Mesh::MakeCartesian2D(5, 7, Element::TRIANGLE);
+   H1_FECollection trial_fec(order, 2), test_fec(order + 1, 2);
+   FiniteElementSpace trial_fes(&mesh, &trial_fec), test_fes(&mesh, &test_fec);
+   MixedBilinearForm a(&trial_fes, &test_fes);
+   a.AddDomainIntegrator(new MixedScalarMassIntegrator);
+   a.Assemble();
+   a.Finalize();
+   const SparseMatrix &A = a.SpMat();
+
+   SellMatrix S(A, sigma);
+   REQUIRE(S.Height() == A.Height());
+   REQUIRE(S.Width() == A.Width());
+   REQUIRE(S.GetSigma() % SellMatrix::chunk_size == 0);
+   REQUIRE(S.NumStoredEntries() >= A.NumNonZeroElems());
+   REQUIRE(S.NumStoredEntries() % SellMatrix::chunk_size == 0);
+
+   Vector x(A.Width()), y(A.Height()), y_ref(A.Height());
+   x.Randomize(1);
+   A.Mult(x, y_ref);
+   y.Randomize(2);
+   S.Mult(x, y);
+   y -= y_ref;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+
+   y = y_ref;
+   S.AddMult(x, y, -2.0);
+   y += y_ref;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+
+   Vector xt(A.Height()), yt(A.Width()), yt_ref(A.Width());
+   xt.Randomize(3);
+   A.MultTranspose(xt, yt_ref);
+   yt.Randomize(4);
+   S.MultTranspose(xt, yt);
+   yt -= yt_ref;
+   REQUIRE(yt.Normlinf() == MFEM_Approx(0.0));
+
+   yt = yt_ref;
+   S.AddMultTranspose(xt, yt, 0.5);
+   yt.Add(-1.5, yt_ref);
+   REQUIRE(yt.Normlinf() == MFEM_Approx(0.0));
+
+   // Sorting within larger windows reduces the padding
+   if (sigma > 1)
+   {
+      SellMatrix S1(A, 1);
+      REQUIRE(S.GetEfficiency() >= S1.GetEfficiency());
+   }
+}
+
+TEST_CASE("SparseMatrix SELL Format", "[SparseMatrix]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(16, 16, Element::QUADRILATERAL);
+   H1_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.Assemble();
+   a.Finalize();
+   SparseMatrix &A = a.SpMat();
+   REQUIRE(SellMatrix::IsBeneficial(A));
+
+   Vector x(A.Width()), y(A.Height()), y_ref(A.Height());
+   x.Randomize(1);
+   A.Mult(x, y_ref);
+   REQUIRE(!A.UsesSellFormat());
+
+   A.UseSellFormat();
+   const bool uses_sell = !Device::Allows(~Backend::CPU_MASK);
+   REQUIRE(A.UsesSellFormat() == uses_sell);
+   A.Mult(x, y);
+   y -= y_ref;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+   A.MultTranspose(x, y);
+   y -= y_ref; // A is symmetric
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+
+   // Solvers only calling Mult() use the SELL-C-sigma format transparently
+   Vector b(A.Height()), u(A.Width());
+   b.Randomize(2);
+   for (int i = 0; i < A.Height(); i++)
+   {
+      A(i, i) += 1.0; // regularize the Neumann problem
+   }
+   A.ResetSellFormat();
+   DSmoother jacobi(A);
+   CGSolver cg;
+   cg.SetOperator(A);
+   cg.SetPreconditioner(jacobi);
+   cg.SetRelTol(1e-12);
+   cg.SetMaxIter(500);
+   u = 0.0;
+   cg.Mult(b, u);
+   REQUIRE(cg.GetConverged());
+   REQUIRE(A.UsesSellFormat() == uses_sell);
+   A.UseSellFormat(false);
+   REQUIRE(!A.UsesSellFormat());
+   Vector r(A.Height());
+   A.Mult(u, r);
+   r -= b;
+   REQUIRE(r.Norml2() <= 1e-10*b.Norml2());
+
+   // Small matrices keep the CSR format
+   SparseMatrix small(4, 4);
+   for (int i = 0; i < 4; i++) { small.Add(i, i, 1.0); }
+   small.Finalize();
+   small.UseSellFormat();
+   REQUIRE(!small.UsesSellFormat());
+}
+
 TEST_CASE("SparseMatrix printing", "[SparseMatrix]")
 {
    // Create a test sparse matrix and print it using different methods
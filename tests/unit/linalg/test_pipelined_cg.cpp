@@ -0,0 +1,217 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace pipelined_cg
+{
+
+/// Counts the calls to the monitor, and records the last residual norm.
+class CountingMonitor : public IterativeSolverMonitor
+{
+public:
+   int calls = 0;
+   real_t last_norm = -1.0;
+
+   void MonitorResidual(int it, real_t norm, const Vector &r,
+                        bool final) override
+   {
+      if (!final) { calls++; last_norm = norm; }
+   }
+};
+
+/// Solve A x = b with CGSolver and the two variants of PipelinedCGSolver and
+/// compare the number of iterations, the final norms and the solutions.
+static void CompareWithCG(const Operator &A, Solver *B, const Vector &b,
+                          CGSolver &cg, PipelinedCGSolver &pcg)
+{
+   const real_t tol = 1e-10;
+   IterativeSolver *solvers[] = {&cg, &pcg};
+   for (IterativeSolver *solver : solvers)
+   {
+      solver->SetRelTol(tol);
+      solver->SetAbsTol(0.0);
+      solver->SetMaxIter(1000);
+      solver->SetOperator(A);
+      if (B) { solver->SetPreconditioner(*B); }
+   }
+
+   Vector x_cg(b.Size());
+   x_cg = 0.0;
+   cg.Mult(b, x_cg);
+   REQUIRE(cg.GetConverged());
+
+   for (auto variant : {PipelinedCGSolver::PIPELINED,
+                        PipelinedCGSolver::SINGLE_REDUCTION})
+   {
+      pcg.SetVariant(variant);
+      CountingMonitor monitor;
+      pcg.SetMonitor(monitor);
+
+      Vector x(b.Size());
+      x = 0.0;
+      pcg.Mult(b, x);
+      CAPTURE(variant, cg.GetNumIterations(), pcg.GetNumIterations());
+      REQUIRE(pcg.GetConverged());
+      // Same iterates in exact arithmetic
+      REQUIRE(std::abs(pcg.GetNumIterations() - cg.GetNumIterations()) <= 2);
+      REQUIRE(pcg.GetInitialNorm() == MFEM_Approx(cg.GetInitialNorm()));
+      REQUIRE(pcg.GetFinalNorm() <= tol*pcg.GetInitialNorm());
+      REQUIRE(monitor.calls == pcg.GetNumIterations() + 1);
+      REQUIRE(monitor.last_norm == MFEM_Approx(
+                 pcg.GetFinalNorm()*pcg.GetFinalNorm()));
+
+      // The recursively updated residual matches the true one
+      Vector r(b.Size());
+      A.Mult(x, r);
+      subtract(b, r, r);
+      const real_t b_norm = sqrt(InnerProduct(b, b));
+      const real_t r_norm = sqrt(InnerProduct(r, r));
+      REQUIRE(r_norm <= 1e-7*b_norm);
+
+      x -= x_cg;
+      const real_t x_norm = sqrt(InnerProduct(x_cg, x_cg));
+      REQUIRE(sqrt(InnerProduct(x, x)) <= 1e-7*x_norm);
+   }
+}
+
+TEST_CASE("PipelinedCGSolver", "[PipelinedCGSolver]")
+{
+   const int order = GENERATE(1, 3);
+   const bool use_prec = GENERATE(false, true);
+   CAPTURE(order, use_prec);
+
+   Mesh mesh = Mesh::MakeCartesian2D(8, 8, Element::QUADRILATERAL);
+   H1_FECollection fec(order, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_tdof_list;
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   ConstantCoefficient one(1.0);
+   LinearForm b(&fes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.Assemble();
+
+   GridFunction x(&fes);
+   x = 0.0;
+   SparseMatrix A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+
+   DSmoother jacobi(A);
+   CGSolver cg;
+   PipelinedCGSolver pcg;
+   CompareWithCG(A, use_prec ? &jacobi : nullptr, B, cg, pcg);
+}
+
+TEST_CASE("PipelinedCGSolver Indefinite", "[PipelinedCGSolver]")
+{
+   mfem::out << "===> BEGIN: Expected PIPECG/SRCG warning messages"
+             << std::endl;
+
+   SparseMatrix indefinite(2, 2);
+   indefinite.Add(0, 0, -1.0);
+   indefinite.Finalize();
+
+   Vector v(2), x(2);
+   v = 1.0;
+   for (auto variant : {PipelinedCGSolver::PIPELINED,
+                        PipelinedCGSolver::SINGLE_REDUCTION})
+   {
+      PipelinedCGSolver pcg(variant);
+      pcg.SetOperator(indefinite);
+      pcg.SetPrintLevel(1);
+      x = 0.0;
+      pcg.Mult(v, x);
+      REQUIRE(!pcg.GetConverged());
+   }
+
+   mfem::out << "===> END: Expected PIPECG/SRCG warning messages" << std::endl;
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("PipelinedCGSolver Parallel", "[PipelinedCGSolver][Parallel]")
+{
+   const int order = GENERATE(1, 2);
+   CAPTURE(order);
+
+   Mesh serial_mesh = Mesh::MakeCartesian3D(4, 4, 4, Element::HEXAHEDRON);
+   ParMesh mesh(MPI_COMM_WORLD, serial_mesh);
+   serial_mesh.Clear();
+   H1_FECollection fec(order, mesh.Dimension());
+   ParFiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_tdof_list;
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   ConstantCoefficient one(1.0);
+   ParLinearForm b(&fes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+   ParBilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.Assemble();
+
+   ParGridFunction x(&fes);
+   x = 0.0;
+   HypreParMatrix A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+
+   HypreSmoother jacobi(A, HypreSmoother::Jacobi);
+   CGSolver cg(MPI_COMM_WORLD);
+   PipelinedCGSolver pcg(MPI_COMM_WORLD);
+   const real_t tol = 1e-10;
+   IterativeSolver *solvers[] = {&cg, &pcg};
+   for (IterativeSolver *solver : solvers)
+   {
+      solver->SetRelTol(tol);
+      solver->SetMaxIter(1000);
+      solver->SetOperator(A);
+      solver->SetPreconditioner(jacobi);
+   }
+
+   Vector x_cg(B.Size());
+   x_cg = 0.0;
+   cg.Mult(B, x_cg);
+   REQUIRE(cg.GetConverged());
+
+   for (auto variant : {PipelinedCGSolver::PIPELINED,
+                        PipelinedCGSolver::SINGLE_REDUCTION})
+   {
+      pcg.SetVariant(variant);
+      X = 0.0;
+      pcg.Mult(B, X);
+      CAPTURE(variant, cg.GetNumIterations(), pcg.GetNumIterations());
+      REQUIRE(pcg.GetConverged());
+      REQUIRE(std::abs(pcg.GetNumIterations() - cg.GetNumIterations()) <= 2);
+      REQUIRE(pcg.GetInitialNorm() == MFEM_Approx(cg.GetInitialNorm()));
+
+      X -= x_cg;
+      const real_t err = sqrt(InnerProduct(MPI_COMM_WORLD, X, X));
+      const real_t x_norm = sqrt(InnerProduct(MPI_COMM_WORLD, x_cg, x_cg));
+      REQUIRE(err <= 1e-7*x_norm);
+   }
+}
+
+#endif // MFEM_USE_MPI
+
+} // namespace pipelined_cg
@@ -0,0 +1,166 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+TEST_CASE("GSSmoother Parallel Variants", "[GSSmoother], [OpenMP]")
+{
+   using Parallelism = GSSmoother::Parallelism;
+   auto variant = GENERATE(Parallelism::MULTICOLOR, Parallelism::HYBRID);
+   CAPTURE(int(variant));
+
+   // Diffusion + mass matrix with homogeneous Dirichlet conditions; the
+   // matrix is diagonally dominant, so that the hybrid variant converges
+   Mesh mesh = Mesh::MakeCartesian2D(12, 10, Element::QUADRILATERAL);
+   H1_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   ConstantCoefficient one(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.AddDomainIntegrator(new MassIntegrator(one));
+   a.Assemble();
+   a.Finalize();
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_dofs;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_dofs);
+   SparseMatrix &A = a.SpMat();
+   A.EliminateBC(ess_dofs, Operator::DIAG_ONE);
+   const int n = A.Height();
+
+   GSSmoother S(A, 0);
+   S.SetParallelism(variant, 4);
+
+   SECTION("Symmetric smoother")
+   {
+      // (S u, v) = (u, S v) for the symmetric variant
+      Vector u(n), v(n), Su(n), Sv(n);
+      u.Randomize(1);
+      v.Randomize(2);
+      S.Mult(u, Su);
+      S.Mult(v, Sv);
+      REQUIRE(Su*v == MFEM_Approx(u*Sv));
+
+      // Repeated calls give the same result
+      Vector Su2(n);
+      S.Mult(u, Su2);
+      Su2 -= Su;
+      REQUIRE(Su2.Normlinf() == 0.0);
+   }
+
+   SECTION("Convergence")
+   {
+      for (int t : {0, 1, 2})
+      {
+         GSSmoother St(A, t, 400);
+         St.SetParallelism(variant, 4);
+         St.iterative_mode = true;
+         Vector b(n), x(n), r(n);
+         b.Randomize(3);
+         x = 0.0;
+         St.Mult(b, x);
+         A.Mult(x, r);
+         r -= b;
+         REQUIRE(r.Normlinf() <= 1e-8*b.Normlinf());
+      }
+   }
+
+   SECTION("Preconditioned CG")
+   {
+      CGSolver cg;
+      cg.SetOperator(A);
+      cg.SetPreconditioner(S);
+      cg.SetRelTol(1e-12);
+      cg.SetMaxIter(200);
+      Vector b(n), x(n);
+      b.Randomize(4);
+      x = 0.0;
+      cg.Mult(b, x);
+      REQUIRE(cg.GetConverged());
+   }
+}
+
+TEST_CASE("GSSmoother Multicolor", "[GSSmoother]")
+{
+   // 1D Laplacian: two colors, the odd-even ordering
+   const int n = 20;
+   SparseMatrix A(n, n);
+   for (int i = 0; i < n; i++)
+   {
+      A.Add(i, i, 2.0);
+      if (i > 0) { A.Add(i, i-1, -1.0); }
+      if (i < n-1) { A.Add(i, i+1, -1.0); }
+   }
+   A.Finalize();
+
+   GSSmoother S(A, 1);
+   S.SetParallelism(GSSmoother::Parallelism::MULTICOLOR);
+   REQUIRE(S.GetNumColors() == 2);
+
+   // Forward sweep: even rows first, then odd rows
+   Vector b(n), x(n), x_ref(n);
+   b.Randomize(1);
+   S.Mult(b, x);
+   x_ref = 0.0;
+   for (int parity : {0, 1})
+   {
+      for (int i = parity; i < n; i += 2)
+      {
+         real_t sum = b(i);
+         if (i > 0) { sum += x_ref(i-1); }
+         if (i < n-1) { sum += x_ref(i+1); }
+         x_ref(i) = sum/2.0;
+      }
+   }
+   x -= x_ref;
+   REQUIRE(x.Normlinf() == MFEM_Approx(0.0));
+
+   // A nonsymmetric pattern: rows coupled in one direction only still get
+   // different colors
+   SparseMatrix B(3, 3);
+   B.Add(0, 0, 1.0);
+   B.Add(1, 1, 1.0);
+   B.Add(2, 2, 1.0);
+   B.Add(0, 2, 1.0);
+   B.Finalize();
+   GSSmoother SB(B);
+   SB.SetParallelism(GSSmoother::Parallelism::MULTICOLOR);
+   REQUIRE(SB.GetNumColors() == 2);
+}
+
+TEST_CASE("GSSmoother Hybrid", "[GSSmoother]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(6, 6, Element::TRIANGLE);
+   H1_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   ConstantCoefficient one(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.AddDomainIntegrator(new MassIntegrator(one));
+   a.Assemble();
+   a.Finalize();
+   const SparseMatrix &A = a.SpMat();
+
+   // With one block, the hybrid smoother is the sequential one
+   Vector b(A.Height()), x(A.Height()), x_ref(A.Height());
+   b.Randomize(1);
+   for (int t : {0, 1, 2})
+   {
+      GSSmoother S(A, t, 2), S_ref(A, t, 2);
+      S.SetParallelism(GSSmoother::Parallelism::HYBRID, 1);
+      S.Mult(b, x);
+      S_ref.Mult(b, x_ref);
+      x -= x_ref;
+      REQUIRE(x.Normlinf() == MFEM_Approx(0.0));
+   }
+}
@@ -146,6 +146,42 @@ TEST_CASE("Gecko integration in MFEM", "[Mesh]")
    }
 }
 
+TEST_CASE("SpaceFillingCurvePartitioning", "[Mesh]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(12, 10, Element::QUADRILATERAL);
+   const int nparts = 7;
+   const bool weighted = GENERATE(false, true);
+   Vector weights(mesh.GetNE());
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      weights(i) = weighted ? 1.0 + (i % 4) : 1.0;
+   }
+   int *partitioning = mesh.SpaceFillingCurvePartitioning(nparts, &weights);
+
+   // The parts are contiguous along the Hilbert curve
+   Array<int> ordering, sequence(mesh.GetNE());
+   mesh.GetHilbertElementOrdering(ordering);
+   for (int i = 0; i < mesh.GetNE(); i++) { sequence[ordering[i]] = i; }
+   for (int i = 1; i < mesh.GetNE(); i++)
+   {
+      REQUIRE(partitioning[sequence[i]] >= partitioning[sequence[i-1]]);
+   }
+
+   // The weight of each part is within one element weight of the average
+   Vector part_weight(nparts);
+   part_weight = 0.0;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      part_weight(partitioning[i]) += weights(i);
+   }
+   const real_t avg_weight = weights.Sum()/nparts;
+   for (int p = 0; p < nparts; p++)
+   {
+      REQUIRE(std::abs(part_weight(p) - avg_weight) <= weights.Max());
+   }
+   delete [] partitioning;
+}
+
 TEST_CASE("MakeSimplicial", "[Mesh]")
 {
    auto mesh_fname = GENERATE("../../data/star.mesh",
@@ -336,3 +372,85 @@ TEST_CASE("MakeNurbs", "[Mesh]")
       Mesh::MakeCartesian3D(1, 1, 1, Element::Type::HEXAHEDRON);
    test_nurbs_extension(patch_topology_3d);
 }
+
+TEST_CASE("Binary file I/O", "[Mesh]")
+{
+   const bool curved = GENERATE(false, true);
+   Mesh mesh = Mesh::MakeCartesian3D(3, 2, 2, Element::HEXAHEDRON);
+   if (curved) { mesh.SetCurvature(2); }
+
+   H1_FECollection fec(2, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec, 2);
+   GridFunction gf(&fes);
+   VectorFunctionCoefficient coeff(2, [](const Vector &x, Vector &v)
+   {
+      v(0) = x(0)*x(1) + x(2);
+      v(1) = x(0) - x(1)*x(2);
+   });
+   gf.ProjectCoefficient(coeff);
+
+   QuadratureSpace qspace(&mesh, 3);
+   QuadratureFunction qf(&qspace, 2);
+   qf.ProjectGridFunction(gf);
+
+   const std::string fname = "binary_file_test.bin";
+   {
+      BinaryFileWriter out(fname);
+      mesh.SaveBinary(out);
+      gf.SaveBinary(out);
+      qf.SaveBinary(out);
+   }
+
+   BinaryFile in(fname);
+   REQUIRE(in.HasEntry("mesh/info"));
+   REQUIRE(in.HasEntry("mesh/nodes/data") == curved);
+
+   Mesh loaded = Mesh::LoadFromBinary(in);
+   REQUIRE(loaded.GetNV() == mesh.GetNV());
+   REQUIRE(loaded.GetNE() == mesh.GetNE());
+   REQUIRE(loaded.GetNBE() == mesh.GetNBE());
+   REQUIRE(loaded.GetNEdges() == mesh.GetNEdges());
+   REQUIRE(loaded.GetNFaces() == mesh.GetNFaces());
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      REQUIRE(loaded.GetAttribute(i) == mesh.GetAttribute(i));
+   }
+   for (int i = 0; i < mesh.GetNBE(); i++)
+   {
+      REQUIRE(loaded.GetBdrAttribute(i) == mesh.GetBdrAttribute(i));
+   }
+   real_t vol = 0.0, loaded_vol = 0.0;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      vol += mesh.GetElementVolume(i);
+      loaded_vol += loaded.GetElementVolume(i);
+   }
+   REQUIRE(loaded_vol == MFEM_Approx(vol));
+
+   // The values refer to the data of the binary file, without copies
+   uint64_t n;
+   const real_t *vert = in.GetEntry<real_t>("mesh/vertices", n);
+   REQUIRE(loaded.GetVertex(0) == vert);
+   if (curved)
+   {
+      const real_t *nodes = in.GetEntry<real_t>("mesh/nodes/data", n);
+      REQUIRE(loaded.GetNodes()->HostRead() == nodes);
+   }
+
+   GridFunction loaded_gf(&loaded, in);
+   REQUIRE(loaded_gf.HostRead() == in.GetEntry<real_t>("gf/data", n));
+   REQUIRE(loaded_gf.FESpace()->GetVDim() == 2);
+   Vector diff(loaded_gf);
+   diff -= gf;
+   REQUIRE(diff.Normlinf() == MFEM_Approx(0.0));
+
+   QuadratureFunction loaded_qf(&loaded, in);
+   REQUIRE(loaded_qf.HostRead() == in.GetEntry<real_t>("qf/data", n));
+   REQUIRE(loaded_qf.GetVDim() == 2);
+   REQUIRE(loaded_qf.GetSpace()->GetOrder() == 3);
+   diff = loaded_qf;
+   diff -= qf;
+   REQUIRE(diff.Normlinf() == MFEM_Approx(0.0));
+
+   remove(fname.c_str());
+}
@@ -182,6 +182,39 @@ TEST_CASE("NCMesh 3D Derefined Volume", "[NCMesh]")
    REQUIRE(derefined_volume == MFEM_Approx(original_volume));
 } // test case
 
+TEST_CASE("NCMesh Memory Usage", "[NCMesh]")
+{
+   Mesh mesh = Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON);
+   mesh.EnsureNCMesh();
+   REQUIRE(mesh.ncmesh != nullptr);
+
+   const NCMesh::MemoryUsageInfo before = mesh.ncmesh->GetMemoryUsage();
+   REQUIRE(before.Total() == mesh.ncmesh->MemoryUsage());
+
+   Array<Refinement> refs;
+   refs.Append(Refinement(0, Refinement::XYZ));
+   refs.Append(Refinement(7, Refinement::X));
+   mesh.GeneralRefinement(refs, 1);
+   mesh.UniformRefinement();
+
+   const NCMesh::MemoryUsageInfo after = mesh.ncmesh->GetMemoryUsage();
+   REQUIRE(after.Total() == mesh.ncmesh->MemoryUsage());
+   // storage is allocated in blocks, it may not grow with each refinement
+   REQUIRE(after.nodes >= before.nodes);
+   REQUIRE(after.faces >= before.faces);
+   REQUIRE(after.elements >= before.elements);
+   REQUIRE(after.leaves > 0);
+   REQUIRE(after.lists > 0);
+   REQUIRE(after.other >= long(sizeof(NCMesh)));
+
+   // Trim() only releases the cached data, not the refinement hierarchy
+   mesh.ncmesh->Trim();
+   const NCMesh::MemoryUsageInfo trimmed = mesh.ncmesh->GetMemoryUsage();
+   REQUIRE(trimmed.Total() == mesh.ncmesh->MemoryUsage());
+   REQUIRE(trimmed.elements == after.elements);
+   REQUIRE(trimmed.lists <= after.lists);
+} // test case
+
 
 #ifdef MFEM_USE_MPI
 
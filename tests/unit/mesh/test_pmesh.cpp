@@ -198,6 +198,427 @@ TEST_CASE("ParMeshMakeSimplicial", "[Parallel], [ParMesh]")
    REQUIRE(x.Normlinf() == MFEM_Approx(0.0));
 }
 
+TEST_CASE("ParMeshParallelFile", "[Parallel], [ParMesh]")
+{
+   const bool nonconforming = GENERATE(false, true);
+   Mesh mesh = Mesh::MakeCartesian3D(4, 4, 4, Element::HEXAHEDRON);
+   mesh.SetCurvature(2);
+   if (nonconforming) { mesh.EnsureNCMesh(); }
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   if (nonconforming)
+   {
+      Array<int> refs({0});
+      pmesh.GeneralRefinement(refs);
+   }
+   const long long global_ne = pmesh.GetGlobalNE();
+
+   const std::string fname = "parallel_file_test.mesh";
+   pmesh.SaveParallelFile(fname);
+
+   // Same number of ranks: every rank reads back its own part
+   ParMesh loaded = ParMesh::LoadParallelFile(MPI_COMM_WORLD, fname);
+   REQUIRE(loaded.Nonconforming() == nonconforming);
+   REQUIRE(loaded.GetNE() == pmesh.GetNE());
+   REQUIRE(loaded.GetNSharedFaces() == pmesh.GetNSharedFaces());
+   REQUIRE(loaded.GetGlobalNE() == global_ne);
+   if (!nonconforming)
+   {
+      // the elements keep their order, the vertices and DOFs are renumbered
+      const GridFunction &nodes = *pmesh.GetNodes();
+      const GridFunction &loaded_nodes = *loaded.GetNodes();
+      Array<int> vdofs, loaded_vdofs;
+      Vector x, loaded_x;
+      real_t max_diff = 0.0;
+      for (int i = 0; i < pmesh.GetNE(); i++)
+      {
+         nodes.FESpace()->GetElementVDofs(i, vdofs);
+         loaded_nodes.FESpace()->GetElementVDofs(i, loaded_vdofs);
+         nodes.GetSubVector(vdofs, x);
+         loaded_nodes.GetSubVector(loaded_vdofs, loaded_x);
+         loaded_x -= x;
+         max_diff = std::max(max_diff, loaded_x.Normlinf());
+      }
+      REQUIRE(max_diff == MFEM_Approx(0.0));
+   }
+
+   // Different number of ranks: the elements are split evenly
+   if (!nonconforming && Mpi::WorldSize() > 1)
+   {
+      MPI_Comm comm;
+      MPI_Comm_split(MPI_COMM_WORLD, Mpi::WorldRank() == 0, 0, &comm);
+      {
+         ParMesh repart = ParMesh::LoadParallelFile(comm, fname);
+         REQUIRE(repart.GetGlobalNE() == global_ne);
+         int nbe = repart.GetNBE(), global_nbe;
+         real_t volume = 0.0, global_volume;
+         for (int i = 0; i < repart.GetNE(); i++)
+         {
+            volume += repart.GetElementVolume(i);
+         }
+         MPI_Allreduce(&nbe, &global_nbe, 1, MPI_INT, MPI_SUM, comm);
+         MPI_Allreduce(&volume, &global_volume, 1, MPITypeMap<real_t>::mpi_type,
+                       MPI_SUM, comm);
+         REQUIRE(global_nbe == 6*4*4);
+         REQUIRE(global_volume == MFEM_Approx(1.0));
+         REQUIRE(repart.bdr_attributes.Size() == 6);
+      }
+      MPI_Comm_free(&comm);
+   }
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (Mpi::Root()) { remove(fname.c_str()); }
+}
+
+// Return the L2 error of the solution of a Poisson problem with the exact
+// linear solution simplicial::exact, which is in the space of order @a order.
+real_t LinearPoissonError(ParMesh &pmesh, int order)
+{
+   H1_FECollection fec(order, pmesh.Dimension());
+   ParFiniteElementSpace fes(&pmesh, &fec);
+   Array<int> ess_bdr(pmesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+   ParLinearForm b(&fes);
+   b.Assemble();
+   ParBilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.Assemble();
+   FunctionCoefficient exact(simplicial::exact);
+   ParGridFunction x(&fes);
+   x = 0.0;
+   x.ProjectBdrCoefficient(exact, ess_bdr);
+   OperatorPtr A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+   CGSolver cg(MPI_COMM_WORLD);
+   cg.SetRelTol(1e-12);
+   cg.SetMaxIter(2000);
+   cg.SetOperator(*A);
+   cg.Mult(B, X);
+   a.RecoverFEMSolution(X, b, x);
+   return x.ComputeL2Error(exact);
+}
+
+TEST_CASE("ParMeshMakeCartesian3D", "[Parallel], [ParMesh]")
+{
+   // The distributed Cartesian mesh is the same as the serial Cartesian mesh
+   // partitioned into the same blocks
+   const auto type = GENERATE(Element::HEXAHEDRON, Element::TETRAHEDRON,
+                              Element::WEDGE);
+   CAPTURE(type);
+
+   const int nranks = Mpi::WorldSize();
+   int nxyz[3] = { 1, 1, nranks };
+   if (nranks % 2 == 0) { nxyz[0] = 2; nxyz[2] = nranks/2; }
+   const int nx = 2*nxyz[0], ny = 3, nz = 2*nxyz[2];
+
+   ParMesh pmesh = ParMesh::MakeCartesian3D(MPI_COMM_WORLD, nx, ny, nz, type,
+                                            1.0, 2.0, 3.0, nxyz);
+   Mesh mesh = Mesh::MakeCartesian3D(nx, ny, nz, type, 1.0, 2.0, 3.0);
+   int *partitioning = mesh.CartesianPartitioning(nxyz);
+   ParMesh pmesh_ref(MPI_COMM_WORLD, mesh, partitioning);
+   delete [] partitioning;
+
+   REQUIRE(pmesh.GetNE() == pmesh_ref.GetNE());
+   REQUIRE(pmesh.GetNBE() == pmesh_ref.GetNBE());
+   REQUIRE(pmesh.GetNV() == pmesh_ref.GetNV());
+   REQUIRE(pmesh.GetNSharedFaces() == pmesh_ref.GetNSharedFaces());
+   REQUIRE(pmesh.GetNGroups() == pmesh_ref.GetNGroups());
+   REQUIRE(pmesh.GetGlobalNE() == mesh.GetNE());
+   REQUIRE(pmesh.bdr_attributes.Size() == 6);
+
+   Vector min, max, min_ref, max_ref;
+   pmesh.GetBoundingBox(min, max);
+   pmesh_ref.GetBoundingBox(min_ref, max_ref);
+   min -= min_ref;
+   max -= max_ref;
+   REQUIRE(min.Normlinf() == MFEM_Approx(0.0));
+   REQUIRE(max.Normlinf() == MFEM_Approx(0.0));
+
+   // Consistent shared vertices, edges and faces
+   for (int order : {1, 3})
+   {
+      H1_FECollection h1_fec(order, 3);
+      ParFiniteElementSpace h1_fes(&pmesh, &h1_fec);
+      ParFiniteElementSpace h1_fes_ref(&pmesh_ref, &h1_fec);
+      REQUIRE(h1_fes.GlobalTrueVSize() == h1_fes_ref.GlobalTrueVSize());
+
+      ND_FECollection nd_fec(order, 3);
+      ParFiniteElementSpace nd_fes(&pmesh, &nd_fec);
+      ParFiniteElementSpace nd_fes_ref(&pmesh_ref, &nd_fec);
+      REQUIRE(nd_fes.GlobalTrueVSize() == nd_fes_ref.GlobalTrueVSize());
+   }
+
+   // The linear solution of a Poisson problem is exact
+   REQUIRE(LinearPoissonError(pmesh, 2) == MFEM_Approx(0.0, 1e-8));
+}
+
+TEST_CASE("ParMeshMakeCartesian3DAutoGrid", "[Parallel], [ParMesh]")
+{
+   // Processor grid chosen by MakeCartesian3D, with blocks of unequal sizes
+   const auto type = GENERATE(Element::HEXAHEDRON, Element::TETRAHEDRON,
+                              Element::WEDGE);
+   CAPTURE(type);
+
+   const int nx = 5, ny = 4, nz = 3;
+   ParMesh pmesh = ParMesh::MakeCartesian3D(MPI_COMM_WORLD, nx, ny, nz, type);
+   Mesh mesh = Mesh::MakeCartesian3D(nx, ny, nz, type);
+
+   REQUIRE(pmesh.GetGlobalNE() == mesh.GetNE());
+   REQUIRE(pmesh.ReduceInt(pmesh.GetNBE()) == mesh.GetNBE());
+   REQUIRE(pmesh.bdr_attributes.Size() == 6);
+
+   for (int order : {1, 2})
+   {
+      H1_FECollection h1_fec(order, 3);
+      ParFiniteElementSpace h1_fes(&pmesh, &h1_fec);
+      FiniteElementSpace h1_fes_ref(&mesh, &h1_fec);
+      REQUIRE(h1_fes.GlobalTrueVSize() == h1_fes_ref.GetTrueVSize());
+
+      ND_FECollection nd_fec(order, 3);
+      ParFiniteElementSpace nd_fes(&pmesh, &nd_fec);
+      FiniteElementSpace nd_fes_ref(&mesh, &nd_fec);
+      REQUIRE(nd_fes.GlobalTrueVSize() == nd_fes_ref.GetTrueVSize());
+   }
+
+   REQUIRE(LinearPoissonError(pmesh, 2) == MFEM_Approx(0.0, 1e-8));
+}
+
+TEST_CASE("ParMeshRebalanceConforming", "[Parallel], [ParMesh]")
+{
+   const auto type = GENERATE(Element::HEXAHEDRON, Element::TETRAHEDRON);
+   const bool curved = GENERATE(false, true);
+   CAPTURE(type, curved);
+
+   Mesh mesh = Mesh::MakeCartesian3D(4, 4, 4, type);
+   mesh.Finalize(true); // mark the tetrahedra for refinement
+   if (curved) { mesh.SetCurvature(2); }
+
+   // All the elements start on the first rank
+   Array<int> partitioning(mesh.GetNE());
+   partitioning = 0;
+   ParMesh pmesh(MPI_COMM_WORLD, mesh, partitioning.GetData());
+
+   // Heavier elements in half of the domain
+   auto element_weights = [&pmesh](Vector &weights)
+   {
+      Vector center;
+      weights.SetSize(pmesh.GetNE());
+      for (int i = 0; i < pmesh.GetNE(); i++)
+      {
+         pmesh.GetElementCenter(i, center);
+         weights(i) = (center(0) < 0.5) ? 1.0 : 3.0;
+      }
+   };
+   Vector weights;
+   element_weights(weights);
+   pmesh.Rebalance(weights);
+   REQUIRE(pmesh.GetGlobalNE() == mesh.GetNE());
+
+   // The weight of each rank is within one element weight of the average
+   element_weights(weights);
+   real_t local_weight = weights.Sum(), min_weight, max_weight, total_weight;
+   const MPI_Datatype mpi_real = MPITypeMap<real_t>::mpi_type;
+   MPI_Allreduce(&local_weight, &min_weight, 1, mpi_real, MPI_MIN,
+                 MPI_COMM_WORLD);
+   MPI_Allreduce(&local_weight, &max_weight, 1, mpi_real, MPI_MAX,
+                 MPI_COMM_WORLD);
+   MPI_Allreduce(&local_weight, &total_weight, 1, mpi_real, MPI_SUM,
+                 MPI_COMM_WORLD);
+   const real_t avg_weight = total_weight/Mpi::WorldSize();
+   REQUIRE(max_weight - avg_weight <= 3.0);
+   REQUIRE(avg_weight - min_weight <= 3.0);
+
+   // The curved nodes are continuous across the ranks
+   if (curved)
+   {
+      ParGridFunction *nodes = dynamic_cast<ParGridFunction*>(pmesh.GetNodes());
+      REQUIRE(nodes != nullptr);
+      Vector tdofs;
+      nodes->GetTrueDofs(tdofs);
+      ParGridFunction nodes_copy(*nodes);
+      nodes_copy.SetFromTrueDofs(tdofs);
+      nodes_copy -= *nodes;
+      REQUIRE(nodes_copy.Normlinf() == MFEM_Approx(0.0));
+   }
+   REQUIRE(LinearPoissonError(pmesh, 2) == MFEM_Approx(0.0, 1e-8));
+
+   // Equal number of elements with the default weights
+   pmesh.Rebalance();
+   REQUIRE(pmesh.GetGlobalNE() == mesh.GetNE());
+   const int ne = pmesh.GetNE();
+   int min_ne, max_ne;
+   MPI_Allreduce(&ne, &min_ne, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+   MPI_Allreduce(&ne, &max_ne, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+   REQUIRE(max_ne - min_ne <= 1);
+   REQUIRE(LinearPoissonError(pmesh, 1) == MFEM_Approx(0.0, 1e-8));
+
+   // Refinement of the rebalanced mesh
+   pmesh.UniformRefinement();
+   REQUIRE(pmesh.GetGlobalNE() == 8*mesh.GetNE());
+   REQUIRE(LinearPoissonError(pmesh, 1) == MFEM_Approx(0.0, 1e-8));
+}
+
+TEST_CASE("ParMeshRebalanceConformingTransfer", "[Parallel], [ParMesh]")
+{
+   const auto type = GENERATE(Element::HEXAHEDRON, Element::TETRAHEDRON);
+   CAPTURE(type);
+
+   Mesh mesh = Mesh::MakeCartesian3D(3, 3, 3, type);
+   mesh.Finalize(true);
+
+   // All the elements start on the first rank
+   Array<int> partitioning(mesh.GetNE());
+   partitioning = 0;
+   ParMesh pmesh(MPI_COMM_WORLD, mesh, partitioning.GetData());
+
+   VectorFunctionCoefficient vcoeff(3, [](const Vector &x, Vector &v)
+   {
+      v(0) = sin(x(1)) + x(2);
+      v(1) = cos(x(2)) * x(0);
+      v(2) = exp(x(0)) - x(1);
+   });
+   FunctionCoefficient coeff([](const Vector &x)
+   {
+      return sin(x(0)) * cos(x(1)) + x(2) * x(2);
+   });
+
+   // Spaces with oriented edge and face DOFs, and a vector H1 space
+   H1_FECollection h1_fec(3, 3);
+   ND_FECollection nd_fec(2, 3);
+   RT_FECollection rt_fec(1, 3);
+   ParFiniteElementSpace h1_fes(&pmesh, &h1_fec);
+   ParFiniteElementSpace h1v_fes(&pmesh, &h1_fec, 3, Ordering::byVDIM);
+   ParFiniteElementSpace nd_fes(&pmesh, &nd_fec);
+   ParFiniteElementSpace rt_fes(&pmesh, &rt_fec);
+   ParFiniteElementSpace *spaces[] = { &h1_fes, &h1v_fes, &nd_fes, &rt_fes };
+
+   std::vector<ParGridFunction> gfs;
+   gfs.reserve(4);
+   for (ParFiniteElementSpace *fes : spaces) { gfs.emplace_back(fes); }
+   auto project = [&](ParGridFunction &gf)
+   {
+      if (gf.FESpace()->GetVDim() == 1 && gf.FESpace()->FEColl() == &h1_fec)
+      {
+         gf.ProjectCoefficient(coeff);
+      }
+      else
+      {
+         gf.ProjectCoefficient(vcoeff);
+      }
+   };
+   for (ParGridFunction &gf : gfs) { project(gf); }
+
+   // The grid functions migrate with the elements: they are equal to the
+   // projections on the new mesh
+   auto check = [&]()
+   {
+      for (int i = 0; i < 4; i++)
+      {
+         CAPTURE(i);
+         spaces[i]->Update();
+         gfs[i].Update();
+         ParGridFunction gf_ref(spaces[i]);
+         project(gf_ref);
+         gf_ref -= gfs[i];
+         REQUIRE(gf_ref.Normlinf() == MFEM_Approx(0.0, 1e-10));
+      }
+   };
+
+   pmesh.Rebalance();
+   REQUIRE(pmesh.GetGlobalNE() == mesh.GetNE());
+   check();
+
+   // Every other element moves to the next rank
+   Array<int> partition(pmesh.GetNE());
+   for (int i = 0; i < pmesh.GetNE(); i++)
+   {
+      partition[i] = (Mpi::WorldRank() + i%2) % Mpi::WorldSize();
+   }
+   pmesh.Rebalance(partition);
+   REQUIRE(pmesh.GetGlobalNE() == mesh.GetNE());
+   check();
+}
+
+TEST_CASE("ParMeshRebalanceWeighted", "[Parallel], [ParMesh]")
+{
+   // Nonconforming mesh with all the elements on the first rank
+   Mesh mesh = Mesh::MakeCartesian2D(8, 8, Element::QUADRILATERAL);
+   mesh.EnsureNCMesh();
+   Array<int> partitioning(mesh.GetNE());
+   partitioning = 0;
+   ParMesh pmesh(MPI_COMM_WORLD, mesh, partitioning.GetData());
+
+   Vector center;
+   Array<int> refs;
+   for (int i = 0; i < pmesh.GetNE(); i++)
+   {
+      pmesh.GetElementCenter(i, center);
+      if (center(0) < 0.3 && center(1) < 0.3) { refs.Append(i); }
+   }
+   pmesh.GeneralRefinement(refs);
+   const long long global_ne = pmesh.GetGlobalNE();
+
+   // Variable-order space, with higher orders in half of the domain
+   auto element_order = [&pmesh](int i)
+   {
+      Vector c;
+      pmesh.GetElementCenter(i, c);
+      return (c(0) > 0.5) ? 3 : 1;
+   };
+   H1_FECollection fec(1, 2);
+   ParFiniteElementSpace fes(&pmesh, &fec);
+   for (int i = 0; i < pmesh.GetNE(); i++)
+   {
+      if (element_order(i) > 1) { fes.SetElementOrder(i, element_order(i)); }
+   }
+   fes.Update(false);
+
+   FunctionCoefficient linear([](const Vector &x)
+   {
+      return 1.0 + x(0) + 2.0*x(1);
+   });
+   ParGridFunction x(&fes);
+   x.ProjectCoefficient(linear);
+
+   ElementCostRecorder recorder(pmesh.GetNE());
+   recorder.AddQuadratureCost(fes);
+   const real_t imbalance = pmesh.GetLoadImbalance(recorder.GetCosts());
+   REQUIRE(imbalance == MFEM_Approx(Mpi::WorldSize()));
+
+   // No migration if the imbalance is acceptable
+   const long sequence = pmesh.GetSequence();
+   REQUIRE_FALSE(pmesh.Rebalance(recorder.GetCosts(), imbalance));
+   REQUIRE(pmesh.GetSequence() == sequence);
+
+   const bool rebalanced = pmesh.Rebalance(recorder.GetCosts(), 1.05);
+   REQUIRE(rebalanced == (Mpi::WorldSize() > 1));
+   fes.Update();
+   x.Update();
+   REQUIRE(pmesh.GetGlobalNE() == global_ne);
+
+   // The orders and the grid function migrated with the elements
+   for (int i = 0; i < pmesh.GetNE(); i++)
+   {
+      REQUIRE(fes.GetElementOrder(i) == element_order(i));
+   }
+   REQUIRE(x.ComputeL2Error(linear) == MFEM_Approx(0.0));
+
+   // The cost of each rank is within one element cost of the average
+   recorder.Reset(pmesh.GetNE());
+   recorder.AddQuadratureCost(fes);
+   real_t local_cost = recorder.GetCosts().Sum(), max_cost, total_cost;
+   const MPI_Datatype mpi_real = MPITypeMap<real_t>::mpi_type;
+   MPI_Allreduce(&local_cost, &max_cost, 1, mpi_real, MPI_MAX,
+                 MPI_COMM_WORLD);
+   MPI_Allreduce(&local_cost, &total_cost, 1, mpi_real, MPI_SUM,
+                 MPI_COMM_WORLD);
+   const real_t max_element_cost = 16*16; // order 3: 16 points, 16 DOFs
+   REQUIRE(max_cost - total_cost/Mpi::WorldSize() <= max_element_cost);
+   REQUIRE(pmesh.GetLoadImbalance(recorder.GetCosts()) ==
+           MFEM_Approx(max_cost*Mpi::WorldSize()/total_cost));
+}
+
 #endif // MFEM_USE_MPI
 
 } // namespace mfem